@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON files and fail on regressions.
+
+    compare_bench.py BASELINE CURRENT [--threshold 0.15] [--metric real_time]
+
+A benchmark regresses when its time in CURRENT exceeds the baseline by more
+than the threshold (a fraction). When the runs used --benchmark_repetitions
+the median aggregate is compared, otherwise the single run. A benchmark in
+CURRENT with no baseline fails the check too, so a stale baseline cannot pass
+new code unmeasured; re-record it (the bench_baseline target). Benchmarks only
+in the baseline, e.g. under --benchmark_filter, are listed but do not fail.
+Exits with 1 on any regression or unbaselined benchmark, 2 on unreadable input.
+"""
+
+import argparse
+import json
+import sys
+
+# Google Benchmark reports each entry in its own unit
+NANOSECONDS_PER_UNIT = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path, metric):
+    try:
+        with open(path) as f:
+            report = json.load(f)
+    except (OSError, ValueError) as error:
+        print(f"error: cannot read {path}: {error}", file=sys.stderr)
+        sys.exit(2)
+
+    singles, medians = {}, {}
+    for entry in report.get("benchmarks", []):
+        if entry.get("error_occurred"):
+            continue
+        nanoseconds = entry[metric] * NANOSECONDS_PER_UNIT[entry.get("time_unit", "ns")]
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[entry["run_name"]] = nanoseconds
+        else:
+            singles.setdefault(entry.get("run_name", entry["name"]), nanoseconds)
+    # Prefer medians where repetitions produced them
+    singles.update(medians)
+    return singles
+
+
+def format_time(nanoseconds):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if nanoseconds >= scale:
+            return f"{nanoseconds / scale:.3f} {unit}"
+    return f"{nanoseconds:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.15,
+                        help="allowed slowdown as a fraction (default 0.15)")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="real_time")
+    args = parser.parse_args()
+
+    baseline = load_times(args.baseline, args.metric)
+    current = load_times(args.current, args.metric)
+
+    regressions = []
+    unbaselined = []
+    width = max((len(name) for name in current), default=10)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>12}  {'Current':>12}  {'Change':>8}")
+    for name in sorted(current):
+        if name not in baseline:
+            unbaselined.append(name)
+            print(f"{name:<{width}}  {'-':>12}  {format_time(current[name]):>12}  {'new':>8}  NO BASELINE")
+            continue
+        change = current[name] / baseline[name] - 1.0
+        marker = ""
+        if change > args.threshold:
+            regressions.append(name)
+            marker = "  REGRESSION"
+        print(f"{name:<{width}}  {format_time(baseline[name]):>12}  "
+              f"{format_time(current[name]):>12}  {change:>+7.1%}{marker}")
+
+    for name in sorted(set(baseline) - set(current)):
+        print(f"{name:<{width}}  {format_time(baseline[name]):>12}  {'-':>12}  {'missing':>8}")
+
+    failed = False
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower than baseline by more than "
+              f"{args.threshold:.0%}: {', '.join(regressions)}")
+        failed = True
+    if unbaselined:
+        print(f"\n{len(unbaselined)} benchmark(s) missing from {args.baseline}: "
+              f"{', '.join(unbaselined)}")
+        failed = True
+    if failed:
+        return 1
+    print(f"\nNo regressions beyond {args.threshold:.0%}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+#include <core/frame_limiter.h>
+#include <core/frame_stats.h>
+#include <core/globals.h>
+#include <input/movement.h>
+#include <input/input_queue.h>
+#include <input/editor_input.h>
+#include <ui/fps_counter.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+extern MovementState moveState;
+
+// One movement integration step per iteration, walking and running in turn
+static void BM_MovementIntegration(benchmark::State& state) {
+    characterPosX = characterPosY = characterPosZ = 0.0f;
+    cameraFront = glm::normalize(glm::vec3(0.3f, 0.0f, -1.0f));
+    moveState = MovementState();
+    moveState.moveForward = true;
+    moveState.moveRight = true;
+
+    int step = 0;
+    for (auto _ : state) {
+        moveState.isRunning = (++step & 64) != 0;
+        Movement::updateMovement(1.0f / 120.0f);
+    }
+    benchmark::DoNotOptimize(characterPosX);
+    moveState = MovementState();
+}
+BENCHMARK(BM_MovementIntegration);
+
+namespace {
+    // Frame times around 8 ms with the odd hitch, replayed in a loop
+    std::vector<double> frameTimes() {
+        std::mt19937 rng(5);
+        std::normal_distribution<double> jitter(8.3, 0.4);
+        std::vector<double> frames(4096);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            frames[i] = i % 500 == 0 ? 40.0 : jitter(rng);
+        }
+        return frames;
+    }
+}
+
+// Arg: window size in frames
+static void BM_FrameTimeStatsAdd(benchmark::State& state) {
+    std::vector<double> frames = frameTimes();
+    FrameTimeStats stats(static_cast<size_t>(state.range(0)));
+    size_t i = 0;
+    for (auto _ : state) {
+        stats.addFrame(frames[i++ & (frames.size() - 1)]);
+    }
+    benchmark::DoNotOptimize(stats.getMaxMs());
+}
+BENCHMARK(BM_FrameTimeStatsAdd)->Arg(60)->Arg(1200);
+
+static void BM_FrameTimePercentiles(benchmark::State& state) {
+    std::vector<double> frames = frameTimes();
+    FrameTimeStats stats(1200);
+    for (double ms : frames) stats.addFrame(ms);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(stats.getPercentileMs(50.0) + stats.getPercentileMs(99.0) + stats.getOnePercentLowFps());
+    }
+}
+BENCHMARK(BM_FrameTimePercentiles);
+
+// Everything the main loop pays per frame for its FPS counter
+static void BM_FPSCounterUpdate(benchmark::State& state) {
+    std::vector<double> frames = frameTimes();
+    int64_t nowNs = 0;
+    size_t i = 0;
+    FPSCounter counter([&] { return nowNs; });
+    for (auto _ : state) {
+        nowNs += static_cast<int64_t>(frames[i++ & (frames.size() - 1)] * 1.0e6);
+        counter.update();
+    }
+    benchmark::DoNotOptimize(counter.getAverageFPS());
+}
+BENCHMARK(BM_FPSCounterUpdate);
+
+// Arg: mouse reports per frame, applied one by one as the callbacks used to
+static void BM_InputBurstPerEvent(benchmark::State& state) {
+    EditorInput::isEditorMode = false;
+    int reports = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        for (int i = 0; i < reports; ++i) {
+            mouse_callback(nullptr, 960.0 + (i & 63), 540.0);
+        }
+    }
+    benchmark::DoNotOptimize(cameraFront);
+    state.SetItemsProcessed(state.iterations() * reports);
+}
+BENCHMARK(BM_InputBurstPerEvent)->Arg(8)->Arg(1000);
+
+// Same reports through InputQueue: queued by the callback, merged at the tick
+static void BM_InputBurstQueued(benchmark::State& state) {
+    EditorInput::isEditorMode = false;
+    int reports = static_cast<int>(state.range(0));
+    InputQueue queue;
+    for (auto _ : state) {
+        for (int i = 0; i < reports; ++i) {
+            queue.push(InputEvent::cursor(960.0 + (i & 63), 540.0));
+        }
+        queue.drain([](const InputEvent& event) { applyInputEvent(nullptr, event); });
+    }
+    benchmark::DoNotOptimize(cameraFront);
+    state.SetItemsProcessed(state.iterations() * reports);
+}
+BENCHMARK(BM_InputBurstQueued)->Arg(8)->Arg(1000);
+
+namespace {
+    const double PACING_FPS = 120.0;
+
+    // How far frames land from the target, as counters; the first frame only
+    // starts the schedule
+    void reportPacing(benchmark::State& state, std::vector<double> frameMs) {
+        if (frameMs.size() < 2) return;
+        frameMs.erase(frameMs.begin());
+        double targetMs = 1000.0 / PACING_FPS;
+        double meanMs = 0.0;
+        std::vector<double> errorsUs;
+        for (double ms : frameMs) {
+            meanMs += ms / frameMs.size();
+            errorsUs.push_back(std::abs(ms - targetMs) * 1000.0);
+        }
+        double variance = 0.0;
+        for (double ms : frameMs) variance += (ms - meanMs) * (ms - meanMs) / frameMs.size();
+        std::sort(errorsUs.begin(), errorsUs.end());
+        state.counters["mean_ms"] = meanMs;
+        state.counters["stddev_us"] = std::sqrt(variance) * 1000.0;
+        state.counters["median_error_us"] = errorsUs[errorsUs.size() / 2];
+        state.counters["p90_error_us"] = errorsUs[errorsUs.size() * 9 / 10];
+    }
+}
+
+// One paced frame per iteration: FrameLimiter's sleep-then-spin on a fixed
+// schedule, against the millisecond sleep_for cap the main loop used before
+static void BM_FrameLimiterPacing(benchmark::State& state) {
+    FrameLimiter limiter(PACING_FPS);
+    std::vector<double> frameMs;
+    frameMs.reserve(static_cast<size_t>(state.max_iterations));
+    limiter.wait();
+    for (auto _ : state) {
+        frameMs.push_back(limiter.wait() * 1000.0);
+    }
+    reportPacing(state, frameMs);
+}
+BENCHMARK(BM_FrameLimiterPacing)->Iterations(240)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_SleepForPacing(benchmark::State& state) {
+    using namespace std::chrono;
+    const double targetMs = 1000.0 / PACING_FPS;
+    std::vector<double> frameMs;
+    frameMs.reserve(static_cast<size_t>(state.max_iterations));
+    auto previous = steady_clock::now();
+    for (auto _ : state) {
+        duration<double, std::milli> work = steady_clock::now() - previous;
+        if (work.count() < targetMs) {
+            std::this_thread::sleep_for(milliseconds(static_cast<int>(targetMs - work.count())));
+        }
+        auto now = steady_clock::now();
+        frameMs.push_back(duration<double, std::milli>(now - previous).count());
+        previous = now;
+    }
+    reportPacing(state, frameMs);
+}
+BENCHMARK(BM_SleepForPacing)->Iterations(240)->Unit(benchmark::kMillisecond)->UseRealTime();
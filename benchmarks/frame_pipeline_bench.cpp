@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+#include <core/frame_pipeline.h>
+#include <editor/editor.h>
+#include <graphics/indirect_renderer.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+    const size_t SCENE_OBJECTS = 20000;
+    const size_t MOVED_PER_FRAME = 200;
+
+    // Heavy scene: every simulated frame moves 1% of the objects and snapshots the rest
+    struct HeavyScene {
+        Editor::WorldEditor editor;
+        std::mt19937 rng{ 2024 };
+
+        HeavyScene() {
+            std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+            const Editor::ObjectType types[] = {
+                Editor::ObjectType::WALL, Editor::ObjectType::HOUSE, Editor::ObjectType::TOWER
+            };
+            for (size_t i = 0; i < SCENE_OBJECTS; ++i) {
+                editor.addObject(types[i % 3], glm::vec3(coordinate(rng), 0.0f, coordinate(rng)), glm::vec3(2.0f));
+            }
+        }
+
+        void simulate(float, FrameSnapshot& snapshot) {
+            std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+            for (size_t i = 0; i < MOVED_PER_FRAME; ++i) {
+                editor.setObjectPosition(rng() % SCENE_OBJECTS, glm::vec3(coordinate(rng), 0.0f, coordinate(rng)));
+            }
+            snapshot.cameraPosition = glm::vec3(0.0f, 1.5f, 0.0f);
+            editor.captureSnapshot(snapshot);
+        }
+    };
+
+    // CPU half of drawing a snapshot (what SnapshotRenderer does before its GL
+    // calls), followed by a wait standing in for the driver and swap
+    struct RenderWork {
+        MeshArena arena;
+        std::unordered_map<const Editor::ProceduralMesh*, MeshRange> ranges;
+        std::vector<IndirectDrawItem> items;
+        IndirectDrawList drawList;
+        Frustum frustum;
+        std::chrono::microseconds presentWait;
+
+        explicit RenderWork(std::chrono::microseconds wait) : presentWait(wait) {
+            glm::mat4 projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+            glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.5f, 0.0f), glm::vec3(0.0f, 1.5f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            frustum = Frustum::fromMatrix(projection * view);
+        }
+
+        void draw(const FrameSnapshot& snapshot) {
+            items.clear();
+            for (const SnapshotObject& object : snapshot.objects) {
+                const Editor::ProceduralMesh* mesh = snapshot.meshes[object.meshIndex].get();
+                auto it = ranges.find(mesh);
+                if (it == ranges.end()) {
+                    it = ranges.emplace(mesh, mesh->appendTo(arena)).first;
+                }
+                items.push_back(IndirectDrawItem{ it->second, object.material, object.model, object.color });
+            }
+            IndirectDraw::buildDrawList(items, frustum, drawList);
+            benchmark::DoNotOptimize(drawList.commands.data());
+            if (presentWait.count() > 0) {
+                std::this_thread::sleep_for(presentWait);
+            }
+        }
+    };
+
+    void reportPipelineStats(benchmark::State& state, const FramePipeline& pipeline) {
+        FramePipeline::Stats stats = pipeline.getStats();
+        state.counters["frames_per_second"] = benchmark::Counter(
+            static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+        state.counters["sim_to_present_ms"] = stats.averageLatencyMs;
+        state.counters["dropped_sim_frames"] = static_cast<double>(stats.droppedFrames);
+    }
+}
+
+// Simulation and rendering take turns on one thread, as mainLoop used to
+static void BM_SerialFrames(benchmark::State& state) {
+    HeavyScene scene;
+    RenderWork render{ std::chrono::microseconds(state.range(0)) };
+    FramePipeline pipeline([&](float deltaTime, FrameSnapshot& snapshot) { scene.simulate(deltaTime, snapshot); }, 0.0f);
+
+    for (auto _ : state) {
+        pipeline.stepOnce(1.0f / 120.0f);
+        const FrameSnapshot* snapshot = pipeline.acquireLatest();
+        render.draw(*snapshot);
+        pipeline.markPresented(*snapshot);
+    }
+    reportPipelineStats(state, pipeline);
+}
+BENCHMARK(BM_SerialFrames)->Arg(0)->Arg(4000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Simulation on its own thread; each iteration presents one new simulated frame
+static void BM_PipelinedFrames(benchmark::State& state) {
+    HeavyScene scene;
+    RenderWork render{ std::chrono::microseconds(state.range(0)) };
+    FramePipeline pipeline([&](float deltaTime, FrameSnapshot& snapshot) { scene.simulate(deltaTime, snapshot); }, 0.0f);
+    pipeline.start();
+
+    for (auto _ : state) {
+        bool isNew = false;
+        const FrameSnapshot* snapshot = pipeline.acquireLatest(&isNew);
+        while (!isNew) {
+            std::this_thread::yield();
+            snapshot = pipeline.acquireLatest(&isNew);
+        }
+        render.draw(*snapshot);
+        pipeline.markPresented(*snapshot);
+    }
+    pipeline.stop();
+    reportPipelineStats(state, pipeline);
+}
+BENCHMARK(BM_PipelinedFrames)->Arg(0)->Arg(4000)->Unit(benchmark::kMillisecond)->UseRealTime();
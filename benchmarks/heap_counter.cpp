@@ -0,0 +1,29 @@
+#include "heap_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Kept apart from the benchmarks so their delete-expressions are not inlined
+// against these definitions
+
+namespace {
+    std::atomic<size_t> allocations(0);
+}
+
+size_t heapAllocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
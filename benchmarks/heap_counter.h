@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+// Heap allocations made through operator new since the benchmark process
+// started. heap_counter.cpp replaces the global operators to count them.
+size_t heapAllocationCount();
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <graphics/mesh_processing.h>
+#include <core/thread_pool.h>
+#include <cmath>
+
+namespace {
+    // Rolling heightfield of (size x size) quads -> 2 * size^2 triangles
+    void buildTerrain(int size, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        vertices.clear();
+        indices.clear();
+        vertices.reserve((size + 1) * (size + 1));
+        indices.reserve(size * size * 6);
+
+        for (int z = 0; z <= size; ++z) {
+            for (int x = 0; x <= size; ++x) {
+                Vertex vertex{};
+                float fx = static_cast<float>(x);
+                float fz = static_cast<float>(z);
+                vertex.position = glm::vec3(fx, std::sin(fx * 0.1f) * std::cos(fz * 0.1f) * 4.0f, fz);
+                vertex.texCoord = glm::vec2(fx / size, fz / size);
+                vertices.push_back(vertex);
+            }
+        }
+
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                uint32_t a = z * (size + 1) + x;
+                uint32_t b = a + 1;
+                uint32_t c = a + size + 1;
+                uint32_t d = c + 1;
+                indices.insert(indices.end(), { a, c, b, b, c, d });
+            }
+        }
+    }
+
+    ThreadPool& benchPool() {
+        static ThreadPool pool;
+        return pool;
+    }
+}
+
+// Arg: grid size; 1024 -> ~2.1M triangles
+static void BM_GenerateNormals(benchmark::State& state) {
+    std::vector<Vertex> baseVertices;
+    std::vector<uint32_t> baseIndices;
+    buildTerrain(static_cast<int>(state.range(0)), baseVertices, baseIndices);
+    ThreadPool* pool = state.range(1) ? &benchPool() : nullptr;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Vertex> vertices = baseVertices;
+        std::vector<uint32_t> indices = baseIndices;
+        state.ResumeTiming();
+
+        MeshProcessing::generateNormals(vertices, indices, MeshProcessing::DEFAULT_CREASE_ANGLE, pool);
+        benchmark::DoNotOptimize(vertices.data());
+    }
+
+    state.counters["triangles"] = static_cast<double>(baseIndices.size() / 3);
+    state.counters["tris/s"] = benchmark::Counter(static_cast<double>(baseIndices.size() / 3),
+                                                  benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_GenerateNormals)
+    ->ArgNames({ "grid", "parallel" })
+    ->Args({ 256, 0 })->Args({ 256, 1 })
+    ->Args({ 1024, 0 })->Args({ 1024, 1 })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_GenerateTangents(benchmark::State& state) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildTerrain(static_cast<int>(state.range(0)), vertices, indices);
+    MeshProcessing::generateNormals(vertices, indices, MeshProcessing::DEFAULT_CREASE_ANGLE, &benchPool());
+    ThreadPool* pool = state.range(1) ? &benchPool() : nullptr;
+
+    for (auto _ : state) {
+        MeshProcessing::generateTangents(vertices, indices, pool);
+        benchmark::DoNotOptimize(vertices.data());
+    }
+
+    state.counters["triangles"] = static_cast<double>(indices.size() / 3);
+    state.counters["tris/s"] = benchmark::Counter(static_cast<double>(indices.size() / 3),
+                                                  benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_GenerateTangents)
+    ->ArgNames({ "grid", "parallel" })
+    ->Args({ 256, 0 })->Args({ 256, 1 })
+    ->Args({ 1024, 0 })->Args({ 1024, 1 })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <graphics/mesh_simplifier.h>
+#include <core/thread_pool.h>
+#include <cmath>
+
+namespace {
+    // UV sphere with a texture seam along one meridian
+    void buildSphere(int segments, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        vertices.clear();
+        indices.clear();
+        int rings = segments / 2;
+        const float pi = 3.14159265f;
+
+        for (int r = 0; r <= rings; ++r) {
+            float theta = pi * r / rings;
+            for (int s = 0; s <= segments; ++s) {
+                float phi = 2.0f * pi * s / segments;
+                Vertex vertex{};
+                vertex.normal = glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                vertex.position = vertex.normal;
+                vertex.texCoord = glm::vec2(float(s) / segments, float(r) / rings);
+                vertices.push_back(vertex);
+            }
+        }
+
+        for (int r = 0; r < rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                uint32_t a = r * (segments + 1) + s;
+                uint32_t b = a + 1;
+                uint32_t c = a + segments + 1;
+                uint32_t d = c + 1;
+                indices.insert(indices.end(), { a, b, c, b, d, c });
+            }
+        }
+    }
+
+    ThreadPool& benchPool() {
+        static ThreadPool pool;
+        return pool;
+    }
+}
+
+// Args: sphere segments, target ratio in percent
+static void BM_SimplifySphere(benchmark::State& state) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildSphere(static_cast<int>(state.range(0)), vertices, indices);
+    size_t target = indices.size() * state.range(1) / 100;
+
+    MeshSimplifier::SimplifiedMesh result;
+    for (auto _ : state) {
+        result = MeshSimplifier::simplify(vertices, indices, target);
+        benchmark::DoNotOptimize(result.indices.data());
+    }
+
+    state.counters["source_tris"] = static_cast<double>(indices.size() / 3);
+    state.counters["result_tris"] = static_cast<double>(result.indices.size() / 3);
+    // Error relative to the unit sphere radius
+    state.counters["error"] = result.error;
+}
+BENCHMARK(BM_SimplifySphere)
+    ->ArgNames({ "segments", "percent" })
+    ->Args({ 256, 50 })->Args({ 256, 10 })->Args({ 256, 2 })
+    ->Args({ 1024, 10 })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_BuildLodChain(benchmark::State& state) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildSphere(static_cast<int>(state.range(0)), vertices, indices);
+    ThreadPool* pool = state.range(1) ? &benchPool() : nullptr;
+    const std::vector<float> ratios = { 0.5f, 0.25f, 0.1f, 0.02f };
+
+    std::vector<MeshSimplifier::SimplifiedMesh> levels;
+    for (auto _ : state) {
+        levels = MeshSimplifier::buildLodChain(vertices, indices, ratios, pool);
+        benchmark::DoNotOptimize(levels.data());
+    }
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        state.counters["lod" + std::to_string(i + 1) + "_error"] = levels[i].error;
+    }
+}
+BENCHMARK(BM_BuildLodChain)
+    ->ArgNames({ "segments", "parallel" })
+    ->Args({ 512, 0 })->Args({ 512, 1 })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
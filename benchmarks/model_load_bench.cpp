@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <graphics/models.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace {
+    // Grid of (size x size) quads written as an OBJ; without normals the
+    // loader has to generate them, which is the expensive path
+    std::string writeGridObj(int size, bool withNormals) {
+        const char* tmp = std::getenv("TMPDIR");
+        std::string path = std::string(tmp ? tmp : "/tmp") + "/bench_grid_" + std::to_string(size)
+            + (withNormals ? "_n" : "") + ".obj";
+        std::ofstream out(path);
+        for (int z = 0; z <= size; ++z) {
+            for (int x = 0; x <= size; ++x) {
+                out << "v " << x << " " << ((x * 7 + z * 13) % 5) * 0.1f << " " << z << "\n";
+                out << "vt " << float(x) / size << " " << float(z) / size << "\n";
+            }
+        }
+        if (withNormals) out << "vn 0 1 0\n";
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                int a = z * (size + 1) + x + 1;
+                int b = a + 1;
+                int c = a + size + 1;
+                int d = c + 1;
+                if (withNormals) {
+                    out << "f " << a << "/" << a << "/1 " << c << "/" << c << "/1 " << b << "/" << b << "/1\n";
+                    out << "f " << b << "/" << b << "/1 " << c << "/" << c << "/1 " << d << "/" << d << "/1\n";
+                } else {
+                    out << "f " << a << "/" << a << " " << c << "/" << c << " " << b << "/" << b << "\n";
+                    out << "f " << b << "/" << b << " " << c << "/" << c << " " << d << "/" << d << "\n";
+                }
+            }
+        }
+        return path;
+    }
+}
+
+// Parse + process (Model::loadMeshData, no GL). Args: grid size, OBJ has normals
+static void BM_ModelLoadMeshData(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    std::string path = writeGridObj(size, state.range(1) != 0);
+
+    for (auto _ : state) {
+        Model model;
+        if (!model.loadMeshData(path, "")) {
+            state.SkipWithError("loadMeshData failed");
+            break;
+        }
+        benchmark::DoNotOptimize(model.getVertices().data());
+    }
+
+    std::remove(path.c_str());
+    state.counters["triangles"] = 2.0 * size * size;
+    state.counters["tris/s"] = benchmark::Counter(2.0 * size * size, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_ModelLoadMeshData)
+    ->Args({ 64, 1 })->Args({ 64, 0 })
+    ->Args({ 128, 1 })->Args({ 128, 0 })
+    ->Unit(benchmark::kMillisecond);
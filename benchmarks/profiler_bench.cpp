@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include <core/profiler.h>
+
+// Cost of one marker: BM_ProfileScope minus BM_EmptyScope. The ring is sized so
+// a run wraps it many times, which is the steady state in the game.
+static void BM_EmptyScope(benchmark::State& state) {
+    int work = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(++work);
+    }
+}
+BENCHMARK(BM_EmptyScope);
+
+static void BM_ProfileScope(benchmark::State& state) {
+    Profiler::instance().setEnabled(true);
+    int work = 0;
+    for (auto _ : state) {
+        ProfileScope scope("Bench");
+        benchmark::DoNotOptimize(++work);
+    }
+}
+BENCHMARK(BM_ProfileScope);
+
+// Built in but switched off from the panel
+static void BM_ProfileScopeDisabled(benchmark::State& state) {
+    Profiler::instance().setEnabled(false);
+    int work = 0;
+    for (auto _ : state) {
+        ProfileScope scope("Bench");
+        benchmark::DoNotOptimize(++work);
+    }
+    Profiler::instance().setEnabled(true);
+}
+BENCHMARK(BM_ProfileScopeDisabled);
+
+static void BM_ProfilerNow(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Profiler::now());
+    }
+}
+BENCHMARK(BM_ProfilerNow);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <core/frame_snapshot.h>
+#include <editor/editor.h>
+#include <graphics/snapshot_renderer.h>
+#include <memory>
+#include <random>
+
+namespace {
+    // Random level over a 2km square: mostly walls, with houses, towers and bridges
+    void buildLevel(Editor::WorldEditor& editor, size_t objectCount) {
+        std::mt19937 rng(2024);
+        std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+        const Editor::ObjectType types[] = {
+            Editor::ObjectType::WALL, Editor::ObjectType::WALL, Editor::ObjectType::RECTANGLE,
+            Editor::ObjectType::HOUSE, Editor::ObjectType::TOWER, Editor::ObjectType::BRIDGE
+        };
+
+        for (size_t i = 0; i < objectCount; ++i) {
+            editor.addObject(types[rng() % 6], glm::vec3(coordinate(rng), 0.0f, coordinate(rng)), glm::vec3(2.0f));
+        }
+    }
+
+    // Draw calls without batching: one per object, two for objects with a colored body
+    size_t perObjectDrawCalls(const Editor::WorldEditor& editor) {
+        size_t drawCalls = 0;
+        for (const auto& obj : editor.getObjects()) {
+            drawCalls += obj->getMesh()->getBodyIndexCount() > 0 ? 2 : 1;
+        }
+        return drawCalls;
+    }
+}
+
+// Batching a whole level from one snapshot, as the renderer does on its first frame
+static void BM_BuildStaticBatches(benchmark::State& state) {
+    Editor::WorldEditor editor;
+    buildLevel(editor, static_cast<size_t>(state.range(0)));
+    FrameSnapshot snapshot;
+    editor.captureSnapshot(snapshot);
+
+    std::unique_ptr<SnapshotRenderer> renderer;
+    for (auto _ : state) {
+        state.PauseTiming();
+        renderer.reset(new SnapshotRenderer());
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(renderer->updateStaticBatches(snapshot));
+    }
+
+    Editor::StaticBatcher::Stats stats = renderer->getStaticBatcher().getStats();
+    state.counters["draw_calls_before"] = static_cast<double>(perObjectDrawCalls(editor));
+    state.counters["draw_calls_after"] = static_cast<double>(stats.batches);
+    state.counters["triangles"] = static_cast<double>(stats.triangles);
+}
+BENCHMARK(BM_BuildStaticBatches)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+// The incremental path: one object moved per frame; the renderer finds the
+// change in the frame's snapshot and rebuilds its batch. The capture, which
+// every frame pays on any path, is not timed.
+static void BM_MoveOneObject(benchmark::State& state) {
+    Editor::WorldEditor editor;
+    buildLevel(editor, static_cast<size_t>(state.range(0)));
+    SnapshotRenderer renderer;
+    FrameSnapshot snapshot;
+    editor.captureSnapshot(snapshot);
+    renderer.updateStaticBatches(snapshot);
+    std::mt19937 rng(7);
+
+    size_t rebuilt = 0;
+    for (auto _ : state) {
+        editor.selectObject(rng() % editor.getObjects().size());
+        editor.moveSelectedObject(glm::vec3(0.5f, 0.0f, 0.0f));
+        state.PauseTiming();
+        editor.captureSnapshot(snapshot);
+        state.ResumeTiming();
+        rebuilt += renderer.updateStaticBatches(snapshot);
+    }
+    state.counters["batches_rebuilt_per_move"] = benchmark::Counter(
+        static_cast<double>(rebuilt), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_MoveOneObject)->Arg(50000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <core/transform_batch.h>
+#include <core/transform_hierarchy.h>
+#include <core/thread_pool.h>
+#include <random>
+
+namespace {
+    TransformSoA buildTransforms(size_t count) {
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+        std::uniform_real_distribution<float> height(1.0f, 4.0f);
+
+        TransformSoA transforms;
+        transforms.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            transforms.set(i, glm::vec3(position(rng), 0.0f, position(rng)),
+                           glm::angleAxis(angle(rng), glm::vec3(0.0f, 1.0f, 0.0f)),
+                           glm::vec3(1.0f, 2.0f, 0.1f));
+            transforms.setBounds(i, AABB(glm::vec3(-0.5f, 0.0f, -0.5f), glm::vec3(0.5f, height(rng), 0.5f)));
+        }
+        return transforms;
+    }
+
+    ThreadPool& benchPool() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void runKernel(benchmark::State& state, void (*kernel)(const TransformBatchData&, size_t, size_t)) {
+        TransformSoA transforms = buildTransforms(static_cast<size_t>(state.range(0)));
+        std::vector<glm::mat4> matrices(transforms.size());
+        std::vector<AABB> bounds(transforms.size());
+        TransformBatchData data{ &transforms, nullptr, nullptr, matrices.data(), bounds.data() };
+
+        for (auto _ : state) {
+            kernel(data, 0, transforms.size());
+            benchmark::DoNotOptimize(matrices.data());
+            benchmark::DoNotOptimize(bounds.data());
+        }
+        state.SetItemsProcessed(state.iterations() * transforms.size());
+    }
+}
+
+static void BM_WorldMatricesScalarGlm(benchmark::State& state) {
+    runKernel(state, TransformBatch::computeRangeScalar);
+}
+BENCHMARK(BM_WorldMatricesScalarGlm)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_WorldMatricesSimd(benchmark::State& state) {
+    runKernel(state, TransformBatch::computeRange);
+    state.SetLabel(TransformBatch::simdPath());
+}
+BENCHMARK(BM_WorldMatricesSimd)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// The hierarchy path: every root moved, one child each, levels split across the pool
+static void BM_WorldMatricesSimdParallel(benchmark::State& state) {
+    const size_t rootCount = static_cast<size_t>(state.range(0)) / 2;
+    TransformSoA transforms = buildTransforms(rootCount * 2);
+    TransformHierarchy hierarchy;
+    hierarchy.setThreadPool(&benchPool());
+    std::vector<TransformId> roots;
+    for (size_t i = 0; i < transforms.size(); ++i) {
+        TransformId node = hierarchy.createNode(i < rootCount ? INVALID_TRANSFORM : roots[i - rootCount]);
+        hierarchy.setLocalPosition(node, transforms.getPosition(i));
+        hierarchy.setLocalRotation(node, transforms.getRotation(i));
+        hierarchy.setLocalScale(node, transforms.getScale(i));
+        hierarchy.setLocalBounds(node, AABB(glm::vec3(-0.5f), glm::vec3(0.5f)));
+        if (i < rootCount) roots.push_back(node);
+    }
+    hierarchy.updateWorldMatrices();
+
+    float offset = 0.0f;
+    for (auto _ : state) {
+        offset += 0.01f;
+        for (size_t i = 0; i < rootCount; ++i) {
+            hierarchy.setLocalPosition(roots[i], transforms.getPosition(i) + glm::vec3(offset));
+        }
+        benchmark::DoNotOptimize(hierarchy.updateWorldMatrices());
+    }
+    state.SetItemsProcessed(state.iterations() * transforms.size());
+    state.SetLabel(TransformBatch::simdPath());
+}
+BENCHMARK(BM_WorldMatricesSimdParallel)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <core/transform_hierarchy.h>
+#include <algorithm>
+#include <random>
+
+namespace {
+    // Shallow, wide forest like an editor scene: roots with a few levels of children
+    std::vector<TransformId> buildForest(TransformHierarchy& hierarchy, size_t nodeCount) {
+        std::vector<TransformId> nodes;
+        nodes.reserve(nodeCount);
+        std::mt19937 rng(42);
+
+        while (nodes.size() < nodeCount) {
+            TransformId parent = INVALID_TRANSFORM;
+            // Roughly a quarter of nodes are roots, the rest hang off a recent node
+            if (!nodes.empty() && rng() % 4 != 0) {
+                size_t window = std::min<size_t>(nodes.size(), 64);
+                parent = nodes[nodes.size() - 1 - rng() % window];
+            }
+            TransformId id = hierarchy.createNode(parent);
+            hierarchy.setLocalPosition(id, glm::vec3(float(rng() % 100), 0.0f, float(rng() % 100)));
+            nodes.push_back(id);
+        }
+        hierarchy.updateWorldMatrices();
+        return nodes;
+    }
+}
+
+// Args: node count, dirty nodes per frame in permille
+static void BM_UpdateDirtyNodes(benchmark::State& state) {
+    TransformHierarchy hierarchy;
+    std::vector<TransformId> nodes = buildForest(hierarchy, static_cast<size_t>(state.range(0)));
+    size_t dirtyPerFrame = nodes.size() * state.range(1) / 1000;
+    std::mt19937 rng(7);
+
+    size_t recomputed = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < dirtyPerFrame; ++i) {
+            TransformId id = nodes[rng() % nodes.size()];
+            hierarchy.setLocalPosition(id, hierarchy.getLocalPosition(id) + glm::vec3(0.01f));
+        }
+        recomputed += hierarchy.updateWorldMatrices();
+    }
+
+    state.counters["recomputed_per_frame"] = benchmark::Counter(
+        static_cast<double>(recomputed), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+BENCHMARK(BM_UpdateDirtyNodes)
+    ->ArgNames({ "nodes", "permille" })
+    ->Args({ 100000, 10 })->Args({ 100000, 100 })->Args({ 100000, 1000 })
+    ->Unit(benchmark::kMicrosecond);
+
+// Reference: every world matrix rebuilt each frame by walking the parent chain
+static void BM_UpdateAllNaive(benchmark::State& state) {
+    TransformHierarchy hierarchy;
+    std::vector<TransformId> nodes = buildForest(hierarchy, static_cast<size_t>(state.range(0)));
+    std::vector<glm::mat4> worlds(nodes.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            glm::mat4 world(1.0f);
+            for (TransformId id = nodes[i]; id != INVALID_TRANSFORM; id = hierarchy.getParent(id)) {
+                glm::mat4 local(1.0f);
+                local[3] = glm::vec4(hierarchy.getLocalPosition(id), 1.0f);
+                world = local * world;
+            }
+            worlds[i] = world;
+        }
+        benchmark::DoNotOptimize(worlds.data());
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+BENCHMARK(BM_UpdateAllNaive)->Arg(100000)->Unit(benchmark::kMicrosecond);
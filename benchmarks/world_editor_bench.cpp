@@ -0,0 +1,544 @@
+#include <benchmark/benchmark.h>
+#include <core/frame_snapshot.h>
+#include <editor/edit_log.h>
+#include <editor/editor.h>
+#include <editor/scene_file.h>
+#include <editor/world_file.h>
+#include <editor/world_streamer.h>
+#include <graphics/frustum.h>
+#include <graphics/indirect_renderer.h>
+#include <graphics/snapshot_renderer.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include "heap_counter.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    const Editor::ObjectType OBJECT_TYPES[] = {
+        Editor::ObjectType::WALL, Editor::ObjectType::HOUSE, Editor::ObjectType::TOWER, Editor::ObjectType::BRIDGE
+    };
+
+    void populate(Editor::WorldEditor& editor, size_t count, std::mt19937& rng) {
+        std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+        for (size_t i = 0; i < count; ++i) {
+            editor.addObject(OBJECT_TYPES[i % 4], glm::vec3(coordinate(rng), 0.0f, coordinate(rng)), glm::vec3(2.0f));
+        }
+    }
+
+    Frustum benchFrustum() {
+        glm::mat4 projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.5f, 0.0f), glm::vec3(0.0f, 1.5f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return Frustum::fromMatrix(projection * view);
+    }
+}
+
+// Arg: objects added per iteration, into an empty editor
+static void BM_WorldEditorAdd(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(1);
+    for (auto _ : state) {
+        Editor::WorldEditor editor;
+        populate(editor, count, rng);
+        benchmark::DoNotOptimize(editor.getEntities().getNodes().data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_WorldEditorAdd)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// Arg: scene size; removes 100 objects from random positions, then restores the count
+static void BM_WorldEditorRemove(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(2);
+    Editor::WorldEditor editor;
+    populate(editor, count, rng);
+
+    for (auto _ : state) {
+        for (int i = 0; i < 100; ++i) {
+            editor.removeObject(rng() % editor.getObjects().size());
+        }
+        state.PauseTiming();
+        populate(editor, 100, rng);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_WorldEditorRemove)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Arg: scene size; deletes every object, each time from a random index
+static void BM_WorldEditorRemoveAll(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(2);
+    Editor::WorldEditor editor;
+    for (auto _ : state) {
+        state.PauseTiming();
+        editor = Editor::WorldEditor();
+        populate(editor, count, rng);
+        state.ResumeTiming();
+        while (!editor.getObjects().empty()) {
+            editor.removeObject(rng() % editor.getObjects().size());
+        }
+        benchmark::DoNotOptimize(editor.getEntities().getNodes().data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_WorldEditorRemoveAll)->Arg(100000)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+// Arg: scene size; moves 1% of the objects and runs the per-frame update
+static void BM_WorldEditorUpdate(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+    Editor::WorldEditor editor;
+    populate(editor, count, rng);
+    editor.update();
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < count / 100; ++i) {
+            editor.setObjectPosition(rng() % count, glm::vec3(coordinate(rng), 0.0f, coordinate(rng)));
+        }
+        editor.update();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_WorldEditorUpdate)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Scene submission without GL: the snapshot of the world matrices, then the
+// renderer's mesh ranges, culling and the indirect command list it would upload
+static void BM_SceneSubmission(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(4);
+    Editor::WorldEditor editor;
+    populate(editor, count, rng);
+    Frustum frustum = benchFrustum();
+    FrameSnapshot snapshot;
+    SnapshotRenderer renderer;
+
+    for (auto _ : state) {
+        editor.captureSnapshot(snapshot);
+        const IndirectDrawList& drawList = renderer.buildDrawList(snapshot, frustum);
+        benchmark::DoNotOptimize(drawList.commands.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SceneSubmission)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Arg: scene size; cursor picks from eye height in random directions against
+// an unchanged scene, refined against triangles
+static void BM_WorldEditorPick(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    Editor::WorldEditor editor;
+    populate(editor, count, rng);
+    Editor::PickHit hit;
+    editor.pick(Ray(glm::vec3(0.0f), glm::vec3(1.0f)), 1.0f, hit);
+
+    std::vector<Ray> rays;
+    for (int i = 0; i < 256; ++i) {
+        rays.push_back(Ray(glm::vec3(0.0f, 1.5f, 0.0f), glm::vec3(direction(rng), direction(rng) * 0.2f, direction(rng)) * 300.0f));
+    }
+    size_t next = 0;
+    int64_t hits = 0;
+    for (auto _ : state) {
+        hits += editor.pick(rays[next++ % rays.size()], 1.0f, hit) ? 1 : 0;
+    }
+    state.counters["hit_rate"] = static_cast<double>(hits) / state.iterations();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldEditorPick)->Arg(10000)->Arg(100000);
+
+// Arg: scene size; first pick after an edit, which rebuilds the BVH
+static void BM_WorldEditorPickAfterEdit(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(6);
+    Editor::WorldEditor editor;
+    populate(editor, count, rng);
+    Ray ray(glm::vec3(0.0f, 1.5f, 0.0f), glm::vec3(0.0f, 0.0f, -300.0f));
+    Editor::PickHit hit;
+
+    for (auto _ : state) {
+        editor.setObjectPosition(rng() % count, glm::vec3(0.0f, 0.0f, -5.0f));
+        benchmark::DoNotOptimize(editor.pick(ray, 1.0f, hit));
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_WorldEditorPickAfterEdit)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Arg: journal memory limit in KiB; records value edits on rotating objects
+// into a ring that has long since wrapped
+static void BM_EditJournalRecord(benchmark::State& state) {
+    Editor::EditJournal journal(static_cast<size_t>(state.range(0)) * 1024);
+    Editor::Edit edit;
+    edit.kind = Editor::EditKind::MOVE;
+    uint32_t index = 0;
+    for (auto _ : state) {
+        edit.objectIndex = index++ % 1000;
+        edit.after.x += 1.0f;
+        journal.record(edit);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["Steps"] = static_cast<double>(journal.getUndoCount());
+    state.counters["Bytes"] = static_cast<double>(journal.getMemoryUsed());
+}
+BENCHMARK(BM_EditJournalRecord)->Arg(64)->Arg(1024);
+
+// Arg: scene size; 1000 edits spread over moves, drags, resizes and colors,
+// then all undone and redone. Items are undo or redo steps.
+static void BM_WorldEditorUndoRedo(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(5);
+    Editor::WorldEditor editor;
+    populate(editor, count, rng);
+    editor.getJournal().clear();
+
+    for (int i = 0; i < 1000; ++i) {
+        editor.selectObject(rng() % count);
+        switch (i % 4) {
+            case 0:
+                editor.moveSelectedObject(glm::vec3(1.0f, 0.0f, 0.0f));
+                break;
+            case 1:
+                // A 60-frame drag, kept as one step
+                for (int frame = 0; frame < 60; ++frame) {
+                    editor.moveSelectedObject(glm::vec3(0.1f, 0.0f, 0.0f));
+                }
+                break;
+            case 2:
+                editor.resizeSelectedObject(glm::vec3(3.0f));
+                break;
+            case 3:
+                editor.setSelectedObjectColor(glm::vec3(1.0f, 0.0f, 0.0f));
+                break;
+        }
+        editor.sealUndoStep();
+    }
+    size_t steps = editor.getJournal().getUndoCount();
+
+    for (auto _ : state) {
+        while (editor.undo()) {}
+        while (editor.redo()) {}
+    }
+    state.SetItemsProcessed(state.iterations() * steps * 2);
+    state.counters["Steps"] = static_cast<double>(steps);
+    state.counters["Bytes"] = static_cast<double>(editor.getJournal().getMemoryUsed());
+}
+BENCHMARK(BM_WorldEditorUndoRedo)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+namespace {
+    // Scene file of count objects, written once per size
+    std::string benchSceneFile(size_t count) {
+        std::string path = "/tmp/world_editor_bench_" + std::to_string(count) + ".scene";
+        static size_t written = 0;
+        if (written != count) {
+            std::mt19937 rng(6);
+            Editor::WorldEditor editor;
+            populate(editor, count, rng);
+            editor.saveScene(path);
+            written = count;
+        }
+        return path;
+    }
+}
+
+// Arg: objects in the scene; map and validate the file
+static void BM_SceneFileOpen(benchmark::State& state) {
+    std::string path = benchSceneFile(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        Editor::SceneFile file;
+        file.open(path);
+        benchmark::DoNotOptimize(file.getSections().data());
+    }
+}
+BENCHMARK(BM_SceneFileOpen)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+// Arg: objects in the scene; open the file and build the editor's objects from it
+static void BM_WorldEditorLoadScene(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::string path = benchSceneFile(count);
+    for (auto _ : state) {
+        Editor::WorldEditor editor;
+        editor.loadScene(path);
+        benchmark::DoNotOptimize(editor.getEntities().getNodes().data());
+        state.PauseTiming();
+        editor = Editor::WorldEditor();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_WorldEditorLoadScene)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// Arg: objects in the scene; serialize and write the file
+static void BM_WorldEditorSaveScene(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(7);
+    Editor::WorldEditor editor;
+    populate(editor, count, rng);
+    std::string path = "/tmp/world_editor_bench_save.scene";
+    for (auto _ : state) {
+        editor.saveScene(path);
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_WorldEditorSaveScene)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// Arg: 0 without, 1 with an edit log attached; one move on a 10000-object
+// scene. The difference is what logging costs the editor's thread.
+static void BM_WorldEditorMoveLogged(benchmark::State& state) {
+    std::string path = "/tmp/world_editor_bench_log.scene";
+    std::remove((path + ".wal").c_str());
+    std::remove((path + ".checkpoint").c_str());
+    std::mt19937 rng(8);
+    Editor::WorldEditor editor;
+    Editor::EditLog log;
+    if (state.range(0)) log.open(path, editor);
+    populate(editor, 10000, rng);
+    if (log.isOpen()) log.flush();
+
+    float x = 0.0f;
+    for (auto _ : state) {
+        editor.setObjectPosition(rng() % 10000, glm::vec3(x, 0.0f, 0.0f));
+        x += 0.01f;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (log.isOpen()) {
+        log.flush();
+        Editor::EditLog::Stats stats = log.getStats();
+        state.counters["Batches"] = static_cast<double>(stats.batchesWritten);
+        state.counters["Checkpoints"] = static_cast<double>(stats.checkpoints);
+        log.close();
+    }
+    std::remove((path + ".wal").c_str());
+    std::remove((path + ".checkpoint").c_str());
+}
+BENCHMARK(BM_WorldEditorMoveLogged)->Arg(0)->Arg(1);
+
+namespace {
+    std::vector<char> readBenchFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    void writeBenchFile(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream file(path, std::ios::binary);
+        file.write(bytes.data(), bytes.size());
+    }
+}
+
+// Arg: edits in the log after a crash, over a checkpoint of 100000 objects;
+// time for open() to load the checkpoint and replay the log
+static void BM_EditLogRecovery(benchmark::State& state) {
+    std::string path = "/tmp/world_editor_bench_recovery.scene";
+    std::remove((path + ".wal").c_str());
+    std::remove((path + ".checkpoint").c_str());
+    std::vector<char> wal;
+    std::vector<char> checkpoint;
+    {
+        std::mt19937 rng(9);
+        Editor::WorldEditor editor;
+        Editor::EditLog::Options options;
+        options.checkpointBytes = ~size_t(0);
+        Editor::EditLog log;
+        log.open(path, editor, options);
+        populate(editor, 100000, rng);
+        log.requestCheckpoint();
+        log.flush();
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            editor.setObjectPosition(rng() % 100000, glm::vec3(float(i), 0.0f, 0.0f));
+        }
+        log.flush();
+        wal = readBenchFile(path + ".wal");
+        checkpoint = readBenchFile(path + ".checkpoint");
+        log.close();
+    }
+
+    for (auto _ : state) {
+        writeBenchFile(path + ".wal", wal);
+        writeBenchFile(path + ".checkpoint", checkpoint);
+        Editor::WorldEditor editor;
+        Editor::EditLog log;
+        log.open(path, editor);
+        state.SetIterationTime(log.getStats().recoveryMs / 1000.0);
+        log.close();
+    }
+    state.counters["LogBytes"] = static_cast<double>(wal.size());
+    std::remove((path + ".wal").c_str());
+    std::remove((path + ".checkpoint").c_str());
+}
+BENCHMARK(BM_EditLogRecovery)->Arg(10000)->Arg(100000)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+// Arg: objects per chunk of a 16x16-chunk world; one frame of walking back and
+// forth across it at 2 units a frame, looking ahead. Time is the editor
+// thread's share; the counters are what the streamer measured.
+static void BM_WorldStreamerWalk(benchmark::State& state) {
+    std::string path = "/tmp/world_editor_bench_" + std::to_string(state.range(0)) + ".world";
+    Editor::TestWorldOptions worldOptions;
+    worldOptions.objectsPerChunk = static_cast<size_t>(state.range(0));
+    Editor::generateTestWorld(path, worldOptions);
+
+    Editor::WorldEditor editor;
+    Editor::WorldStreamer streamer;
+    streamer.open(path, editor);
+    float x = -400.0f;
+    float direction = 1.0f;
+    for (auto _ : state) {
+        streamer.update(glm::vec3(x, 0.0f, 0.0f), glm::vec3(direction, 0.0f, 0.0f));
+        x += 2.0f * direction;
+        if (x > 400.0f || x < -400.0f) direction = -direction;
+    }
+    const Editor::WorldStreamer::Stats& stats = streamer.getStats();
+    state.counters["Loaded"] = static_cast<double>(stats.chunksLoaded);
+    state.counters["AvgLoadMs"] = stats.averageLoadMs;
+    state.counters["MaxLoadMs"] = stats.maxLoadMs;
+    state.counters["ResidentMB"] = stats.residentBytes / 1048576.0;
+    state.counters["PeakMB"] = stats.peakResidentBytes / 1048576.0;
+    streamer.close();
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_WorldStreamerWalk)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+namespace {
+    // The layout the editor kept before the entity store: one heap object per
+    // entity behind virtual calls, and a hash lookup per object for its arena mesh
+    struct LegacyScene {
+        std::vector<std::unique_ptr<Editor::EditableObject>> objects;
+        TransformHierarchy transforms;
+        MeshArena arena;
+        std::unordered_map<const Editor::ProceduralMesh*, MeshRange> arenaRanges;
+        std::vector<IndirectDrawItem> drawItems;
+    };
+
+    void populateLegacy(LegacyScene& scene, size_t count, std::mt19937& rng) {
+        std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+        for (size_t i = 0; i < count; ++i) {
+            Editor::ObjectType type = OBJECT_TYPES[i % 4];
+            glm::vec3 position(coordinate(rng), 0.0f, coordinate(rng));
+            std::unique_ptr<Editor::EditableObject> obj;
+            if (type == Editor::ObjectType::WALL) {
+                obj.reset(new Editor::Wall(position, glm::vec3(2.0f)));
+            } else {
+                obj.reset(new Editor::PredefinedObject(type, position, glm::vec3(2.0f)));
+            }
+            TransformId node = scene.transforms.createNode();
+            scene.transforms.setLocalPosition(node, position);
+            obj->setTransformId(node);
+            scene.objects.push_back(std::move(obj));
+        }
+    }
+
+    void legacyUpdateAndDrawList(LegacyScene& scene, const Frustum& frustum, IndirectDrawList& out) {
+        for (auto& obj : scene.objects) {
+            obj->update();
+        }
+        scene.transforms.updateWorldMatrices();
+
+        scene.drawItems.clear();
+        scene.drawItems.reserve(scene.objects.size());
+        for (const auto& obj : scene.objects) {
+            glm::mat4 model = scene.transforms.getWorldMatrix(obj->getTransformId());
+            glm::vec3 size = obj->getSize();
+            model[0] *= size.x;
+            model[1] *= size.y;
+            model[2] *= size.z;
+
+            std::shared_ptr<const Editor::ProceduralMesh> mesh = obj->getMesh();
+            auto range = scene.arenaRanges.find(mesh.get());
+            if (range == scene.arenaRanges.end()) {
+                range = scene.arenaRanges.emplace(mesh.get(), mesh->appendTo(scene.arena)).first;
+            }
+
+            IndirectDrawItem item;
+            item.mesh = range->second;
+            item.material = static_cast<uint32_t>(obj->getType());
+            item.model = model;
+            item.color = glm::vec4(obj->getColor(), 1.0f);
+            scene.drawItems.push_back(item);
+        }
+        IndirectDraw::buildDrawList(scene.drawItems, frustum, out);
+    }
+}
+
+// Args: entities, then 0 for the old object-per-entity layout or 1 for the
+// entity store, each with its transform nodes. Creates them all, counting heap
+// allocations on the way; tearing down is not timed. (WorldEditor::addObject
+// also journals each add, which costs more than either layout.)
+static void BM_EditorLayoutCreate(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+    size_t allocations = 0;
+    for (auto _ : state) {
+        std::mt19937 rng(11);
+        size_t before = heapAllocationCount();
+        if (state.range(1) == 0) {
+            std::unique_ptr<LegacyScene> scene(new LegacyScene());
+            populateLegacy(*scene, count, rng);
+            benchmark::DoNotOptimize(scene->objects.data());
+            allocations = heapAllocationCount() - before;
+            state.PauseTiming();
+            scene.reset();
+        } else {
+            std::unique_ptr<Editor::EntityStore> store(new Editor::EntityStore());
+            std::unique_ptr<TransformHierarchy> transforms(new TransformHierarchy());
+            for (size_t i = 0; i < count; ++i) {
+                glm::vec3 position(coordinate(rng), 0.0f, coordinate(rng));
+                TransformId node = transforms->createNode();
+                transforms->setLocalPosition(node, position);
+                store->insert(i, OBJECT_TYPES[i % 4], position, glm::vec3(2.0f), node);
+            }
+            benchmark::DoNotOptimize(store->getNodes().data());
+            allocations = heapAllocationCount() - before;
+            state.PauseTiming();
+            store.reset();
+            transforms.reset();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["AllocsPerEntity"] = static_cast<double>(allocations) / count;
+}
+BENCHMARK(BM_EditorLayoutCreate)
+    ->Args({1000000, 0})->Args({1000000, 1})
+    ->Unit(benchmark::kMillisecond);
+
+// Args: entities, then 0 for the old object-per-entity layout or 1 for the
+// entity store. One frame of update and indirect draw-list preparation.
+static void BM_EditorLayoutUpdateAndDrawList(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(10);
+    Frustum frustum = benchFrustum();
+    IndirectDrawList list;
+
+    if (state.range(1) == 0) {
+        LegacyScene scene;
+        populateLegacy(scene, count, rng);
+        legacyUpdateAndDrawList(scene, frustum, list);
+        for (auto _ : state) {
+            legacyUpdateAndDrawList(scene, frustum, list);
+            benchmark::DoNotOptimize(list.commands.data());
+        }
+    } else {
+        Editor::WorldEditor editor;
+        populate(editor, count, rng);
+        editor.getJournal().clear();
+        FrameSnapshot snapshot;
+        SnapshotRenderer renderer;
+        editor.update();
+        editor.captureSnapshot(snapshot);
+        renderer.buildDrawList(snapshot, frustum);
+        for (auto _ : state) {
+            editor.update();
+            editor.captureSnapshot(snapshot);
+            benchmark::DoNotOptimize(renderer.buildDrawList(snapshot, frustum).commands.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_EditorLayoutUpdateAndDrawList)
+    ->Args({100000, 0})->Args({100000, 1})->Args({1000000, 0})->Args({1000000, 1})
+    ->Unit(benchmark::kMillisecond);
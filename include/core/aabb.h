@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cfloat>
+#include <glm/glm.hpp>
+
+// Axis-aligned bounding box. Default constructed boxes are empty and grow with expand().
+struct AABB {
+    glm::vec3 min;
+    glm::vec3 max;
+
+    AABB() : min(FLT_MAX), max(-FLT_MAX) {}
+    AABB(const glm::vec3& min, const glm::vec3& max) : min(min), max(max) {}
+
+    bool isEmpty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    glm::vec3 extents() const { return (max - min) * 0.5f; }
+
+    void expand(const glm::vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void expand(const AABB& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    bool contains(const glm::vec3& point) const {
+        return point.x >= min.x && point.x <= max.x &&
+               point.y >= min.y && point.y <= max.y &&
+               point.z >= min.z && point.z <= max.z;
+    }
+
+    // Bounds of this box after an affine transform (Arvo): center through the matrix,
+    // half extents through its absolute value
+    AABB transformed(const glm::mat4& m) const {
+        glm::vec3 c = center();
+        glm::vec3 e = extents();
+        glm::vec3 newCenter = glm::vec3(m[3]) + glm::vec3(m[0]) * c.x + glm::vec3(m[1]) * c.y + glm::vec3(m[2]) * c.z;
+        glm::vec3 newExtents = glm::abs(glm::vec3(m[0])) * e.x + glm::abs(glm::vec3(m[1])) * e.y + glm::abs(glm::vec3(m[2])) * e.z;
+        return AABB(newCenter - newExtents, newCenter + newExtents);
+    }
+
+    bool intersects(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+};
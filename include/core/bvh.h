@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "aabb.h"
+#include "ray.h"
+
+// Bounding volume hierarchy over item boxes, for ray queries. Built top down,
+// splitting every node at the median centroid along its widest axis, so depth
+// stays logarithmic whatever the layout. Nodes live in one flat array with the
+// two children of a node side by side.
+class BVH {
+public:
+    static const uint32_t NO_ITEM = 0xFFFFFFFFu;
+    static const uint32_t MAX_LEAF_ITEMS = 4;
+
+    // Item i is boxes[i]; empty boxes are left out
+    void build(const std::vector<AABB>& boxes);
+    // Takes new boxes for the same items without changing the tree's shape:
+    // linear, and enough for moves that do not scatter the items. Items left
+    // out of build stay out.
+    void refit(const std::vector<AABB>& boxes);
+    void clear();
+
+    size_t getItemCount() const { return items.size(); }
+    size_t getNodeCount() const { return nodes.size(); }
+
+    // Closest hit within maxT. Every item whose box the ray enters before the
+    // closest hit so far goes to intersect(item, t), which returns false for a
+    // miss or true with t set, so callers can refine the box test (against
+    // triangles, say) or accept it by returning the box entry distance it is
+    // given in t. Returns the item hit, or NO_ITEM.
+    template <typename Intersect>
+    uint32_t raycast(const Ray& ray, float maxT, Intersect intersect, float& hitT) const;
+
+private:
+    struct Node {
+        AABB bounds;
+        uint32_t first;     // Left child for inner nodes, first entry of items for leaves
+        uint32_t count;     // Items in a leaf; 0 for inner nodes
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> items;    // Item ids in leaf order
+    std::vector<AABB> itemBoxes;    // Their boxes, in the same order
+
+    struct BuildEntry {
+        AABB box;
+        glm::vec3 centroid;
+        uint32_t item;
+    };
+    void buildNode(uint32_t nodeIndex, std::vector<BuildEntry>& entries, uint32_t begin, uint32_t end);
+};
+
+template <typename Intersect>
+uint32_t BVH::raycast(const Ray& ray, float maxT, Intersect intersect, float& hitT) const {
+    uint32_t hitItem = NO_ITEM;
+    hitT = maxT;
+    float entry;
+    if (nodes.empty() || !intersectRayAABB(ray, nodes[0].bounds, hitT, entry)) return hitItem;
+
+    // Nodes still to visit with the distance the ray enters them; never more
+    // than the depth, which the median split keeps under 32
+    struct Pending {
+        uint32_t node;
+        float entry;
+    };
+    Pending stack[64];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = Pending{ 0, entry };
+
+    while (stackSize > 0) {
+        Pending pending = stack[--stackSize];
+        // A closer hit may have turned up since this was pushed
+        if (pending.entry > hitT) continue;
+
+        const Node& node = nodes[pending.node];
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                float t;
+                if (intersectRayAABB(ray, itemBoxes[i], hitT, t) && intersect(items[i], t) && t < hitT) {
+                    hitT = t;
+                    hitItem = items[i];
+                }
+            }
+            continue;
+        }
+
+        // Nearer child on top, so its hits can prune the other one
+        float leftEntry, rightEntry;
+        bool hitsLeft = intersectRayAABB(ray, nodes[node.first].bounds, hitT, leftEntry);
+        bool hitsRight = intersectRayAABB(ray, nodes[node.first + 1].bounds, hitT, rightEntry);
+        if (hitsLeft && hitsRight) {
+            bool leftFirst = leftEntry <= rightEntry;
+            stack[stackSize++] = leftFirst ? Pending{ node.first + 1, rightEntry } : Pending{ node.first, leftEntry };
+            stack[stackSize++] = leftFirst ? Pending{ node.first, leftEntry } : Pending{ node.first + 1, rightEntry };
+        } else if (hitsLeft) {
+            stack[stackSize++] = Pending{ node.first, leftEntry };
+        } else if (hitsRight) {
+            stack[stackSize++] = Pending{ node.first + 1, rightEntry };
+        }
+    }
+    return hitItem;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Accumulator for running the simulation at a fixed tick rate, independent of the
+// frame rate. Feed it real elapsed time; it says how many ticks are due and how far
+// the leftover time is into the next tick (for interpolating what is drawn).
+class FixedTimestep {
+public:
+    // maxTicksPerAdvance bounds catch-up work after a stall; the rest is dropped
+    explicit FixedTimestep(float tickRate, int maxTicksPerAdvance = 5);
+
+    void setTickRate(float tickRate);
+    float getTickRate() const { return static_cast<float>(1.0 / tickSeconds); }
+    float getTickSeconds() const { return static_cast<float>(tickSeconds); }
+
+    // Adds elapsed time and returns the number of ticks to run now
+    int advance(double elapsedSeconds);
+    // Leftover time as a fraction of a tick, in [0, 1)
+    float getAlpha() const { return static_cast<float>(accumulator / tickSeconds); }
+    double getSimulatedSeconds() const { return simulatedSeconds; }
+    void reset();
+
+private:
+    double tickSeconds;
+    int maxTicksPerAdvance;
+    double accumulator;
+    double simulatedSeconds;
+};
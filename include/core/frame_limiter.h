@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+// Paces a loop to a target rate. Sleeps with clock_nanosleep on an absolute
+// deadline, waking a little early, then spins the rest of the way; how early is
+// learned from how late the OS has been waking us. Deadlines advance by exactly
+// one period, so small overshoots do not accumulate into drift.
+class FrameLimiter {
+public:
+    // Monotonic time in nanoseconds, and a wait until a deadline returning how
+    // late the OS woke (see sleepUntil); tests inject fakes that move time by hand
+    using ClockFunction = std::function<int64_t()>;
+    using SleepFunction = std::function<int64_t(int64_t deadlineNs, int64_t spinWindowNs)>;
+
+    explicit FrameLimiter(double targetFps, ClockFunction clock = ClockFunction(),
+                          SleepFunction sleep = SleepFunction());
+
+    void setTargetFps(double targetFps);
+    double getTargetFps() const;
+
+    // Blocks until the next frame boundary, or leadNs before it, which keeps
+    // the schedule but leaves time to get a frame out by the boundary itself.
+    // Returns the time since the previous wait returned in seconds.
+    double wait(int64_t leadNs = 0);
+    // Starts the schedule over from now (after a pause or a long load)
+    void reset();
+
+    // Monotonic clock used for all deadlines
+    static int64_t nowNanoseconds();
+    // Hybrid wait until deadline: OS sleep up to spinWindow before it, then spin.
+    // Returns how late the OS sleep woke up relative to its own target.
+    static int64_t sleepUntil(int64_t deadlineNs, int64_t spinWindowNs);
+
+    int64_t getSpinWindowNanoseconds() const { return spinWindowNs; }
+
+private:
+    ClockFunction clock;
+    SleepFunction sleep;
+    int64_t periodNs;
+    int64_t nextDeadlineNs;
+    int64_t lastFrameNs;
+    int64_t spinWindowNs;
+    double averageWakeLatencyNs;
+};
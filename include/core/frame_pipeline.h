@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include "fixed_timestep.h"
+#include "frame_snapshot.h"
+#include "triple_buffer.h"
+
+// Hands simulated frames to the render thread. The simulation steps at a fixed
+// tick rate, either on its own thread (start) or inline (advance); either way each
+// tick fills a FrameSnapshot that the render side picks up through a lock-free
+// triple buffer, so neither side waits on the other.
+class FramePipeline {
+public:
+    // Advances the game by deltaTime seconds and describes the result in snapshot
+    using StepFunction = std::function<void(float deltaTime, FrameSnapshot& snapshot)>;
+
+    struct Stats {
+        uint64_t simulatedFrames = 0;
+        uint64_t presentedFrames = 0;
+        uint64_t droppedFrames = 0;     // Simulated but replaced before being drawn
+        double averageLatencyMs = 0.0;  // Simulation end to present
+        double maxLatencyMs = 0.0;
+    };
+
+    // tickRate 0 steps back to back with the measured frame time instead
+    FramePipeline(StepFunction step, float tickRate);
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    float getTickRate() const { return tickRate; }
+    // Only while stopped
+    void setTickRate(float tickRate);
+
+    // Runs the ticks on a simulation thread, paced by a FrameLimiter
+    void start();
+    void stop();
+    bool isThreaded() const { return simulationThread.joinable(); }
+
+    // Single-threaded mode: runs the ticks due after elapsedSeconds of real time
+    void advance(double elapsedSeconds);
+    // One step of the given length on the calling thread
+    void stepOnce(float deltaTime);
+
+    // Render side: how far presentation is between the snapshot's previous and
+    // current state, in [0, 1]
+    float getInterpolationAlpha(const FrameSnapshot& snapshot) const;
+
+    // Render side: the newest snapshot, or nullptr before the first one. It stays
+    // valid until the next call.
+    const FrameSnapshot* acquireLatest(bool* isNew = nullptr);
+    // Render side: call once the acquired snapshot is on screen
+    void markPresented(const FrameSnapshot& snapshot);
+
+    // Render side
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    StepFunction step;
+    float tickRate;
+    FixedTimestep timestep;     // Used by whichever side runs the ticks
+    TripleBuffer<FrameSnapshot> frames;
+    std::thread simulationThread;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> simulatedFrames;
+    std::atomic<uint64_t> droppedFrames;
+    bool hasFrame;
+
+    // Owned by the render side
+    uint64_t presentedFrames;
+    uint64_t lastPresentedIndex;
+    double latencySumMs;
+    double maxLatencyMs;
+    uint64_t statsSimulatedBase;
+    uint64_t statsDroppedBase;
+
+    void simulate(float deltaTime);
+    void simulationLoop();
+};
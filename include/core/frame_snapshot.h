@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../editor/procedural_mesh.h"
+
+// One placed object as the render thread sees it
+struct SnapshotObject {
+    uint32_t key;           // Names the object from frame to frame (its transform node)
+    uint32_t meshIndex;     // Into FrameSnapshot::meshes
+    uint32_t material;      // Object type
+    glm::mat4 model;        // World matrix with the object size folded in
+    glm::vec4 color;
+};
+
+// Everything the render thread needs to draw one simulated frame. Written by the
+// simulation thread, then only read, so rendering never touches live game state.
+// Slots are reused frame to frame, so the vectors keep their capacity.
+struct FrameSnapshot {
+    uint64_t frameIndex = 0;
+    std::chrono::steady_clock::time_point simulatedAt;
+    float deltaTime = 0.0f;
+
+    // Camera; the position is drawn interpolated from the previous tick
+    glm::vec3 previousCameraPosition = glm::vec3(0.0f);
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
+
+    // Mouse look as of this tick, so the render side can late-latch newer cursor
+    // moves on top. lookCursorTimeNs is 0 until a live cursor move was applied.
+    float yaw = -90.0f;
+    float pitch = 0.0f;
+    glm::dvec2 lookCursor = glm::dvec2(0.0);
+    int64_t lookCursorTimeNs = 0;
+
+    // Editor objects; meshes keeps every referenced mesh alive until the frame is drawn
+    std::vector<std::shared_ptr<const Editor::ProceduralMesh>> meshes;
+    std::vector<SnapshotObject> objects;
+
+    // Editor UI state
+    bool editorMode = false;
+    bool placingObject = false;
+    glm::vec3 placementStart = glm::vec3(0.0f);
+    glm::vec3 placementEnd = glm::vec3(0.0f);
+    bool showPreview = false;
+    Editor::ObjectType previewType;
+    glm::vec3 previewPosition = glm::vec3(0.0f);
+    glm::vec3 previewSize = glm::vec3(1.0f);
+    std::vector<Editor::ObjectType> inventoryItems;
+    size_t selectedInventoryIndex = 0;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Log-linear histogram of frame times in microseconds, HDR-histogram style:
+// exact below 128 us, then every power of two split into 64 buckets, so any
+// value is off by at most 1/64 (1.6%). Covers up to 2^26 us (67 s); longer
+// frames land in the top bucket. Fixed size, so recording never allocates.
+class FrameTimeHistogram {
+public:
+    static const uint32_t LINEAR_BUCKETS = 128;
+    static const uint32_t SUB_BUCKETS = 64;
+    static const uint32_t MAX_EXPONENT = 26;
+    static const uint32_t BUCKET_COUNT = LINEAR_BUCKETS + (MAX_EXPONENT - 7) * SUB_BUCKETS;
+
+    FrameTimeHistogram();
+
+    void add(uint32_t microseconds) { ++counts[bucketFor(microseconds)]; ++total; }
+    void remove(uint32_t microseconds) { --counts[bucketFor(microseconds)]; --total; }
+    void clear();
+
+    uint64_t getCount() const { return total; }
+    // Value (to bucket precision) that percentile% of samples are at or below;
+    // 0 when empty
+    double percentileMicroseconds(double percentile) const;
+    // Mean of the slowest fraction of samples, e.g. 0.01 for the slowest 1%
+    double slowestMeanMicroseconds(double fraction) const;
+
+    static uint32_t bucketFor(uint32_t microseconds);
+    // Midpoint of the values a bucket holds
+    static double bucketValue(uint32_t bucket);
+
+private:
+    std::array<uint32_t, BUCKET_COUNT> counts;
+    uint64_t total;
+};
+
+// Extreme (min or max, depending on Better) of a sliding window in O(1)
+// amortised per sample. Holds only samples that can still become the extreme,
+// in decreasing order of Better, in a ring sized to the window.
+template <typename Better>
+class MonotonicWindow {
+public:
+    explicit MonotonicWindow(size_t capacity) : entries(capacity), head(0), size(0) {}
+
+    // Drops samples older than firstIndex; call before push
+    void expire(uint64_t firstIndex) {
+        while (size > 0 && entries[head].index < firstIndex) {
+            head = (head + 1) % entries.size();
+            --size;
+        }
+    }
+
+    void push(uint64_t index, double value) {
+        // Anything not strictly better than the new sample can never win again
+        while (size > 0 && !Better()(entries[(head + size - 1) % entries.size()].value, value)) {
+            --size;
+        }
+        entries[(head + size) % entries.size()] = Entry{ index, value };
+        ++size;
+    }
+
+    bool empty() const { return size == 0; }
+    double front() const { return size > 0 ? entries[head].value : 0.0; }
+    void clear() { head = 0; size = 0; }
+
+private:
+    struct Entry {
+        uint64_t index;
+        double value;
+    };
+    std::vector<Entry> entries;
+    size_t head;
+    size_t size;
+};
+
+// Rolling frame-time statistics over the last windowFrames frames: min, max and
+// mean in O(1), percentiles and 1% lows from a histogram of the same window,
+// and stutter detection. All storage is sized up front; addFrame never allocates.
+class FrameTimeStats {
+public:
+    // A frame this many times the window's median frame time is a stutter
+    static constexpr double STUTTER_FACTOR = 2.0;
+    // Frames in the window before stutters are judged
+    static const size_t STUTTER_WARMUP_FRAMES = 10;
+
+    explicit FrameTimeStats(size_t windowFrames);
+
+    void addFrame(double frameMs);
+    void reset();
+
+    size_t getWindowFrames() const { return samples.size(); }
+    size_t getSampleCount() const { return count; }
+
+    double getLastMs() const { return lastMs; }
+    double getMinMs() const { return minWindow.front(); }
+    double getMaxMs() const { return maxWindow.front(); }
+    double getAverageMs() const { return count > 0 ? sumMs / count : 0.0; }
+    // percentile in [0, 100], e.g. 99 for p99
+    double getPercentileMs(double percentile) const;
+    // Average frame rate over the slowest 1% of frames
+    double getOnePercentLowFps() const;
+
+    bool wasLastFrameStutter() const { return lastWasStutter; }
+    size_t getStuttersInWindow() const { return stuttersInWindow; }
+    uint64_t getTotalStutters() const { return totalStutters; }
+
+private:
+    struct Sample {
+        double ms;
+        uint32_t microseconds;
+        bool stutter;
+    };
+
+    std::vector<Sample> samples;     // Ring holding the window
+    uint64_t framesSeen;
+    size_t count;
+    double sumMs;
+    double lastMs;
+    FrameTimeHistogram histogram;
+    MonotonicWindow<std::less<double>> minWindow;
+    MonotonicWindow<std::greater<double>> maxWindow;
+    bool lastWasStutter;
+    size_t stuttersInWindow;
+    uint64_t totalStutters;
+};
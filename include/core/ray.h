@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include "aabb.h"
+
+// Ray for CPU picking. direction need not be unit length; hit distances are in
+// multiples of it. The reciprocal is kept for the slab test.
+struct Ray {
+    glm::vec3 origin;
+    glm::vec3 direction;
+    glm::vec3 inverseDirection;
+
+    Ray(const glm::vec3& origin, const glm::vec3& direction)
+        : origin(origin)
+        , direction(direction)
+        , inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z) {}
+
+    glm::vec3 at(float t) const { return origin + direction * t; }
+
+    // Ray through window pixel (x, y), y down as GLFW reports it, from the near
+    // to the far plane of the camera; direction spans the whole depth range
+    static Ray fromScreen(double x, double y, const glm::mat4& inverseViewProjection, float width, float height) {
+        float ndcX = static_cast<float>(2.0 * x / width - 1.0);
+        float ndcY = static_cast<float>(1.0 - 2.0 * y / height);
+        glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+        glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+        glm::vec3 start = glm::vec3(nearPoint) / nearPoint.w;
+        glm::vec3 end = glm::vec3(farPoint) / farPoint.w;
+        return Ray(start, end - start);
+    }
+};
+
+// Slab test. On a hit, tNear is where the ray enters the box (0 if it starts
+// inside); boxes entirely beyond maxT miss.
+inline bool intersectRayAABB(const Ray& ray, const AABB& box, float maxT, float& tNear) {
+    glm::vec3 t0 = (box.min - ray.origin) * ray.inverseDirection;
+    glm::vec3 t1 = (box.max - ray.origin) * ray.inverseDirection;
+    glm::vec3 tMin = glm::min(t0, t1);
+    glm::vec3 tMax = glm::max(t0, t1);
+    float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+    float exit = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxT));
+    tNear = enter;
+    return enter <= exit;
+}
+
+// Moller-Trumbore, both faces. t is the ray parameter of the hit.
+inline bool intersectRayTriangle(const Ray& ray, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float& t) {
+    const float EPSILON = 1e-8f;
+    glm::vec3 edge1 = b - a;
+    glm::vec3 edge2 = c - a;
+    glm::vec3 p = glm::cross(ray.direction, edge2);
+    float determinant = glm::dot(edge1, p);
+    if (std::fabs(determinant) < EPSILON) return false;
+
+    float inverseDeterminant = 1.0f / determinant;
+    glm::vec3 s = ray.origin - a;
+    float u = glm::dot(s, p) * inverseDeterminant;
+    if (u < 0.0f || u > 1.0f) return false;
+    glm::vec3 q = glm::cross(s, edge1);
+    float v = glm::dot(ray.direction, q) * inverseDeterminant;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    t = glm::dot(edge2, q) * inverseDeterminant;
+    return t >= 0.0f;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free single-producer / single-consumer ring. One thread pushes,
+// one thread pops; neither ever blocks, a full queue just refuses the push.
+// Each side keeps a cached copy of the other's index so the common case touches
+// no shared cache line. Capacity is rounded up to a power of two.
+template <typename T>
+class SPSCQueue {
+public:
+    explicit SPSCQueue(size_t minCapacity)
+        : slots(roundUpToPowerOfTwo(minCapacity))
+        , mask(slots.size() - 1)
+        , head(0)
+        , cachedTail(0)
+        , tail(0)
+        , cachedHead(0) {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    // Producer side. keepFree slots are left empty, reserving them for pushes
+    // that pass a smaller keepFree.
+    bool tryPush(const T& value, size_t keepFree = 0) {
+        size_t index = head.load(std::memory_order_relaxed);
+        size_t limit = slots.size() - keepFree;
+        if (index - cachedTail >= limit) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (index - cachedTail >= limit) return false;
+        }
+        slots[index & mask] = value;
+        head.store(index + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side: slots in use, possibly overstated while the consumer pops
+    size_t sizeForProducer() {
+        cachedTail = tail.load(std::memory_order_acquire);
+        return head.load(std::memory_order_relaxed) - cachedTail;
+    }
+
+    // Consumer side
+    bool tryPop(T& out) {
+        size_t index = tail.load(std::memory_order_relaxed);
+        if (index == cachedHead) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (index == cachedHead) return false;
+        }
+        out = slots[index & mask];
+        tail.store(index + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return slots.size(); }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t capacity = 1;
+        while (capacity < value) capacity <<= 1;
+        return capacity;
+    }
+
+    std::vector<T> slots;
+    const size_t mask;
+
+    // Written by the producer
+    alignas(64) std::atomic<size_t> head;
+    size_t cachedTail;
+    // Written by the consumer
+    alignas(64) std::atomic<size_t> tail;
+    size_t cachedHead;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads for background work (asset loading, mesh processing)
+class ThreadPool {
+public:
+    // threadCount == 0 picks hardware_concurrency - 1 (at least one worker)
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void enqueue(std::function<void()> task);
+    void waitIdle();
+
+    // Splits [0, count) into grainSize chunks and runs body(begin, end) on them across the
+    // pool. The calling thread works on chunks too, so it is safe to call from a pool worker.
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+    size_t getThreadCount() const { return workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable idle;
+    size_t activeTasks;
+    bool stopping;
+
+    void workerLoop();
+};
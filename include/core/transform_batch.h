@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "aabb.h"
+
+// Translation / rotation / scale of many objects, one array per component so the
+// batch kernels can load 4 or 8 objects per instruction, plus the local bounds
+// whose world AABBs they compute. TransformHierarchy keeps its nodes in one.
+struct TransformSoA {
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+    std::vector<float> scaleX, scaleY, scaleZ;
+    // Center and half extents; a negative half x marks an object without bounds
+    std::vector<float> boundsCenterX, boundsCenterY, boundsCenterZ;
+    std::vector<float> boundsHalfX, boundsHalfY, boundsHalfZ;
+
+    void resize(size_t count);
+    void clear() { resize(0); }
+    size_t size() const { return positionX.size(); }
+
+    void set(size_t index, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+    void push(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+    // Empty bounds leave the object without any
+    void setBounds(size_t index, const AABB& bounds);
+    // Every component of source's object from into index
+    void copy(size_t index, const TransformSoA& source, size_t from);
+
+    glm::vec3 getPosition(size_t index) const { return glm::vec3(positionX[index], positionY[index], positionZ[index]); }
+    glm::quat getRotation(size_t index) const {
+        return glm::quat(rotationW[index], rotationX[index], rotationY[index], rotationZ[index]);
+    }
+    glm::vec3 getScale(size_t index) const { return glm::vec3(scaleX[index], scaleY[index], scaleZ[index]); }
+};
+
+// What one batch reads and writes, all indexed by object. An object with a parent
+// gets the parent's world matrix times its own T * R * S; parents must be final
+// already, so a call never computes an object together with its parent.
+struct TransformBatchData {
+    const TransformSoA* locals = nullptr;
+    const uint32_t* parents = nullptr;      // TransformBatch::NO_PARENT for roots; null when all are
+    const uint8_t* changed = nullptr;       // Only flagged objects are written; null writes all
+    glm::mat4* worldMatrices = nullptr;
+    AABB* worldBounds = nullptr;            // Null to skip bounds; objects without local bounds get empty ones
+};
+
+namespace TransformBatch {
+    const uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    // World matrices and world AABBs for objects [begin, end). Uses AVX when
+    // compiled with it, SSE otherwise and plain C++ elsewhere.
+    void computeRange(const TransformBatchData& data, size_t begin, size_t end);
+
+    // Same results through glm one object at a time; reference for tests and benchmarks
+    void computeRangeScalar(const TransformBatchData& data, size_t begin, size_t end);
+
+    // "avx", "sse" or "scalar"
+    const char* simdPath();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "aabb.h"
+#include "transform_batch.h"
+
+class ThreadPool;
+
+using TransformId = uint32_t;
+const TransformId INVALID_TRANSFORM = 0xFFFFFFFFu;
+
+// Scene graph of TRS nodes kept in flat arrays sorted by depth, so every parent sits
+// before its children and world matrices are refreshed one depth level at a time by
+// the TransformBatch kernels, split across a ThreadPool when one is set. Only nodes
+// that changed, and their descendants, are recomputed.
+class TransformHierarchy {
+public:
+    TransformHierarchy();
+
+    TransformId createNode(TransformId parent = INVALID_TRANSFORM);
+    // Children move up to the destroyed node's parent and keep their local transforms
+    void destroyNode(TransformId id);
+    // Fails (returns false) if the new parent is the node itself or one of its descendants
+    bool setParent(TransformId id, TransformId parent);
+
+    void setLocalPosition(TransformId id, const glm::vec3& position);
+    void setLocalRotation(TransformId id, const glm::quat& rotation);
+    void setLocalScale(TransformId id, const glm::vec3& scale);
+
+    // Bounds in the node's own space; empty (the default) leaves its world bounds empty
+    void setLocalBounds(TransformId id, const AABB& bounds);
+
+    glm::vec3 getLocalPosition(TransformId id) const { return locals.getPosition(idToSlot[id]); }
+    glm::quat getLocalRotation(TransformId id) const { return locals.getRotation(idToSlot[id]); }
+    glm::vec3 getLocalScale(TransformId id) const { return locals.getScale(idToSlot[id]); }
+    TransformId getParent(TransformId id) const;
+    uint32_t getDepth(TransformId id) const { return depths[idToSlot[id]]; }
+
+    // Valid as of the last updateWorldMatrices()
+    const glm::mat4& getWorldMatrix(TransformId id) const { return worldMatrices[idToSlot[id]]; }
+    glm::vec3 getWorldPosition(TransformId id) const { return glm::vec3(getWorldMatrix(id)[3]); }
+    const AABB& getWorldBounds(TransformId id) const { return worldBounds[idToSlot[id]]; }
+
+    // Returns the number of world matrices recomputed; their ids are appended to
+    // changedIds when given
+    size_t updateWorldMatrices(std::vector<TransformId>* changedIds = nullptr);
+
+    bool isValid(TransformId id) const;
+    size_t size() const { return slotToId.size() - removedCount; }
+    bool hasPendingChanges() const { return firstDirtySlot != NO_SLOT || needsSort; }
+
+    // Levels wider than PARALLEL_GRAIN nodes are split across the pool; null runs
+    // everything on the calling thread
+    void setThreadPool(ThreadPool* pool) { threadPool = pool; }
+    ThreadPool* getThreadPool() const { return threadPool; }
+
+    static const size_t PARALLEL_GRAIN = 4096;
+
+private:
+    static const uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    // Per-slot data, in depth order once sorted
+    std::vector<TransformId> slotToId;
+    std::vector<uint32_t> parentSlots;
+    std::vector<uint32_t> depths;
+    TransformSoA locals;
+    std::vector<glm::mat4> worldMatrices;
+    std::vector<AABB> worldBounds;
+    std::vector<uint8_t> dirtyFlags;
+    std::vector<uint8_t> changedScratch;
+
+    // Stable ids -> current slot
+    std::vector<uint32_t> idToSlot;
+    std::vector<TransformId> freeIds;
+
+    uint32_t firstDirtySlot;
+    size_t removedCount;
+    bool needsSort;
+    ThreadPool* threadPool;
+
+    void markDirty(uint32_t slot);
+    void sortByDepth();
+    void updateRange(size_t begin, size_t end);
+};
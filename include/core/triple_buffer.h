@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer / single-consumer triple buffer. The producer fills
+// writeBuffer() and publishes it; the consumer picks up the newest published
+// buffer. Neither side ever waits for the other, and frames the consumer did not
+// get to in time are overwritten rather than queued.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : writeIndex(0), readIndex(1), shared(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer side
+    T& writeBuffer() { return buffers[writeIndex]; }
+
+    // Hands the write buffer to the consumer and takes back the spare one.
+    // Returns true if that replaced a buffer the consumer never read.
+    bool publish() {
+        uint8_t previous = shared.exchange(static_cast<uint8_t>(writeIndex | FRESH), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+        return (previous & FRESH) != 0;
+    }
+
+    // Consumer side: swaps in the newest published buffer, if there is one
+    bool acquire() {
+        if ((shared.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        uint8_t previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& readBuffer() const { return buffers[readIndex]; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    T buffers[3];
+    uint8_t writeIndex;                 // Owned by the producer
+    uint8_t readIndex;                  // Owned by the consumer
+    std::atomic<uint8_t> shared;        // Spare index, plus FRESH when it holds an unread frame
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Editor {
+
+enum class ObjectType;
+
+enum class EditKind : uint8_t {
+    ADD,
+    REMOVE,
+    MOVE,       // Local position
+    RESIZE,
+    PROPERTY,
+    PARENT      // Parent and local position
+};
+
+enum class ObjectProperty : uint8_t {
+    COLOR,
+    WALL_THICKNESS,     // Scalars live in x
+    ROOF_HEIGHT,
+    WINDOW_COUNT,
+    DOOR_WIDTH
+};
+
+// Everything needed to put a removed object back where it was. Indices are
+// into WorldEditor::getObjects() as it was with the object in place.
+struct ObjectState {
+    static const uint32_t NO_PARENT = 0xffffffffu;
+
+    ObjectType type;
+    glm::vec3 position;     // Relative to the parent
+    glm::vec3 size;
+    glm::vec3 color;
+    float wallThickness = 0.0f;
+    float roofHeight = 0.0f;
+    int32_t windowCount = 0;
+    float doorWidth = 0.0f;
+    uint32_t parentIndex = NO_PARENT;
+    std::vector<uint32_t> children;
+};
+
+// One change to the scene. ADD and REMOVE carry the object; the others the
+// value before and after the change (PARENT also the parent indices).
+struct Edit {
+    EditKind kind = EditKind::MOVE;
+    ObjectProperty property = ObjectProperty::COLOR;
+    uint32_t objectIndex = 0;
+    glm::vec3 before = glm::vec3(0.0f);
+    glm::vec3 after = glm::vec3(0.0f);
+    uint32_t parentBefore = ObjectState::NO_PARENT;
+    uint32_t parentAfter = ObjectState::NO_PARENT;
+    ObjectState object;
+};
+
+// The edit that takes the change back
+Edit inverseEdit(const Edit& edit);
+
+// Packed form shared by the journal and the edit log: u8 kind, u8 property,
+// u16 unused, u32 object index, then the payload. encodeEdit appends to out;
+// decodeEdit returns false when the bytes are not exactly one edit.
+void encodeEdit(const Edit& edit, std::vector<uint8_t>& out);
+bool decodeEdit(const uint8_t* data, size_t size, Edit& out);
+
+// Undo/redo history kept as packed records in a byte ring of fixed size. A new
+// record past the limit drops the oldest ones, so memory stays bounded however
+// long the session runs. Record, undo and redo touch only the records at the
+// cursor: O(1) whatever the scene size.
+//
+// A move, resize or property change on the same object as the step before it
+// folds into that step until seal() is called, so a drag undoes in one go.
+//
+// Record layout: u32 size, the encoded edit, then the size again so the ring
+// can be walked backwards. Value changes take 40 bytes, a parent change 48, an
+// object 80 plus 4 per child.
+class EditJournal {
+public:
+    static const size_t DEFAULT_MEMORY_LIMIT = 1 << 20;
+
+    explicit EditJournal(size_t memoryLimit = DEFAULT_MEMORY_LIMIT);
+
+    // Drops the redo steps, then appends or merges the edit
+    void record(const Edit& edit);
+    // Ends the current gesture; the next edit starts a new step
+    void seal() { mergeable = false; }
+
+    // The step to revert or re-apply; false when there is none
+    bool undo(Edit& out);
+    bool redo(Edit& out);
+
+    void clear();
+    // Drops the redo steps, and the oldest undo steps that no longer fit
+    void setMemoryLimit(size_t bytes);
+    size_t getMemoryLimit() const { return ring.size(); }
+    size_t getMemoryUsed() const { return static_cast<size_t>(end - begin); }
+    size_t getUndoCount() const { return undoCount; }
+    size_t getRedoCount() const { return redoCount; }
+
+private:
+    std::vector<uint8_t> ring;
+    // Offsets grow without wrapping; the ring position is offset % size
+    uint64_t begin;
+    uint64_t cursor;    // Undo steps lie before it, redo steps after
+    uint64_t end;
+    size_t undoCount;
+    size_t redoCount;
+    bool mergeable;
+    uint64_t lastRecord;   // Start of the step before the cursor, while mergeable
+    std::vector<uint8_t> scratch;
+
+    void write(uint64_t offset, const void* data, size_t size);
+    void read(uint64_t offset, void* data, size_t size) const;
+    uint32_t readSize(uint64_t offset) const;
+    void dropOldest();
+    void decode(uint64_t offset, uint32_t size, Edit& out);
+};
+
+} // namespace Editor
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "editor.h"
+
+namespace Editor {
+
+// Crash safety for editing sessions. Every change the editor reports goes to
+// a write-ahead log, <scene>.wal, written by a background thread. That thread
+// also replays the changes onto a shadow copy of the scene, and from it writes
+// a checkpoint, <scene>.checkpoint, whenever the log grows past a limit; the
+// log then starts over. The editor never waits on the disk.
+//
+// Opening recovers the scene from the checkpoint (else the scene file itself)
+// plus the intact log records newer than it, then checkpoints the result.
+// Each checkpoint notes the scene file's size and modification time; if the
+// scene file no longer matches, it was replaced outside the log (saved by
+// something else, or copied over), and it wins over the checkpoint and the
+// log, edits logged after it was written included. Saves made through save()
+// checkpoint against the new file, so the edits after them stay recoverable.
+//
+// Log: "FPSL", u32 version, then per record u32 length, u32 CRC-32 of what
+// follows, u64 sequence number and the encoded edit (see encodeEdit).
+// Checkpoint: "FPSC", u32 version, u64 sequence of the last edit it holds,
+// u64 scene file size and i64 modification time in nanoseconds (zeros for
+// no file), then a SceneFile.
+class EditLog {
+public:
+    static const uint32_t FORMAT_VERSION = 2;
+
+    enum class SyncPolicy {
+        EVERY_BATCH,    // fsync each write; a crash loses at most the batch in flight
+        INTERVAL,       // fsync at most every syncIntervalMs
+        NEVER           // Left to the OS; checkpoints are still synced
+    };
+
+    struct Options {
+        SyncPolicy sync = SyncPolicy::INTERVAL;
+        int flushIntervalMs = 20;               // How long edits wait to be written
+        int syncIntervalMs = 250;
+        size_t checkpointBytes = 8 << 20;       // Log size that triggers a checkpoint
+    };
+
+    struct Stats {
+        uint64_t editsLogged = 0;
+        uint64_t batchesWritten = 0;
+        uint64_t syncs = 0;
+        uint64_t checkpoints = 0;
+        uint64_t saves = 0;
+        uint64_t recoveredEdits = 0;            // Replayed by open()
+        double recoveryMs = 0.0;
+    };
+
+    EditLog();
+    ~EditLog();
+    EditLog(const EditLog&) = delete;
+    EditLog& operator=(const EditLog&) = delete;
+
+    // Recovers the editor's scene and logs its changes from then on. The
+    // editor must outlive close(). Prints the error and returns false on failure.
+    bool open(const std::string& scenePath, WorldEditor& editor);
+    bool open(const std::string& scenePath, WorldEditor& editor, const Options& options);
+    // Writes what is pending and a final checkpoint, and detaches from the editor
+    void close();
+    bool isOpen() const { return editor != nullptr; }
+
+    // On the editor's thread; the editor calls it for every change once open
+    void append(const Edit& edit);
+    // Blocks until everything appended so far is written and synced, and every
+    // save requested so far is done
+    void flush();
+    // Has the background thread checkpoint after its next write
+    void requestCheckpoint();
+    // Has the background thread write the scene file, with every edit appended
+    // so far, then checkpoint against it. The editor does not wait for it.
+    void save();
+
+    Stats getStats() const;
+
+private:
+    std::string sceneFilePath;
+    std::string logPath;
+    std::string checkpointPath;
+    Options options;
+    WorldEditor* editor;
+    uint64_t nextSequence;      // Editor thread only
+
+    // Background thread state
+    std::unique_ptr<WorldEditor> shadow;
+    std::FILE* logFile;
+    size_t logBytes;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;       // For the background thread
+    std::condition_variable written;    // For flush()
+    std::vector<uint8_t> pending;       // Records appended since the last write
+    uint64_t appendedSequence;
+    uint64_t durableSequence;
+    bool flushRequested;
+    bool checkpointRequested;
+    uint64_t savesRequested;
+    uint64_t savesWritten;
+    bool stopping;
+    Stats stats;
+    std::thread ioThread;
+
+    void ioLoop(std::vector<uint8_t> initialScene, uint64_t initialSequence);
+    bool writeCheckpoint(const std::vector<uint8_t>& scene, uint64_t sequence);
+    bool startLog();
+    void sync();
+};
+
+} // namespace Editor
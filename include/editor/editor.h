@@ -1,12 +1,24 @@
 #pragma once
 
 #include <vector>
+#include <functional>
 #include <memory>
+#include <string>
 #include <glm/glm.hpp>
 #include "../graphics/renderer.h"
+#include "../core/transform_hierarchy.h"
+#include "procedural_mesh.h"
+#include "../core/bvh.h"
+#include "../core/ray.h"
+#include "edit_journal.h"
+#include "entity_store.h"
+
+struct FrameSnapshot;
 
 namespace Editor {
 
+class SceneFile;
+
 // Enum for different types of objects that can be placed
 enum class ObjectType {
     WALL,
@@ -17,7 +29,9 @@ enum class ObjectType {
     BRIDGE
 };
 
-// Base class for all editable objects
+// A standalone editable object, drawn for placement previews. WorldEditor keeps
+// its objects in an EntityStore instead. position is relative to the parent
+// object; render() draws in the space of the parent's world matrix.
 class EditableObject {
 public:
     EditableObject(ObjectType type, const glm::vec3& position, const glm::vec3& size);
@@ -32,16 +46,24 @@ public:
     glm::vec3 getSize() const { return size; }
     ObjectType getType() const { return type; }
     glm::vec3 getColor() const { return color; }
+    TransformId getTransformId() const { return transformId; }
 
     void setPosition(const glm::vec3& pos) { position = pos; }
     void setSize(const glm::vec3& s) { size = s; }
     void setColor(const glm::vec3& c) { color = c; }
+    void setTransformId(TransformId id) { transformId = id; }
+
+    // Baked unit-space geometry, shared through ProceduralMeshCache
+    std::shared_ptr<const ProceduralMesh> getMesh() const;
+    virtual ProceduralMeshKey getMeshKey() const;
 
 protected:
     ObjectType type;
     glm::vec3 position;
     glm::vec3 size;
     glm::vec3 color;
+    TransformId transformId = INVALID_TRANSFORM;
+    mutable std::shared_ptr<const ProceduralMesh> mesh;
 };
 
 // Specific object types
@@ -69,17 +91,20 @@ public:
     void renderPreview() const override;
     void update() override;
 
-    // Additional properties for predefined objects
+    // Additional properties for predefined objects. Changing one that shapes the
+    // geometry drops the baked mesh; wall thickness does not.
     void setWallThickness(float thickness) { wallThickness = thickness; }
-    void setRoofHeight(float height) { roofHeight = height; }
-    void setWindowCount(int count) { windowCount = count; }
-    void setDoorWidth(float width) { doorWidth = width; }
+    void setRoofHeight(float height) { if (height != roofHeight) { roofHeight = height; mesh.reset(); } }
+    void setWindowCount(int count) { if (count != windowCount) { windowCount = count; mesh.reset(); } }
+    void setDoorWidth(float width) { if (width != doorWidth) { doorWidth = width; mesh.reset(); } }
 
     float getWallThickness() const { return wallThickness; }
     float getRoofHeight() const { return roofHeight; }
     int getWindowCount() const { return windowCount; }
     float getDoorWidth() const { return doorWidth; }
 
+    ProceduralMeshKey getMeshKey() const override;
+
 private:
     float wallThickness;
     float roofHeight;
@@ -87,6 +112,16 @@ private:
     float doorWidth;
 };
 
+// Draws the translucent placement ghost for an object type
+void renderObjectPreview(ObjectType type, const glm::vec3& position, const glm::vec3& size);
+
+// Where a pick ray met a placed object
+struct PickHit {
+    size_t objectIndex;     // Into WorldEditor::getObjects()
+    glm::vec3 point;        // World-space point on the object
+    float distance;         // Along the ray, in multiples of its direction
+};
+
 // Main editor class
 class WorldEditor {
 public:
@@ -94,17 +129,71 @@ public:
     ~WorldEditor();
 
     void update();
-    void render() const;
     void renderPreview(const glm::vec3& position, const glm::vec3& size) const;
     
-    // Editor operations
+    // Editor operations. Removal is O(1): the last object takes the removed
+    // one's index. Handles (getObjects()[i]->getHandle()) keep naming the same
+    // object through that, and go stale when it is removed.
     void addObject(ObjectType type, const glm::vec3& position, const glm::vec3& size);
     void removeObject(size_t index);
+    void removeObject(ObjectHandle handle);
     void selectObject(size_t index);
+    void selectObject(ObjectHandle handle);
     void moveSelectedObject(const glm::vec3& offset);
     void resizeSelectedObject(const glm::vec3& newSize);
+    void setObjectPosition(size_t index, const glm::vec3& position);
     void setCurrentObjectType(ObjectType type) { currentObjectType = type; }
 
+    // Hierarchy: children follow their parent. Positions stay relative to the parent,
+    // and re-parenting keeps the object where it is in the world.
+    bool setObjectParent(size_t childIndex, size_t parentIndex);
+    void clearObjectParent(size_t childIndex);
+    glm::vec3 getObjectWorldPosition(size_t index) const;
+    const TransformHierarchy& getTransforms() const { return transforms; }
+    // Wide hierarchy levels update across the pool (see TransformHierarchy); null
+    // keeps the update on the calling thread
+    void setThreadPool(ThreadPool* pool) { transforms.setThreadPool(pool); }
+
+    // Closest object the ray hits within maxDistance: a BVH over the objects'
+    // world bounds narrows the candidates, then with refineTriangles their mesh
+    // triangles decide. The first pick after objects were added or removed
+    // rebuilds the BVH; after moves and resizes it is only refitted.
+    bool pick(const Ray& ray, float maxDistance, PickHit& hit, bool refineTriangles = true) const;
+
+    // Edit history. The operations above and the property setters below are
+    // journaled; undo and redo return false when there is nothing left to step
+    // over, and select the object they touched.
+    bool undo();
+    bool redo();
+    // Ends a drag: the next move, resize or property change is a new undo step
+    void sealUndoStep() { journal.seal(); }
+    EditJournal& getJournal() { return journal; }
+    const EditJournal& getJournal() const { return journal; }
+
+    // Called with every change made through the editor, undo and redo
+    // included, in the form replayEdit() applies again
+    using EditListener = std::function<void(const Edit&)>;
+    void setEditListener(EditListener listener) { editListener = std::move(listener); }
+    // Applies a reported change without journaling or reporting it
+    void replayEdit(const Edit& edit);
+
+    // Scene files (see SceneFile). Loading replaces every object and clears the
+    // undo history; the path versions print the error and return false on failure.
+    bool saveScene(const std::string& path) const;
+    bool loadScene(const std::string& path);
+    void loadScene(const SceneFile& file);
+    // Streaming (see WorldStreamer): adds a scene's objects next to the current
+    // ones and hands back their handles, then takes them out again. Neither is
+    // journaled or reported, and both clear the undo history, whose indices
+    // they invalidate; the selection is kept unless its object is removed.
+    void appendScene(const SceneFile& file, std::vector<ObjectHandle>& handles);
+    void removeObjects(const std::vector<ObjectHandle>& handles);
+
+    // Copies what the render thread draws (objects, placement and inventory state)
+    // into a snapshot, which SnapshotRenderer draws; its camera and editor-input
+    // fields are left alone
+    void captureSnapshot(FrameSnapshot& out) const;
+
     // Inventory system
     void selectInventoryItem(size_t index);
     void placeSelectedItem(const glm::vec3& position, const glm::vec3& size);
@@ -121,15 +210,31 @@ public:
     void setSelectedObjectWindowCount(int count);
     void setSelectedObjectDoorWidth(float width);
 
-    // Getters
-    const std::vector<std::unique_ptr<EditableObject>>& getObjects() const { return objects; }
-    size_t getSelectedObjectIndex() const { return selectedObjectIndex; }
+    // Getters. The objects are read through the store; the list reads like the
+    // vector of objects it replaced.
+    ObjectList getObjects() const { return ObjectList(entities); }
+    const EntityStore& getEntities() const { return entities; }
+    // EntityStore::NO_INDEX for stale handles
+    size_t getObjectIndex(ObjectHandle handle) const { return entities.indexOf(handle); }
+    // The selection is held by handle, so it survives other objects being
+    // removed. Nothing is selected once the object goes; the index is then
+    // getObjects().size().
+    ObjectHandle getSelectedObject() const { return selectedObject; }
+    size_t getSelectedObjectIndex() const;
     ObjectType getCurrentObjectType() const { return currentObjectType; }
 
     // Move constructor and move assignment operator
     WorldEditor(WorldEditor&& other) noexcept
-        : objects(std::move(other.objects))
-        , selectedObjectIndex(other.selectedObjectIndex)
+        : entities(std::move(other.entities))
+        , transforms(std::move(other.transforms))
+        , nodeObjects(std::move(other.nodeObjects))
+        , nodeChildCounts(std::move(other.nodeChildCounts))
+        , boundsChangedNodes(std::move(other.boundsChangedNodes))
+        , pickTreeDirty(true)
+        , journal(std::move(other.journal))
+        , replayingEdit(false)
+        , editListener(std::move(other.editListener))
+        , selectedObject(other.selectedObject)
         , currentObjectType(other.currentObjectType)
         , inventoryItems(std::move(other.inventoryItems))
         , selectedInventoryIndex(other.selectedInventoryIndex)
@@ -140,8 +245,15 @@ public:
 
     WorldEditor& operator=(WorldEditor&& other) noexcept {
         if (this != &other) {
-            objects = std::move(other.objects);
-            selectedObjectIndex = other.selectedObjectIndex;
+            entities = std::move(other.entities);
+            transforms = std::move(other.transforms);
+            nodeObjects = std::move(other.nodeObjects);
+            nodeChildCounts = std::move(other.nodeChildCounts);
+            boundsChangedNodes = std::move(other.boundsChangedNodes);
+            pickTreeDirty = true;
+            journal = std::move(other.journal);
+            editListener = std::move(other.editListener);
+            selectedObject = other.selectedObject;
             currentObjectType = other.currentObjectType;
             inventoryItems = std::move(other.inventoryItems);
             selectedInventoryIndex = other.selectedInventoryIndex;
@@ -154,8 +266,28 @@ public:
     }
 
 private:
-    std::vector<std::unique_ptr<EditableObject>> objects;
-    size_t selectedObjectIndex;
+    EntityStore entities;
+    // World matrices are a cache, refreshed lazily when rendering or querying
+    mutable TransformHierarchy transforms;
+    std::vector<uint32_t> nodeObjects;      // TransformId -> object index
+    std::vector<uint32_t> nodeChildCounts;  // TransformId -> children, so removing a leaf skips the search
+    mutable std::vector<TransformId> changedNodes;
+    // Nodes whose object was added, resized or reshaped; their local bounds come
+    // from the mesh table on the next refresh, when the meshes are built
+    mutable std::vector<TransformId> boundsChangedNodes;
+
+    // Picking state, brought up to date lazily: per object its world bounds and
+    // the inverse of its scaled world matrix for the triangle test
+    mutable BVH pickTree;
+    mutable std::vector<AABB> pickBounds;
+    mutable std::vector<glm::mat4> pickInverseModels;
+    mutable std::vector<size_t> pickChangedObjects;     // Moved or resized since, for a refit
+    mutable bool pickTreeDirty;
+
+    EditJournal journal;
+    bool replayingEdit;     // Undo and redo go through the operations without recording
+    EditListener editListener;
+    ObjectHandle selectedObject;
     bool isEditing;
     ObjectType currentObjectType;
 
@@ -166,6 +298,28 @@ private:
     bool isPlacing;
     glm::vec3 previewPosition;
     glm::vec3 previewSize;
+
+    // Refreshes local bounds, world matrices and world bounds, and hands moved
+    // objects to the pick tree
+    void refreshWorldState() const;
+    // False for types the editor cannot place
+    bool insertObject(size_t index, ObjectType type, const glm::vec3& position, const glm::vec3& size,
+                      TransformId parent);
+    void restoreObject(size_t index, const ObjectState& state);
+    void appendSceneObjects(const SceneFile& file);
+    void resizeObject(size_t index, const glm::vec3& size);
+    void setObjectProperty(size_t index, ObjectProperty property, const glm::vec3& value);
+    void recordValueEdit(EditKind kind, ObjectProperty property, size_t index,
+                         const glm::vec3& before, const glm::vec3& after);
+    void noteEdit(const Edit& edit);
+    size_t findObject(TransformId node) const;
+    // Parent changes go through here to keep the child counts
+    bool reparentNode(TransformId node, TransformId parent);
+    void setParentDirect(size_t index, uint32_t parentIndex, const glm::vec3& localPosition);
+    void applyEdit(const Edit& edit, bool forward);
+    void rebuildPickTree() const;
+    void updatePickBounds(size_t index) const;
+    void markPickChanged(size_t index) const;
 };
 
 } // namespace Editor 
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../core/aabb.h"
+#include "../core/transform_hierarchy.h"
+#include "procedural_mesh.h"
+
+namespace Editor {
+
+// Parameters only houses, towers and bridges carry
+struct PredefinedParams {
+    float wallThickness = 0.2f;
+    float roofHeight = 1.0f;
+    int windowCount = 2;
+    float doorWidth = 1.0f;
+};
+
+// Stable name for an entity: a slot in the store's handle table and the
+// generation the slot had when the entity got it. Removal bumps the
+// generation, so an old handle never finds the entity that reuses the slot.
+struct ObjectHandle {
+    static const uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    uint32_t slot = NO_SLOT;
+    uint32_t generation = 0;
+
+    bool operator==(const ObjectHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const ObjectHandle& other) const { return !(*this == other); }
+};
+
+// Editor objects as parallel component arrays, indexed by their place in the
+// scene, so systems walk each component front to back instead of chasing one
+// heap object per entity. Erasing swaps the last entity into the hole, so it is
+// O(1) but moves that entity; handles follow it. Predefined parameters are sparse: only houses,
+// towers and bridges have a slot. The render mesh is an id into a table of the
+// distinct meshes in use, resolved on first use, so a thousand identical
+// houses share one entry (and one set of local bounds). Entries count their
+// entities; the last one leaving frees the entry and its id for reuse.
+class EntityStore {
+public:
+    static const uint32_t NO_PARAMS = 0xFFFFFFFFu;
+    static const uint32_t NO_MESH = 0xFFFFFFFFu;
+    static const size_t NO_INDEX = static_cast<size_t>(-1);
+
+    // Entry in the mesh table
+    struct MeshEntry {
+        std::shared_ptr<const ProceduralMesh> mesh;     // Null while the id is free
+        AABB bounds;            // Unit space
+        uint32_t users = 0;
+        uint32_t generation = 0;    // Bumped when the id is freed, for caches keyed by id
+    };
+
+    static bool isPredefined(ObjectType type);
+    // False for types the editor cannot place
+    static bool isPlaceable(ObjectType type);
+
+    size_t size() const { return types.size(); }
+    bool empty() const { return types.empty(); }
+    void reserve(size_t count);
+    // Every handle goes stale and every mesh entry is freed
+    void clear();
+
+    // The new entity gets a fresh handle and its type's default color and
+    // parameters. Inserting before the end moves the entity at index to the
+    // end, and erasing moves the last entity to index, so one undoes the other.
+    void insert(size_t index, ObjectType type, const glm::vec3& position, const glm::vec3& size, TransformId node);
+    void erase(size_t index);
+
+    ObjectHandle getHandle(size_t index) const {
+        uint32_t slot = handleSlots[index];
+        return ObjectHandle{ slot, slots[slot].generation };
+    }
+    // NO_INDEX for handles whose entity is gone
+    size_t indexOf(ObjectHandle handle) const {
+        if (handle.slot >= slots.size() || slots[handle.slot].generation != handle.generation) return NO_INDEX;
+        return slots[handle.slot].entity;
+    }
+    bool isValid(ObjectHandle handle) const { return indexOf(handle) != NO_INDEX; }
+
+    ObjectType getType(size_t index) const { return types[index]; }
+    const glm::vec3& getPosition(size_t index) const { return positions[index]; }
+    const glm::vec3& getSize(size_t index) const { return sizes[index]; }
+    const glm::vec3& getColor(size_t index) const { return colors[index]; }
+    TransformId getNode(size_t index) const { return nodes[index]; }
+    void setPosition(size_t index, const glm::vec3& position) { positions[index] = position; }
+    void setSize(size_t index, const glm::vec3& size) { sizes[index] = size; }
+    void setColor(size_t index, const glm::vec3& color) { colors[index] = color; }
+
+    bool hasParams(size_t index) const { return paramSlots[index] != NO_PARAMS; }
+    // Defaults for entities without parameters
+    const PredefinedParams& getParams(size_t index) const;
+    // Ignored for entities without parameters; a change drops the resolved mesh
+    void setParams(size_t index, const PredefinedParams& values);
+
+    ProceduralMeshKey getMeshKey(size_t index) const;
+    uint32_t getMeshId(size_t index) const {
+        uint32_t id = meshIds[index];
+        return id != NO_MESH ? id : resolveMesh(index);
+    }
+    const MeshEntry& getMeshEntry(uint32_t meshId) const { return meshTable[meshId]; }
+    const std::shared_ptr<const ProceduralMesh>& getMesh(size_t index) const { return meshTable[getMeshId(index)].mesh; }
+    // Mesh ids are below this; some may be free
+    size_t getMeshCount() const { return meshTable.size(); }
+    size_t getMeshesInUse() const { return meshTable.size() - freeMeshIds.size(); }
+    // Counts every entry freed, so caches keyed by mesh id can tell when to look
+    uint64_t getMeshReleaseCount() const { return meshReleases; }
+
+    // Whole components, for systems
+    const std::vector<ObjectType>& getTypes() const { return types; }
+    const std::vector<glm::vec3>& getSizes() const { return sizes; }
+    const std::vector<glm::vec3>& getColors() const { return colors; }
+    const std::vector<TransformId>& getNodes() const { return nodes; }
+
+private:
+    std::vector<ObjectType> types;
+    std::vector<glm::vec3> positions;   // Relative to the parent
+    std::vector<glm::vec3> sizes;
+    std::vector<glm::vec3> colors;
+    std::vector<TransformId> nodes;     // Into the editor's TransformHierarchy
+    std::vector<uint32_t> paramSlots;
+    mutable std::vector<uint32_t> meshIds;
+    std::vector<uint32_t> handleSlots;
+
+    // Handle table. A free slot's generation has moved past every handle given
+    // out for it.
+    struct Slot {
+        uint32_t entity;
+        uint32_t generation;
+    };
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    // Sparse parameter component; paramOwners maps each slot back to its entity
+    std::vector<PredefinedParams> params;
+    std::vector<uint32_t> paramOwners;
+
+    mutable std::vector<MeshEntry> meshTable;
+    mutable std::unordered_map<const ProceduralMesh*, uint32_t> meshTableIds;
+    mutable std::vector<uint32_t> freeMeshIds;
+    uint64_t meshReleases = 0;
+
+    uint32_t resolveMesh(size_t index) const;
+    void releaseMesh(size_t index);
+    void swapEntities(size_t a, size_t b);
+};
+
+// One entity seen through the store, with the getters EditableObject has.
+// Valid until the store changes.
+class ObjectRef {
+public:
+    ObjectRef(const EntityStore& store, size_t index) : store(&store), index(index) {}
+
+    ObjectType getType() const { return store->getType(index); }
+    glm::vec3 getPosition() const { return store->getPosition(index); }
+    glm::vec3 getSize() const { return store->getSize(index); }
+    glm::vec3 getColor() const { return store->getColor(index); }
+    TransformId getTransformId() const { return store->getNode(index); }
+    ObjectHandle getHandle() const { return store->getHandle(index); }
+
+    bool isPredefined() const { return store->hasParams(index); }
+    float getWallThickness() const { return store->getParams(index).wallThickness; }
+    float getRoofHeight() const { return store->getParams(index).roofHeight; }
+    int getWindowCount() const { return store->getParams(index).windowCount; }
+    float getDoorWidth() const { return store->getParams(index).doorWidth; }
+
+    ProceduralMeshKey getMeshKey() const { return store->getMeshKey(index); }
+    std::shared_ptr<const ProceduralMesh> getMesh() const { return store->getMesh(index); }
+
+    // So list[i]->getType() reads like it did over unique_ptrs
+    const ObjectRef* operator->() const { return this; }
+    ObjectRef operator*() const { return *this; }
+
+private:
+    const EntityStore* store;
+    size_t index;
+};
+
+// What WorldEditor::getObjects() returns: the store as a list of ObjectRefs
+class ObjectList {
+public:
+    class Iterator {
+    public:
+        Iterator(const EntityStore& store, size_t index) : store(&store), index(index) {}
+        ObjectRef operator*() const { return ObjectRef(*store, index); }
+        Iterator& operator++() { ++index; return *this; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+
+    private:
+        const EntityStore* store;
+        size_t index;
+    };
+
+    explicit ObjectList(const EntityStore& store) : store(&store) {}
+
+    size_t size() const { return store->size(); }
+    bool empty() const { return store->empty(); }
+    ObjectRef operator[](size_t index) const { return ObjectRef(*store, index); }
+    Iterator begin() const { return Iterator(*store, 0); }
+    Iterator end() const { return Iterator(*store, store->size()); }
+
+private:
+    const EntityStore* store;
+};
+
+} // namespace Editor
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../graphics/mesh_arena.h"
+
+namespace Editor {
+
+enum class ObjectType;
+
+// Everything the geometry of an editor object depends on. Color is applied at
+// draw time and wall thickness is not modelled, so objects differing only in
+// those still share one mesh.
+struct ProceduralMeshKey {
+    ObjectType type;
+    float roofHeight;
+    int windowCount;
+    float doorWidth;
+
+    bool operator==(const ProceduralMeshKey& other) const {
+        return type == other.type && roofHeight == other.roofHeight &&
+               windowCount == other.windowCount && doorWidth == other.doorWidth;
+    }
+};
+
+struct ProceduralMeshKeyHash {
+    size_t operator()(const ProceduralMeshKey& key) const;
+};
+
+struct ProceduralVertex {
+    glm::vec3 position;
+    glm::vec3 color;
+};
+
+// Unit-space geometry (scaled by the object size when drawn). The first
+// bodyIndexCount indices, and the bodyVertexCount vertices they use, take the
+// object color; the rest keep their vertex colors.
+class ProceduralMesh {
+public:
+    ProceduralMesh() = default;
+
+    ProceduralMesh(const ProceduralMesh&) = delete;
+    ProceduralMesh& operator=(const ProceduralMesh&) = delete;
+
+    // Draws from the CPU copy; needs a current GL context
+    void draw(const glm::vec3& bodyColor) const;
+
+    const std::vector<ProceduralVertex>& getVertices() const { return vertices; }
+    const std::vector<uint32_t>& getIndices() const { return indices; }
+    size_t getBodyIndexCount() const { return bodyIndexCount; }
+    size_t getBodyVertexCount() const { return bodyVertexCount; }
+    size_t getTriangleCount() const { return indices.size() / 3; }
+
+    // Copies the mesh into a shared arena; body vertices get tint 1
+    MeshRange appendTo(MeshArena& arena) const;
+
+    // Bakes the triangles the editor objects used to draw in immediate mode
+    static std::unique_ptr<ProceduralMesh> generate(const ProceduralMeshKey& key);
+
+private:
+    std::vector<ProceduralVertex> vertices;
+    std::vector<uint32_t> indices;
+    size_t bodyIndexCount = 0;
+    size_t bodyVertexCount = 0;
+
+    void addQuad(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d, const glm::vec3& color);
+    void addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& color);
+};
+
+// Shares baked meshes between objects with identical parameters. Entries are held
+// weakly, so a mesh goes away with the last object using it.
+class ProceduralMeshCache {
+public:
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        double hitRate() const { return hits + misses ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    static ProceduralMeshCache& instance();
+
+    std::shared_ptr<const ProceduralMesh> acquire(const ProceduralMeshKey& key);
+
+    Stats getStats() const;
+    void resetStats();
+    // Number of meshes still alive
+    size_t size() const;
+    void clear();
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<ProceduralMeshKey, std::weak_ptr<const ProceduralMesh>, ProceduralMeshKeyHash> entries;
+    Stats stats;
+    size_t sweepThreshold = 64;
+};
+
+} // namespace Editor
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "editor.h"
+
+namespace Editor {
+
+// On-disk records, used in place from the mapped file. Little-endian hosts only.
+struct SceneObjectRecord {
+    glm::vec3 position;     // Relative to the parent
+    glm::vec3 size;
+    glm::vec3 color;
+    uint32_t parent;        // Scene index, or SceneFile::NO_PARENT
+    uint32_t index;         // Position in WorldEditor::getObjects()
+};
+
+struct ScenePredefinedParams {
+    float wallThickness;
+    float roofHeight;
+    int32_t windowCount;
+    float doorWidth;
+};
+
+struct SceneFileHeader {
+    char magic[4];              // "FPSW"
+    uint32_t version;
+    uint64_t fileSize;
+    uint64_t objectCount;
+    uint32_t sectionCount;
+    uint32_t stringTableSize;
+    uint64_t stringTableOffset;
+};
+
+struct SceneSectionEntry {
+    uint32_t type;              // ObjectType
+    uint32_t nameOffset;        // Into the string table
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t objectsOffset;     // count SceneObjectRecords
+    uint64_t paramsOffset;      // count ScenePredefinedParams, or 0 for plain types
+};
+
+// Saved WorldEditor scene. Objects are grouped into one section per type; each
+// record keeps its index in the scene, which loading restores and parents use.
+//
+// Layout: header, section table, string table (NUL-terminated type names),
+// then per section its object records followed by its predefined parameters.
+// Every array starts 8-byte aligned. Opening maps the file and checks the
+// header and section bounds only; the records are read where they lie.
+class SceneFile {
+public:
+    static const uint32_t FORMAT_VERSION = 1;
+    static const uint32_t NO_PARENT = 0xffffffffu;
+
+    struct Section {
+        ObjectType type;
+        const char* name;
+        uint32_t count;
+        const SceneObjectRecord* objects;
+        const ScenePredefinedParams* params;    // Null for plain types
+    };
+
+    SceneFile();
+    ~SceneFile();
+    SceneFile(const SceneFile&) = delete;
+    SceneFile& operator=(const SceneFile&) = delete;
+
+    // Maps the file (reads it where mmap is unavailable); the scene starts
+    // offset bytes in, a multiple of 8. Prints the error and returns false on failure.
+    bool open(const std::string& path, size_t offset = 0);
+    // The same over memory the caller keeps alive; false (and closed) on malformed data
+    bool view(const uint8_t* data, size_t size);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    uint64_t getObjectCount() const { return objectCount; }
+    const std::vector<Section>& getSections() const { return sections; }
+
+    // Writer side: the whole file laid out in one buffer, each record written once
+    static std::vector<uint8_t> serialize(const WorldEditor& editor);
+    static bool save(const WorldEditor& editor, const std::string& path);
+
+private:
+    const uint8_t* data;
+    size_t size;
+    void* mapping;                  // Owned mmap region, if any
+    size_t mappingSize;
+    std::vector<uint8_t> buffer;    // Owned copy where mapping is unavailable
+    uint64_t objectCount;
+    std::vector<Section> sections;
+
+    bool parse();
+};
+
+} // namespace Editor
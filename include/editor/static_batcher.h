@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "procedural_mesh.h"
+
+namespace Editor {
+
+// What a batch needs of an object, kept until the object is updated
+struct BatchObject {
+    std::shared_ptr<const ProceduralMesh> mesh;
+    glm::vec3 size;
+    glm::vec3 color;
+};
+
+// Merges placed objects into world-space vertex buffers, one per spatial cluster of
+// at most a few thousand triangles. Objects are grouped by a grid cell on the XZ
+// plane; adding, moving or removing one only rebuilds the batches it touches.
+class StaticBatcher {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 32.0f;
+    static const size_t DEFAULT_MAX_TRIANGLES = 4096;
+
+    struct Stats {
+        size_t objects = 0;
+        size_t batches = 0;          // Non-empty batches, i.e. draw calls
+        size_t triangles = 0;
+        size_t batchesRebuilt = 0;   // By the last rebuildDirty()
+    };
+
+    explicit StaticBatcher(float cellSize = DEFAULT_CELL_SIZE, size_t maxTrianglesPerBatch = DEFAULT_MAX_TRIANGLES);
+    ~StaticBatcher();
+
+    StaticBatcher(const StaticBatcher&) = delete;
+    StaticBatcher& operator=(const StaticBatcher&) = delete;
+
+    // Objects are named by a key of the caller's choosing (SnapshotRenderer uses
+    // the transform node). Keys index a table, so they should be small and dense
+    // like TransformIds. world is the object's transform without its size.
+    void addObject(uint32_t key, const BatchObject& object, const glm::mat4& world);
+    // Moves a batched object; unknown keys are ignored
+    void updateObject(uint32_t key, const glm::mat4& world);
+    // Geometry, size or color changed without a move; an object that no longer
+    // fits its batch's triangle cap moves to another batch in the cell
+    void updateObject(uint32_t key, const BatchObject& object);
+    void removeObject(uint32_t key);
+    void clear();
+
+    // Regenerates the vertex data of changed batches; returns how many were rebuilt
+    size_t rebuildDirty();
+    // One draw call per non-empty batch; uploads rebuilt batches first
+    void render() const;
+
+    bool contains(uint32_t key) const { return key < locations.size() && locations[key].batch != NO_BATCH; }
+    size_t getDrawCallCount() const;
+    Stats getStats() const;
+
+private:
+    struct Member {
+        uint32_t key;
+        BatchObject object;
+        glm::mat4 world;
+        size_t triangles;       // What the member added to its batch's count
+    };
+
+    struct Batch {
+        int64_t cell = 0;
+        std::vector<Member> members;
+        size_t triangleCount = 0;
+        std::vector<ProceduralVertex> vertices;
+        std::vector<uint32_t> indices;
+        bool dirty = false;
+        mutable bool uploaded = false;
+        mutable unsigned int vertexBuffer = 0;
+        mutable unsigned int indexBuffer = 0;
+    };
+
+    static const uint32_t NO_BATCH = 0xFFFFFFFFu;
+
+    struct Location {
+        uint32_t batch = NO_BATCH;
+        uint32_t member = 0;
+    };
+
+    float cellSize;
+    size_t maxTrianglesPerBatch;
+    std::vector<std::unique_ptr<Batch>> batches;
+    std::unordered_map<int64_t, std::vector<size_t>> cellBatches;
+    std::vector<Location> locations;    // By key, so batching an object allocates nothing of its own
+    size_t objectCount;
+    std::vector<size_t> dirtyBatches;
+    size_t lastRebuildCount;
+
+    int64_t cellKey(const glm::mat4& world) const;
+    void markBatchDirty(size_t batchIndex);
+    void rebuildBatch(Batch& batch);
+};
+
+} // namespace Editor
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Editor {
+
+struct WorldFileHeader {
+    char magic[4];              // "FPSK"
+    uint32_t version;
+    float chunkSize;
+    uint32_t chunkCount;
+    uint64_t tableOffset;       // chunkCount WorldChunkEntries
+};
+
+// The chunk covering [x, x + 1) * chunkSize on X and [z, z + 1) * chunkSize on Z
+struct WorldChunkEntry {
+    int32_t x;
+    int32_t z;
+    uint32_t objectCount;
+    uint32_t reserved;
+    uint64_t offset;            // Of the chunk's scene, 8-byte aligned
+    uint64_t size;
+};
+
+// A world cut into square chunks on the ground plane, for streaming. Each chunk
+// is a complete SceneFile of the objects standing in it, in world coordinates;
+// parents do not cross chunks.
+//
+// Layout: header, the chunk scenes, then the chunk table, so a writer can
+// stream chunks out without knowing how many follow. Opening reads the header
+// and table only.
+class WorldFile {
+public:
+    static const uint32_t FORMAT_VERSION = 1;
+
+    WorldFile();
+    ~WorldFile();
+    WorldFile(const WorldFile&) = delete;
+    WorldFile& operator=(const WorldFile&) = delete;
+
+    // Prints the error and returns false on failure
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return opened; }
+    float getChunkSize() const { return chunkSize; }
+    const std::vector<WorldChunkEntry>& getChunks() const { return chunks; }
+
+    // Reads one chunk's scene; safe from several threads at once
+    bool readChunk(size_t index, std::vector<uint8_t>& out) const;
+
+private:
+    std::string path;
+    int fd;                     // For positioned reads, where available
+    bool opened;
+    float chunkSize;
+    std::vector<WorldChunkEntry> chunks;
+};
+
+// Writes a WorldFile one chunk at a time
+class WorldFileWriter {
+public:
+    WorldFileWriter();
+    ~WorldFileWriter();
+    WorldFileWriter(const WorldFileWriter&) = delete;
+    WorldFileWriter& operator=(const WorldFileWriter&) = delete;
+
+    bool open(const std::string& path, float chunkSize);
+    // scene is a serialized SceneFile (see SceneFile::serialize)
+    void addChunk(int32_t x, int32_t z, uint32_t objectCount, const std::vector<uint8_t>& scene);
+    // Writes the chunk table and closes; prints the error and returns false if any write failed
+    bool finish();
+
+private:
+    std::string path;
+    std::FILE* file;
+    float chunkSize;
+    uint64_t offset;
+    std::vector<WorldChunkEntry> chunks;
+    bool failed;
+};
+
+struct TestWorldOptions {
+    int chunksPerSide = 16;         // Centered on the origin
+    float chunkSize = 64.0f;
+    size_t objectsPerChunk = 500;
+    uint32_t seed = 1;
+};
+
+// Writes a world of randomly placed walls, rectangles, houses, towers and
+// bridges, for trying out and measuring streaming
+bool generateTestWorld(const std::string& path, const TestWorldOptions& options);
+
+} // namespace Editor
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "editor.h"
+#include "world_file.h"
+
+namespace Editor {
+
+// Keeps the chunks of a WorldFile around a position loaded into a WorldEditor.
+// A background thread reads and checks chunk scenes; update(), on the editor's
+// thread once a frame, decides what should be resident and moves finished
+// chunks into the editor.
+//
+// Chunks start loading once the position comes within loadRadius of them,
+// nearest first with those ahead of the view preferred, and unload only past
+// unloadRadius, so walking along a chunk border does not thrash. A resident
+// chunk is costed at bytesPerObject per object; a load that would go over the
+// budget evicts resident chunks ranked below it, or else waits.
+//
+// Streamed objects go through WorldEditor::appendScene and removeObjects, which
+// clear the undo history. Edits to them last until their chunk unloads; they
+// are not written back, and the edit log is not meant to run alongside.
+class WorldStreamer {
+public:
+    struct Options {
+        float loadRadius = 96.0f;           // Distances are to the chunk's square on XZ
+        float unloadRadius = 160.0f;        // At least loadRadius
+        float viewWeight = 0.5f;            // A chunk behind ranks as if 1 + 2 * viewWeight times as far
+        size_t memoryBudget = 256 << 20;
+        size_t bytesPerObject = 1024;       // Store, transform, batch and pick data, as measured
+        size_t chunksPerUpdate = 2;         // Moved into the editor per update(), bounding the hitch
+    };
+
+    struct Stats {
+        size_t residentChunks = 0;
+        size_t residentObjects = 0;
+        size_t residentBytes = 0;           // Estimated, see bytesPerObject
+        size_t peakResidentBytes = 0;
+        size_t pendingChunks = 0;           // Queued, being read or waiting for update()
+        uint64_t chunksLoaded = 0;
+        uint64_t chunksUnloaded = 0;
+        uint64_t chunksEvicted = 0;         // Unloaded early to make room
+        uint64_t budgetStalls = 0;          // Updates that left a wanted chunk waiting for room
+        uint64_t readFailures = 0;
+        double lastLoadMs = 0.0;            // From request to resident
+        double averageLoadMs = 0.0;
+        double maxLoadMs = 0.0;
+        double lastReadMs = 0.0;            // Disk read and check, on the background thread
+        double lastInsertMs = 0.0;          // Adding a chunk's objects, on the editor's thread
+    };
+
+    WorldStreamer();
+    ~WorldStreamer();
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    // Starts streaming into the editor, which must outlive close(). Nothing
+    // loads before the first update(). Prints the error and returns false on failure.
+    bool open(const std::string& path, WorldEditor& editor);
+    bool open(const std::string& path, WorldEditor& editor, const Options& options);
+    // Stops the background thread and unloads every resident chunk
+    void close();
+    bool isOpen() const { return editor != nullptr; }
+
+    // On the editor's thread, with the position and view direction in world space
+    void update(const glm::vec3& position, const glm::vec3& viewDirection);
+    // Waits for the reads in flight and queued, then moves all of them into
+    // the editor, for tools and tests that need the world settled
+    void finishPending();
+
+    bool isResident(int32_t x, int32_t z) const;
+    float getChunkSize() const { return file.getChunkSize(); }
+    // Editor thread only
+    const Stats& getStats() const { return stats; }
+
+private:
+    enum class ChunkState : uint8_t {
+        UNLOADED,
+        LOADING,            // Queued, being read, or read and waiting for update()
+        RESIDENT
+    };
+
+    struct Chunk {
+        ChunkState state = ChunkState::UNLOADED;
+        float rank = 0.0f;                  // As of the last update(); lower goes first
+        size_t cost = 0;
+        bool requeued = false;              // Taken back from the queue this update(), still requested
+        std::vector<ObjectHandle> handles;  // While resident
+        std::chrono::steady_clock::time_point requested;
+    };
+
+    struct ReadChunk {
+        uint32_t chunk;
+        bool ok;
+        double readMs;
+        std::vector<uint8_t> scene;
+    };
+
+    WorldFile file;
+    WorldEditor* editor;
+    Options options;
+
+    // Editor thread state
+    std::vector<Chunk> chunks;                      // Parallel to the file's chunk table
+    std::unordered_map<int64_t, uint32_t> chunkAt;  // By packed coordinates
+    std::vector<uint32_t> residentChunks;
+    std::vector<ReadChunk> arrived;                 // Read, not yet in the editor
+    std::vector<uint32_t> untaken;                  // Scratch for update(), kept for its capacity
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> requests;
+    size_t committedBytes;                          // Resident and loading
+    glm::vec3 lastPosition;
+    Stats stats;
+    double totalLoadMs;
+
+    // Shared with the background thread
+    std::mutex mutex;
+    std::condition_variable wake;       // For the background thread
+    std::condition_variable idle;       // For finishPending()
+    std::vector<uint32_t> queue;        // Chunks to read, best last
+    std::vector<ReadChunk> finished;
+    bool reading;
+    bool stopping;
+    std::thread ioThread;
+
+    void ioLoop();
+    static int64_t packCoordinates(int32_t x, int32_t z);
+    float distanceTo(const WorldChunkEntry& entry, const glm::vec3& position) const;
+    float rankOf(const WorldChunkEntry& entry, const glm::vec3& position, const glm::vec2& view) const;
+    void collectArrived();
+    // Moves up to limit arrived chunks into the editor, dropping those no longer wanted
+    void integrateArrived(size_t limit);
+    void unloadChunk(uint32_t index);
+};
+
+} // namespace Editor
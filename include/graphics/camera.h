@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "frustum.h"
+#include "../core/ray.h"
+
+// Perspective camera that owns its matrices. Setters only mark what they affect
+// as stale (and only when the value really changes); the getters bring view,
+// projection, their product, the inverses and the frustum planes up to date on
+// first use, so every reader in a frame (rendering, culling, picking) shares one
+// update and nothing is read back from GL. Not thread safe; give each thread
+// its own camera.
+class Camera {
+public:
+    explicit Camera(float fovYDegrees = 90.0f, float aspect = 16.0f / 9.0f, float nearPlane = 0.1f, float farPlane = 100.0f);
+
+    void setPosition(const glm::vec3& position);
+    // Looking direction; need not be unit length. Up is always +y.
+    void setDirection(const glm::vec3& direction);
+    void setPerspective(float fovYDegrees, float aspect, float nearPlane, float farPlane);
+
+    const glm::vec3& getPosition() const { return position; }
+    const glm::vec3& getDirection() const { return direction; }
+    float getFovY() const { return fovYDegrees; }
+    float getAspect() const { return aspect; }
+    float getNearPlane() const { return nearPlane; }
+    float getFarPlane() const { return farPlane; }
+
+    const glm::mat4& getView() const;
+    const glm::mat4& getProjection() const;
+    const glm::mat4& getViewProjection() const;
+    const glm::mat4& getInverseView() const;
+    const glm::mat4& getInverseProjection() const;
+    const glm::mat4& getInverseViewProjection() const;
+    const Frustum& getFrustum() const;
+
+    // From the near to the far plane through window pixel (x, y), y down
+    Ray screenRay(double x, double y, float width, float height) const;
+
+    // Matrix updates so far; for tests and stats
+    uint64_t getUpdateCount() const { return updateCount; }
+
+private:
+    glm::vec3 position;
+    glm::vec3 direction;
+    float fovYDegrees;
+    float aspect;
+    float nearPlane;
+    float farPlane;
+
+    mutable bool viewDirty;
+    mutable bool projectionDirty;
+    mutable bool combinedDirty;
+    mutable glm::mat4 view;
+    mutable glm::mat4 projection;
+    mutable glm::mat4 viewProjection;
+    mutable glm::mat4 inverseView;
+    mutable glm::mat4 inverseProjection;
+    mutable glm::mat4 inverseViewProjection;
+    mutable Frustum frustum;
+    mutable uint64_t updateCount;
+
+    void update() const;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include "../core/aabb.h"
+
+// View frustum as six planes (xyz = inward normal, w = distance), extracted from a
+// view-projection matrix. Plane order: left, right, bottom, top, near, far.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    // Conservative: boxes near a corner may pass even if they are just outside
+    bool intersects(const AABB& box) const;
+    bool contains(const glm::vec3& point) const;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+#include "mesh_arena.h"
+#include "frustum.h"
+
+// Layout fixed by glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "indirect command must be tightly packed");
+
+// Per-draw data, read as instanced attributes through baseInstance
+struct DrawInstanceData {
+    glm::mat4 model;
+    glm::vec4 color;
+};
+
+// One object to draw: which arena mesh, which material, where and in what color
+struct IndirectDrawItem {
+    MeshRange mesh;
+    uint32_t material;
+    glm::mat4 model;
+    glm::vec4 color;
+};
+
+// Commands are grouped by material; each group is one multi-draw
+struct MaterialDrawRange {
+    uint32_t material;
+    uint32_t firstCommand;
+    uint32_t commandCount;
+};
+
+struct IndirectDrawList {
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<DrawInstanceData> instances;
+    std::vector<MaterialDrawRange> materials;
+    size_t visibleItems = 0;
+    size_t culledItems = 0;
+
+    void clear();
+};
+
+namespace IndirectDraw {
+    // CPU pass: frustum-culls the items, sorts survivors by material and mesh, and
+    // writes one command per run of the same mesh (instanceCount = run length).
+    // No GL calls, so it can run on any thread.
+    void buildDrawList(const std::vector<IndirectDrawItem>& items, const Frustum& frustum, IndirectDrawList& out);
+}
+
+// Issues an IndirectDrawList from a MeshArena: one glMultiDrawElementsIndirect per
+// material. Needs OpenGL 4.3.
+class IndirectRenderer {
+public:
+    IndirectRenderer();
+    ~IndirectRenderer();
+
+    IndirectRenderer(const IndirectRenderer&) = delete;
+    IndirectRenderer& operator=(const IndirectRenderer&) = delete;
+
+    // Compiles the shader and creates the VAO; prints the error and returns false on failure
+    bool initialize();
+    bool isInitialized() const { return program != 0; }
+
+    // bindMaterial, if given, is called before each material's multi-draw
+    void submit(MeshArena& arena, const IndirectDrawList& list, const glm::mat4& viewProjection,
+                const std::function<void(uint32_t)>& bindMaterial = nullptr);
+
+    size_t getLastMultiDrawCount() const { return lastMultiDrawCount; }
+
+private:
+    unsigned int program;
+    unsigned int vertexArray;
+    unsigned int instanceBuffer;
+    unsigned int commandBuffer;
+    unsigned int boundVertexBuffer;
+    int viewProjectionLocation;
+    size_t lastMultiDrawCount;
+
+    void bindArena(const MeshArena& arena);
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../core/aabb.h"
+
+// Vertex format shared by every mesh in an arena. tint = 1 marks vertices whose
+// color is replaced by the per-draw color (object bodies).
+struct ArenaVertex {
+    glm::vec3 position;
+    glm::vec3 color;
+    float tint;
+};
+
+// Where one mesh lives inside the arena, in the terms of DrawElementsIndirectCommand
+struct MeshRange {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    int32_t baseVertex = 0;
+    AABB bounds;
+};
+
+// Append-only vertex and index storage for many meshes, so they can all be drawn
+// from one VAO. CPU copies are kept; upload() sends whatever was added since the
+// last call.
+class MeshArena {
+public:
+    MeshArena();
+    ~MeshArena();
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    MeshRange add(const std::vector<ArenaVertex>& vertices, const std::vector<uint32_t>& indices);
+    void clear();
+
+    const std::vector<ArenaVertex>& getVertices() const { return vertices; }
+    const std::vector<uint32_t>& getIndices() const { return indices; }
+    bool needsUpload() const { return uploadedVertices != vertices.size() || uploadedIndices != indices.size(); }
+
+    // Needs a current GL context. Buffers grow geometrically and keep their names.
+    void upload();
+    unsigned int getVertexBuffer() const { return vertexBuffer; }
+    unsigned int getIndexBuffer() const { return indexBuffer; }
+
+private:
+    std::vector<ArenaVertex> vertices;
+    std::vector<uint32_t> indices;
+
+    unsigned int vertexBuffer;
+    unsigned int indexBuffer;
+    size_t vertexCapacity;
+    size_t indexCapacity;
+    size_t uploadedVertices;
+    size_t uploadedIndices;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "models.h"
+
+class ThreadPool;
+
+namespace MeshProcessing {
+    // Default smoothing threshold for generated normals: faces meeting at a sharper
+    // angle keep a hard edge
+    const float DEFAULT_CREASE_ANGLE = 60.0f;
+
+    // Replaces the normals of an indexed triangle mesh with angle-weighted smooth normals.
+    // Corners whose faces differ by more than creaseAngleDegrees are not averaged together,
+    // so vertices on hard edges get split; vertices and indices are rewritten in place.
+    void generateNormals(std::vector<Vertex>& vertices,
+                         std::vector<uint32_t>& indices,
+                         float creaseAngleDegrees = DEFAULT_CREASE_ANGLE,
+                         ThreadPool* pool = nullptr);
+
+    // Fills Vertex::tangent (xyz = tangent, w = bitangent sign) following the MikkTSpace
+    // recipe: per-corner UV tangents projected onto the normal plane, angle-weighted and
+    // orthonormalized against the vertex normal. Requires valid normals.
+    void generateTangents(std::vector<Vertex>& vertices,
+                          const std::vector<uint32_t>& indices,
+                          ThreadPool* pool = nullptr);
+}
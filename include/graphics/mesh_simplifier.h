@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "models.h"
+
+class ThreadPool;
+
+namespace MeshSimplifier {
+    struct SimplifiedMesh {
+        std::vector<uint32_t> indices;  // References the unchanged source vertex array
+        float error = 0.0f;             // Estimated max deviation from the source, object units
+    };
+
+    // Quadric-error edge collapse down to about targetIndexCount indices. Collapses always
+    // land on an existing vertex, so the result reuses the source vertices. Mesh borders
+    // only collapse along themselves and vertices on UV/normal seams are kept in place.
+    SimplifiedMesh simplify(const std::vector<Vertex>& vertices,
+                            const std::vector<uint32_t>& indices,
+                            size_t targetIndexCount);
+
+    // One simplify() per ratio (fraction of source triangles), run across the pool.
+    // Results are ordered from finest to coarsest with non-decreasing error.
+    std::vector<SimplifiedMesh> buildLodChain(const std::vector<Vertex>& vertices,
+                                              const std::vector<uint32_t>& indices,
+                                              const std::vector<float>& ratios,
+                                              ThreadPool* pool = nullptr);
+
+    // Picks the coarsest LOD whose error, projected to the screen, stays under
+    // pixelThreshold. projectionScale = viewportHeight / (2 * tan(fovY / 2)).
+    size_t selectLod(const std::vector<MeshLod>& lods, float distance,
+                     float projectionScale, float pixelThreshold);
+}
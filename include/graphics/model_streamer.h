@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include "models.h"
+#include "../core/mpsc_queue.h"
+#include "../core/thread_pool.h"
+
+// Receives the GPU side of a streamed model. The default implementation forwards to
+// Model's incremental upload; tests substitute a recorder so no GL context is needed.
+class ModelUploader {
+public:
+    virtual ~ModelUploader() = default;
+
+    virtual bool begin(Model& model) = 0;
+    virtual void uploadVertices(Model& model, size_t byteOffset, size_t byteCount) = 0;
+    virtual void uploadIndices(Model& model, size_t byteOffset, size_t byteCount) = 0;
+    virtual void finish(Model& model) = 0;
+};
+
+class GLModelUploader : public ModelUploader {
+public:
+    bool begin(Model& model) override { return model.beginUpload(); }
+    void uploadVertices(Model& model, size_t byteOffset, size_t byteCount) override {
+        model.uploadVertexRange(byteOffset, byteCount);
+    }
+    void uploadIndices(Model& model, size_t byteOffset, size_t byteCount) override {
+        model.uploadIndexRange(byteOffset, byteCount);
+    }
+    void finish(Model& model) override { model.finishUpload(); }
+};
+
+struct ModelStreamerStats {
+    size_t requestsCompleted = 0;
+    size_t requestsFailed = 0;
+    size_t totalBytesUploaded = 0;
+    size_t lastFrameBytes = 0;
+    double lastFrameMs = 0.0;   // Main-thread time spent in the last update()
+    double maxFrameMs = 0.0;    // Worst update() seen so far (the streaming hitch)
+};
+
+// Loads models in the background: OBJ parsing and processing run on the thread pool,
+// finished meshes come back through a lock-free queue, and update() (main thread, once
+// per frame) uploads them with at most uploadBudget bytes per call.
+class ModelStreamer {
+public:
+    using ModelPtr = std::shared_ptr<Model>;
+    using ReadyCallback = std::function<void(const ModelPtr&)>;
+
+    static const size_t DEFAULT_UPLOAD_BUDGET = 2 * 1024 * 1024;  // Bytes per frame
+
+    explicit ModelStreamer(ThreadPool& pool,
+                           size_t uploadBudgetBytes = DEFAULT_UPLOAD_BUDGET,
+                           std::unique_ptr<ModelUploader> uploader = nullptr);
+    ~ModelStreamer();
+
+    ModelStreamer(const ModelStreamer&) = delete;
+    ModelStreamer& operator=(const ModelStreamer&) = delete;
+
+    // The future resolves (and onReady runs, on the thread calling update) once the model is
+    // drawable; both receive nullptr if loading failed.
+    std::shared_future<ModelPtr> requestLoad(const std::string& objFilename,
+                                             const std::string& mtlBasePath,
+                                             ReadyCallback onReady = nullptr);
+
+    // Returns the number of bytes uploaded during this call
+    size_t update();
+
+    void setUploadBudget(size_t bytes) { uploadBudget = bytes > 0 ? bytes : 1; }
+    size_t getUploadBudget() const { return uploadBudget; }
+    size_t getPendingCount() const { return pendingRequests.load(std::memory_order_relaxed); }
+    const ModelStreamerStats& getStats() const { return stats; }
+
+private:
+    struct Request {
+        std::string objFilename;
+        std::string mtlBasePath;
+        ModelPtr model;
+        std::promise<ModelPtr> promise;
+        ReadyCallback onReady;
+        bool parsed = false;
+        bool uploadStarted = false;
+        size_t vertexBytesUploaded = 0;
+        size_t indexBytesUploaded = 0;
+    };
+
+    ThreadPool& pool;
+    std::unique_ptr<ModelUploader> uploader;
+    size_t uploadBudget;
+
+    MPSCQueue<Request*> parsedRequests;              // Filled by workers, drained by update()
+    std::deque<std::unique_ptr<Request>> uploadQueue; // Main thread only
+    std::atomic<size_t> pendingRequests;
+    std::atomic<size_t> parsesInFlight;
+    ModelStreamerStats stats;
+
+    void complete(Request& request, bool success);
+};
@@ -5,14 +5,24 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include <GL/glew.h> // Make sure to include GLEW (or your OpenGL loader)
-#define TINYOBJLOADER_IMPLEMENTATION
-#include "tiny_obj_loader.h"
+#include "tiny_obj_loader.h"  // Implementation lives in src/third_party/tiny_obj_loader_impl.cpp
 
 
+class ThreadPool;
+
 struct Vertex {
     glm::vec3 position;
     glm::vec3 normal;
     glm::vec2 texCoord;
+    glm::vec4 tangent;  // xyz = tangent, w = bitangent sign
+};
+
+// One level of detail: a range of the model's index buffer over the shared vertices
+struct MeshLod {
+    size_t indexOffset;
+    size_t indexCount;
+    float ratio;   // Fraction of the full-detail triangle count
+    float error;   // Max deviation from the full-detail mesh, object units
 };
 
 class Model {
@@ -20,7 +30,37 @@ public:
     Model();
     ~Model();
     bool loadFromFile(const std::string& objFilename, const std::string& mtlBasePath);
+    // CPU half of loadFromFile (parse + process, no GL calls), safe to run on a worker thread
+    bool loadMeshData(const std::string& objFilename, const std::string& mtlBasePath);
     void draw(GLuint shaderProgram) const;
+    void drawLod(GLuint shaderProgram, size_t level) const;
+
+    // Incremental GPU upload used by ModelStreamer; main thread only.
+    // beginUpload allocates the buffers, the ranges fill them, finishUpload marks the model drawable.
+    bool beginUpload();
+    void uploadVertexRange(size_t byteOffset, size_t byteCount);
+    void uploadIndexRange(size_t byteOffset, size_t byteCount);
+    void finishUpload();
+
+    const std::vector<Vertex>& getVertices() const { return vertices; }
+    const std::vector<uint32_t>& getIndices() const { return indices; }
+    size_t getVertexDataSize() const { return vertices.size() * sizeof(Vertex); }
+    size_t getIndexDataSize() const { return indices.size() * sizeof(uint32_t); }
+    bool isLoaded() const { return isInitialized; }
+
+    // Smoothing threshold used when the OBJ has no normals and they are generated
+    void setNormalCreaseAngle(float degrees) { normalCreaseAngle = degrees; }
+    float getNormalCreaseAngle() const { return normalCreaseAngle; }
+    // Optional pool for normal/tangent generation; nullptr processes on the calling thread
+    void setProcessingPool(ThreadPool* pool) { processingPool = pool; }
+
+    // Level-of-detail chain. Level 0 is always the full mesh; the simplified levels are
+    // appended to the index buffer, so build them before uploading. Ratios set through
+    // setLodRatios are built by loadMeshData (i.e. on the loader's worker thread).
+    void setLodRatios(const std::vector<float>& ratios) { lodRatios = ratios; }
+    bool generateLods(const std::vector<float>& ratios);
+    const std::vector<MeshLod>& getLods() const { return lods; }
+    size_t selectLod(float distance, float projectionScale, float pixelThreshold) const;
     // Other methods...
 
 private:
@@ -29,6 +69,10 @@ private:
     glm::mat4 modelMatrix;  // This should be a member variable
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
+    std::vector<MeshLod> lods;
+    std::vector<float> lodRatios;
+    float normalCreaseAngle;
+    ThreadPool* processingPool;
 
     bool processModelData(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::shape_t>& shapes);
     bool setupBuffers();
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../core/frame_snapshot.h"
+#include "../editor/static_batcher.h"
+#include "indirect_renderer.h"
+#include "camera.h"
+
+// Render-thread side of the editor objects: draws the objects of a FrameSnapshot
+// with the indirect path when GL 4.3 is there, from static batches otherwise.
+// Every GL object it draws from (arena, indirect buffers, batches) is its own;
+// the meshes it caches hold none, so the other threads may drop them at any time.
+class SnapshotRenderer {
+public:
+    SnapshotRenderer();
+
+    SnapshotRenderer(const SnapshotRenderer&) = delete;
+    SnapshotRenderer& operator=(const SnapshotRenderer&) = delete;
+
+    // Needs a current GL context; culls against the camera's frustum. The
+    // fallback path draws through the fixed-function stacks as they are.
+    void render(const FrameSnapshot& snapshot, const Camera& camera);
+
+    // CPU halves of the two paths, which render() follows with its GL calls.
+    // buildDrawList adds new meshes to the arena, culls and fills the command
+    // list; updateStaticBatches brings the batches up to date with the objects
+    // (by SnapshotObject::key) and returns how many it rebuilt.
+    const IndirectDrawList& buildDrawList(const FrameSnapshot& snapshot, const Frustum& frustum);
+    size_t updateStaticBatches(const FrameSnapshot& snapshot);
+
+    size_t getCachedMeshCount() const { return meshes.size(); }
+    const MeshArena& getMeshArena() const { return arena; }
+    const Editor::StaticBatcher& getStaticBatcher() const { return batcher; }
+
+private:
+    struct CachedMesh {
+        std::shared_ptr<const Editor::ProceduralMesh> mesh;
+        MeshRange range;
+        uint64_t lastFrame;     // Last frame whose snapshot used the mesh
+    };
+
+    // What an object was batched with, to tell which ones changed
+    struct BatchedObject {
+        const Editor::ProceduralMesh* mesh = nullptr;
+        glm::mat4 model;
+        glm::vec4 color;
+        uint64_t lastFrame = 0;
+    };
+
+    MeshArena arena;
+    std::unordered_map<const Editor::ProceduralMesh*, CachedMesh> meshes;
+    std::vector<const MeshRange*> snapshotRanges;
+    std::vector<IndirectDrawItem> items;
+    IndirectDrawList drawList;
+    IndirectRenderer indirectRenderer;
+    bool indirectUnavailable;
+    Editor::StaticBatcher batcher;
+    std::vector<BatchedObject> batched;     // By key
+    uint64_t frame;
+
+    const MeshRange& rangeFor(const std::shared_ptr<const Editor::ProceduralMesh>& mesh);
+    void releaseUnusedMeshes();
+};
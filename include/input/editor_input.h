@@ -2,8 +2,15 @@
 
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
+#include <string>
 #include "../editor/editor.h"
 
+struct FrameSnapshot;
+
+namespace Editor {
+    class EditLog;
+}
+
 namespace EditorInput {
     extern bool isEditorMode;
     extern bool isPlacingObject;
@@ -12,10 +19,19 @@ namespace EditorInput {
     extern glm::vec3 placementEnd;
     extern Editor::WorldEditor worldEditor;
     extern GLFWwindow* window;
+    // Where Ctrl+S saves the world; empty disables saving
+    extern std::string scenePath;
+    // The log kept next to scenePath, when open; saves then go through it
+    extern Editor::EditLog* editLog;
 
     void initialize(GLFWwindow* window);
     void update(float deltaTime);
     void handleKeyPress(GLFWwindow* window, int key, int scancode, int action, int mods);
     void handleMouseClick(GLFWwindow* window, int button, int action, int mods);
     void handleMouseMove(GLFWwindow* window, double xpos, double ypos);
+
+    // Key state for update(); key_callback reports every key event here first
+    void recordKey(int key, int action);
+    // Fills the editor and camera-independent UI parts of a render snapshot
+    void captureSnapshot(FrameSnapshot& out);
 } 
\ No newline at end of file
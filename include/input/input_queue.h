@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "input_recording.h"
+#include "../core/spsc_queue.h"
+
+// Window input on its way from the GLFW callbacks to the simulation tick that
+// applies it. Callbacks only copy a small event into a lock-free SPSC ring; the
+// simulation drains the ring once per tick and merges each run of cursor moves
+// into its last position, so the camera maths runs once per tick however fast
+// the mouse reports. Safe with producer and consumer on different threads.
+class InputQueue {
+public:
+    static const size_t CAPACITY = 1 << 14;
+    // Slots that only key and button events may fill. Cursor events carry
+    // absolute positions, so dropping one in a flood loses nothing but the
+    // path in between; a dropped key release would leave the key held.
+    static const size_t CURSOR_HEADROOM = 256;
+
+    struct Stats {
+        uint64_t pushed = 0;
+        uint64_t applied = 0;
+        uint64_t coalesced = 0;     // Cursor moves merged into a later one
+        uint64_t dropped = 0;       // Refused because the ring was full
+    };
+
+    using ApplyFunction = std::function<void(const InputEvent&)>;
+
+    InputQueue();
+
+    // Producer side; stamps timeNs unless the caller already did. False if the
+    // event was dropped.
+    bool push(InputEvent event);
+
+    // Consumer side: applies everything queued, in order, with cursor runs
+    // merged. Returns the number of events applied.
+    size_t drain(const ApplyFunction& apply);
+
+    // Any thread
+    Stats getStats() const;
+
+private:
+    SPSCQueue<InputEvent> events;
+    std::atomic<uint64_t> pushed;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> applied;
+    std::atomic<uint64_t> coalesced;
+};
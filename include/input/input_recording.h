@@ -0,0 +1,95 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class InputEventType : uint8_t {
+    KEY = 1,
+    CURSOR = 2,
+    MOUSE_BUTTON = 3,
+    INVENTORY_SELECT = 4    // Inventory pick made in the ImGui window
+};
+
+// One window callback, stamped with the simulation tick it was applied before
+struct InputEvent {
+    uint64_t tick = 0;
+    int64_t timeNs = 0;     // When the window reported it (FrameLimiter clock); not recorded
+    InputEventType type = InputEventType::KEY;
+    int32_t code = 0;       // Key, mouse button or inventory index
+    int32_t scancode = 0;
+    int32_t action = 0;
+    int32_t mods = 0;
+    double x = 0.0;         // Cursor position
+    double y = 0.0;
+
+    static InputEvent key(int key, int scancode, int action, int mods);
+    static InputEvent cursor(double x, double y);
+    static InputEvent mouseButton(int button, int action, int mods);
+    static InputEvent inventorySelect(size_t index);
+
+    // Compares what a recording keeps
+    bool operator==(const InputEvent& other) const;
+};
+
+// Feeds an event into the same handlers the GLFW callbacks use. window may be
+// null (headless replay).
+void applyInputEvent(GLFWwindow* window, const InputEvent& event);
+
+// Input log for reproducible runs. Replaying it at the recorded tick rate,
+// one fixed step per tick, reproduces the run bit for bit.
+//
+// File layout, little-endian: "FPSI", u32 version, f32 tick rate, u64 ticks,
+// u64 event count, then per event a LEB128 tick delta, a type byte and the
+// payload (key codes as zigzag LEB128, cursor positions as raw doubles).
+// A key event takes 6 to 8 bytes, a cursor move 18.
+class InputRecording {
+public:
+    static const uint32_t FORMAT_VERSION = 1;
+
+    explicit InputRecording(float tickRate = 0.0f);
+
+    // Events must arrive in tick order
+    void append(const InputEvent& event);
+    void clear();
+
+    float getTickRate() const { return tickRate; }
+    void setTickRate(float rate) { tickRate = rate; }
+    // Ticks the recording covers; replay runs this long even after the last event
+    uint64_t getTickCount() const { return tickCount; }
+    void setTickCount(uint64_t ticks) { tickCount = ticks; }
+    const std::vector<InputEvent>& getEvents() const { return events; }
+
+    std::vector<uint8_t> serialize() const;
+    // False (and unchanged) on malformed data
+    bool deserialize(const uint8_t* data, size_t size);
+
+    // Print the error and return false on failure
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    float tickRate;
+    uint64_t tickCount;
+    std::vector<InputEvent> events;
+};
+
+// Walks a recording tick by tick
+class InputReplayer {
+public:
+    using ApplyFunction = std::function<void(const InputEvent&)>;
+
+    explicit InputReplayer(const InputRecording& recording);
+
+    // Applies every event recorded for tick, in recorded order. Ticks must be
+    // visited in increasing order.
+    void replayTick(uint64_t tick, const ApplyFunction& apply);
+    bool isFinished(uint64_t tick) const { return tick >= recording.getTickCount(); }
+
+private:
+    const InputRecording& recording;
+    size_t nextEvent;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "input_recording.h"
+#include "../core/frame_snapshot.h"
+#include "../core/frame_stats.h"
+
+// Mouse look from the freshest cursor position, for the render side. The
+// simulation applies cursor moves once per tick, so the snapshot being drawn
+// can trail the mouse by a tick or more. The cursor callback also hands each
+// position to the latch, and right before the view is submitted the snapshot's
+// yaw and pitch are turned by whatever the cursor did since the simulation last
+// read it. The next tick applies the same moves with the same maths, so the
+// view never snaps back. Main thread only.
+class LateLatch {
+public:
+    struct View {
+        glm::vec3 front;
+        int64_t inputTimeNs;    // Newest input the view reflects; 0 if none
+        bool latched;           // Turned by input newer than the snapshot
+    };
+
+    LateLatch();
+
+    // Off, aim() returns the snapshot's own view
+    void setEnabled(bool enable) { enabled = enable; }
+    bool isEnabled() const { return enabled; }
+
+    // From the cursor callback; the event must carry its timestamp
+    void onCursor(const InputEvent& event);
+
+    View aim(const FrameSnapshot& snapshot) const;
+
+private:
+    bool enabled;
+    glm::dvec2 cursor;
+    int64_t cursorTimeNs;
+};
+
+// Input-to-submit latency: for every frame that shows newer input than the one
+// before it, how old that input was when the frame was submitted
+class InputLatencyTracker {
+public:
+    explicit InputLatencyTracker(size_t windowFrames);
+
+    void onSubmit(int64_t inputTimeNs, int64_t submitNs);
+    void reset();
+
+    // Latencies in place of frame times
+    const FrameTimeStats& getStats() const { return stats; }
+
+private:
+    FrameTimeStats stats;
+    int64_t lastInputNs;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
 
 // Function declarations
 void handleCameraKeys(GLFWwindow* window, int key, int action);
@@ -8,4 +9,8 @@ void updateCamera(float xpos, float ypos);
 void updateCameraDirection();
 void handleCameraMouseMovement(double xpos, double ypos);
 
-
+// Turns yaw and pitch (degrees) by a cursor move of (xoffset, yoffset) pixels,
+// y pointing up; pitch stays within +-89
+void applyMouseLook(float& yaw, float& pitch, double xoffset, double yoffset);
+// Unit view direction for yaw and pitch in degrees
+glm::vec3 cameraDirection(float yaw, float pitch);
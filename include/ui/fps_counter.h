@@ -1,13 +1,22 @@
 #pragma once
 
 #include <string>
-#include <chrono>
-#include <deque>
-#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include "../core/frame_stats.h"
 
 class FPSCounter {
 public:
-    FPSCounter();
+    // Monotonic time in nanoseconds; tests inject a fake one
+    using ClockFunction = std::function<int64_t()>;
+
+    static const size_t SAMPLE_SIZE = 60;                 // Frames behind current/avg/min/max
+    static const size_t PERCENTILE_WINDOW_SIZE = 1200;    // Frames behind percentiles and 1% lows
+
+    explicit FPSCounter(ClockFunction clock = ClockFunction(),
+                        size_t windowFrames = SAMPLE_SIZE,
+                        size_t percentileWindowFrames = PERCENTILE_WINDOW_SIZE);
+    // Call once per frame; the first call only starts the clock
     void update();
     void render();
     float getCurrentFPS() const;
@@ -15,16 +24,18 @@ public:
     float getMinFPS() const;
     float getMaxFPS() const;
 
+    // Frame times say more than rates: a 50 ms hitch barely moves an FPS average
+    const FrameTimeStats& getRecentStats() const { return recent; }
+    const FrameTimeStats& getPercentileStats() const { return longTerm; }
+
 private:
-    static const int SAMPLE_SIZE = 60;  // Number of frames to average
-    std::deque<float> fpsHistory;
-    float currentFPS;
-    float averageFPS;
-    float minFPS;
-    float maxFPS;
-    std::chrono::high_resolution_clock::time_point lastFrameTime;
-    
-    void updateStats();
+    ClockFunction clock;
+    int64_t lastFrameTime;
+    bool started;
+    FrameTimeStats recent;
+    FrameTimeStats longTerm;
+
+    static float toFPS(double frameMs) { return frameMs > 0.0 ? static_cast<float>(1000.0 / frameMs) : 0.0f; }
     void renderBackground();
     void renderText(const std::string& text, float x, float y);
-}; 
\ No newline at end of file
+};
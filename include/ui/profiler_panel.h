@@ -0,0 +1,6 @@
+#pragma once
+
+namespace UI {
+    // Per-thread timeline of the last frame, with trace export
+    void renderProfilerWindow();
+}
@@ -0,0 +1,86 @@
+#include "../../include/core/bvh.h"
+#include <algorithm>
+
+const uint32_t BVH::NO_ITEM;
+const uint32_t BVH::MAX_LEAF_ITEMS;
+
+void BVH::build(const std::vector<AABB>& boxes) {
+    clear();
+    // Sorted in place while splitting; contiguous, so each level is one linear pass
+    std::vector<BuildEntry> entries;
+    entries.reserve(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (boxes[i].isEmpty()) continue;
+        entries.push_back(BuildEntry{ boxes[i], boxes[i].center(), static_cast<uint32_t>(i) });
+    }
+    if (entries.empty()) return;
+
+    // Split leaves keep at least two items, so there are no more nodes than items
+    nodes.reserve(entries.size());
+    nodes.push_back(Node());
+    buildNode(0, entries, 0, static_cast<uint32_t>(entries.size()));
+
+    items.reserve(entries.size());
+    itemBoxes.reserve(entries.size());
+    for (const BuildEntry& entry : entries) {
+        items.push_back(entry.item);
+        itemBoxes.push_back(entry.box);
+    }
+}
+
+void BVH::refit(const std::vector<AABB>& boxes) {
+    for (size_t i = 0; i < items.size(); ++i) {
+        itemBoxes[i] = boxes[items[i]];
+    }
+    // Children always come after their parent, so walking backwards sees them first
+    for (size_t i = nodes.size(); i-- > 0;) {
+        Node& node = nodes[i];
+        AABB bounds;
+        if (node.count > 0) {
+            for (uint32_t item = node.first; item < node.first + node.count; ++item) {
+                bounds.expand(itemBoxes[item]);
+            }
+        } else {
+            bounds = nodes[node.first].bounds;
+            bounds.expand(nodes[node.first + 1].bounds);
+        }
+        node.bounds = bounds;
+    }
+}
+
+void BVH::clear() {
+    nodes.clear();
+    items.clear();
+    itemBoxes.clear();
+}
+
+void BVH::buildNode(uint32_t nodeIndex, std::vector<BuildEntry>& entries, uint32_t begin, uint32_t end) {
+    AABB bounds;
+    AABB centroidBounds;
+    for (uint32_t i = begin; i < end; ++i) {
+        bounds.expand(entries[i].box);
+        centroidBounds.expand(entries[i].centroid);
+    }
+    nodes[nodeIndex].bounds = bounds;
+
+    glm::vec3 spread = centroidBounds.max - centroidBounds.min;
+    // Stacked items cannot be told apart by position; keep them in one leaf
+    if (end - begin <= MAX_LEAF_ITEMS || (spread.x <= 0.0f && spread.y <= 0.0f && spread.z <= 0.0f)) {
+        nodes[nodeIndex].first = begin;
+        nodes[nodeIndex].count = end - begin;
+        return;
+    }
+
+    int axis = spread.x >= spread.y && spread.x >= spread.z ? 0 : (spread.y >= spread.z ? 1 : 2);
+    uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(entries.begin() + begin, entries.begin() + middle, entries.begin() + end,
+                     [axis](const BuildEntry& a, const BuildEntry& b) { return a.centroid[axis] < b.centroid[axis]; });
+
+    uint32_t left = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node());
+    nodes.push_back(Node());
+    nodes[nodeIndex].first = left;
+    nodes[nodeIndex].count = 0;
+    buildNode(left, entries, begin, middle);
+    buildNode(left + 1, entries, middle, end);
+}
@@ -0,0 +1,35 @@
+#include "../../include/core/fixed_timestep.h"
+#include <algorithm>
+
+FixedTimestep::FixedTimestep(float tickRate, int maxTicksPerAdvance)
+    : tickSeconds(1.0 / tickRate)
+    , maxTicksPerAdvance(std::max(maxTicksPerAdvance, 1))
+    , accumulator(0.0)
+    , simulatedSeconds(0.0) {}
+
+void FixedTimestep::setTickRate(float tickRate) {
+    tickSeconds = 1.0 / tickRate;
+    accumulator = std::min(accumulator, tickSeconds);
+}
+
+int FixedTimestep::advance(double elapsedSeconds) {
+    accumulator += std::max(elapsedSeconds, 0.0);
+
+    int ticks = 0;
+    while (accumulator >= tickSeconds && ticks < maxTicksPerAdvance) {
+        accumulator -= tickSeconds;
+        ++ticks;
+    }
+    // Too far behind to catch up: let the simulation run slow rather than spiral
+    if (accumulator >= tickSeconds) {
+        accumulator = 0.0;
+    }
+
+    simulatedSeconds += ticks * tickSeconds;
+    return ticks;
+}
+
+void FixedTimestep::reset() {
+    accumulator = 0.0;
+    simulatedSeconds = 0.0;
+}
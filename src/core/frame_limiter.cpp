@@ -0,0 +1,103 @@
+#include "../../include/core/frame_limiter.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <time.h>
+
+namespace {
+    const int64_t NANOS_PER_SECOND = 1000000000;
+    // Spin window bounds and its margin over the average wake-up latency
+    const int64_t MIN_SPIN_WINDOW_NS = 50000;
+    const int64_t MAX_SPIN_WINDOW_NS = 2000000;
+    const double WAKE_LATENCY_MARGIN = 2.0;
+    const double WAKE_LATENCY_SMOOTHING = 0.1;
+}
+
+FrameLimiter::FrameLimiter(double targetFps, ClockFunction clock, SleepFunction sleep)
+    : clock(clock ? std::move(clock) : ClockFunction(nowNanoseconds))
+    , sleep(sleep ? std::move(sleep) : SleepFunction(sleepUntil))
+    , periodNs(0)
+    , nextDeadlineNs(0)
+    , lastFrameNs(0)
+    , spinWindowNs(500000)
+    , averageWakeLatencyNs(static_cast<double>(spinWindowNs) / WAKE_LATENCY_MARGIN) {
+    setTargetFps(targetFps);
+}
+
+void FrameLimiter::setTargetFps(double targetFps) {
+    periodNs = targetFps > 0.0 ? static_cast<int64_t>(NANOS_PER_SECOND / targetFps) : 0;
+    reset();
+}
+
+double FrameLimiter::getTargetFps() const {
+    return periodNs > 0 ? static_cast<double>(NANOS_PER_SECOND) / periodNs : 0.0;
+}
+
+void FrameLimiter::reset() {
+    nextDeadlineNs = 0;
+    lastFrameNs = 0;
+}
+
+int64_t FrameLimiter::nowNanoseconds() {
+#if defined(__linux__)
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * NANOS_PER_SECOND + now.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+int64_t FrameLimiter::sleepUntil(int64_t deadlineNs, int64_t spinWindowNs) {
+    int64_t wakeLatencyNs = 0;
+    int64_t sleepTargetNs = deadlineNs - spinWindowNs;
+    if (sleepTargetNs > nowNanoseconds()) {
+#if defined(__linux__)
+        timespec target;
+        target.tv_sec = static_cast<time_t>(sleepTargetNs / NANOS_PER_SECOND);
+        target.tv_nsec = static_cast<long>(sleepTargetNs % NANOS_PER_SECOND);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {}
+#else
+        std::this_thread::sleep_for(std::chrono::nanoseconds(sleepTargetNs - nowNanoseconds()));
+#endif
+        wakeLatencyNs = nowNanoseconds() - sleepTargetNs;
+    }
+
+    while (nowNanoseconds() < deadlineNs) {
+        // Busy wait for the last stretch; the OS cannot wake us this precisely
+    }
+    return wakeLatencyNs;
+}
+
+double FrameLimiter::wait(int64_t leadNs) {
+    int64_t now = clock();
+    if (nextDeadlineNs == 0) {
+        nextDeadlineNs = now + periodNs;
+        lastFrameNs = now;
+    }
+
+    if (periodNs > 0) {
+        leadNs = std::min(std::max(leadNs, static_cast<int64_t>(0)), periodNs);
+        int64_t wakeLatencyNs = sleep(nextDeadlineNs - leadNs, spinWindowNs);
+        if (wakeLatencyNs > 0) {
+            averageWakeLatencyNs += (wakeLatencyNs - averageWakeLatencyNs) * WAKE_LATENCY_SMOOTHING;
+            spinWindowNs = std::min(std::max(static_cast<int64_t>(averageWakeLatencyNs * WAKE_LATENCY_MARGIN),
+                                             MIN_SPIN_WINDOW_NS), MAX_SPIN_WINDOW_NS);
+        }
+    }
+
+    now = clock();
+    double frameSeconds = static_cast<double>(now - lastFrameNs) / NANOS_PER_SECOND;
+    lastFrameNs = now;
+
+    // Keep the fixed schedule, unless we have fallen a whole frame behind it;
+    // then start over instead of rushing out catch-up frames
+    nextDeadlineNs += periodNs;
+    if (now > nextDeadlineNs) {
+        nextDeadlineNs = now + periodNs;
+    }
+    return frameSeconds;
+}
@@ -0,0 +1,136 @@
+#include "../../include/core/frame_pipeline.h"
+#include "../../include/core/frame_limiter.h"
+#include "../../include/core/profiler.h"
+#include <algorithm>
+
+FramePipeline::FramePipeline(StepFunction step, float tickRate)
+    : step(std::move(step))
+    , tickRate(tickRate)
+    , timestep(tickRate > 0.0f ? tickRate : 1.0f)
+    , running(false)
+    , simulatedFrames(0)
+    , droppedFrames(0)
+    , hasFrame(false)
+    , presentedFrames(0)
+    , lastPresentedIndex(0)
+    , latencySumMs(0.0)
+    , maxLatencyMs(0.0)
+    , statsSimulatedBase(0)
+    , statsDroppedBase(0) {}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+void FramePipeline::setTickRate(float rate) {
+    if (isThreaded()) return;
+    tickRate = rate;
+    if (tickRate > 0.0f) {
+        timestep.setTickRate(tickRate);
+    }
+}
+
+void FramePipeline::start() {
+    if (isThreaded()) return;
+    running = true;
+    simulationThread = std::thread(&FramePipeline::simulationLoop, this);
+}
+
+void FramePipeline::stop() {
+    running = false;
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
+}
+
+void FramePipeline::advance(double elapsedSeconds) {
+    if (tickRate <= 0.0f) {
+        simulate(static_cast<float>(elapsedSeconds));
+        return;
+    }
+
+    int ticks = timestep.advance(elapsedSeconds);
+    for (int i = 0; i < ticks; ++i) {
+        simulate(timestep.getTickSeconds());
+    }
+}
+
+void FramePipeline::stepOnce(float deltaTime) {
+    simulate(deltaTime);
+}
+
+void FramePipeline::simulate(float deltaTime) {
+    PROFILE_SCOPE("Simulate");
+
+    FrameSnapshot& snapshot = frames.writeBuffer();
+    step(deltaTime, snapshot);
+    snapshot.frameIndex = simulatedFrames.load(std::memory_order_relaxed) + 1;
+    snapshot.deltaTime = deltaTime;
+    snapshot.simulatedAt = std::chrono::steady_clock::now();
+
+    simulatedFrames.fetch_add(1, std::memory_order_relaxed);
+    if (frames.publish()) {
+        droppedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FramePipeline::simulationLoop() {
+    Profiler::instance().setThreadName("Simulation");
+    FrameLimiter limiter(tickRate);
+    timestep.reset();
+    limiter.wait();
+
+    while (running.load(std::memory_order_relaxed)) {
+        // Normally one tick per wait; more if the thread fell behind
+        advance(limiter.wait());
+    }
+}
+
+float FramePipeline::getInterpolationAlpha(const FrameSnapshot& snapshot) const {
+    if (tickRate <= 0.0f) return 1.0f;
+
+    if (!isThreaded()) {
+        return timestep.getAlpha();
+    }
+    // The simulation thread ticks in real time, so the time since the snapshot
+    // was published is how far into the next tick we are
+    float sinceTick = std::chrono::duration<float>(std::chrono::steady_clock::now() - snapshot.simulatedAt).count();
+    return std::min(std::max(sinceTick * tickRate, 0.0f), 1.0f);
+}
+
+const FrameSnapshot* FramePipeline::acquireLatest(bool* isNew) {
+    bool fresh = frames.acquire();
+    hasFrame = hasFrame || fresh;
+    if (isNew) *isNew = fresh;
+    return hasFrame ? &frames.readBuffer() : nullptr;
+}
+
+void FramePipeline::markPresented(const FrameSnapshot& snapshot) {
+    // Redrawing an old frame adds no new simulation to the screen
+    if (snapshot.frameIndex == lastPresentedIndex) return;
+    lastPresentedIndex = snapshot.frameIndex;
+
+    double latencyMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - snapshot.simulatedAt).count();
+    ++presentedFrames;
+    latencySumMs += latencyMs;
+    maxLatencyMs = std::max(maxLatencyMs, latencyMs);
+}
+
+FramePipeline::Stats FramePipeline::getStats() const {
+    Stats stats;
+    stats.simulatedFrames = simulatedFrames.load(std::memory_order_relaxed) - statsSimulatedBase;
+    stats.droppedFrames = droppedFrames.load(std::memory_order_relaxed) - statsDroppedBase;
+    stats.presentedFrames = presentedFrames;
+    stats.averageLatencyMs = presentedFrames ? latencySumMs / presentedFrames : 0.0;
+    stats.maxLatencyMs = maxLatencyMs;
+    return stats;
+}
+
+void FramePipeline::resetStats() {
+    statsSimulatedBase = simulatedFrames.load(std::memory_order_relaxed);
+    statsDroppedBase = droppedFrames.load(std::memory_order_relaxed);
+    presentedFrames = 0;
+    latencySumMs = 0.0;
+    maxLatencyMs = 0.0;
+}
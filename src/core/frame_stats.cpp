@@ -0,0 +1,130 @@
+#include "../../include/core/frame_stats.h"
+#include <algorithm>
+#include <cmath>
+
+const uint32_t FrameTimeHistogram::LINEAR_BUCKETS;
+const uint32_t FrameTimeHistogram::SUB_BUCKETS;
+const uint32_t FrameTimeHistogram::MAX_EXPONENT;
+const uint32_t FrameTimeHistogram::BUCKET_COUNT;
+constexpr double FrameTimeStats::STUTTER_FACTOR;
+const size_t FrameTimeStats::STUTTER_WARMUP_FRAMES;
+
+FrameTimeHistogram::FrameTimeHistogram() {
+    clear();
+}
+
+void FrameTimeHistogram::clear() {
+    counts.fill(0);
+    total = 0;
+}
+
+uint32_t FrameTimeHistogram::bucketFor(uint32_t microseconds) {
+    if (microseconds < LINEAR_BUCKETS) return microseconds;
+    microseconds = std::min(microseconds, (1u << MAX_EXPONENT) - 1);
+
+    // Position of the leading bit picks the power of two, the next six bits the sub-bucket
+    uint32_t exponent = 31 - __builtin_clz(microseconds);
+    uint32_t mantissa = (microseconds >> (exponent - 6)) & (SUB_BUCKETS - 1);
+    return LINEAR_BUCKETS + (exponent - 7) * SUB_BUCKETS + mantissa;
+}
+
+double FrameTimeHistogram::bucketValue(uint32_t bucket) {
+    if (bucket < LINEAR_BUCKETS) return bucket;
+    uint32_t offset = bucket - LINEAR_BUCKETS;
+    uint32_t shift = offset / SUB_BUCKETS + 1;
+    uint32_t lower = (SUB_BUCKETS + offset % SUB_BUCKETS) << shift;
+    return lower + ((1u << shift) - 1) / 2.0;
+}
+
+double FrameTimeHistogram::percentileMicroseconds(double percentile) const {
+    if (total == 0) return 0.0;
+    double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * total)));
+
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        seen += counts[bucket];
+        if (seen >= target) return bucketValue(bucket);
+    }
+    return bucketValue(BUCKET_COUNT - 1);
+}
+
+double FrameTimeHistogram::slowestMeanMicroseconds(double fraction) const {
+    if (total == 0) return 0.0;
+    uint64_t wanted = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * total)));
+
+    uint64_t taken = 0;
+    double sum = 0.0;
+    for (uint32_t bucket = BUCKET_COUNT; bucket-- > 0 && taken < wanted;) {
+        uint64_t take = std::min<uint64_t>(counts[bucket], wanted - taken);
+        sum += take * bucketValue(bucket);
+        taken += take;
+    }
+    return sum / taken;
+}
+
+FrameTimeStats::FrameTimeStats(size_t windowFrames)
+    : samples(std::max<size_t>(windowFrames, 1))
+    , minWindow(samples.size())
+    , maxWindow(samples.size()) {
+    reset();
+}
+
+void FrameTimeStats::reset() {
+    framesSeen = 0;
+    count = 0;
+    sumMs = 0.0;
+    lastMs = 0.0;
+    histogram.clear();
+    minWindow.clear();
+    maxWindow.clear();
+    lastWasStutter = false;
+    stuttersInWindow = 0;
+    totalStutters = 0;
+}
+
+void FrameTimeStats::addFrame(double frameMs) {
+    // Judged against the window before this frame joins it. A stutter is at
+    // least twice the fastest frame, so most frames skip the median lookup.
+    bool stutter = count >= STUTTER_WARMUP_FRAMES
+        && frameMs > STUTTER_FACTOR * getMinMs()
+        && frameMs > STUTTER_FACTOR * histogram.percentileMicroseconds(50.0) / 1000.0;
+
+    Sample& slot = samples[framesSeen % samples.size()];
+    if (count == samples.size()) {
+        sumMs -= slot.ms;
+        histogram.remove(slot.microseconds);
+        if (slot.stutter) --stuttersInWindow;
+    } else {
+        ++count;
+    }
+
+    slot.ms = frameMs;
+    slot.microseconds = static_cast<uint32_t>(std::min(std::max(frameMs * 1000.0, 0.0), 4.0e9));
+    slot.stutter = stutter;
+    sumMs += frameMs;
+    histogram.add(slot.microseconds);
+
+    uint64_t firstInWindow = framesSeen + 1 - count;
+    minWindow.expire(firstInWindow);
+    maxWindow.expire(firstInWindow);
+    minWindow.push(framesSeen, frameMs);
+    maxWindow.push(framesSeen, frameMs);
+
+    lastMs = frameMs;
+    lastWasStutter = stutter;
+    if (stutter) {
+        ++stuttersInWindow;
+        ++totalStutters;
+    }
+    ++framesSeen;
+}
+
+double FrameTimeStats::getPercentileMs(double percentile) const {
+    return histogram.percentileMicroseconds(percentile) / 1000.0;
+}
+
+double FrameTimeStats::getOnePercentLowFps() const {
+    double slowestUs = histogram.slowestMeanMicroseconds(0.01);
+    return slowestUs > 0.0 ? 1.0e6 / slowestUs : 0.0;
+}
@@ -2,8 +2,10 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <chrono>
+#include <fstream>
 #include <sstream>
 #include <thread>
+#include <memory>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <GL/freeglut.h>
@@ -17,12 +19,26 @@
 #include "../../include/input/editor_input.h"
 #include "../../include/ui/imgui_interface.h"
 #include "../../include/ui/fps_counter.h"
+#include "../../include/core/frame_pipeline.h"
+#include "../../include/core/frame_limiter.h"
+#include "../../include/core/fixed_timestep.h"
+#include "../../include/input/input_recording.h"
+#include "../../include/input/input_queue.h"
+#include "../../include/input/late_latch.h"
+#include "../../include/core/profiler.h"
+#include "../../include/ui/profiler_panel.h"
+#include "../../include/graphics/snapshot_renderer.h"
+#include "../../include/graphics/camera.h"
+#include "../../include/editor/edit_log.h"
+#include "../../include/editor/world_streamer.h"
+#include "../../include/core/thread_pool.h"
+#include <glm/gtc/type_ptr.hpp>
 // #include "../include/input.h"
 // #include "../include/godmode.h"
 
 // Constants
 const float TARGET_FPS = 120.0f;
-const float FRAME_DURATION = 1000.0f / TARGET_FPS; // in milliseconds
+const float DEFAULT_TICK_RATE = 60.0f;   // Simulation ticks per second; --tick-rate overrides
 
 // Globals
 GLFWwindow* window = nullptr;
@@ -31,8 +47,53 @@ float lastTime = 0.0f;
 int frameCount = 0;
 float fps = 0.0f;
 FPSCounter fpsCounter;  // Add FPS counter instance
+bool threadedSimulation = true;  // --single-thread runs simulation and rendering in turn
+bool cursorVisible = false;
+
+// Window input, drained by the simulation once per tick
+InputQueue inputQueue;
+
+// --low-latency polls input right before rendering and late-latches mouse look;
+// --just-in-time also starts each frame as late as its predicted work allows
+bool lowLatency = false;
+bool justInTime = false;
+LateLatch lateLatch;
+InputLatencyTracker inputLatency(600);
+
+// Last live cursor move applied to the camera; simulation side only
+glm::dvec2 lookCursor(0.0);
+int64_t lookCursorTimeNs = 0;
+
+// Input recording (--record) and replay (--replay, optionally --headless)
+InputRecording inputRecording;
+std::string inputRecordPath;
+InputRecording replayRecording;
+std::unique_ptr<InputReplayer> inputReplayer;
+uint64_t simulationTick = 0;  // Simulation side only; stamps recorded events
+
+// With --scene the windowed editor logs every edit next to the scene file and
+// recovers them on the next start; --wal-sync picks how often the log is synced
+Editor::EditLog editLog;
+Editor::EditLog::Options editLogOptions;
+
+// --world streams a chunked world around the character instead of opening a
+// scene, within --world-budget megabytes; --generate-world writes a test world
+Editor::WorldStreamer worldStreamer;
+Editor::WorldStreamer::Options worldStreamerOptions;
+std::string worldPath;
+
+// Wide levels of the editor's transform hierarchy are updated across these workers
+ThreadPool transformPool;
 
 // Function Declarations
+void simulateFrame(float deltaTime, FrameSnapshot& snapshot);
+
+// The simulation only talks to rendering through these
+FramePipeline framePipeline(simulateFrame, DEFAULT_TICK_RATE);
+SnapshotRenderer snapshotRenderer;
+// Render side camera; the editor keeps its own for picking
+Camera renderCamera(90.0f, static_cast<float>(WIDTH) / HEIGHT, 0.1f, 100.0f);
+
 void displayFPS(float fps);
 void setupProjection();
 void renderText(const std::string& text, float x, float y);
@@ -41,6 +102,7 @@ void initializeGLEW();
 void initializeGLUT(int& argc, char** argv);
 void setupCallbacks();
 void mainLoop();
+int64_t renderFrame(const FrameSnapshot& snapshot);
 void initializeInput(GLFWwindow* window);
 
 // Function Implementations
@@ -50,8 +112,7 @@ void displayFPS(float fps) {
 
 void setupProjection() {
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluPerspective(90.0f, static_cast<float>(WIDTH) / HEIGHT, 0.1f, 100.0f); // Increased FOV to 90
+    glLoadMatrixf(glm::value_ptr(renderCamera.getProjection()));
     glMatrixMode(GL_MODELVIEW);
 }
 
@@ -93,157 +154,463 @@ void initializeGLUT(int& argc, char** argv) {
     glutInit(&argc, argv);
 }
 
+// Runs on the simulation side, before the tick it is stamped with
+void applyLiveInput(const InputEvent& queued) {
+    InputEvent event = queued;
+    event.tick = simulationTick;
+    if (!inputRecordPath.empty()) {
+        inputRecording.append(event);
+    }
+    applyInputEvent(window, event);
+    if (event.type == InputEventType::CURSOR && !EditorInput::isEditorMode) {
+        lookCursor = glm::dvec2(event.x, event.y);
+        lookCursorTimeNs = event.timeNs;
+    }
+}
+
+// Window events arrive on the main thread and only queue up; the simulation
+// applies them at the start of its next tick
+void postKeyEvent(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    inputQueue.push(InputEvent::key(key, scancode, action, mods));
+}
+
+void postCursorEvent(GLFWwindow* window, double xpos, double ypos) {
+    InputEvent event = InputEvent::cursor(xpos, ypos);
+    event.timeNs = FrameLimiter::nowNanoseconds();
+    lateLatch.onCursor(event);
+    inputQueue.push(event);
+}
+
+void postMouseButtonEvent(GLFWwindow* window, int button, int action, int mods) {
+    inputQueue.push(InputEvent::mouseButton(button, action, mods));
+}
+
 void setupCallbacks() {
-    glfwSetKeyCallback(window, key_callback);
-    glfwSetCursorPosCallback(window, mouse_callback);
-    glfwSetMouseButtonCallback(window, mouse_button_callback);
+    if (inputReplayer) {
+        // Live input would make the replay diverge; only Escape still quits
+        glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int, int action, int) {
+            if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
+                glfwSetWindowShouldClose(window, GLFW_TRUE);
+            }
+        });
+        return;
+    }
+    glfwSetKeyCallback(window, postKeyEvent);
+    glfwSetCursorPosCallback(window, postCursorEvent);
+    glfwSetMouseButtonCallback(window, postMouseButtonEvent);
 }
 
-void mainLoop() {
-    using namespace std::chrono;
-    auto lastFrameTimePoint = high_resolution_clock::now();
+// Runs on the simulation thread (or inline with --single-thread): advances the
+// game, then records what the render thread should draw
+void simulateFrame(float tickDeltaTime, FrameSnapshot& snapshot) {
+    static glm::vec3 lastCameraPosition(characterPosX, characterPosY + 1.5f, characterPosZ);
+    deltaTime = tickDeltaTime;
 
-    while (!glfwWindowShouldClose(window)) {
-        auto frameStartTime = high_resolution_clock::now();
+    if (inputReplayer) {
+        inputReplayer->replayTick(simulationTick, [](const InputEvent& event) { applyInputEvent(window, event); });
+        if (inputReplayer->isFinished(simulationTick) && window) {
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+        }
+    } else {
+        PROFILE_SCOPE("Input");
+        inputQueue.drain(applyLiveInput);
+    }
 
-        float currentFrame = glfwGetTime();
-        deltaTime = currentFrame - lastFrameTime;
-        lastFrameTime = currentFrame;
+    if (!EditorInput::isEditorMode) {
+        PROFILE_SCOPE("Movement");
+        Movement::updateMovement(deltaTime);
+    }
 
-        // Update FPS counter
-        fpsCounter.update();
+    {
+        PROFILE_SCOPE("Editor update");
+        EditorInput::update(deltaTime);
+    }
 
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        glLoadIdentity();
+    if (worldStreamer.isOpen()) {
+        PROFILE_SCOPE("World streaming");
+        worldStreamer.update(glm::vec3(characterPosX, characterPosY, characterPosZ), cameraFront);
+    }
 
-        // Set up camera
-        glm::vec3 cameraPosition(characterPosX, characterPosY + 1.5f, characterPosZ);
-        glm::vec3 cameraTarget = cameraPosition + cameraFront;
-        gluLookAt(cameraPosition.x, cameraPosition.y, cameraPosition.z,
-                  cameraTarget.x, cameraTarget.y, cameraTarget.z,
-                  0.0f, 1.0f, 0.0f);
-        
+    snapshot.previousCameraPosition = lastCameraPosition;
+    snapshot.cameraPosition = glm::vec3(characterPosX, characterPosY + 1.5f, characterPosZ);
+    snapshot.cameraFront = cameraFront;
+    snapshot.yaw = yaw;
+    snapshot.pitch = pitch;
+    snapshot.lookCursor = lookCursor;
+    snapshot.lookCursorTimeNs = lookCursorTimeNs;
+    lastCameraPosition = snapshot.cameraPosition;
+    PROFILE_SCOPE("Snapshot capture");
+    EditorInput::captureSnapshot(snapshot);
+    ++simulationTick;
+}
+
+void syncCursorMode(bool editorMode) {
+    if (editorMode == cursorVisible) return;
+    cursorVisible = editorMode;
+    glfwSetInputMode(window, GLFW_CURSOR, editorMode ? GLFW_CURSOR_NORMAL : GLFW_CURSOR_DISABLED);
+}
+
+// Draws one snapshot; reads no live game state beyond the late-latched cursor.
+// Returns the timestamp of the newest input the view reflects.
+int64_t renderFrame(const FrameSnapshot& snapshot) {
+    syncCursorMode(snapshot.editorMode);
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Set up camera, between the last two ticks so motion stays smooth at any frame rate
+    float alpha = framePipeline.getInterpolationAlpha(snapshot);
+    glm::vec3 cameraPosition = glm::mix(snapshot.previousCameraPosition, snapshot.cameraPosition, alpha);
+    LateLatch::View view;
+    {
+        PROFILE_SCOPE("Late latch");
+        view = lateLatch.aim(snapshot);
+    }
+    renderCamera.setPosition(cameraPosition);
+    renderCamera.setDirection(view.front);
+    // The scene and overlays still draw through the fixed-function stacks
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(glm::value_ptr(renderCamera.getProjection()));
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(glm::value_ptr(renderCamera.getView()));
+    
+    {
+        PROFILE_SCOPE("Scene draw");
         drawScene();
+    }
+    
+    // Render editor objects and preview
+    if (snapshot.editorMode) {
+        PROFILE_SCOPE("Editor render");
+        snapshotRenderer.render(snapshot, renderCamera);
         
-        // Render editor objects and preview
-        if (EditorInput::isEditorMode) {
-            EditorInput::worldEditor.render();
-            
-            // Draw preview if placing object
-            if (EditorInput::isPlacingObject) {
-                glPushMatrix();
-                glColor4f(1.0f, 1.0f, 1.0f, 0.5f);
-                glBegin(GL_LINES);
-                glVertex3f(EditorInput::placementStart.x, EditorInput::placementStart.y, EditorInput::placementStart.z);
-                glVertex3f(EditorInput::placementEnd.x, EditorInput::placementEnd.y, EditorInput::placementEnd.z);
-                glEnd();
-                glPopMatrix();
-            }
+        // Draw preview if placing object
+        if (snapshot.placingObject) {
+            glPushMatrix();
+            glColor4f(1.0f, 1.0f, 1.0f, 0.5f);
+            glBegin(GL_LINES);
+            glVertex3f(snapshot.placementStart.x, snapshot.placementStart.y, snapshot.placementStart.z);
+            glVertex3f(snapshot.placementEnd.x, snapshot.placementEnd.y, snapshot.placementEnd.z);
+            glEnd();
+            glPopMatrix();
         }
-        
-        drawCrosshair(WIDTH, HEIGHT);
-        
-        if (!EditorInput::isEditorMode) {
-            Movement::updateMovement(deltaTime);
+
+        if (snapshot.showPreview) {
+            Editor::renderObjectPreview(snapshot.previewType, snapshot.previewPosition, snapshot.previewSize);
         }
-        
-        EditorInput::update(deltaTime);
+    }
+    
+    drawCrosshair(WIDTH, HEIGHT);
 
-        // Render ImGui interface
-        UI::beginImGuiFrame();
+    // Render ImGui interface
+    PROFILE_SCOPE("ImGui");
+    UI::beginImGuiFrame();
+    
+    // FPS Display Window
+    FramePipeline::Stats pipelineStats = framePipeline.getStats();
+    ImGui::Begin("FPS");
+    ImGui::Text("FPS: %.1f", fpsCounter.getCurrentFPS());
+    ImGui::Text("Average: %.1f", fpsCounter.getAverageFPS());
+    ImGui::Text("Min: %.1f", fpsCounter.getMinFPS());
+    ImGui::Text("Max: %.1f", fpsCounter.getMaxFPS());
+    const FrameTimeStats& frameTimes = fpsCounter.getPercentileStats();
+    ImGui::Text("Frame time: %.2f ms (p50 %.2f, p95 %.2f, p99 %.2f)", frameTimes.getLastMs(),
+                frameTimes.getPercentileMs(50.0), frameTimes.getPercentileMs(95.0), frameTimes.getPercentileMs(99.0));
+    ImGui::Text("1%% low: %.1f FPS", frameTimes.getOnePercentLowFps());
+    ImGui::Text("Stutters: %zu in window, %llu total", frameTimes.getStuttersInWindow(),
+                static_cast<unsigned long long>(frameTimes.getTotalStutters()));
+    ImGui::Text("Simulation: %s", framePipeline.isThreaded() ? "own thread" : "inline");
+    ImGui::Text("Sim-to-present: %.2f ms (max %.2f)", pipelineStats.averageLatencyMs, pipelineStats.maxLatencyMs);
+    ImGui::Text("Dropped sim frames: %llu", static_cast<unsigned long long>(pipelineStats.droppedFrames));
+    InputQueue::Stats inputStats = inputQueue.getStats();
+    ImGui::Text("Input events: %llu (%llu merged, %llu dropped)", static_cast<unsigned long long>(inputStats.pushed),
+                static_cast<unsigned long long>(inputStats.coalesced), static_cast<unsigned long long>(inputStats.dropped));
+    const FrameTimeStats& latency = inputLatency.getStats();
+    ImGui::Text("Input to submit: %.2f ms (p50 %.2f, p99 %.2f)%s", latency.getLastMs(), latency.getPercentileMs(50.0),
+                latency.getPercentileMs(99.0), lateLatch.isEnabled() ? ", late-latched" : "");
+    ImGui::End();
+    
+    // Editor Inventory Window
+    if (snapshot.editorMode) {
+        ImGui::Begin("Inventory");
         
-        // FPS Display Window
-        ImGui::Begin("FPS");
-        ImGui::Text("FPS: %.1f", fpsCounter.getCurrentFPS());
-        ImGui::Text("Average: %.1f", fpsCounter.getAverageFPS());
-        ImGui::Text("Min: %.1f", fpsCounter.getMinFPS());
-        ImGui::Text("Max: %.1f", fpsCounter.getMaxFPS());
-        ImGui::End();
+        const auto& inventoryItems = snapshot.inventoryItems;
+        size_t selectedIndex = snapshot.selectedInventoryIndex;
         
-        // Editor Inventory Window
-        if (EditorInput::isEditorMode) {
-            ImGui::Begin("Inventory");
-            
-            const auto& inventoryItems = EditorInput::worldEditor.getInventoryItems();
-            size_t selectedIndex = EditorInput::worldEditor.getSelectedInventoryIndex();
-            
-            for (size_t i = 0; i < inventoryItems.size(); ++i) {
-                const char* itemName = "";
-                switch (inventoryItems[i]) {
-                    case Editor::ObjectType::WALL:
-                        itemName = "Wall";
-                        break;
-                    case Editor::ObjectType::RECTANGLE:
-                        itemName = "Rectangle";
-                        break;
-                    case Editor::ObjectType::HOUSE:
-                        itemName = "House";
-                        break;
-                    case Editor::ObjectType::TOWER:
-                        itemName = "Tower";
-                        break;
-                    case Editor::ObjectType::BRIDGE:
-                        itemName = "Bridge";
-                        break;
-                }
-                
-                bool isSelected = (i == selectedIndex);
-                if (ImGui::Selectable(itemName, isSelected)) {
-                    EditorInput::worldEditor.selectInventoryItem(i);
-                }
-                
-                if (isSelected) {
-                    ImGui::SetItemDefaultFocus();
-                }
+        for (size_t i = 0; i < inventoryItems.size(); ++i) {
+            const char* itemName = "";
+            switch (inventoryItems[i]) {
+                case Editor::ObjectType::WALL:
+                    itemName = "Wall";
+                    break;
+                case Editor::ObjectType::RECTANGLE:
+                    itemName = "Rectangle";
+                    break;
+                case Editor::ObjectType::HOUSE:
+                    itemName = "House";
+                    break;
+                case Editor::ObjectType::TOWER:
+                    itemName = "Tower";
+                    break;
+                case Editor::ObjectType::BRIDGE:
+                    itemName = "Bridge";
+                    break;
             }
             
-            ImGui::Separator();
-            
-            if (EditorInput::worldEditor.isPlacingObject()) {
-                ImGui::Text("Press 'P' to place object");
-                ImGui::Text("Press 'X' to cancel");
+            bool isSelected = (i == selectedIndex);
+            if (ImGui::Selectable(itemName, isSelected)) {
+                inputQueue.push(InputEvent::inventorySelect(i));
             }
             
-            ImGui::End();
+            if (isSelected) {
+                ImGui::SetItemDefaultFocus();
+            }
         }
         
-        UI::endImGuiFrame();
+        ImGui::Separator();
+        
+        if (snapshot.showPreview) {
+            ImGui::Text("Press 'P' to place object");
+            ImGui::Text("Press 'X' to cancel");
+        }
+        
+        ImGui::End();
+    }
+
+    UI::renderProfilerWindow();
+    
+    UI::endImGuiFrame();
+    return view.inputTimeNs;
+}
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+void mainLoop() {
+    FrameLimiter frameLimiter(TARGET_FPS);
+    Profiler::instance().setThreadName("Render");
+    int64_t predictedWorkNs = 0;    // Poll to submit; the --just-in-time lead
 
-        // Frame capping
-        auto frameEndTime = high_resolution_clock::now();
-        duration<float, std::milli> frameDuration = frameEndTime - frameStartTime;
+    if (threadedSimulation) {
+        framePipeline.start();
+    }
 
-        if (frameDuration.count() < FRAME_DURATION) {
-            std::this_thread::sleep_for(milliseconds(static_cast<int>(FRAME_DURATION - frameDuration.count())));
+    while (!glfwWindowShouldClose(window)) {
+        Profiler::instance().markFrame();
+        int64_t workStartNs = 0;
+        if (lowLatency) {
+            // Wait first and poll right after, so input that arrives during the
+            // wait makes this frame instead of the next
+            {
+                PROFILE_SCOPE("Limiter wait");
+                frameLimiter.wait(justInTime ? predictedWorkNs : 0);
+            }
+            workStartNs = FrameLimiter::nowNanoseconds();
+            PROFILE_SCOPE("Poll events");
+            glfwPollEvents();
+        }
+
+        float currentFrame = glfwGetTime();
+        float frameDeltaTime = currentFrame - lastFrameTime;
+        lastFrameTime = currentFrame;
+
+        if (!framePipeline.isThreaded()) {
+            framePipeline.advance(frameDeltaTime);
+        }
+
+        // Update FPS counter
+        fpsCounter.update();
+
+        const FrameSnapshot* snapshot = framePipeline.acquireLatest();
+        int64_t inputTimeNs = 0;
+        if (snapshot) {
+            PROFILE_SCOPE("Render frame");
+            inputTimeNs = renderFrame(*snapshot);
+        }
+
+        int64_t submitNs = FrameLimiter::nowNanoseconds();
+        inputLatency.onSubmit(inputTimeNs, submitNs);
+        if (lowLatency) {
+            // Jumps up to a slow frame at once, eases back down over a few
+            int64_t workNs = submitNs - workStartNs;
+            predictedWorkNs = std::max(workNs, predictedWorkNs - (predictedWorkNs - workNs) / 8);
+        }
+        {
+            PROFILE_SCOPE("Swap");
+            glfwSwapBuffers(window);
+        }
+        if (snapshot) {
+            framePipeline.markPresented(*snapshot);
+        }
+
+        if (!lowLatency) {
+            {
+                PROFILE_SCOPE("Poll events");
+                glfwPollEvents();
+            }
+
+            // Frame capping
+            PROFILE_SCOPE("Limiter wait");
+            frameLimiter.wait();
         }
     }
+
+    framePipeline.stop();
 }
 
 void initializeInput(GLFWwindow* window) {
     // Implementation of initializeInput function
 }
 
-int main() {
+// FNV-1a over what a frame shows; equal across runs means the replay matched
+uint64_t hashSnapshot(const FrameSnapshot& snapshot) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    mix(&snapshot.cameraPosition, sizeof(snapshot.cameraPosition));
+    mix(&snapshot.cameraFront, sizeof(snapshot.cameraFront));
+    for (const SnapshotObject& object : snapshot.objects) {
+        mix(&object.material, sizeof(object.material));
+        mix(&object.model, sizeof(object.model));
+        mix(&object.color, sizeof(object.color));
+    }
+    return hash;
+}
+
+// --scene: the world the editor opens with and Ctrl+S saves to, recovered
+// through its edit log; a file that does not exist yet starts an empty world.
+// --world streams a chunked world into the editor instead.
+bool openStartupWorld() {
+    if (!EditorInput::scenePath.empty()) {
+        if (!editLog.open(EditorInput::scenePath, EditorInput::worldEditor, editLogOptions)) return false;
+        EditorInput::editLog = &editLog;
+    }
+    return worldPath.empty() || worldStreamer.open(worldPath, EditorInput::worldEditor, worldStreamerOptions);
+}
+
+void closeStartupWorld() {
+    worldStreamer.close();
+    EditorInput::editLog = nullptr;
+    editLog.close();
+}
+
+// Replays a recording with no window or GL context, as fast as it simulates
+int runHeadlessReplay() {
+    float tickSeconds = FixedTimestep(framePipeline.getTickRate()).getTickSeconds();
+    auto start = std::chrono::steady_clock::now();
+    while (!inputReplayer->isFinished(simulationTick)) {
+        framePipeline.stepOnce(tickSeconds);
+        // Chunks land right after the tick that asked for them, so the result
+        // does not depend on how fast the streaming thread reads
+        if (worldStreamer.isOpen()) worldStreamer.finishPending();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const FrameSnapshot* snapshot = framePipeline.acquireLatest();
+    std::ostringstream hash;
+    hash << std::hex << (snapshot ? hashSnapshot(*snapshot) : 0);
+    std::cout << "Replayed " << simulationTick << " ticks in " << seconds * 1000.0 << " ms ("
+              << simulationTick / std::max(seconds, 1e-9) << " ticks/s), state " << hash.str() << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--single-thread") {
+            threadedSimulation = false;
+        } else if (arg == "--tick-rate" && i + 1 < argc) {
+            framePipeline.setTickRate(std::stof(argv[++i]));
+        } else if (arg == "--record" && i + 1 < argc) {
+            inputRecordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            if (!replayRecording.load(argv[++i])) {
+                return -1;
+            }
+            inputReplayer.reset(new InputReplayer(replayRecording));
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--low-latency") {
+            lowLatency = true;
+        } else if (arg == "--just-in-time") {
+            lowLatency = true;
+            justInTime = true;
+        } else if (arg == "--scene" && i + 1 < argc) {
+            EditorInput::scenePath = argv[++i];
+        } else if (arg == "--wal-sync" && i + 1 < argc) {
+            std::string policy(argv[++i]);
+            if (policy == "every-batch") {
+                editLogOptions.sync = Editor::EditLog::SyncPolicy::EVERY_BATCH;
+            } else if (policy == "never") {
+                editLogOptions.sync = Editor::EditLog::SyncPolicy::NEVER;
+            } else {
+                editLogOptions.sync = Editor::EditLog::SyncPolicy::INTERVAL;
+            }
+        } else if (arg == "--world" && i + 1 < argc) {
+            worldPath = argv[++i];
+        } else if (arg == "--world-budget" && i + 1 < argc) {
+            worldStreamerOptions.memoryBudget = static_cast<size_t>(std::stod(argv[++i]) * 1048576.0);
+        } else if (arg == "--generate-world" && i + 1 < argc) {
+            return Editor::generateTestWorld(argv[++i], Editor::TestWorldOptions()) ? 0 : -1;
+        }
+    }
+
+    if (!worldPath.empty() && !EditorInput::scenePath.empty()) {
+        // Streamed objects come and go outside the edit log
+        std::cerr << "--world cannot be combined with --scene" << std::endl;
+        return -1;
+    }
+    lateLatch.setEnabled(lowLatency);
+    EditorInput::worldEditor.setThreadPool(&transformPool);
+    if (inputReplayer) {
+        // Same timestep as the recording, or the ticks would not line up
+        framePipeline.setTickRate(replayRecording.getTickRate());
+    }
+    if (!inputRecordPath.empty()) {
+        if (framePipeline.getTickRate() <= 0.0f) {
+            std::cerr << "--record needs a fixed tick rate" << std::endl;
+            return -1;
+        }
+        inputRecording.setTickRate(framePipeline.getTickRate());
+    }
+    if (headless) {
+        if (!inputReplayer) {
+            std::cerr << "--headless needs --replay" << std::endl;
+            return -1;
+        }
+        if (!openStartupWorld()) return -1;
+        int result = runHeadlessReplay();
+        closeStartupWorld();
+        return result;
+    }
+
     try {
         initializeGLFW();
         initializeGLEW();
 
-        int argc = 0;
-        char** argv = nullptr;
-        initializeGLUT(argc, argv);
+        int glutArgc = 0;
+        char** glutArgv = nullptr;
+        initializeGLUT(glutArgc, glutArgv);
 
         setupCallbacks();
         setupProjection();
         
         EditorInput::initialize(window);
+        if (!openStartupWorld()) {
+            return -1;
+        }
         UI::initializeImGui(window);
         
         mainLoop();
         
+        closeStartupWorld();
         UI::cleanupImGui();
+
+        if (!inputRecordPath.empty()) {
+            inputRecording.setTickCount(simulationTick);
+            inputRecording.save(inputRecordPath);
+        }
         
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -0,0 +1,185 @@
+#include "../../include/core/profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace {
+    int64_t steadyNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Below this the calibration window is too short to trust
+    const int64_t MIN_CALIBRATION_NS = 5000000;
+
+    void writeJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+            else out << c;
+        }
+        out << '"';
+    }
+}
+
+const uint32_t Profiler::EVENTS_PER_THREAD;
+const uint32_t Profiler::FRAMES_KEPT;
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : enabled(true)
+    , frameMarks()
+    , frameCount(0)
+    , calibrationTicks(now())
+    , calibrationNanoseconds(steadyNanoseconds()) {}
+
+Profiler::ThreadBuffer* Profiler::registerThread() {
+    std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+    buffer->events.reset(new ProfileEvent[EVENTS_PER_THREAD]);
+    buffer->count.store(0, std::memory_order_relaxed);
+    buffer->clearedAt.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    buffer->threadIndex = static_cast<uint32_t>(threads.size());
+    buffer->name = "Thread " + std::to_string(buffer->threadIndex);
+    threads.push_back(std::move(buffer));
+    return threads.back().get();
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer* buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    buffer->name = name;
+}
+
+void Profiler::markFrame() {
+    uint64_t index = frameCount.load(std::memory_order_relaxed);
+    frameMarks[index % FRAMES_KEPT] = now();
+    frameCount.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::getLastFrame(uint64_t& begin, uint64_t& end) const {
+    uint64_t count = frameCount.load(std::memory_order_acquire);
+    if (count < 2) return false;
+    begin = frameMarks[(count - 2) % FRAMES_KEPT];
+    end = frameMarks[(count - 1) % FRAMES_KEPT];
+    return true;
+}
+
+void Profiler::readEvents(const ThreadBuffer& buffer, std::vector<ProfileEvent>& out) {
+    out.clear();
+    uint64_t count = buffer.count.load(std::memory_order_acquire);
+    uint64_t first = std::max(buffer.clearedAt.load(std::memory_order_relaxed),
+                              count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD : 0);
+    for (uint64_t i = first; i < count; ++i) {
+        out.push_back(buffer.events[i & (EVENTS_PER_THREAD - 1)]);
+    }
+
+    // The writer kept going while we copied; anything it lapped is garbage
+    uint64_t countAfter = buffer.count.load(std::memory_order_acquire);
+    if (countAfter > EVENTS_PER_THREAD && countAfter - EVENTS_PER_THREAD > first) {
+        size_t overwritten = static_cast<size_t>(std::min<uint64_t>(countAfter - EVENTS_PER_THREAD - first, out.size()));
+        out.erase(out.begin(), out.begin() + overwritten);
+    }
+}
+
+void Profiler::collect(uint64_t begin, uint64_t end, std::vector<ThreadTimeline>& out) const {
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    out.resize(threads.size());
+
+    std::vector<ProfileEvent> events;
+    for (size_t i = 0; i < threads.size(); ++i) {
+        ThreadTimeline& timeline = out[i];
+        timeline.threadIndex = threads[i]->threadIndex;
+        timeline.name = threads[i]->name;
+        timeline.events.clear();
+
+        readEvents(*threads[i], events);
+        for (const ProfileEvent& event : events) {
+            if (event.end > begin && event.start < end) {
+                timeline.events.push_back(event);
+            }
+        }
+    }
+}
+
+double Profiler::ticksPerMicrosecond() const {
+    int64_t elapsedNs = steadyNanoseconds() - calibrationNanoseconds;
+    if (elapsedNs < MIN_CALIBRATION_NS) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(MIN_CALIBRATION_NS - elapsedNs));
+    }
+    uint64_t ticks = now();
+    elapsedNs = steadyNanoseconds() - calibrationNanoseconds;
+    return static_cast<double>(ticks - calibrationTicks) * 1000.0 / static_cast<double>(elapsedNs);
+}
+
+double Profiler::ticksToMicroseconds(uint64_t ticks) const {
+    return static_cast<double>(ticks) / ticksPerMicrosecond();
+}
+
+std::string Profiler::toChromeTrace() const {
+    double tickRate = ticksPerMicrosecond();
+
+    std::vector<ThreadTimeline> timelines;
+    collect(0, UINT64_MAX, timelines);
+
+    uint64_t origin = UINT64_MAX;
+    for (const ThreadTimeline& timeline : timelines) {
+        for (const ProfileEvent& event : timeline.events) {
+            origin = std::min(origin, event.start);
+        }
+    }
+
+    // Complete ("X") events, plus one metadata event naming each thread
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const ThreadTimeline& timeline : timelines) {
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << timeline.threadIndex << ",\"args\":{\"name\":";
+        writeJsonString(out, timeline.name);
+        out << "}}";
+        first = false;
+
+        for (const ProfileEvent& event : timeline.events) {
+            out << ",\n{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << timeline.threadIndex
+                << ",\"ts\":" << (event.start - origin) / tickRate
+                << ",\"dur\":" << (event.end - event.start) / tickRate << "}";
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+    file << toChromeTrace();
+    if (!file) {
+        std::cerr << "Failed to write trace file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    for (auto& buffer : threads) {
+        buffer->clearedAt.store(buffer->count.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,121 @@
+#include "../../include/core/thread_pool.h"
+#include <algorithm>
+#include <memory>
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : activeTasks(0)
+    , stopping(false) {
+    if (threadCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return tasks.empty() && activeTasks == 0; });
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    if (grainSize == 0) grainSize = 1;
+
+    size_t chunkCount = (count + grainSize - 1) / grainSize;
+    if (chunkCount == 1 || workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    // Shared with helper tasks, which may still be queued after this call returns
+    struct ForState {
+        std::function<void(size_t, size_t)> body;
+        size_t count;
+        size_t grainSize;
+        size_t chunkCount;
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> finishedChunks{0};
+        std::mutex doneMutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<ForState>();
+    state->body = body;
+    state->count = count;
+    state->grainSize = grainSize;
+    state->chunkCount = chunkCount;
+
+    auto runChunks = [](ForState& s) {
+        size_t chunk;
+        while ((chunk = s.nextChunk.fetch_add(1, std::memory_order_relaxed)) < s.chunkCount) {
+            size_t begin = chunk * s.grainSize;
+            s.body(begin, std::min(begin + s.grainSize, s.count));
+            if (s.finishedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == s.chunkCount) {
+                std::lock_guard<std::mutex> lock(s.doneMutex);
+                s.done.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(workers.size(), chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        enqueue([state, runChunks] { runChunks(*state); });
+    }
+
+    runChunks(*state);
+
+    std::unique_lock<std::mutex> lock(state->doneMutex);
+    state->done.wait(lock, [&state] {
+        return state->finishedChunks.load(std::memory_order_acquire) == state->chunkCount;
+    });
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+            // Drain remaining work before shutting down
+            if (tasks.empty()) return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            ++activeTasks;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --activeTasks;
+            if (tasks.empty() && activeTasks == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+}
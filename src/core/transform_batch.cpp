@@ -0,0 +1,314 @@
+#include "../../include/core/transform_batch.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define TRANSFORM_BATCH_SIMD 1
+#endif
+
+void TransformSoA::resize(size_t count) {
+    positionX.resize(count); positionY.resize(count); positionZ.resize(count);
+    rotationX.resize(count); rotationY.resize(count); rotationZ.resize(count); rotationW.resize(count, 1.0f);
+    scaleX.resize(count, 1.0f); scaleY.resize(count, 1.0f); scaleZ.resize(count, 1.0f);
+    boundsCenterX.resize(count); boundsCenterY.resize(count); boundsCenterZ.resize(count);
+    boundsHalfX.resize(count, -1.0f); boundsHalfY.resize(count); boundsHalfZ.resize(count);
+}
+
+void TransformSoA::set(size_t index, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+    positionX[index] = position.x; positionY[index] = position.y; positionZ[index] = position.z;
+    rotationX[index] = rotation.x; rotationY[index] = rotation.y; rotationZ[index] = rotation.z; rotationW[index] = rotation.w;
+    scaleX[index] = scale.x; scaleY[index] = scale.y; scaleZ[index] = scale.z;
+}
+
+void TransformSoA::push(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+    positionX.push_back(position.x); positionY.push_back(position.y); positionZ.push_back(position.z);
+    rotationX.push_back(rotation.x); rotationY.push_back(rotation.y); rotationZ.push_back(rotation.z); rotationW.push_back(rotation.w);
+    scaleX.push_back(scale.x); scaleY.push_back(scale.y); scaleZ.push_back(scale.z);
+    boundsCenterX.push_back(0.0f); boundsCenterY.push_back(0.0f); boundsCenterZ.push_back(0.0f);
+    boundsHalfX.push_back(-1.0f); boundsHalfY.push_back(0.0f); boundsHalfZ.push_back(0.0f);
+}
+
+void TransformSoA::setBounds(size_t index, const AABB& bounds) {
+    if (bounds.isEmpty()) {
+        boundsCenterX[index] = boundsCenterY[index] = boundsCenterZ[index] = 0.0f;
+        boundsHalfX[index] = -1.0f;
+        boundsHalfY[index] = boundsHalfZ[index] = 0.0f;
+        return;
+    }
+    glm::vec3 center = bounds.center();
+    glm::vec3 half = bounds.extents();
+    boundsCenterX[index] = center.x; boundsCenterY[index] = center.y; boundsCenterZ[index] = center.z;
+    boundsHalfX[index] = half.x; boundsHalfY[index] = half.y; boundsHalfZ[index] = half.z;
+}
+
+void TransformSoA::copy(size_t index, const TransformSoA& source, size_t from) {
+    set(index, source.getPosition(from), source.getRotation(from), source.getScale(from));
+    boundsCenterX[index] = source.boundsCenterX[from];
+    boundsCenterY[index] = source.boundsCenterY[from];
+    boundsCenterZ[index] = source.boundsCenterZ[from];
+    boundsHalfX[index] = source.boundsHalfX[from];
+    boundsHalfY[index] = source.boundsHalfY[from];
+    boundsHalfZ[index] = source.boundsHalfZ[from];
+}
+
+namespace TransformBatch {
+
+namespace {
+    const glm::mat4 IDENTITY(1.0f);
+
+    inline AABB worldBox(const glm::vec3& center, const glm::vec3& half) {
+        return AABB(center - half, center + half);
+    }
+
+#ifdef TRANSFORM_BATCH_SIMD
+    // Column-major 4x4 of four objects held as 16 lane registers -> four glm::mat4
+    inline void storeMatrices4(const __m128* m, float* out) {
+        for (int column = 0; column < 4; ++column) {
+            __m128 r0 = m[column * 4 + 0], r1 = m[column * 4 + 1];
+            __m128 r2 = m[column * 4 + 2], r3 = m[column * 4 + 3];
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(out + 0 * 16 + column * 4, r0);
+            _mm_storeu_ps(out + 1 * 16 + column * 4, r1);
+            _mm_storeu_ps(out + 2 * 16 + column * 4, r2);
+            _mm_storeu_ps(out + 3 * 16 + column * 4, r3);
+        }
+    }
+
+    // The reverse, from four matrices anywhere in memory
+    inline void loadMatrices4(const float* const* matrices, __m128* m) {
+        for (int column = 0; column < 4; ++column) {
+            __m128 r0 = _mm_loadu_ps(matrices[0] + column * 4), r1 = _mm_loadu_ps(matrices[1] + column * 4);
+            __m128 r2 = _mm_loadu_ps(matrices[2] + column * 4), r3 = _mm_loadu_ps(matrices[3] + column * 4);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            m[column * 4 + 0] = r0;
+            m[column * 4 + 1] = r1;
+            m[column * 4 + 2] = r2;
+            m[column * 4 + 3] = r3;
+        }
+    }
+
+    struct SseOps {
+        typedef __m128 Reg;
+        static const size_t width = 4;
+        static Reg load(const float* p) { return _mm_loadu_ps(p); }
+        static Reg set1(float f) { return _mm_set1_ps(f); }
+        static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+        static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+        static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+        static Reg abs(Reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        static void store(float* p, Reg a) { _mm_storeu_ps(p, a); }
+        static void storeMatrices(const Reg* m, float* out) { storeMatrices4(m, out); }
+        static void loadMatrices(const float* const* matrices, Reg* m) { loadMatrices4(matrices, m); }
+    };
+
+#ifdef __AVX__
+    struct AvxOps {
+        typedef __m256 Reg;
+        static const size_t width = 8;
+        static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+        static Reg set1(float f) { return _mm256_set1_ps(f); }
+        static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+        static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+        static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+        static Reg abs(Reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        static void store(float* p, Reg a) { _mm256_storeu_ps(p, a); }
+        static void storeMatrices(const Reg* m, float* out) {
+            __m128 low[16], high[16];
+            for (int i = 0; i < 16; ++i) {
+                low[i] = _mm256_castps256_ps128(m[i]);
+                high[i] = _mm256_extractf128_ps(m[i], 1);
+            }
+            storeMatrices4(low, out);
+            storeMatrices4(high, out + 4 * 16);
+        }
+        static void loadMatrices(const float* const* matrices, Reg* m) {
+            __m128 low[16], high[16];
+            loadMatrices4(matrices, low);
+            loadMatrices4(matrices + 4, high);
+            for (int i = 0; i < 16; ++i) {
+                m[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(low[i]), high[i], 1);
+            }
+        }
+    };
+    typedef AvxOps WideOps;
+#else
+    typedef SseOps WideOps;
+#endif
+
+    // One block of Ops::width objects starting at index
+    template<typename Ops>
+    inline void computeBlock(const TransformBatchData& data, size_t index) {
+        typedef typename Ops::Reg Reg;
+        const size_t W = Ops::width;
+
+        // Blocks of unchanged objects are skipped whole, and ones with just a
+        // few changed objects are cheaper one object at a time
+        bool allChanged = true;
+        if (data.changed) {
+            size_t changedCount = 0;
+            for (size_t k = 0; k < W; ++k) {
+                changedCount += data.changed[index + k] != 0;
+            }
+            if (changedCount == 0) return;
+            if (changedCount * 2 <= W) {
+                computeRangeScalar(data, index, index + W);
+                return;
+            }
+            allChanged = changedCount == W;
+        }
+
+        const TransformSoA& t = *data.locals;
+        const Reg one = Ops::set1(1.0f);
+        const Reg two = Ops::set1(2.0f);
+        const Reg zero = Ops::set1(0.0f);
+
+        Reg qx = Ops::load(&t.rotationX[index]);
+        Reg qy = Ops::load(&t.rotationY[index]);
+        Reg qz = Ops::load(&t.rotationZ[index]);
+        Reg qw = Ops::load(&t.rotationW[index]);
+        Reg sx = Ops::load(&t.scaleX[index]);
+        Reg sy = Ops::load(&t.scaleY[index]);
+        Reg sz = Ops::load(&t.scaleZ[index]);
+
+        Reg xx = Ops::mul(qx, qx), yy = Ops::mul(qy, qy), zz = Ops::mul(qz, qz);
+        Reg xy = Ops::mul(qx, qy), xz = Ops::mul(qx, qz), yz = Ops::mul(qy, qz);
+        Reg wx = Ops::mul(qw, qx), wy = Ops::mul(qw, qy), wz = Ops::mul(qw, qz);
+
+        // Same layout as glm::mat4_cast, each column scaled by its axis
+        Reg m[16];
+        m[0] = Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(yy, zz))), sx);
+        m[1] = Ops::mul(Ops::mul(two, Ops::add(xy, wz)), sx);
+        m[2] = Ops::mul(Ops::mul(two, Ops::sub(xz, wy)), sx);
+        m[3] = zero;
+        m[4] = Ops::mul(Ops::mul(two, Ops::sub(xy, wz)), sy);
+        m[5] = Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(xx, zz))), sy);
+        m[6] = Ops::mul(Ops::mul(two, Ops::add(yz, wx)), sy);
+        m[7] = zero;
+        m[8] = Ops::mul(Ops::mul(two, Ops::add(xz, wy)), sz);
+        m[9] = Ops::mul(Ops::mul(two, Ops::sub(yz, wx)), sz);
+        m[10] = Ops::mul(Ops::sub(one, Ops::mul(two, Ops::add(xx, yy))), sz);
+        m[11] = zero;
+        m[12] = Ops::load(&t.positionX[index]);
+        m[13] = Ops::load(&t.positionY[index]);
+        m[14] = Ops::load(&t.positionZ[index]);
+        m[15] = one;
+
+        // Parent world * local, summed in glm's order; roots multiply by identity
+        if (data.parents) {
+            const float* parentMatrices[W];
+            bool anyParent = false;
+            for (size_t k = 0; k < W; ++k) {
+                uint32_t parent = data.parents[index + k];
+                anyParent |= parent != NO_PARENT;
+                parentMatrices[k] = glm::value_ptr(parent != NO_PARENT ? data.worldMatrices[parent] : IDENTITY);
+            }
+            if (anyParent) {
+                Reg p[16];
+                Ops::loadMatrices(parentMatrices, p);
+                Reg local[16];
+                for (int i = 0; i < 16; ++i) local[i] = m[i];
+                for (int column = 0; column < 4; ++column) {
+                    for (int row = 0; row < 4; ++row) {
+                        Reg sum = Ops::mul(p[0 * 4 + row], local[column * 4 + 0]);
+                        sum = Ops::add(sum, Ops::mul(p[1 * 4 + row], local[column * 4 + 1]));
+                        sum = Ops::add(sum, Ops::mul(p[2 * 4 + row], local[column * 4 + 2]));
+                        sum = Ops::add(sum, Ops::mul(p[3 * 4 + row], local[column * 4 + 3]));
+                        m[column * 4 + row] = sum;
+                    }
+                }
+            }
+        }
+
+        if (allChanged) {
+            Ops::storeMatrices(m, glm::value_ptr(data.worldMatrices[index]));
+        } else {
+            glm::mat4 block[W];
+            Ops::storeMatrices(m, glm::value_ptr(block[0]));
+            for (size_t k = 0; k < W; ++k) {
+                if (data.changed[index + k]) data.worldMatrices[index + k] = block[k];
+            }
+        }
+
+        if (!data.worldBounds) return;
+
+        // Transformed center plus the box half extents through |M| (Arvo)
+        const Reg localCenter[3] = {
+            Ops::load(&t.boundsCenterX[index]), Ops::load(&t.boundsCenterY[index]), Ops::load(&t.boundsCenterZ[index])
+        };
+        const Reg localHalf[3] = {
+            Ops::load(&t.boundsHalfX[index]), Ops::load(&t.boundsHalfY[index]), Ops::load(&t.boundsHalfZ[index])
+        };
+        alignas(32) float lanes[6][W];
+        for (int row = 0; row < 3; ++row) {
+            Reg center = m[12 + row];
+            Reg half = zero;
+            for (int column = 0; column < 3; ++column) {
+                Reg element = m[column * 4 + row];
+                center = Ops::add(center, Ops::mul(element, localCenter[column]));
+                half = Ops::add(half, Ops::mul(Ops::abs(element), localHalf[column]));
+            }
+            Ops::store(lanes[row], center);
+            Ops::store(lanes[3 + row], half);
+        }
+        for (size_t k = 0; k < W; ++k) {
+            if (data.changed && !data.changed[index + k]) continue;
+            data.worldBounds[index + k] = t.boundsHalfX[index + k] < 0.0f ? AABB() :
+                worldBox(glm::vec3(lanes[0][k], lanes[1][k], lanes[2][k]), glm::vec3(lanes[3][k], lanes[4][k], lanes[5][k]));
+        }
+    }
+#endif
+}
+
+void computeRangeScalar(const TransformBatchData& data, size_t begin, size_t end) {
+    const TransformSoA& t = *data.locals;
+    for (size_t i = begin; i < end; ++i) {
+        if (data.changed && !data.changed[i]) continue;
+
+        glm::quat rotation(t.rotationW[i], t.rotationX[i], t.rotationY[i], t.rotationZ[i]);
+        glm::mat4 m = glm::mat4_cast(rotation);
+        m[0] *= t.scaleX[i];
+        m[1] *= t.scaleY[i];
+        m[2] *= t.scaleZ[i];
+        m[3] = glm::vec4(t.positionX[i], t.positionY[i], t.positionZ[i], 1.0f);
+        uint32_t parent = data.parents ? data.parents[i] : NO_PARENT;
+        if (parent != NO_PARENT) {
+            m = data.worldMatrices[parent] * m;
+        }
+        data.worldMatrices[i] = m;
+
+        if (data.worldBounds) {
+            if (t.boundsHalfX[i] < 0.0f) {
+                data.worldBounds[i] = AABB();
+                continue;
+            }
+            glm::vec3 localCenter(t.boundsCenterX[i], t.boundsCenterY[i], t.boundsCenterZ[i]);
+            glm::vec3 localHalf(t.boundsHalfX[i], t.boundsHalfY[i], t.boundsHalfZ[i]);
+            glm::mat3 basis(m);
+            glm::mat3 absBasis(glm::abs(basis[0]), glm::abs(basis[1]), glm::abs(basis[2]));
+            data.worldBounds[i] = worldBox(glm::vec3(m[3]) + basis * localCenter, absBasis * localHalf);
+        }
+    }
+}
+
+void computeRange(const TransformBatchData& data, size_t begin, size_t end) {
+    size_t i = begin;
+#ifdef TRANSFORM_BATCH_SIMD
+    for (; i + WideOps::width <= end; i += WideOps::width) {
+        computeBlock<WideOps>(data, i);
+    }
+#endif
+    computeRangeScalar(data, i, end);
+}
+
+const char* simdPath() {
+#if defined(__AVX__)
+    return "avx";
+#elif defined(TRANSFORM_BATCH_SIMD)
+    return "sse";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace TransformBatch
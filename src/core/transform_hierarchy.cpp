@@ -0,0 +1,269 @@
+#include "../../include/core/transform_hierarchy.h"
+#include "../../include/core/thread_pool.h"
+#include <algorithm>
+
+const uint32_t TransformHierarchy::NO_SLOT;
+const size_t TransformHierarchy::PARALLEL_GRAIN;
+
+// parentSlots goes to the kernels as is
+static_assert(TransformBatch::NO_PARENT == 0xFFFFFFFFu, "root parents must match NO_SLOT");
+
+TransformHierarchy::TransformHierarchy()
+    : firstDirtySlot(NO_SLOT)
+    , removedCount(0)
+    , needsSort(false)
+    , threadPool(nullptr) {}
+
+TransformId TransformHierarchy::createNode(TransformId parent) {
+    TransformId id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<TransformId>(idToSlot.size());
+        idToSlot.push_back(NO_SLOT);
+    }
+
+    uint32_t slot = static_cast<uint32_t>(slotToId.size());
+    uint32_t parentSlot = isValid(parent) ? idToSlot[parent] : NO_SLOT;
+    uint32_t depth = parentSlot != NO_SLOT ? depths[parentSlot] + 1 : 0;
+
+    // Appending keeps parents ahead of children; only the depth order can break
+    if (!depths.empty() && depth < depths.back()) {
+        needsSort = true;
+    }
+
+    idToSlot[id] = slot;
+    slotToId.push_back(id);
+    parentSlots.push_back(parentSlot);
+    depths.push_back(depth);
+    locals.push(glm::vec3(0.0f), glm::quat(), glm::vec3(1.0f));
+    worldMatrices.push_back(glm::mat4(1.0f));
+    worldBounds.push_back(AABB());
+    dirtyFlags.push_back(0);
+    markDirty(slot);
+    return id;
+}
+
+void TransformHierarchy::destroyNode(TransformId id) {
+    if (!isValid(id)) return;
+
+    // The slot stays behind as a tombstone so its children can still walk past it;
+    // the next sort resolves their parents and compacts the arrays.
+    uint32_t slot = idToSlot[id];
+    slotToId[slot] = INVALID_TRANSFORM;
+    idToSlot[id] = NO_SLOT;
+    freeIds.push_back(id);
+    ++removedCount;
+    needsSort = true;
+}
+
+bool TransformHierarchy::setParent(TransformId id, TransformId parent) {
+    if (!isValid(id)) return false;
+
+    uint32_t slot = idToSlot[id];
+    uint32_t parentSlot = isValid(parent) ? idToSlot[parent] : NO_SLOT;
+
+    for (uint32_t p = parentSlot; p != NO_SLOT; p = parentSlots[p]) {
+        if (p == slot) return false;
+    }
+
+    parentSlots[slot] = parentSlot;
+    needsSort = true;
+    markDirty(slot);
+    return true;
+}
+
+void TransformHierarchy::setLocalPosition(TransformId id, const glm::vec3& position) {
+    uint32_t slot = idToSlot[id];
+    locals.positionX[slot] = position.x;
+    locals.positionY[slot] = position.y;
+    locals.positionZ[slot] = position.z;
+    markDirty(slot);
+}
+
+void TransformHierarchy::setLocalRotation(TransformId id, const glm::quat& rotation) {
+    uint32_t slot = idToSlot[id];
+    locals.rotationX[slot] = rotation.x;
+    locals.rotationY[slot] = rotation.y;
+    locals.rotationZ[slot] = rotation.z;
+    locals.rotationW[slot] = rotation.w;
+    markDirty(slot);
+}
+
+void TransformHierarchy::setLocalScale(TransformId id, const glm::vec3& scale) {
+    uint32_t slot = idToSlot[id];
+    locals.scaleX[slot] = scale.x;
+    locals.scaleY[slot] = scale.y;
+    locals.scaleZ[slot] = scale.z;
+    markDirty(slot);
+}
+
+void TransformHierarchy::setLocalBounds(TransformId id, const AABB& bounds) {
+    uint32_t slot = idToSlot[id];
+    locals.setBounds(slot, bounds);
+    markDirty(slot);
+}
+
+TransformId TransformHierarchy::getParent(TransformId id) const {
+    uint32_t p = parentSlots[idToSlot[id]];
+    while (p != NO_SLOT && slotToId[p] == INVALID_TRANSFORM) {
+        p = parentSlots[p];
+    }
+    return p != NO_SLOT ? slotToId[p] : INVALID_TRANSFORM;
+}
+
+bool TransformHierarchy::isValid(TransformId id) const {
+    return id < idToSlot.size() && idToSlot[id] != NO_SLOT;
+}
+
+void TransformHierarchy::markDirty(uint32_t slot) {
+    dirtyFlags[slot] = 1;
+    if (firstDirtySlot == NO_SLOT || slot < firstDirtySlot) {
+        firstDirtySlot = slot;
+    }
+}
+
+size_t TransformHierarchy::updateWorldMatrices(std::vector<TransformId>* changedIds) {
+    if (needsSort) {
+        sortByDepth();
+    }
+    if (firstDirtySlot == NO_SLOT) {
+        return 0;
+    }
+
+    // Nothing before the first dirty slot can change. Slots are in depth order,
+    // so each level only reads parents the level before finished; a level's
+    // nodes are independent of each other and go to the pool in ranges.
+    const size_t count = slotToId.size();
+    changedScratch.resize(count);
+
+    size_t levelBegin = firstDirtySlot;
+    while (levelBegin < count) {
+        size_t levelEnd = std::upper_bound(depths.begin() + levelBegin, depths.end(), depths[levelBegin]) - depths.begin();
+        size_t levelSize = levelEnd - levelBegin;
+        if (threadPool && levelSize > PARALLEL_GRAIN) {
+            threadPool->parallelFor(levelSize, PARALLEL_GRAIN, [this, levelBegin](size_t begin, size_t end) {
+                updateRange(levelBegin + begin, levelBegin + end);
+            });
+        } else {
+            updateRange(levelBegin, levelEnd);
+        }
+        levelBegin = levelEnd;
+    }
+
+    size_t recomputed = 0;
+    for (size_t i = firstDirtySlot; i < count; ++i) {
+        if (!changedScratch[i]) continue;
+        ++recomputed;
+        if (changedIds) changedIds->push_back(slotToId[i]);
+    }
+
+    firstDirtySlot = NO_SLOT;
+    return recomputed;
+}
+
+// Flags the nodes of [begin, end) that changed themselves or under a changed
+// parent, then recomputes just those
+void TransformHierarchy::updateRange(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        uint32_t parent = parentSlots[i];
+        bool parentChanged = parent != NO_SLOT && parent >= firstDirtySlot && changedScratch[parent];
+        changedScratch[i] = dirtyFlags[i] || parentChanged;
+        dirtyFlags[i] = 0;
+    }
+
+    TransformBatchData batch;
+    batch.locals = &locals;
+    batch.parents = parentSlots.data();
+    batch.changed = changedScratch.data();
+    batch.worldMatrices = worldMatrices.data();
+    batch.worldBounds = worldBounds.data();
+    TransformBatch::computeRange(batch, begin, end);
+}
+
+void TransformHierarchy::sortByDepth() {
+    const uint32_t count = static_cast<uint32_t>(slotToId.size());
+
+    // Skip over destroyed parents; a child that loses one needs a new world matrix
+    for (uint32_t i = 0; i < count; ++i) {
+        if (slotToId[i] == INVALID_TRANSFORM) continue;
+        uint32_t p = parentSlots[i];
+        if (p == NO_SLOT || slotToId[p] != INVALID_TRANSFORM) continue;
+        while (p != NO_SLOT && slotToId[p] == INVALID_TRANSFORM) {
+            p = parentSlots[p];
+        }
+        parentSlots[i] = p;
+        dirtyFlags[i] = 1;
+    }
+
+    // Depths from scratch, since reparenting moves whole subtrees
+    std::vector<uint32_t> newDepths(count, NO_SLOT);
+    std::vector<uint32_t> chain;
+    uint32_t maxDepth = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (slotToId[i] == INVALID_TRANSFORM || newDepths[i] != NO_SLOT) continue;
+        uint32_t s = i;
+        while (s != NO_SLOT && newDepths[s] == NO_SLOT) {
+            chain.push_back(s);
+            s = parentSlots[s];
+        }
+        uint32_t depth = s == NO_SLOT ? 0 : newDepths[s] + 1;
+        while (!chain.empty()) {
+            newDepths[chain.back()] = depth++;
+            chain.pop_back();
+        }
+        maxDepth = std::max(maxDepth, depth - 1);
+    }
+
+    // Stable counting sort by depth, dropping tombstones
+    std::vector<uint32_t> depthStart(maxDepth + 2, 0);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (slotToId[i] != INVALID_TRANSFORM) ++depthStart[newDepths[i] + 1];
+    }
+    for (size_t d = 1; d < depthStart.size(); ++d) {
+        depthStart[d] += depthStart[d - 1];
+    }
+    std::vector<uint32_t> oldToNew(count, NO_SLOT);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (slotToId[i] != INVALID_TRANSFORM) oldToNew[i] = depthStart[newDepths[i]]++;
+    }
+
+    const uint32_t liveCount = count - static_cast<uint32_t>(removedCount);
+    std::vector<TransformId> sortedIds(liveCount);
+    std::vector<uint32_t> sortedParents(liveCount);
+    std::vector<uint32_t> sortedDepths(liveCount);
+    TransformSoA sortedLocals;
+    sortedLocals.resize(liveCount);
+    std::vector<glm::mat4> sortedWorlds(liveCount);
+    std::vector<AABB> sortedBounds(liveCount);
+    std::vector<uint8_t> sortedDirty(liveCount);
+
+    firstDirtySlot = NO_SLOT;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t n = oldToNew[i];
+        if (n == NO_SLOT) continue;
+        sortedIds[n] = slotToId[i];
+        sortedParents[n] = parentSlots[i] != NO_SLOT ? oldToNew[parentSlots[i]] : NO_SLOT;
+        sortedDepths[n] = newDepths[i];
+        sortedLocals.copy(n, locals, i);
+        sortedWorlds[n] = worldMatrices[i];
+        sortedBounds[n] = worldBounds[i];
+        sortedDirty[n] = dirtyFlags[i];
+        idToSlot[slotToId[i]] = n;
+        if (dirtyFlags[i] && n < firstDirtySlot) {
+            firstDirtySlot = n;
+        }
+    }
+
+    slotToId.swap(sortedIds);
+    parentSlots.swap(sortedParents);
+    depths.swap(sortedDepths);
+    std::swap(locals, sortedLocals);
+    worldMatrices.swap(sortedWorlds);
+    worldBounds.swap(sortedBounds);
+    dirtyFlags.swap(sortedDirty);
+
+    removedCount = 0;
+    needsSort = false;
+}
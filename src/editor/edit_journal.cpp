@@ -0,0 +1,255 @@
+#include "../../include/editor/edit_journal.h"
+#include <algorithm>
+#include <utility>
+#include <cstring>
+
+namespace Editor {
+
+namespace {
+    const size_t HEADER_SIZE = 12;
+    const size_t TRAILER_SIZE = 4;
+
+    bool isValueEdit(EditKind kind) {
+        return kind == EditKind::MOVE || kind == EditKind::RESIZE || kind == EditKind::PROPERTY;
+    }
+
+    template <typename T>
+    void put(std::vector<uint8_t>& out, const T& value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // Bounds-checked; an overrun sets failed and leaves the value alone
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+        size_t offset;
+        bool failed;
+
+        template <typename T>
+        void take(T& value) {
+            if (size - offset < sizeof(T)) {
+                failed = true;
+                return;
+            }
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+        }
+    };
+}
+
+Edit inverseEdit(const Edit& edit) {
+    Edit inverse = edit;
+    std::swap(inverse.before, inverse.after);
+    std::swap(inverse.parentBefore, inverse.parentAfter);
+    if (edit.kind == EditKind::ADD) inverse.kind = EditKind::REMOVE;
+    if (edit.kind == EditKind::REMOVE) inverse.kind = EditKind::ADD;
+    return inverse;
+}
+
+void encodeEdit(const Edit& edit, std::vector<uint8_t>& out) {
+    put(out, static_cast<uint8_t>(edit.kind));
+    put(out, static_cast<uint8_t>(edit.property));
+    put(out, uint16_t(0));
+    put(out, edit.objectIndex);
+    if (edit.kind == EditKind::ADD || edit.kind == EditKind::REMOVE) {
+        const ObjectState& object = edit.object;
+        put(out, static_cast<uint32_t>(object.type));
+        put(out, object.position);
+        put(out, object.size);
+        put(out, object.color);
+        put(out, object.wallThickness);
+        put(out, object.roofHeight);
+        put(out, object.windowCount);
+        put(out, object.doorWidth);
+        put(out, object.parentIndex);
+        put(out, static_cast<uint32_t>(object.children.size()));
+        for (uint32_t child : object.children) put(out, child);
+        return;
+    }
+    put(out, edit.before);
+    put(out, edit.after);
+    if (edit.kind == EditKind::PARENT) {
+        put(out, edit.parentBefore);
+        put(out, edit.parentAfter);
+    }
+}
+
+bool decodeEdit(const uint8_t* data, size_t size, Edit& out) {
+    Reader in{ data, size, 0, false };
+    uint8_t kind = 0;
+    uint8_t property = 0;
+    uint16_t unused = 0;
+    in.take(kind);
+    in.take(property);
+    in.take(unused);
+    in.take(out.objectIndex);
+    if (kind > static_cast<uint8_t>(EditKind::PARENT)) return false;
+    out.kind = static_cast<EditKind>(kind);
+    out.property = static_cast<ObjectProperty>(property);
+
+    if (out.kind == EditKind::ADD || out.kind == EditKind::REMOVE) {
+        ObjectState& object = out.object;
+        uint32_t type = 0;
+        uint32_t childCount = 0;
+        in.take(type);
+        object.type = static_cast<ObjectType>(type);
+        in.take(object.position);
+        in.take(object.size);
+        in.take(object.color);
+        in.take(object.wallThickness);
+        in.take(object.roofHeight);
+        in.take(object.windowCount);
+        in.take(object.doorWidth);
+        in.take(object.parentIndex);
+        in.take(childCount);
+        if (in.failed || childCount != (size - in.offset) / sizeof(uint32_t)) return false;
+        object.children.resize(childCount);
+        for (uint32_t& child : object.children) in.take(child);
+    } else {
+        in.take(out.before);
+        in.take(out.after);
+        if (out.kind == EditKind::PARENT) {
+            in.take(out.parentBefore);
+            in.take(out.parentAfter);
+        }
+    }
+    return !in.failed && in.offset == size;
+}
+
+const size_t EditJournal::DEFAULT_MEMORY_LIMIT;
+const uint32_t ObjectState::NO_PARENT;
+
+EditJournal::EditJournal(size_t memoryLimit)
+    : ring(memoryLimit)
+    , begin(0)
+    , cursor(0)
+    , end(0)
+    , undoCount(0)
+    , redoCount(0)
+    , mergeable(false)
+    , lastRecord(0) {}
+
+void EditJournal::write(uint64_t offset, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t position = static_cast<size_t>(offset % ring.size());
+    size_t first = std::min(size, ring.size() - position);
+    std::memcpy(ring.data() + position, bytes, first);
+    std::memcpy(ring.data(), bytes + first, size - first);
+}
+
+void EditJournal::read(uint64_t offset, void* data, size_t size) const {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    size_t position = static_cast<size_t>(offset % ring.size());
+    size_t first = std::min(size, ring.size() - position);
+    std::memcpy(bytes, ring.data() + position, first);
+    std::memcpy(bytes + first, ring.data(), size - first);
+}
+
+uint32_t EditJournal::readSize(uint64_t offset) const {
+    uint32_t size;
+    read(offset, &size, sizeof(size));
+    return size;
+}
+
+void EditJournal::dropOldest() {
+    begin += readSize(begin);
+    --undoCount;
+    if (begin > lastRecord) mergeable = false;
+}
+
+void EditJournal::record(const Edit& edit) {
+    if (ring.empty()) return;
+
+    // Redo steps are gone once history branches
+    end = cursor;
+    redoCount = 0;
+
+    if (mergeable && isValueEdit(edit.kind)) {
+        uint8_t header[HEADER_SIZE];
+        read(lastRecord, header, sizeof(header));
+        uint32_t index;
+        std::memcpy(&index, header + 8, sizeof(index));
+        if (header[4] == static_cast<uint8_t>(edit.kind) && index == edit.objectIndex
+            && (edit.kind != EditKind::PROPERTY || header[5] == static_cast<uint8_t>(edit.property))) {
+            write(lastRecord + HEADER_SIZE + sizeof(glm::vec3), &edit.after, sizeof(edit.after));
+            return;
+        }
+    }
+
+    scratch.clear();
+    put(scratch, uint32_t(0));
+    encodeEdit(edit, scratch);
+    uint32_t size = static_cast<uint32_t>(scratch.size() + TRAILER_SIZE);
+    put(scratch, size);
+    std::memcpy(scratch.data(), &size, sizeof(size));
+
+    if (size > ring.size()) {
+        // Can't be kept; nothing before it can be undone either
+        clear();
+        return;
+    }
+    while (end + size - begin > ring.size()) {
+        dropOldest();
+    }
+    write(end, scratch.data(), size);
+    lastRecord = end;
+    end += size;
+    cursor = end;
+    ++undoCount;
+    mergeable = isValueEdit(edit.kind);
+}
+
+void EditJournal::decode(uint64_t offset, uint32_t size, Edit& out) {
+    scratch.resize(size);
+    read(offset, scratch.data(), size);
+    decodeEdit(scratch.data() + sizeof(uint32_t), size - sizeof(uint32_t) - TRAILER_SIZE, out);
+}
+
+bool EditJournal::undo(Edit& out) {
+    if (cursor == begin) return false;
+    uint32_t size = readSize(cursor - TRAILER_SIZE);
+    cursor -= size;
+    decode(cursor, size, out);
+    --undoCount;
+    ++redoCount;
+    mergeable = false;
+    return true;
+}
+
+bool EditJournal::redo(Edit& out) {
+    if (cursor == end) return false;
+    uint32_t size = readSize(cursor);
+    decode(cursor, size, out);
+    cursor += size;
+    --redoCount;
+    ++undoCount;
+    mergeable = false;
+    return true;
+}
+
+void EditJournal::clear() {
+    begin = cursor = end = 0;
+    undoCount = redoCount = 0;
+    mergeable = false;
+}
+
+void EditJournal::setMemoryLimit(size_t bytes) {
+    // Redo steps go first, then the oldest undo steps that no longer fit
+    end = cursor;
+    redoCount = 0;
+    while (end - begin > bytes) {
+        dropOldest();
+    }
+
+    std::vector<uint8_t> kept(static_cast<size_t>(end - begin));
+    if (!kept.empty()) read(begin, kept.data(), kept.size());
+    ring.assign(bytes, 0);
+    ring.shrink_to_fit();
+    begin = 0;
+    cursor = end = kept.size();
+    mergeable = false;
+    if (!kept.empty()) write(0, kept.data(), kept.size());
+}
+
+} // namespace Editor
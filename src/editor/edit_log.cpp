@@ -0,0 +1,434 @@
+#include "../../include/editor/edit_log.h"
+#include "../../include/editor/scene_file.h"
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Editor {
+
+namespace {
+    const char LOG_MAGIC[4] = { 'F', 'P', 'S', 'L' };
+    const char CHECKPOINT_MAGIC[4] = { 'F', 'P', 'S', 'C' };
+    const size_t LOG_HEADER_SIZE = 8;
+    const size_t CHECKPOINT_HEADER_SIZE = 32;
+    const size_t RECORD_HEADER_SIZE = 8;        // Length and checksum
+    const size_t SEQUENCE_SIZE = 8;
+
+    uint32_t crc32(const uint8_t* data, size_t size) {
+        // Built once, thread-safely, on first use; both threads checksum records
+        static const std::array<uint32_t, 256> table = [] {
+            std::array<uint32_t, 256> entries;
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                }
+                entries[i] = value;
+            }
+            return entries;
+        }();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i) {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    // Forces written data to the device; a plain flush where fsync is unavailable
+    bool syncFile(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#if defined(__unix__) || defined(__APPLE__)
+        return fsync(fileno(file)) == 0;
+#else
+        return true;
+#endif
+    }
+
+    // Makes a rename in the directory durable
+    void syncDirectory(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+        int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+        }
+#endif
+    }
+
+    // The scene file's size and modification time in nanoseconds; zeros when
+    // there is none. Sizes alone where the platform has no stat.
+    void stampOf(const std::string& path, uint64_t& size, int64_t& modified) {
+        size = 0;
+        modified = 0;
+#if defined(__unix__) || defined(__APPLE__)
+        struct stat info;
+        if (::stat(path.c_str(), &info) != 0) return;
+        size = static_cast<uint64_t>(info.st_size);
+#if defined(__APPLE__)
+        modified = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+        modified = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (file) size = static_cast<uint64_t>(file.tellg());
+#endif
+    }
+
+    bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+}
+
+const uint32_t EditLog::FORMAT_VERSION;
+
+EditLog::EditLog()
+    : editor(nullptr)
+    , nextSequence(1)
+    , logFile(nullptr)
+    , logBytes(0)
+    , appendedSequence(0)
+    , durableSequence(0)
+    , flushRequested(false)
+    , checkpointRequested(false)
+    , savesRequested(0)
+    , savesWritten(0)
+    , stopping(false) {}
+
+EditLog::~EditLog() {
+    close();
+}
+
+bool EditLog::open(const std::string& scenePath, WorldEditor& target) {
+    return open(scenePath, target, Options());
+}
+
+bool EditLog::open(const std::string& scenePath, WorldEditor& target, const Options& opts) {
+    close();
+    sceneFilePath = scenePath;
+    logPath = scenePath + ".wal";
+    checkpointPath = scenePath + ".checkpoint";
+    options = opts;
+    auto start = std::chrono::steady_clock::now();
+
+    // The base: the checkpoint, else the scene file, else an empty scene. A
+    // checkpoint taken against a scene file that has since been replaced is
+    // stale, and so is its log.
+    uint64_t lastSequence = 0;
+    bool stale = false;
+    bool fromCheckpoint = false;
+    std::ifstream checkpoint(checkpointPath, std::ios::binary);
+    if (checkpoint) {
+        uint8_t header[CHECKPOINT_HEADER_SIZE] = {};
+        uint32_t version = 0;
+        uint64_t sceneSize = 0;
+        int64_t sceneModified = 0;
+        SceneFile file;
+        if (checkpoint.read(reinterpret_cast<char*>(header), sizeof(header))) {
+            std::memcpy(&version, header + 4, sizeof(version));
+            std::memcpy(&lastSequence, header + 8, sizeof(lastSequence));
+            std::memcpy(&sceneSize, header + 16, sizeof(sceneSize));
+            std::memcpy(&sceneModified, header + 24, sizeof(sceneModified));
+        }
+        if (std::memcmp(header, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 || version != FORMAT_VERSION
+            || !file.open(checkpointPath, CHECKPOINT_HEADER_SIZE)) {
+            std::cerr << "Invalid checkpoint: " << checkpointPath << std::endl;
+            return false;
+        }
+        uint64_t size;
+        int64_t modified;
+        stampOf(scenePath, size, modified);
+        stale = size != sceneSize || modified != sceneModified;
+        if (stale) {
+            std::cout << "Scene file changed since the last checkpoint, ignoring " << checkpointPath << std::endl;
+            lastSequence = 0;
+        } else {
+            target.loadScene(file);
+            fromCheckpoint = true;
+        }
+    }
+    if (!fromCheckpoint) {
+        if (std::ifstream(scenePath)) {
+            if (!target.loadScene(scenePath)) return false;
+        } else {
+            target.loadScene(SceneFile());
+        }
+    }
+
+    // Then every intact record newer than it; a torn or damaged tail ends the log
+    uint64_t recovered = 0;
+    std::vector<uint8_t> log;
+    uint32_t version = 0;
+    if (!stale && readFile(logPath, log) && log.size() >= LOG_HEADER_SIZE) {
+        std::memcpy(&version, log.data() + 4, sizeof(version));
+    }
+    if (version == FORMAT_VERSION && std::memcmp(log.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) == 0) {
+        Edit edit;
+        size_t offset = LOG_HEADER_SIZE;
+        while (log.size() - offset >= RECORD_HEADER_SIZE) {
+            uint32_t length;
+            uint32_t checksum;
+            std::memcpy(&length, log.data() + offset, sizeof(length));
+            std::memcpy(&checksum, log.data() + offset + 4, sizeof(checksum));
+            const uint8_t* body = log.data() + offset + RECORD_HEADER_SIZE;
+            if (length < SEQUENCE_SIZE || length > log.size() - offset - RECORD_HEADER_SIZE
+                || crc32(body, length) != checksum) {
+                break;
+            }
+            uint64_t sequence;
+            std::memcpy(&sequence, body, sizeof(sequence));
+            if (!decodeEdit(body + SEQUENCE_SIZE, length - SEQUENCE_SIZE, edit)) break;
+            if (sequence > lastSequence) {
+                target.replayEdit(edit);
+                lastSequence = sequence;
+                ++recovered;
+            }
+            offset += RECORD_HEADER_SIZE + length;
+        }
+    }
+    if (recovered > 0) {
+        std::cout << "Recovered " << recovered << " edits from " << logPath << std::endl;
+    }
+
+    // The background thread writes the recovered scene as the new checkpoint,
+    // starts the log over and builds its shadow from it
+    std::vector<uint8_t> scene = SceneFile::serialize(target);
+    nextSequence = lastSequence + 1;
+    appendedSequence = lastSequence;
+    durableSequence = lastSequence;
+    flushRequested = false;
+    checkpointRequested = false;
+    savesRequested = 0;
+    savesWritten = 0;
+    stopping = false;
+    pending.clear();
+    stats = Stats();
+    stats.recoveredEdits = recovered;
+    stats.recoveryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    editor = &target;
+    ioThread = std::thread(&EditLog::ioLoop, this, std::move(scene), lastSequence);
+    target.setEditListener([this](const Edit& edit) { append(edit); });
+    return true;
+}
+
+void EditLog::close() {
+    if (!editor) return;
+    editor->setEditListener(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    ioThread.join();
+    if (logFile) {
+        std::fclose(logFile);
+        logFile = nullptr;
+    }
+    shadow.reset();
+    editor = nullptr;
+}
+
+void EditLog::append(const Edit& edit) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // The checksum is left to the background thread
+    size_t start = pending.size();
+    pending.resize(start + RECORD_HEADER_SIZE + SEQUENCE_SIZE);
+    uint64_t sequence = nextSequence++;
+    std::memcpy(pending.data() + start + RECORD_HEADER_SIZE, &sequence, sizeof(sequence));
+    encodeEdit(edit, pending);
+    uint32_t length = static_cast<uint32_t>(pending.size() - start - RECORD_HEADER_SIZE);
+    std::memcpy(pending.data() + start, &length, sizeof(length));
+    appendedSequence = sequence;
+    ++stats.editsLogged;
+}
+
+void EditLog::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!editor) return;
+    uint64_t target = appendedSequence;
+    uint64_t savesTarget = savesRequested;
+    flushRequested = true;
+    wake.notify_one();
+    written.wait(lock, [&] { return durableSequence >= target && savesWritten >= savesTarget; });
+}
+
+void EditLog::requestCheckpoint() {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkpointRequested = true;
+    wake.notify_one();
+}
+
+void EditLog::save() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!editor) return;
+    ++savesRequested;
+    wake.notify_one();
+}
+
+EditLog::Stats EditLog::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void EditLog::ioLoop(std::vector<uint8_t> scene, uint64_t sequence) {
+    shadow.reset(new WorldEditor());
+    SceneFile file;
+    file.view(scene.data(), scene.size());
+    shadow->loadScene(file);
+    file.close();
+    if (!writeCheckpoint(scene, sequence) || !startLog()) {
+        std::cerr << "Edit log disabled: " << logPath << std::endl;
+    }
+    std::vector<uint8_t>().swap(scene);
+
+    std::vector<uint8_t> batch;
+    Edit edit;
+    auto lastSync = std::chrono::steady_clock::now();
+    bool unsynced = false;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait_for(lock, std::chrono::milliseconds(options.flushIntervalMs),
+                      [this] { return stopping || flushRequested || checkpointRequested || savesWritten < savesRequested; });
+        batch.swap(pending);
+        uint64_t batchSequence = appendedSequence;
+        uint64_t saveTarget = savesRequested;
+        bool saving = savesWritten < saveTarget;
+        bool flushing = flushRequested || stopping || saving;
+        bool checkpointing = checkpointRequested || stopping;
+        bool stop = stopping;
+        flushRequested = false;
+        checkpointRequested = false;
+        lock.unlock();
+
+        // Checksum each record and bring the shadow up to date
+        for (size_t offset = 0; offset < batch.size();) {
+            uint32_t length;
+            std::memcpy(&length, batch.data() + offset, sizeof(length));
+            const uint8_t* body = batch.data() + offset + RECORD_HEADER_SIZE;
+            uint32_t checksum = crc32(body, length);
+            std::memcpy(batch.data() + offset + 4, &checksum, sizeof(checksum));
+            if (decodeEdit(body + SEQUENCE_SIZE, length - SEQUENCE_SIZE, edit)) {
+                shadow->replayEdit(edit);
+            }
+            offset += RECORD_HEADER_SIZE + length;
+        }
+
+        uint64_t batches = 0;
+        uint64_t syncs = 0;
+        uint64_t checkpoints = 0;
+        uint64_t saves = 0;
+        if (logFile && !batch.empty()) {
+            if (std::fwrite(batch.data(), 1, batch.size(), logFile) != batch.size() || std::fflush(logFile) != 0) {
+                std::cerr << "Failed to write edit log: " << logPath << std::endl;
+            }
+            logBytes += batch.size();
+            unsynced = true;
+            ++batches;
+        }
+        auto now = std::chrono::steady_clock::now();
+        bool syncDue = flushing || options.sync == SyncPolicy::EVERY_BATCH
+            || (options.sync == SyncPolicy::INTERVAL && now - lastSync >= std::chrono::milliseconds(options.syncIntervalMs));
+        if (logFile && unsynced && syncDue) {
+            syncFile(logFile);
+            unsynced = false;
+            lastSync = now;
+            ++syncs;
+        }
+        // A save is the shadow, which now holds the whole batch; the checkpoint
+        // after it is stamped with the new file, so recovery keeps trusting
+        // the log. A crash in between finds the saved file newer than the old
+        // checkpoint and loads it, which lacks nothing the log had.
+        bool saved = false;
+        if (saving) {
+            saved = SceneFile::save(*shadow, sceneFilePath);
+            if (saved) {
+                std::cout << "Saved " << shadow->getObjects().size() << " objects to " << sceneFilePath << std::endl;
+                ++saves;
+            }
+        }
+        if (saved || (logFile && logBytes > LOG_HEADER_SIZE && (checkpointing || logBytes >= options.checkpointBytes))) {
+            if (writeCheckpoint(SceneFile::serialize(*shadow), batchSequence) && startLog()) {
+                ++checkpoints;
+            }
+        }
+        batch.clear();
+
+        lock.lock();
+        stats.batchesWritten += batches;
+        stats.syncs += syncs;
+        stats.checkpoints += checkpoints;
+        stats.saves += saves;
+        savesWritten = saveTarget;
+        if (!unsynced) durableSequence = batchSequence;
+        written.notify_all();
+        if (stop) break;
+    }
+}
+
+// Written aside and renamed over the old one, so a crash leaves one or the other
+bool EditLog::writeCheckpoint(const std::vector<uint8_t>& scene, uint64_t sequence) {
+    std::string temporary = checkpointPath + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to write checkpoint: " << temporary << std::endl;
+        return false;
+    }
+    uint64_t sceneSize;
+    int64_t sceneModified;
+    stampOf(sceneFilePath, sceneSize, sceneModified);
+    uint8_t header[CHECKPOINT_HEADER_SIZE];
+    std::memcpy(header, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    std::memcpy(header + 4, &FORMAT_VERSION, sizeof(FORMAT_VERSION));
+    std::memcpy(header + 8, &sequence, sizeof(sequence));
+    std::memcpy(header + 16, &sceneSize, sizeof(sceneSize));
+    std::memcpy(header + 24, &sceneModified, sizeof(sceneModified));
+    bool ok = std::fwrite(header, 1, sizeof(header), file) == sizeof(header)
+        && std::fwrite(scene.data(), 1, scene.size(), file) == scene.size()
+        && syncFile(file);
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), checkpointPath.c_str()) != 0) {
+        std::cerr << "Failed to write checkpoint: " << checkpointPath << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    syncDirectory(checkpointPath);
+    return true;
+}
+
+// Everything logged so far is in the checkpoint; a crash before the log is
+// emptied only leaves records recovery skips by sequence
+bool EditLog::startLog() {
+    if (logFile) std::fclose(logFile);
+    logFile = std::fopen(logPath.c_str(), "wb");
+    if (!logFile) {
+        std::cerr << "Failed to open edit log: " << logPath << std::endl;
+        return false;
+    }
+    uint8_t header[LOG_HEADER_SIZE];
+    std::memcpy(header, LOG_MAGIC, sizeof(LOG_MAGIC));
+    std::memcpy(header + 4, &FORMAT_VERSION, sizeof(FORMAT_VERSION));
+    std::fwrite(header, 1, sizeof(header), logFile);
+    syncFile(logFile);
+    logBytes = LOG_HEADER_SIZE;
+    return true;
+}
+
+void EditLog::sync() {
+    if (logFile) syncFile(logFile);
+}
+
+} // namespace Editor
@@ -1,42 +1,39 @@
 #include "../../include/editor/editor.h"
+#include "../../include/editor/scene_file.h"
+#include "../../include/core/frame_snapshot.h"
 #include <GL/gl.h>
+#include <algorithm>
 #include <memory>
 
 namespace Editor {
 
 // EditableObject implementation
 EditableObject::EditableObject(ObjectType type, const glm::vec3& position, const glm::vec3& size)
-    : type(type), position(position), size(size) {}
+    : type(type), position(position), size(size), color(1.0f) {}
 
 void EditableObject::update() {
     // Base implementation - can be overridden by derived classes
 }
 
+ProceduralMeshKey EditableObject::getMeshKey() const {
+    return ProceduralMeshKey{ type, 0.0f, 0, 0.0f };
+}
+
+std::shared_ptr<const ProceduralMesh> EditableObject::getMesh() const {
+    if (!mesh) {
+        mesh = ProceduralMeshCache::instance().acquire(getMeshKey());
+    }
+    return mesh;
+}
+
 // Wall implementation
 Wall::Wall(const glm::vec3& position, const glm::vec3& size)
     : EditableObject(ObjectType::WALL, position, size) {}
 
 void Wall::render() const {
     glPushMatrix();
-    glTranslatef(position.x, position.y, position.z);
     glScalef(size.x, size.y, size.z);
-    
-    glBegin(GL_QUADS);
-    // Front face
-    glColor3f(0.8f, 0.8f, 0.8f);
-    glVertex3f(-0.5f, -0.5f, 0.5f);
-    glVertex3f(0.5f, -0.5f, 0.5f);
-    glVertex3f(0.5f, 0.5f, 0.5f);
-    glVertex3f(-0.5f, 0.5f, 0.5f);
-    
-    // Back face
-    glColor3f(0.7f, 0.7f, 0.7f);
-    glVertex3f(-0.5f, -0.5f, -0.5f);
-    glVertex3f(-0.5f, 0.5f, -0.5f);
-    glVertex3f(0.5f, 0.5f, -0.5f);
-    glVertex3f(0.5f, -0.5f, -0.5f);
-    glEnd();
-    
+    getMesh()->draw(color);
     glPopMatrix();
 }
 
@@ -88,25 +85,8 @@ Rectangle::Rectangle(const glm::vec3& position, const glm::vec3& size)
 
 void Rectangle::render() const {
     glPushMatrix();
-    glTranslatef(position.x, position.y, position.z);
     glScalef(size.x, size.y, size.z);
-    
-    glBegin(GL_QUADS);
-    // Top face
-    glColor3f(0.6f, 0.8f, 0.6f);
-    glVertex3f(-0.5f, 0.5f, -0.5f);
-    glVertex3f(-0.5f, 0.5f, 0.5f);
-    glVertex3f(0.5f, 0.5f, 0.5f);
-    glVertex3f(0.5f, 0.5f, -0.5f);
-    
-    // Bottom face
-    glColor3f(0.4f, 0.6f, 0.4f);
-    glVertex3f(-0.5f, -0.5f, -0.5f);
-    glVertex3f(0.5f, -0.5f, -0.5f);
-    glVertex3f(0.5f, -0.5f, 0.5f);
-    glVertex3f(-0.5f, -0.5f, 0.5f);
-    glEnd();
-    
+    getMesh()->draw(color);
     glPopMatrix();
 }
 
@@ -165,137 +145,15 @@ PredefinedObject::PredefinedObject(ObjectType type, const glm::vec3& position, c
 
 void PredefinedObject::render() const {
     glPushMatrix();
-    glTranslatef(position.x, position.y, position.z);
     glScalef(size.x, size.y, size.z);
-    
-    switch (type) {
-        case ObjectType::HOUSE: {
-            // Draw house body
-            glColor3f(color.x, color.y, color.z);
-            glBegin(GL_QUADS);
-            // Front face
-            glVertex3f(-0.5f, -0.5f, 0.5f);
-            glVertex3f(0.5f, -0.5f, 0.5f);
-            glVertex3f(0.5f, 0.5f, 0.5f);
-            glVertex3f(-0.5f, 0.5f, 0.5f);
-            
-            // Back face
-            glVertex3f(-0.5f, -0.5f, -0.5f);
-            glVertex3f(-0.5f, 0.5f, -0.5f);
-            glVertex3f(0.5f, 0.5f, -0.5f);
-            glVertex3f(0.5f, -0.5f, -0.5f);
-            glEnd();
-            
-            // Draw roof
-            glColor3f(0.6f, 0.3f, 0.0f); // Brown color for roof
-            glBegin(GL_TRIANGLES);
-            glVertex3f(-0.5f, 0.5f, 0.5f);
-            glVertex3f(0.5f, 0.5f, 0.5f);
-            glVertex3f(0.0f, 0.5f + roofHeight, 0.0f);
-            
-            glVertex3f(-0.5f, 0.5f, -0.5f);
-            glVertex3f(0.5f, 0.5f, -0.5f);
-            glVertex3f(0.0f, 0.5f + roofHeight, 0.0f);
-            glEnd();
-            
-            // Draw windows
-            glColor3f(0.7f, 0.9f, 1.0f); // Light blue for windows
-            float windowSpacing = 1.0f / (windowCount + 1);
-            float windowSize = 0.2f;
-            
-            for (int i = 0; i < windowCount; ++i) {
-                float x = -0.5f + (i + 1) * windowSpacing;
-                glBegin(GL_QUADS);
-                glVertex3f(x - windowSize/2, 0.0f, 0.51f);
-                glVertex3f(x + windowSize/2, 0.0f, 0.51f);
-                glVertex3f(x + windowSize/2, windowSize, 0.51f);
-                glVertex3f(x - windowSize/2, windowSize, 0.51f);
-                glEnd();
-            }
-            
-            // Draw door
-            glColor3f(0.4f, 0.2f, 0.0f); // Brown color for door
-            glBegin(GL_QUADS);
-            glVertex3f(-doorWidth/2, -0.5f, 0.51f);
-            glVertex3f(doorWidth/2, -0.5f, 0.51f);
-            glVertex3f(doorWidth/2, 0.0f, 0.51f);
-            glVertex3f(-doorWidth/2, 0.0f, 0.51f);
-            glEnd();
-            break;
-        }
-        
-        case ObjectType::TOWER: {
-            // Draw tower body
-            glColor3f(color.x, color.y, color.z);
-            glBegin(GL_QUADS);
-            // Front face
-            glVertex3f(-0.3f, -0.5f, 0.3f);
-            glVertex3f(0.3f, -0.5f, 0.3f);
-            glVertex3f(0.3f, 0.5f, 0.3f);
-            glVertex3f(-0.3f, 0.5f, 0.3f);
-            
-            // Back face
-            glVertex3f(-0.3f, -0.5f, -0.3f);
-            glVertex3f(-0.3f, 0.5f, -0.3f);
-            glVertex3f(0.3f, 0.5f, -0.3f);
-            glVertex3f(0.3f, -0.5f, -0.3f);
-            glEnd();
-            
-            // Draw windows on each side
-            glColor3f(0.7f, 0.9f, 1.0f);
-            float windowSize = 0.15f;
-            
-            // Front windows
-            for (int i = 0; i < windowCount; ++i) {
-                float y = -0.4f + (i * 0.8f / (windowCount - 1));
-                glBegin(GL_QUADS);
-                glVertex3f(-windowSize/2, y - windowSize/2, 0.31f);
-                glVertex3f(windowSize/2, y - windowSize/2, 0.31f);
-                glVertex3f(windowSize/2, y + windowSize/2, 0.31f);
-                glVertex3f(-windowSize/2, y + windowSize/2, 0.31f);
-                glEnd();
-            }
-            break;
-        }
-        
-        case ObjectType::BRIDGE: {
-            // Draw bridge body
-            glColor3f(color.x, color.y, color.z);
-            glBegin(GL_QUADS);
-            // Top face
-            glVertex3f(-0.5f, 0.0f, -0.2f);
-            glVertex3f(-0.5f, 0.0f, 0.2f);
-            glVertex3f(0.5f, 0.0f, 0.2f);
-            glVertex3f(0.5f, 0.0f, -0.2f);
-            
-            // Bottom face
-            glVertex3f(-0.5f, -0.1f, -0.2f);
-            glVertex3f(0.5f, -0.1f, -0.2f);
-            glVertex3f(0.5f, -0.1f, 0.2f);
-            glVertex3f(-0.5f, -0.1f, 0.2f);
-            glEnd();
-            
-            // Draw supports
-            glColor3f(0.4f, 0.4f, 0.4f);
-            float supportWidth = 0.1f;
-            float supportSpacing = 1.0f / (windowCount + 1);
-            
-            for (int i = 0; i < windowCount; ++i) {
-                float x = -0.5f + (i + 1) * supportSpacing;
-                glBegin(GL_QUADS);
-                glVertex3f(x - supportWidth/2, -0.1f, -0.2f);
-                glVertex3f(x - supportWidth/2, -0.1f, 0.2f);
-                glVertex3f(x + supportWidth/2, -0.1f, 0.2f);
-                glVertex3f(x + supportWidth/2, -0.1f, -0.2f);
-                glEnd();
-            }
-            break;
-        }
-    }
-    
+    getMesh()->draw(color);
     glPopMatrix();
 }
 
+ProceduralMeshKey PredefinedObject::getMeshKey() const {
+    return ProceduralMeshKey{ type, roofHeight, windowCount, doorWidth };
+}
+
 void PredefinedObject::renderPreview() const {
     // Similar to render() but with transparency
     glEnable(GL_BLEND);
@@ -323,8 +181,23 @@ void PredefinedObject::update() {
 }
 
 // WorldEditor implementation
+namespace {
+    const uint32_t NO_OBJECT = 0xFFFFFFFFu;
+
+    // The mesh's unit-space bounds at the object's size, which the world matrix leaves out
+    AABB scaledMeshBounds(const EntityStore& entities, size_t index) {
+        const AABB& meshBounds = entities.getMeshEntry(entities.getMeshId(index)).bounds;
+        if (meshBounds.isEmpty()) return AABB();
+        const glm::vec3& size = entities.getSize(index);
+        glm::vec3 a = meshBounds.min * size;
+        glm::vec3 b = meshBounds.max * size;
+        return AABB(glm::min(a, b), glm::max(a, b));
+    }
+}
+
 WorldEditor::WorldEditor()
-    : selectedObjectIndex(0)
+    : pickTreeDirty(false)
+    , replayingEdit(false)
     , isEditing(false)
     , currentObjectType(ObjectType::WALL)
     , selectedInventoryIndex(0)
@@ -344,22 +217,112 @@ WorldEditor::WorldEditor()
 
 WorldEditor::~WorldEditor() = default;
 
+// Objects have no behaviour of their own; an update is the transform system
+// bringing world matrices and pick state up to date
 void WorldEditor::update() {
-    for (auto& obj : objects) {
-        obj->update();
+    refreshWorldState();
+}
+
+void WorldEditor::refreshWorldState() const {
+    for (TransformId node : boundsChangedNodes) {
+        if (!transforms.isValid(node) || node >= nodeObjects.size() || nodeObjects[node] == NO_OBJECT) continue;
+        size_t index = nodeObjects[node];
+        transforms.setLocalBounds(node, scaledMeshBounds(entities, index));
+    }
+    boundsChangedNodes.clear();
+
+    changedNodes.clear();
+    transforms.updateWorldMatrices(&changedNodes);
+    for (TransformId node : changedNodes) {
+        if (node >= nodeObjects.size() || nodeObjects[node] == NO_OBJECT) continue;
+        markPickChanged(nodeObjects[node]);
     }
 }
 
-void WorldEditor::render() const {
-    for (const auto& obj : objects) {
-        obj->render();
+void WorldEditor::markPickChanged(size_t index) const {
+    // A rebuild is due anyway, or the object is newer than the tree
+    if (pickTreeDirty || index >= pickBounds.size()) return;
+    // After this many moves without a pick, a fresh tree beats a refit
+    if (pickChangedObjects.size() >= pickBounds.size()) {
+        pickChangedObjects.clear();
+        pickTreeDirty = true;
+        return;
     }
+    pickChangedObjects.push_back(index);
 }
 
-void WorldEditor::renderPreview(const glm::vec3& position, const glm::vec3& size) const {
-    if (!isPlacing) return;
+// Bounds system: world bounds as the hierarchy computed them from the scaled
+// mesh bounds, plus the inverse of the scaled world matrix for the triangle test
+void WorldEditor::updatePickBounds(size_t index) const {
+    TransformId node = entities.getNode(index);
+    glm::mat4 model = transforms.getWorldMatrix(node);
+    const glm::vec3& size = entities.getSize(index);
+    model[0] *= size.x;
+    model[1] *= size.y;
+    model[2] *= size.z;
+    pickBounds[index] = transforms.getWorldBounds(node);
+    pickInverseModels[index] = glm::inverse(model);
+}
+
+void WorldEditor::rebuildPickTree() const {
+    pickBounds.resize(entities.size());
+    pickInverseModels.resize(entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        updatePickBounds(i);
+    }
+    pickTree.build(pickBounds);
+    pickChangedObjects.clear();
+    pickTreeDirty = false;
+}
+
+bool WorldEditor::pick(const Ray& ray, float maxDistance, PickHit& hit, bool refineTriangles) const {
+    refreshWorldState();
+    if (pickTreeDirty) {
+        rebuildPickTree();
+    } else if (!pickChangedObjects.empty()) {
+        for (size_t index : pickChangedObjects) {
+            updatePickBounds(index);
+        }
+        pickChangedObjects.clear();
+        pickTree.refit(pickBounds);
+    }
+
+    auto intersectObject = [&](uint32_t index, float& t) {
+        if (!refineTriangles) return true;
+
+        // Triangles stay in mesh space; the ray goes there instead. Its
+        // direction is not renormalised, so t carries over unchanged.
+        const glm::mat4& toLocal = pickInverseModels[index];
+        Ray localRay(glm::vec3(toLocal * glm::vec4(ray.origin, 1.0f)), glm::vec3(toLocal * glm::vec4(ray.direction, 0.0f)));
+        const ProceduralMesh& mesh = *entities.getMesh(index);
+        const std::vector<ProceduralVertex>& vertices = mesh.getVertices();
+        const std::vector<uint32_t>& indices = mesh.getIndices();
+        bool found = false;
+        float closest = maxDistance;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            float triangleT;
+            if (intersectRayTriangle(localRay, vertices[indices[i]].position, vertices[indices[i + 1]].position,
+                                     vertices[indices[i + 2]].position, triangleT) && triangleT < closest) {
+                closest = triangleT;
+                found = true;
+            }
+        }
+        t = closest;
+        return found;
+    };
 
-    switch (selectedInventoryItem) {
+    float t;
+    uint32_t index = pickTree.raycast(ray, maxDistance, intersectObject, t);
+    if (index == BVH::NO_ITEM) return false;
+
+    hit.objectIndex = index;
+    hit.point = ray.at(t);
+    hit.distance = t;
+    return true;
+}
+
+void renderObjectPreview(ObjectType type, const glm::vec3& position, const glm::vec3& size) {
+    switch (type) {
         case ObjectType::WALL: {
             Wall previewWall(position, size);
             previewWall.renderPreview();
@@ -373,7 +336,7 @@ void WorldEditor::renderPreview(const glm::vec3& position, const glm::vec3& size
         case ObjectType::HOUSE:
         case ObjectType::TOWER:
         case ObjectType::BRIDGE: {
-            PredefinedObject previewObj(selectedInventoryItem, position, size);
+            PredefinedObject previewObj(type, position, size);
             previewObj.renderPreview();
             break;
         }
@@ -382,93 +345,525 @@ void WorldEditor::renderPreview(const glm::vec3& position, const glm::vec3& size
     }
 }
 
+void WorldEditor::renderPreview(const glm::vec3& position, const glm::vec3& size) const {
+    if (!isPlacing) return;
+    renderObjectPreview(selectedInventoryItem, position, size);
+}
+
+void WorldEditor::captureSnapshot(FrameSnapshot& out) const {
+    refreshWorldState();
+
+    // Each distinct mesh is referenced once; objects point into the list
+    std::vector<uint32_t> meshSlots;
+    const std::vector<ObjectType>& types = entities.getTypes();
+    const std::vector<glm::vec3>& sizes = entities.getSizes();
+    const std::vector<glm::vec3>& colors = entities.getColors();
+    const std::vector<TransformId>& nodes = entities.getNodes();
+    out.meshes.clear();
+    out.objects.resize(entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        uint32_t meshId = entities.getMeshId(i);
+        if (meshId >= meshSlots.size()) {
+            meshSlots.resize(entities.getMeshCount(), NO_OBJECT);
+        }
+        if (meshSlots[meshId] == NO_OBJECT) {
+            meshSlots[meshId] = static_cast<uint32_t>(out.meshes.size());
+            out.meshes.push_back(entities.getMeshEntry(meshId).mesh);
+        }
+
+        SnapshotObject& object = out.objects[i];
+        object.key = nodes[i];
+        object.meshIndex = meshSlots[meshId];
+        object.material = static_cast<uint32_t>(types[i]);
+        object.model = transforms.getWorldMatrix(nodes[i]);
+        object.model[0] *= sizes[i].x;
+        object.model[1] *= sizes[i].y;
+        object.model[2] *= sizes[i].z;
+        object.color = glm::vec4(colors[i], 1.0f);
+    }
+
+    out.showPreview = isPlacing;
+    out.previewType = selectedInventoryItem;
+    out.inventoryItems = inventoryItems;
+    out.selectedInventoryIndex = selectedInventoryIndex;
+}
+
+bool WorldEditor::insertObject(size_t index, ObjectType type, const glm::vec3& position, const glm::vec3& size,
+                               TransformId parent) {
+    if (!EntityStore::isPlaceable(type) || index > entities.size()) return false;
+
+    TransformId node = transforms.createNode(parent);
+    transforms.setLocalPosition(node, position);
+    if (node >= nodeObjects.size()) {
+        nodeObjects.resize(node + 1, NO_OBJECT);
+        nodeChildCounts.resize(node + 1, 0);
+    }
+    nodeChildCounts[node] = 0;
+    if (transforms.isValid(parent)) ++nodeChildCounts[parent];
+
+    // The object at index, if any, moves to the end
+    size_t last = entities.size();
+    entities.insert(index, type, position, size, node);
+    nodeObjects[node] = static_cast<uint32_t>(index);
+    boundsChangedNodes.push_back(node);
+    if (index < last) nodeObjects[entities.getNode(last)] = static_cast<uint32_t>(last);
+    selectedObject = entities.getHandle(index);
+    pickTreeDirty = true;
+    return true;
+}
+
+namespace {
+    // The object alone; removal fills in where it sits in the hierarchy
+    ObjectState describeObject(const EntityStore& entities, size_t index) {
+        ObjectState state;
+        state.type = entities.getType(index);
+        state.position = entities.getPosition(index);
+        state.size = entities.getSize(index);
+        state.color = entities.getColor(index);
+        if (entities.hasParams(index)) {
+            const PredefinedParams& params = entities.getParams(index);
+            state.wallThickness = params.wallThickness;
+            state.roofHeight = params.roofHeight;
+            state.windowCount = params.windowCount;
+            state.doorWidth = params.doorWidth;
+        }
+        return state;
+    }
+
+    glm::vec3 propertyValue(const EntityStore& entities, size_t index, ObjectProperty property) {
+        const PredefinedParams& params = entities.getParams(index);
+        switch (property) {
+            case ObjectProperty::COLOR:
+                return entities.getColor(index);
+            case ObjectProperty::WALL_THICKNESS:
+                return glm::vec3(params.wallThickness, 0.0f, 0.0f);
+            case ObjectProperty::ROOF_HEIGHT:
+                return glm::vec3(params.roofHeight, 0.0f, 0.0f);
+            case ObjectProperty::WINDOW_COUNT:
+                return glm::vec3(static_cast<float>(params.windowCount), 0.0f, 0.0f);
+            case ObjectProperty::DOOR_WIDTH:
+                return glm::vec3(params.doorWidth, 0.0f, 0.0f);
+        }
+        return glm::vec3(0.0f);
+    }
+}
+
 void WorldEditor::addObject(ObjectType type, const glm::vec3& position, const glm::vec3& size) {
-    std::unique_ptr<EditableObject> obj;
-    
-    switch (type) {
-        case ObjectType::WALL:
-            obj = std::make_unique<Wall>(position, size);
-            break;
-        case ObjectType::RECTANGLE:
-            obj = std::make_unique<Rectangle>(position, size);
-            break;
-        case ObjectType::HOUSE:
-        case ObjectType::TOWER:
-        case ObjectType::BRIDGE:
-            obj = std::make_unique<PredefinedObject>(type, position, size);
-            break;
-        default:
-            return;
+    size_t index = entities.size();
+    if (!insertObject(index, type, position, size, INVALID_TRANSFORM)) return;
+
+    if (!replayingEdit) {
+        Edit edit;
+        edit.kind = EditKind::ADD;
+        edit.objectIndex = static_cast<uint32_t>(index);
+        edit.object = describeObject(entities, index);
+        noteEdit(edit);
     }
-    
-    objects.push_back(std::move(obj));
-    selectedObjectIndex = objects.size() - 1;
+}
+
+// Puts a removed object back with its place in the hierarchy: under its old
+// parent, and over the children removal handed to that parent
+void WorldEditor::restoreObject(size_t index, const ObjectState& state) {
+    // Indices from the journal are from before the removal, when the object
+    // that filled the hole was still last; until the insert puts it back there
+    // it is at index
+    TransformId parent = INVALID_TRANSFORM;
+    size_t parentIndex = state.parentIndex == entities.size() ? index : state.parentIndex;
+    if (state.parentIndex != ObjectState::NO_PARENT && parentIndex < entities.size()) {
+        parent = entities.getNode(parentIndex);
+    }
+    if (!insertObject(index, state.type, state.position, state.size, parent)) return;
+
+    entities.setColor(index, state.color);
+    PredefinedParams params;
+    params.wallThickness = state.wallThickness;
+    params.roofHeight = state.roofHeight;
+    params.windowCount = state.windowCount;
+    params.doorWidth = state.doorWidth;
+    entities.setParams(index, params);
+
+    TransformId node = entities.getNode(index);
+    for (uint32_t childIndex : state.children) {
+        if (childIndex >= entities.size() || childIndex == index) continue;
+        TransformId childNode = entities.getNode(childIndex);
+        reparentNode(childNode, node);
+        entities.setPosition(childIndex, entities.getPosition(childIndex) - state.position);
+        transforms.setLocalPosition(childNode, entities.getPosition(childIndex));
+    }
+}
+
+void WorldEditor::removeObject(ObjectHandle handle) {
+    removeObject(entities.indexOf(handle));
 }
 
 void WorldEditor::removeObject(size_t index) {
-    if (index < objects.size()) {
-        objects.erase(objects.begin() + index);
-        if (selectedObjectIndex >= objects.size()) {
-            selectedObjectIndex = objects.size() > 0 ? objects.size() - 1 : 0;
+    if (index < entities.size()) {
+        Edit edit;
+        edit.kind = EditKind::REMOVE;
+        edit.objectIndex = static_cast<uint32_t>(index);
+        edit.object = describeObject(entities, index);
+
+        TransformId node = entities.getNode(index);
+        TransformId parent = transforms.getParent(node);
+        edit.object.parentIndex = static_cast<uint32_t>(findObject(parent));
+
+        // Children move up a level; fold our offset into theirs so they stay in
+        // place. Only objects with children pay for the search.
+        uint32_t children = nodeChildCounts[node];
+        glm::vec3 offset = entities.getPosition(index);
+        const std::vector<TransformId>& nodes = entities.getNodes();
+        for (size_t i = 0; i < nodes.size() && edit.object.children.size() < children; ++i) {
+            if (transforms.getParent(nodes[i]) == node) {
+                entities.setPosition(i, entities.getPosition(i) + offset);
+                transforms.setLocalPosition(nodes[i], entities.getPosition(i));
+                edit.object.children.push_back(static_cast<uint32_t>(i));
+            }
         }
+        if (parent != INVALID_TRANSFORM) nodeChildCounts[parent] += children - 1;
+        transforms.destroyNode(node);
+        nodeObjects[node] = NO_OBJECT;
+
+        // The last object fills the hole
+        entities.erase(index);
+        if (index < entities.size()) nodeObjects[entities.getNode(index)] = static_cast<uint32_t>(index);
+        pickTreeDirty = true;
+        noteEdit(edit);
+    }
+}
+
+bool WorldEditor::saveScene(const std::string& path) const {
+    return SceneFile::save(*this, path);
+}
+
+bool WorldEditor::loadScene(const std::string& path) {
+    SceneFile file;
+    if (!file.open(path)) return false;
+    loadScene(file);
+    return true;
+}
+
+void WorldEditor::loadScene(const SceneFile& file) {
+    entities.clear();
+    ThreadPool* pool = transforms.getThreadPool();
+    transforms = TransformHierarchy();
+    transforms.setThreadPool(pool);
+    nodeObjects.clear();
+    boundsChangedNodes.clear();
+    nodeChildCounts.clear();
+    pickChangedObjects.clear();
+    journal.clear();
+
+    size_t count = static_cast<size_t>(file.getObjectCount());
+    entities.reserve(count);
+    nodeObjects.reserve(count);
+    nodeChildCounts.reserve(count);
+    appendSceneObjects(file);
+    selectedObject = entities.empty() ? ObjectHandle() : entities.getHandle(0);
+    pickTreeDirty = true;
+}
+
+void WorldEditor::appendScene(const SceneFile& file, std::vector<ObjectHandle>& handles) {
+    ObjectHandle selection = selectedObject;
+    size_t first = entities.size();
+    appendSceneObjects(file);
+    handles.clear();
+    handles.reserve(entities.size() - first);
+    for (size_t i = first; i < entities.size(); ++i) {
+        handles.push_back(entities.getHandle(i));
+    }
+    selectedObject = selection;
+    journal.clear();
+}
+
+void WorldEditor::removeObjects(const std::vector<ObjectHandle>& handles) {
+    replayingEdit = true;
+    for (ObjectHandle handle : handles) {
+        removeObject(handle);
+    }
+    replayingEdit = false;
+    journal.clear();
+}
+
+// New objects reach the pick tree through its next rebuild
+void WorldEditor::appendSceneObjects(const SceneFile& file) {
+    // Records go back to their scene index
+    struct Source {
+        const SceneFile::Section* section;
+        uint32_t record;
+    };
+    size_t count = static_cast<size_t>(file.getObjectCount());
+    std::vector<Source> sources(count, Source{ nullptr, 0 });
+    for (const SceneFile::Section& section : file.getSections()) {
+        if (!EntityStore::isPlaceable(section.type)) continue;
+        for (uint32_t i = 0; i < section.count; ++i) {
+            uint32_t index = section.objects[i].index;
+            if (index < count && !sources[index].section) {
+                sources[index] = Source{ &section, i };
+            }
+        }
+    }
+
+    // Gaps a damaged file leaves are closed up
+    std::vector<uint32_t> loadedIndex(count, SceneFile::NO_PARENT);
+    for (size_t i = 0; i < count; ++i) {
+        const SceneFile::Section* section = sources[i].section;
+        if (!section) continue;
+        const SceneObjectRecord& record = section->objects[sources[i].record];
+        size_t index = entities.size();
+        insertObject(index, section->type, record.position, record.size, INVALID_TRANSFORM);
+        entities.setColor(index, record.color);
+        if (section->params) {
+            const ScenePredefinedParams& stored = section->params[sources[i].record];
+            PredefinedParams params;
+            params.wallThickness = stored.wallThickness;
+            params.roofHeight = stored.roofHeight;
+            params.windowCount = stored.windowCount;
+            params.doorWidth = stored.doorWidth;
+            entities.setParams(index, params);
+        }
+        loadedIndex[i] = static_cast<uint32_t>(index);
+    }
+
+    // Parents can come later in the scene, so they are linked once all exist
+    for (size_t i = 0; i < count; ++i) {
+        if (loadedIndex[i] == SceneFile::NO_PARENT) continue;
+        uint32_t parent = sources[i].section->objects[sources[i].record].parent;
+        if (parent >= count || parent == i || loadedIndex[parent] == SceneFile::NO_PARENT) continue;
+        reparentNode(entities.getNode(loadedIndex[i]), entities.getNode(loadedIndex[parent]));
     }
 }
 
 void WorldEditor::selectObject(size_t index) {
-    if (index < objects.size()) {
-        selectedObjectIndex = index;
+    if (index < entities.size()) {
+        selectedObject = entities.getHandle(index);
+    }
+}
+
+void WorldEditor::selectObject(ObjectHandle handle) {
+    if (entities.isValid(handle)) {
+        selectedObject = handle;
     }
 }
 
+size_t WorldEditor::getSelectedObjectIndex() const {
+    size_t index = entities.indexOf(selectedObject);
+    return index != EntityStore::NO_INDEX ? index : entities.size();
+}
+
 void WorldEditor::moveSelectedObject(const glm::vec3& offset) {
-    if (selectedObjectIndex < objects.size()) {
-        auto& obj = objects[selectedObjectIndex];
-        obj->setPosition(obj->getPosition() + offset);
+    size_t index = getSelectedObjectIndex();
+    if (index < entities.size()) {
+        setObjectPosition(index, entities.getPosition(index) + offset);
+    }
+}
+
+void WorldEditor::setObjectPosition(size_t index, const glm::vec3& position) {
+    if (index < entities.size()) {
+        recordValueEdit(EditKind::MOVE, ObjectProperty::COLOR, index, entities.getPosition(index), position);
+        entities.setPosition(index, position);
+        transforms.setLocalPosition(entities.getNode(index), position);
     }
 }
 
 void WorldEditor::resizeSelectedObject(const glm::vec3& newSize) {
-    if (selectedObjectIndex < objects.size()) {
-        objects[selectedObjectIndex]->setSize(newSize);
+    resizeObject(getSelectedObjectIndex(), newSize);
+}
+
+void WorldEditor::resizeObject(size_t index, const glm::vec3& size) {
+    if (index < entities.size()) {
+        recordValueEdit(EditKind::RESIZE, ObjectProperty::COLOR, index, entities.getSize(index), size);
+        entities.setSize(index, size);
+        boundsChangedNodes.push_back(entities.getNode(index));
+        markPickChanged(index);
     }
 }
 
+// Editor objects only carry translation, so keeping the world position while
+// re-parenting is a matter of swapping one offset for another.
+bool WorldEditor::setObjectParent(size_t childIndex, size_t parentIndex) {
+    if (childIndex >= entities.size() || parentIndex >= entities.size()) return false;
+
+    refreshWorldState();
+    TransformId childNode = entities.getNode(childIndex);
+    TransformId parentNode = entities.getNode(parentIndex);
+    glm::vec3 worldPosition = transforms.getWorldPosition(childNode);
+
+    Edit edit;
+    edit.kind = EditKind::PARENT;
+    edit.objectIndex = static_cast<uint32_t>(childIndex);
+    edit.before = entities.getPosition(childIndex);
+    edit.parentBefore = static_cast<uint32_t>(findObject(transforms.getParent(childNode)));
+    if (!reparentNode(childNode, parentNode)) return false;
+
+    entities.setPosition(childIndex, worldPosition - transforms.getWorldPosition(parentNode));
+    transforms.setLocalPosition(childNode, entities.getPosition(childIndex));
+    edit.after = entities.getPosition(childIndex);
+    edit.parentAfter = static_cast<uint32_t>(parentIndex);
+    noteEdit(edit);
+    return true;
+}
+
+void WorldEditor::clearObjectParent(size_t childIndex) {
+    if (childIndex >= entities.size()) return;
+
+    refreshWorldState();
+    TransformId childNode = entities.getNode(childIndex);
+    glm::vec3 worldPosition = transforms.getWorldPosition(childNode);
+
+    Edit edit;
+    edit.kind = EditKind::PARENT;
+    edit.objectIndex = static_cast<uint32_t>(childIndex);
+    edit.before = entities.getPosition(childIndex);
+    edit.parentBefore = static_cast<uint32_t>(findObject(transforms.getParent(childNode)));
+    if (edit.parentBefore == ObjectState::NO_PARENT) return;
+
+    reparentNode(childNode, INVALID_TRANSFORM);
+    entities.setPosition(childIndex, worldPosition);
+    transforms.setLocalPosition(childNode, worldPosition);
+    edit.after = worldPosition;
+    noteEdit(edit);
+}
+
+size_t WorldEditor::findObject(TransformId node) const {
+    if (node >= nodeObjects.size() || nodeObjects[node] == NO_OBJECT) return ObjectState::NO_PARENT;
+    return nodeObjects[node];
+}
+
+bool WorldEditor::reparentNode(TransformId node, TransformId parent) {
+    TransformId oldParent = transforms.getParent(node);
+    if (!transforms.setParent(node, parent)) return false;
+    if (oldParent != INVALID_TRANSFORM) --nodeChildCounts[oldParent];
+    if (transforms.isValid(parent)) ++nodeChildCounts[parent];
+    return true;
+}
+
+void WorldEditor::setParentDirect(size_t index, uint32_t parentIndex, const glm::vec3& localPosition) {
+    if (index >= entities.size()) return;
+    TransformId node = entities.getNode(index);
+    TransformId parent = parentIndex < entities.size() ? entities.getNode(parentIndex) : INVALID_TRANSFORM;
+    if (!reparentNode(node, parent)) return;
+    entities.setPosition(index, localPosition);
+    transforms.setLocalPosition(node, localPosition);
+}
+
+glm::vec3 WorldEditor::getObjectWorldPosition(size_t index) const {
+    if (index >= entities.size()) return glm::vec3(0.0f);
+    refreshWorldState();
+    return transforms.getWorldPosition(entities.getNode(index));
+}
+
 void WorldEditor::setSelectedObjectColor(const glm::vec3& color) {
-    if (selectedObjectIndex < objects.size()) {
-        objects[selectedObjectIndex]->setColor(color);
-    }
+    setObjectProperty(getSelectedObjectIndex(), ObjectProperty::COLOR, color);
 }
 
 void WorldEditor::setSelectedObjectWallThickness(float thickness) {
-    if (selectedObjectIndex < objects.size()) {
-        if (auto* predefined = dynamic_cast<PredefinedObject*>(objects[selectedObjectIndex].get())) {
-            predefined->setWallThickness(thickness);
-        }
-    }
+    setObjectProperty(getSelectedObjectIndex(), ObjectProperty::WALL_THICKNESS, glm::vec3(thickness, 0.0f, 0.0f));
 }
 
 void WorldEditor::setSelectedObjectRoofHeight(float height) {
-    if (selectedObjectIndex < objects.size()) {
-        if (auto* predefined = dynamic_cast<PredefinedObject*>(objects[selectedObjectIndex].get())) {
-            predefined->setRoofHeight(height);
-        }
-    }
+    setObjectProperty(getSelectedObjectIndex(), ObjectProperty::ROOF_HEIGHT, glm::vec3(height, 0.0f, 0.0f));
 }
 
 void WorldEditor::setSelectedObjectWindowCount(int count) {
-    if (selectedObjectIndex < objects.size()) {
-        if (auto* predefined = dynamic_cast<PredefinedObject*>(objects[selectedObjectIndex].get())) {
-            predefined->setWindowCount(count);
-        }
-    }
+    setObjectProperty(getSelectedObjectIndex(), ObjectProperty::WINDOW_COUNT, glm::vec3(static_cast<float>(count), 0.0f, 0.0f));
 }
 
 void WorldEditor::setSelectedObjectDoorWidth(float width) {
-    if (selectedObjectIndex < objects.size()) {
-        if (auto* predefined = dynamic_cast<PredefinedObject*>(objects[selectedObjectIndex].get())) {
-            predefined->setDoorWidth(width);
-        }
+    setObjectProperty(getSelectedObjectIndex(), ObjectProperty::DOOR_WIDTH, glm::vec3(width, 0.0f, 0.0f));
+}
+
+// Scalar properties travel in x; all but the color are for houses, towers and bridges only
+void WorldEditor::setObjectProperty(size_t index, ObjectProperty property, const glm::vec3& value) {
+    if (index >= entities.size()) return;
+    if (property != ObjectProperty::COLOR && !entities.hasParams(index)) return;
+
+    recordValueEdit(EditKind::PROPERTY, property, index, propertyValue(entities, index, property), value);
+    PredefinedParams params = entities.getParams(index);
+    switch (property) {
+        case ObjectProperty::COLOR:
+            entities.setColor(index, value);
+            break;
+        case ObjectProperty::WALL_THICKNESS:
+            params.wallThickness = value.x;
+            break;
+        case ObjectProperty::ROOF_HEIGHT:
+            params.roofHeight = value.x;
+            break;
+        case ObjectProperty::WINDOW_COUNT:
+            params.windowCount = static_cast<int>(value.x);
+            break;
+        case ObjectProperty::DOOR_WIDTH:
+            params.doorWidth = value.x;
+            break;
+    }
+    entities.setParams(index, params);
+    if (property != ObjectProperty::COLOR) boundsChangedNodes.push_back(entities.getNode(index));
+    markPickChanged(index);
+}
+
+void WorldEditor::recordValueEdit(EditKind kind, ObjectProperty property, size_t index,
+                                  const glm::vec3& before, const glm::vec3& after) {
+    if (replayingEdit || before == after) return;
+    Edit edit;
+    edit.kind = kind;
+    edit.property = property;
+    edit.objectIndex = static_cast<uint32_t>(index);
+    edit.before = before;
+    edit.after = after;
+    noteEdit(edit);
+}
+
+void WorldEditor::noteEdit(const Edit& edit) {
+    if (replayingEdit) return;
+    journal.record(edit);
+    if (editListener) editListener(edit);
+}
+
+bool WorldEditor::undo() {
+    Edit edit;
+    if (!journal.undo(edit)) return false;
+    applyEdit(edit, false);
+    return true;
+}
+
+bool WorldEditor::redo() {
+    Edit edit;
+    if (!journal.redo(edit)) return false;
+    applyEdit(edit, true);
+    return true;
+}
+
+void WorldEditor::replayEdit(const Edit& edit) {
+    replayingEdit = true;
+    switch (edit.kind) {
+        case EditKind::ADD:
+            restoreObject(edit.objectIndex, edit.object);
+            break;
+        case EditKind::REMOVE:
+            removeObject(edit.objectIndex);
+            break;
+        case EditKind::MOVE:
+            setObjectPosition(edit.objectIndex, edit.after);
+            break;
+        case EditKind::RESIZE:
+            resizeObject(edit.objectIndex, edit.after);
+            break;
+        case EditKind::PROPERTY:
+            setObjectProperty(edit.objectIndex, edit.property, edit.after);
+            break;
+        case EditKind::PARENT:
+            setParentDirect(edit.objectIndex, edit.parentAfter, edit.after);
+            break;
     }
+    replayingEdit = false;
+}
+
+// Undo reports the inverse, so listeners only ever see changes going forward
+void WorldEditor::applyEdit(const Edit& edit, bool forward) {
+    Edit change = forward ? edit : inverseEdit(edit);
+    replayEdit(change);
+    if (editListener) editListener(change);
+    selectObject(change.objectIndex);
 }
 
 void WorldEditor::selectInventoryItem(size_t index) {
@@ -0,0 +1,196 @@
+#include "../../include/editor/entity_store.h"
+#include "../../include/editor/editor.h"
+#include <utility>
+
+namespace Editor {
+
+namespace {
+    const PredefinedParams DEFAULT_PARAMS;
+}
+
+const uint32_t EntityStore::NO_PARAMS;
+const uint32_t EntityStore::NO_MESH;
+const size_t EntityStore::NO_INDEX;
+const uint32_t ObjectHandle::NO_SLOT;
+
+bool EntityStore::isPredefined(ObjectType type) {
+    return type == ObjectType::HOUSE || type == ObjectType::TOWER || type == ObjectType::BRIDGE;
+}
+
+bool EntityStore::isPlaceable(ObjectType type) {
+    return type == ObjectType::WALL || type == ObjectType::RECTANGLE || isPredefined(type);
+}
+
+void EntityStore::reserve(size_t count) {
+    types.reserve(count);
+    positions.reserve(count);
+    sizes.reserve(count);
+    colors.reserve(count);
+    nodes.reserve(count);
+    paramSlots.reserve(count);
+    meshIds.reserve(count);
+    handleSlots.reserve(count);
+    slots.reserve(count);
+}
+
+void EntityStore::clear() {
+    for (size_t i = 0; i < meshIds.size(); ++i) {
+        releaseMesh(i);
+    }
+    for (uint32_t slot : handleSlots) {
+        ++slots[slot].generation;
+        freeSlots.push_back(slot);
+    }
+    types.clear();
+    positions.clear();
+    sizes.clear();
+    colors.clear();
+    nodes.clear();
+    paramSlots.clear();
+    meshIds.clear();
+    handleSlots.clear();
+    params.clear();
+    paramOwners.clear();
+}
+
+void EntityStore::insert(size_t index, ObjectType type, const glm::vec3& position, const glm::vec3& size,
+                         TransformId node) {
+    bool predefined = isPredefined(type);
+    size_t last = types.size();
+    uint32_t slot = NO_PARAMS;
+    if (predefined) {
+        slot = static_cast<uint32_t>(params.size());
+        params.push_back(DEFAULT_PARAMS);
+        paramOwners.push_back(static_cast<uint32_t>(last));
+    }
+
+    uint32_t handleSlot;
+    if (!freeSlots.empty()) {
+        handleSlot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        handleSlot = static_cast<uint32_t>(slots.size());
+        slots.push_back(Slot{ 0, 0 });
+    }
+    slots[handleSlot].entity = static_cast<uint32_t>(last);
+
+    types.push_back(type);
+    positions.push_back(position);
+    sizes.push_back(size);
+    colors.push_back(predefined ? glm::vec3(0.8f) : glm::vec3(1.0f));
+    nodes.push_back(node);
+    paramSlots.push_back(slot);
+    meshIds.push_back(NO_MESH);
+    handleSlots.push_back(handleSlot);
+    if (index < last) swapEntities(index, last);
+}
+
+void EntityStore::erase(size_t index) {
+    size_t last = types.size() - 1;
+    if (index != last) swapEntities(index, last);
+    releaseMesh(last);
+
+    // The last parameter slot fills the hole
+    uint32_t slot = paramSlots[last];
+    if (slot != NO_PARAMS) {
+        uint32_t lastSlot = static_cast<uint32_t>(params.size() - 1);
+        if (slot != lastSlot) {
+            params[slot] = params[lastSlot];
+            paramOwners[slot] = paramOwners[lastSlot];
+            paramSlots[paramOwners[slot]] = slot;
+        }
+        params.pop_back();
+        paramOwners.pop_back();
+    }
+    ++slots[handleSlots[last]].generation;
+    freeSlots.push_back(handleSlots[last]);
+
+    types.pop_back();
+    positions.pop_back();
+    sizes.pop_back();
+    colors.pop_back();
+    nodes.pop_back();
+    paramSlots.pop_back();
+    meshIds.pop_back();
+    handleSlots.pop_back();
+}
+
+void EntityStore::swapEntities(size_t a, size_t b) {
+    std::swap(types[a], types[b]);
+    std::swap(positions[a], positions[b]);
+    std::swap(sizes[a], sizes[b]);
+    std::swap(colors[a], colors[b]);
+    std::swap(nodes[a], nodes[b]);
+    std::swap(paramSlots[a], paramSlots[b]);
+    std::swap(meshIds[a], meshIds[b]);
+    std::swap(handleSlots[a], handleSlots[b]);
+    for (size_t index : { a, b }) {
+        if (paramSlots[index] != NO_PARAMS) paramOwners[paramSlots[index]] = static_cast<uint32_t>(index);
+        slots[handleSlots[index]].entity = static_cast<uint32_t>(index);
+    }
+}
+
+const PredefinedParams& EntityStore::getParams(size_t index) const {
+    uint32_t slot = paramSlots[index];
+    return slot != NO_PARAMS ? params[slot] : DEFAULT_PARAMS;
+}
+
+void EntityStore::setParams(size_t index, const PredefinedParams& values) {
+    uint32_t slot = paramSlots[index];
+    if (slot == NO_PARAMS) return;
+    PredefinedParams& current = params[slot];
+    bool sameGeometry = current.roofHeight == values.roofHeight && current.windowCount == values.windowCount
+        && current.doorWidth == values.doorWidth;
+    current = values;
+    // Wall thickness is kept for the scene but does not change the mesh
+    if (!sameGeometry) releaseMesh(index);
+}
+
+ProceduralMeshKey EntityStore::getMeshKey(size_t index) const {
+    if (!hasParams(index)) {
+        return ProceduralMeshKey{ types[index], 0.0f, 0, 0.0f };
+    }
+    const PredefinedParams& values = getParams(index);
+    return ProceduralMeshKey{ types[index], values.roofHeight, values.windowCount, values.doorWidth };
+}
+
+uint32_t EntityStore::resolveMesh(size_t index) const {
+    std::shared_ptr<const ProceduralMesh> mesh = ProceduralMeshCache::instance().acquire(getMeshKey(index));
+    auto it = meshTableIds.find(mesh.get());
+    if (it == meshTableIds.end()) {
+        uint32_t id;
+        if (!freeMeshIds.empty()) {
+            id = freeMeshIds.back();
+            freeMeshIds.pop_back();
+        } else {
+            id = static_cast<uint32_t>(meshTable.size());
+            meshTable.emplace_back();
+        }
+        MeshEntry& entry = meshTable[id];
+        entry.bounds = AABB();
+        for (const ProceduralVertex& vertex : mesh->getVertices()) {
+            entry.bounds.expand(vertex.position);
+        }
+        it = meshTableIds.emplace(mesh.get(), id).first;
+        entry.mesh = std::move(mesh);
+    }
+    ++meshTable[it->second].users;
+    meshIds[index] = it->second;
+    return it->second;
+}
+
+// The mesh itself lives on while batches still hold it; the cache only has a weak entry
+void EntityStore::releaseMesh(size_t index) {
+    uint32_t id = meshIds[index];
+    if (id == NO_MESH) return;
+    meshIds[index] = NO_MESH;
+    MeshEntry& entry = meshTable[id];
+    if (--entry.users > 0) return;
+    meshTableIds.erase(entry.mesh.get());
+    entry.mesh.reset();
+    ++entry.generation;
+    freeMeshIds.push_back(id);
+    ++meshReleases;
+}
+
+} // namespace Editor
@@ -0,0 +1,229 @@
+#include <GL/glew.h>
+#include "../../include/editor/procedural_mesh.h"
+#include "../../include/editor/editor.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+namespace Editor {
+
+namespace {
+    const glm::vec3 BODY_COLOR(1.0f);           // Replaced by the object color when drawn
+    const glm::vec3 ROOF_COLOR(0.6f, 0.3f, 0.0f);
+    const glm::vec3 WINDOW_COLOR(0.7f, 0.9f, 1.0f);
+    const glm::vec3 DOOR_COLOR(0.4f, 0.2f, 0.0f);
+    const glm::vec3 SUPPORT_COLOR(0.4f, 0.4f, 0.4f);
+    const glm::vec3 WALL_FRONT_COLOR(0.8f, 0.8f, 0.8f);
+    const glm::vec3 WALL_BACK_COLOR(0.7f, 0.7f, 0.7f);
+    const glm::vec3 RECTANGLE_TOP_COLOR(0.6f, 0.8f, 0.6f);
+    const glm::vec3 RECTANGLE_BOTTOM_COLOR(0.4f, 0.6f, 0.4f);
+
+    inline void hashCombine(size_t& seed, size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+}
+
+size_t ProceduralMeshKeyHash::operator()(const ProceduralMeshKey& key) const {
+    size_t seed = std::hash<int>()(static_cast<int>(key.type));
+    hashCombine(seed, std::hash<float>()(key.roofHeight));
+    hashCombine(seed, std::hash<int>()(key.windowCount));
+    hashCombine(seed, std::hash<float>()(key.doorWidth));
+    return seed;
+}
+
+// ProceduralMesh implementation
+void ProceduralMesh::addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& color) {
+    uint32_t base = static_cast<uint32_t>(vertices.size());
+    vertices.push_back({ a, color });
+    vertices.push_back({ b, color });
+    vertices.push_back({ c, color });
+    indices.insert(indices.end(), { base, base + 1, base + 2 });
+}
+
+void ProceduralMesh::addQuad(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d, const glm::vec3& color) {
+    uint32_t base = static_cast<uint32_t>(vertices.size());
+    vertices.push_back({ a, color });
+    vertices.push_back({ b, color });
+    vertices.push_back({ c, color });
+    vertices.push_back({ d, color });
+    indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+}
+
+MeshRange ProceduralMesh::appendTo(MeshArena& arena) const {
+    std::vector<ArenaVertex> arenaVertices;
+    arenaVertices.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        float tint = i < bodyVertexCount ? 1.0f : 0.0f;
+        arenaVertices.push_back(ArenaVertex{ vertices[i].position, vertices[i].color, tint });
+    }
+    return arena.add(arenaVertices, indices);
+}
+
+std::unique_ptr<ProceduralMesh> ProceduralMesh::generate(const ProceduralMeshKey& key) {
+    std::unique_ptr<ProceduralMesh> mesh(new ProceduralMesh());
+    ProceduralMesh& m = *mesh;
+    const int windowCount = key.windowCount;
+
+    switch (key.type) {
+        // Walls and rectangles have fixed face colors and no body
+        case ObjectType::WALL: {
+            m.addQuad({ -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f }, WALL_FRONT_COLOR);
+            m.addQuad({ -0.5f, -0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, WALL_BACK_COLOR);
+            break;
+        }
+
+        case ObjectType::RECTANGLE: {
+            m.addQuad({ -0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { 0.5f, 0.5f, -0.5f }, RECTANGLE_TOP_COLOR);
+            m.addQuad({ -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, 0.5f }, { -0.5f, -0.5f, 0.5f }, RECTANGLE_BOTTOM_COLOR);
+            break;
+        }
+
+        case ObjectType::HOUSE: {
+            // Body: front and back faces
+            m.addQuad({ -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f }, BODY_COLOR);
+            m.addQuad({ -0.5f, -0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, BODY_COLOR);
+            m.bodyIndexCount = m.indices.size();
+            m.bodyVertexCount = m.vertices.size();
+
+            // Roof
+            glm::vec3 apex(0.0f, 0.5f + key.roofHeight, 0.0f);
+            m.addTriangle({ -0.5f, 0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, apex, ROOF_COLOR);
+            m.addTriangle({ -0.5f, 0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, apex, ROOF_COLOR);
+
+            // Windows
+            float windowSpacing = 1.0f / (windowCount + 1);
+            float windowSize = 0.2f;
+            for (int i = 0; i < windowCount; ++i) {
+                float x = -0.5f + (i + 1) * windowSpacing;
+                m.addQuad({ x - windowSize / 2, 0.0f, 0.51f }, { x + windowSize / 2, 0.0f, 0.51f },
+                          { x + windowSize / 2, windowSize, 0.51f }, { x - windowSize / 2, windowSize, 0.51f }, WINDOW_COLOR);
+            }
+
+            // Door
+            float halfDoor = key.doorWidth / 2;
+            m.addQuad({ -halfDoor, -0.5f, 0.51f }, { halfDoor, -0.5f, 0.51f },
+                      { halfDoor, 0.0f, 0.51f }, { -halfDoor, 0.0f, 0.51f }, DOOR_COLOR);
+            break;
+        }
+
+        case ObjectType::TOWER: {
+            m.addQuad({ -0.3f, -0.5f, 0.3f }, { 0.3f, -0.5f, 0.3f }, { 0.3f, 0.5f, 0.3f }, { -0.3f, 0.5f, 0.3f }, BODY_COLOR);
+            m.addQuad({ -0.3f, -0.5f, -0.3f }, { -0.3f, 0.5f, -0.3f }, { 0.3f, 0.5f, -0.3f }, { 0.3f, -0.5f, -0.3f }, BODY_COLOR);
+            m.bodyIndexCount = m.indices.size();
+            m.bodyVertexCount = m.vertices.size();
+
+            // Front windows spread over the height; a single window sits in the middle
+            float windowSize = 0.15f;
+            for (int i = 0; i < windowCount; ++i) {
+                float y = windowCount > 1 ? -0.4f + (i * 0.8f / (windowCount - 1)) : 0.0f;
+                m.addQuad({ -windowSize / 2, y - windowSize / 2, 0.31f }, { windowSize / 2, y - windowSize / 2, 0.31f },
+                          { windowSize / 2, y + windowSize / 2, 0.31f }, { -windowSize / 2, y + windowSize / 2, 0.31f }, WINDOW_COLOR);
+            }
+            break;
+        }
+
+        case ObjectType::BRIDGE: {
+            // Deck: top and bottom faces
+            m.addQuad({ -0.5f, 0.0f, -0.2f }, { -0.5f, 0.0f, 0.2f }, { 0.5f, 0.0f, 0.2f }, { 0.5f, 0.0f, -0.2f }, BODY_COLOR);
+            m.addQuad({ -0.5f, -0.1f, -0.2f }, { 0.5f, -0.1f, -0.2f }, { 0.5f, -0.1f, 0.2f }, { -0.5f, -0.1f, 0.2f }, BODY_COLOR);
+            m.bodyIndexCount = m.indices.size();
+            m.bodyVertexCount = m.vertices.size();
+
+            // Supports
+            float supportWidth = 0.1f;
+            float supportSpacing = 1.0f / (windowCount + 1);
+            for (int i = 0; i < windowCount; ++i) {
+                float x = -0.5f + (i + 1) * supportSpacing;
+                m.addQuad({ x - supportWidth / 2, -0.1f, -0.2f }, { x - supportWidth / 2, -0.1f, 0.2f },
+                          { x + supportWidth / 2, -0.1f, 0.2f }, { x + supportWidth / 2, -0.1f, -0.2f }, SUPPORT_COLOR);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return mesh;
+}
+
+// Client-side arrays: the mesh owns no GL objects, so whichever thread drops
+// the last reference can free it
+void ProceduralMesh::draw(const glm::vec3& bodyColor) const {
+    if (indices.empty()) return;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(ProceduralVertex), &vertices[0].position);
+
+    if (bodyIndexCount > 0) {
+        glColor3f(bodyColor.x, bodyColor.y, bodyColor.z);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(bodyIndexCount), GL_UNSIGNED_INT, indices.data());
+    }
+
+    if (indices.size() > bodyIndexCount) {
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(3, GL_FLOAT, sizeof(ProceduralVertex), &vertices[0].color);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size() - bodyIndexCount), GL_UNSIGNED_INT,
+                       indices.data() + bodyIndexCount);
+        glDisableClientState(GL_COLOR_ARRAY);
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+// ProceduralMeshCache implementation
+ProceduralMeshCache& ProceduralMeshCache::instance() {
+    static ProceduralMeshCache cache;
+    return cache;
+}
+
+std::shared_ptr<const ProceduralMesh> ProceduralMeshCache::acquire(const ProceduralMeshKey& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        if (auto mesh = it->second.lock()) {
+            ++stats.hits;
+            return mesh;
+        }
+    }
+
+    ++stats.misses;
+    std::shared_ptr<const ProceduralMesh> mesh(ProceduralMesh::generate(key));
+    entries[key] = mesh;
+
+    // Drop entries whose meshes died each time the table doubles
+    if (entries.size() >= sweepThreshold) {
+        for (auto entry = entries.begin(); entry != entries.end();) {
+            entry = entry->second.expired() ? entries.erase(entry) : std::next(entry);
+        }
+        sweepThreshold = std::max<size_t>(64, entries.size() * 2);
+    }
+    return mesh;
+}
+
+ProceduralMeshCache::Stats ProceduralMeshCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void ProceduralMeshCache::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats = Stats();
+}
+
+size_t ProceduralMeshCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t alive = 0;
+    for (const auto& entry : entries) {
+        if (!entry.second.expired()) ++alive;
+    }
+    return alive;
+}
+
+void ProceduralMeshCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+} // namespace Editor
@@ -0,0 +1,301 @@
+#include "../../include/editor/scene_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Editor {
+
+namespace {
+    const char MAGIC[4] = { 'F', 'P', 'S', 'W' };
+    const uint32_t TYPE_COUNT = static_cast<uint32_t>(ObjectType::BRIDGE) + 1;
+    const char* const TYPE_NAMES[TYPE_COUNT] = { "Wall", "Rectangle", "Cube", "House", "Tower", "Bridge" };
+
+    static_assert(sizeof(SceneFileHeader) == 40, "scene header layout");
+    static_assert(sizeof(SceneSectionEntry) == 32, "scene section layout");
+    static_assert(sizeof(SceneObjectRecord) == 44, "scene object layout");
+    static_assert(sizeof(ScenePredefinedParams) == 16, "scene parameter layout");
+
+    bool hasParams(ObjectType type) {
+        return type == ObjectType::HOUSE || type == ObjectType::TOWER || type == ObjectType::BRIDGE;
+    }
+
+    uint64_t align8(uint64_t offset) {
+        return (offset + 7) & ~uint64_t(7);
+    }
+
+    // Forces written data to the device; a plain flush where fsync is unavailable
+    bool syncFile(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#if defined(__unix__) || defined(__APPLE__)
+        return fsync(fileno(file)) == 0;
+#else
+        return true;
+#endif
+    }
+
+    // Makes a rename in the directory durable
+    void syncDirectory(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+        int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+        }
+#endif
+    }
+}
+
+const uint32_t SceneFile::FORMAT_VERSION;
+const uint32_t SceneFile::NO_PARENT;
+
+SceneFile::SceneFile()
+    : data(nullptr)
+    , size(0)
+    , mapping(nullptr)
+    , mappingSize(0)
+    , objectCount(0) {}
+
+SceneFile::~SceneFile() {
+    close();
+}
+
+bool SceneFile::open(const std::string& path, size_t offset) {
+    close();
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open scene: " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    void* region = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        region = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        std::cerr << "Failed to map scene: " << path << std::endl;
+        return false;
+    }
+    mapping = region;
+    mappingSize = static_cast<size_t>(info.st_size);
+    data = static_cast<const uint8_t*>(region);
+    size = mappingSize;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open scene: " << path << std::endl;
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+#endif
+    if (offset > size) offset = size;
+    data += offset;
+    size -= offset;
+    if (!parse()) {
+        std::cerr << "Invalid scene file: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool SceneFile::view(const uint8_t* bytes, size_t length) {
+    close();
+    data = bytes;
+    size = length;
+    if (!parse()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SceneFile::close() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapping) munmap(mapping, mappingSize);
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    buffer.clear();
+    data = nullptr;
+    size = 0;
+    objectCount = 0;
+    sections.clear();
+}
+
+// Bounds and alignment only; the records themselves are not visited
+bool SceneFile::parse() {
+    SceneFileHeader header;
+    if (!data || size < sizeof(header) || reinterpret_cast<uintptr_t>(data) % 8 != 0) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION
+        || header.fileSize != size || header.sectionCount > TYPE_COUNT) {
+        return false;
+    }
+    if (header.stringTableOffset > size || header.stringTableSize == 0
+        || header.stringTableSize > size - header.stringTableOffset
+        || data[header.stringTableOffset + header.stringTableSize - 1] != '\0') {
+        return false;
+    }
+    if (sizeof(header) + header.sectionCount * sizeof(SceneSectionEntry) > size) return false;
+
+    auto fits = [this](uint64_t offset, uint64_t count, size_t recordSize) {
+        return offset % 8 == 0 && offset <= size && count <= (size - offset) / recordSize;
+    };
+    const char* strings = reinterpret_cast<const char*>(data + header.stringTableOffset);
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        SceneSectionEntry entry;
+        std::memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        if (entry.type >= TYPE_COUNT || entry.nameOffset >= header.stringTableSize
+            || !fits(entry.objectsOffset, entry.count, sizeof(SceneObjectRecord))) {
+            return false;
+        }
+        Section section;
+        section.type = static_cast<ObjectType>(entry.type);
+        section.name = strings + entry.nameOffset;
+        section.count = entry.count;
+        section.objects = reinterpret_cast<const SceneObjectRecord*>(data + entry.objectsOffset);
+        section.params = nullptr;
+        if (hasParams(section.type)) {
+            if (!fits(entry.paramsOffset, entry.count, sizeof(ScenePredefinedParams))) return false;
+            section.params = reinterpret_cast<const ScenePredefinedParams*>(data + entry.paramsOffset);
+        } else if (entry.paramsOffset != 0) {
+            return false;
+        }
+        total += entry.count;
+        if (total >= NO_PARENT) return false;
+        sections.push_back(section);
+    }
+    if (total != header.objectCount) return false;
+    objectCount = total;
+    return true;
+}
+
+std::vector<uint8_t> SceneFile::serialize(const WorldEditor& editor) {
+    const EntityStore& entities = editor.getEntities();
+    const TransformHierarchy& transforms = editor.getTransforms();
+
+    // Section sizes first, so each record is written once in place
+    uint32_t counts[TYPE_COUNT] = {};
+    TransformId nodeLimit = 0;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        ++counts[static_cast<uint32_t>(entities.getType(i))];
+        nodeLimit = std::max(nodeLimit, entities.getNode(i) + 1);
+    }
+
+    std::vector<uint32_t> sectionTypes;
+    std::string strings;
+    std::vector<uint32_t> nameOffsets;
+    for (uint32_t type = 0; type < TYPE_COUNT; ++type) {
+        if (counts[type] == 0) continue;
+        sectionTypes.push_back(type);
+        nameOffsets.push_back(static_cast<uint32_t>(strings.size()));
+        strings += TYPE_NAMES[type];
+        strings += '\0';
+    }
+    if (strings.empty()) strings += '\0';
+
+    SceneFileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.objectCount = entities.size();
+    header.sectionCount = static_cast<uint32_t>(sectionTypes.size());
+    header.stringTableOffset = sizeof(header) + sectionTypes.size() * sizeof(SceneSectionEntry);
+    header.stringTableSize = static_cast<uint32_t>(strings.size());
+
+    std::vector<SceneSectionEntry> entries(sectionTypes.size());
+    uint64_t offset = align8(header.stringTableOffset + header.stringTableSize);
+    for (size_t s = 0; s < sectionTypes.size(); ++s) {
+        uint32_t type = sectionTypes[s];
+        SceneSectionEntry& entry = entries[s];
+        entry.type = type;
+        entry.nameOffset = nameOffsets[s];
+        entry.count = counts[type];
+        entry.reserved = 0;
+        entry.objectsOffset = offset;
+        offset = align8(offset + uint64_t(entry.count) * sizeof(SceneObjectRecord));
+        entry.paramsOffset = 0;
+        if (hasParams(static_cast<ObjectType>(type))) {
+            entry.paramsOffset = offset;
+            offset += uint64_t(entry.count) * sizeof(ScenePredefinedParams);
+        }
+    }
+    header.fileSize = offset;
+
+    std::vector<uint32_t> indexOfNode(nodeLimit, NO_PARENT);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        indexOfNode[entities.getNode(i)] = static_cast<uint32_t>(i);
+    }
+
+    std::vector<uint8_t> out(static_cast<size_t>(header.fileSize), 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), entries.data(), entries.size() * sizeof(SceneSectionEntry));
+    std::memcpy(out.data() + header.stringTableOffset, strings.data(), strings.size());
+
+    SceneObjectRecord* records[TYPE_COUNT] = {};
+    ScenePredefinedParams* params[TYPE_COUNT] = {};
+    for (const SceneSectionEntry& entry : entries) {
+        records[entry.type] = reinterpret_cast<SceneObjectRecord*>(out.data() + entry.objectsOffset);
+        if (entry.paramsOffset) {
+            params[entry.type] = reinterpret_cast<ScenePredefinedParams*>(out.data() + entry.paramsOffset);
+        }
+    }
+    for (size_t i = 0; i < entities.size(); ++i) {
+        uint32_t type = static_cast<uint32_t>(entities.getType(i));
+        SceneObjectRecord& record = *records[type]++;
+        record.index = static_cast<uint32_t>(i);
+        record.position = entities.getPosition(i);
+        record.size = entities.getSize(i);
+        record.color = entities.getColor(i);
+        TransformId parent = transforms.getParent(entities.getNode(i));
+        record.parent = parent < nodeLimit ? indexOfNode[parent] : NO_PARENT;
+        if (params[type]) {
+            ScenePredefinedParams& values = *params[type]++;
+            const PredefinedParams& stored = entities.getParams(i);
+            values.wallThickness = stored.wallThickness;
+            values.roofHeight = stored.roofHeight;
+            values.windowCount = stored.windowCount;
+            values.doorWidth = stored.doorWidth;
+        }
+    }
+    return out;
+}
+
+// Written aside and renamed over the old file, so a crash while saving leaves
+// one scene or the other, never a torn one
+bool SceneFile::save(const WorldEditor& editor, const std::string& path) {
+    std::vector<uint8_t> bytes = serialize(editor);
+    std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to write scene: " << temporary << std::endl;
+        return false;
+    }
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() && syncFile(file);
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to write scene: " << path << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    syncDirectory(path);
+    return true;
+}
+
+} // namespace Editor
@@ -0,0 +1,234 @@
+#include <GL/glew.h>
+#include "../../include/editor/static_batcher.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace Editor {
+
+constexpr float StaticBatcher::DEFAULT_CELL_SIZE;
+const size_t StaticBatcher::DEFAULT_MAX_TRIANGLES;
+const uint32_t StaticBatcher::NO_BATCH;
+
+StaticBatcher::StaticBatcher(float cellSize, size_t maxTrianglesPerBatch)
+    : cellSize(cellSize)
+    , maxTrianglesPerBatch(maxTrianglesPerBatch)
+    , objectCount(0)
+    , lastRebuildCount(0) {}
+
+StaticBatcher::~StaticBatcher() {
+    clear();
+}
+
+int64_t StaticBatcher::cellKey(const glm::mat4& world) const {
+    int64_t x = static_cast<int64_t>(std::floor(world[3].x / cellSize));
+    int64_t z = static_cast<int64_t>(std::floor(world[3].z / cellSize));
+    return (x << 32) ^ (z & 0xFFFFFFFF);
+}
+
+void StaticBatcher::markBatchDirty(size_t batchIndex) {
+    Batch& batch = *batches[batchIndex];
+    if (!batch.dirty) {
+        batch.dirty = true;
+        dirtyBatches.push_back(batchIndex);
+    }
+}
+
+void StaticBatcher::addObject(uint32_t key, const BatchObject& object, const glm::mat4& world) {
+    if (contains(key)) {
+        removeObject(key);
+    }
+
+    int64_t cell = cellKey(world);
+    size_t triangles = object.mesh->getTriangleCount();
+
+    // First batch in the cell with room left, or a new one
+    std::vector<size_t>& candidates = cellBatches[cell];
+    size_t target = batches.size();
+    for (size_t index : candidates) {
+        const Batch& batch = *batches[index];
+        if (batch.members.empty() || batch.triangleCount + triangles <= maxTrianglesPerBatch) {
+            target = index;
+            break;
+        }
+    }
+    if (target == batches.size()) {
+        batches.emplace_back(new Batch());
+        batches.back()->cell = cell;
+        candidates.push_back(target);
+    }
+
+    Batch& batch = *batches[target];
+    if (key >= locations.size()) {
+        locations.resize(key + 1);
+    }
+    locations[key].batch = static_cast<uint32_t>(target);
+    locations[key].member = static_cast<uint32_t>(batch.members.size());
+    ++objectCount;
+    batch.members.push_back(Member{ key, object, world, triangles });
+    batch.triangleCount += triangles;
+    markBatchDirty(target);
+}
+
+void StaticBatcher::updateObject(uint32_t key, const glm::mat4& world) {
+    if (!contains(key)) return;
+
+    Location location = locations[key];
+    Batch& batch = *batches[location.batch];
+    Member& member = batch.members[location.member];
+    if (batch.cell == cellKey(world)) {
+        member.world = world;
+        markBatchDirty(location.batch);
+    } else {
+        BatchObject object = member.object;
+        removeObject(key);
+        addObject(key, object, world);
+    }
+}
+
+void StaticBatcher::updateObject(uint32_t key, const BatchObject& object) {
+    if (!contains(key)) return;
+
+    Location location = locations[key];
+    Batch& batch = *batches[location.batch];
+    Member& member = batch.members[location.member];
+    size_t triangles = object.mesh->getTriangleCount();
+    size_t otherTriangles = batch.triangleCount - member.triangles;
+    if (batch.members.size() > 1 && otherTriangles + triangles > maxTrianglesPerBatch) {
+        glm::mat4 world = member.world;
+        removeObject(key);
+        addObject(key, object, world);
+        return;
+    }
+    batch.triangleCount = otherTriangles + triangles;
+    member.object = object;
+    member.triangles = triangles;
+    markBatchDirty(location.batch);
+}
+
+void StaticBatcher::removeObject(uint32_t key) {
+    if (!contains(key)) return;
+
+    Location location = locations[key];
+    locations[key].batch = NO_BATCH;
+    --objectCount;
+
+    Batch& batch = *batches[location.batch];
+    batch.triangleCount -= batch.members[location.member].triangles;
+    if (location.member != batch.members.size() - 1) {
+        batch.members[location.member] = std::move(batch.members.back());
+        locations[batch.members[location.member].key].member = location.member;
+    }
+    batch.members.pop_back();
+    markBatchDirty(location.batch);
+}
+
+void StaticBatcher::clear() {
+    for (auto& batch : batches) {
+        if (batch->vertexBuffer) glDeleteBuffers(1, &batch->vertexBuffer);
+        if (batch->indexBuffer) glDeleteBuffers(1, &batch->indexBuffer);
+    }
+    batches.clear();
+    cellBatches.clear();
+    locations.clear();
+    objectCount = 0;
+    dirtyBatches.clear();
+}
+
+void StaticBatcher::rebuildBatch(Batch& batch) {
+    batch.vertices.clear();
+    batch.indices.clear();
+    batch.triangleCount = 0;
+
+    for (const Member& member : batch.members) {
+        const auto& mesh = member.object.mesh;
+        glm::vec3 size = member.object.size;
+        glm::vec3 color = member.object.color;
+
+        glm::mat4 model = member.world;
+        model[0] *= size.x;
+        model[1] *= size.y;
+        model[2] *= size.z;
+
+        uint32_t base = static_cast<uint32_t>(batch.vertices.size());
+        const auto& vertices = mesh->getVertices();
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            ProceduralVertex vertex;
+            vertex.position = glm::vec3(model * glm::vec4(vertices[i].position, 1.0f));
+            vertex.color = i < mesh->getBodyVertexCount() ? color : vertices[i].color;
+            batch.vertices.push_back(vertex);
+        }
+        for (uint32_t index : mesh->getIndices()) {
+            batch.indices.push_back(base + index);
+        }
+        batch.triangleCount += member.triangles;
+    }
+
+    batch.dirty = false;
+    batch.uploaded = false;
+}
+
+size_t StaticBatcher::rebuildDirty() {
+    for (size_t index : dirtyBatches) {
+        rebuildBatch(*batches[index]);
+    }
+    lastRebuildCount = dirtyBatches.size();
+    dirtyBatches.clear();
+    return lastRebuildCount;
+}
+
+void StaticBatcher::render() const {
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    for (const auto& batch : batches) {
+        if (batch->indices.empty()) continue;
+
+        if (!batch->uploaded) {
+            if (!batch->vertexBuffer) {
+                glGenBuffers(1, &batch->vertexBuffer);
+                glGenBuffers(1, &batch->indexBuffer);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer);
+            glBufferData(GL_ARRAY_BUFFER, batch->vertices.size() * sizeof(ProceduralVertex), batch->vertices.data(), GL_STATIC_DRAW);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->indexBuffer);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, batch->indices.size() * sizeof(uint32_t), batch->indices.data(), GL_STATIC_DRAW);
+            batch->uploaded = true;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->indexBuffer);
+        glVertexPointer(3, GL_FLOAT, sizeof(ProceduralVertex),
+                        reinterpret_cast<const void*>(offsetof(ProceduralVertex, position)));
+        glColorPointer(3, GL_FLOAT, sizeof(ProceduralVertex),
+                       reinterpret_cast<const void*>(offsetof(ProceduralVertex, color)));
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(batch->indices.size()), GL_UNSIGNED_INT, nullptr);
+    }
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+size_t StaticBatcher::getDrawCallCount() const {
+    size_t drawCalls = 0;
+    for (const auto& batch : batches) {
+        if (!batch->members.empty()) ++drawCalls;
+    }
+    return drawCalls;
+}
+
+StaticBatcher::Stats StaticBatcher::getStats() const {
+    Stats stats;
+    stats.objects = objectCount;
+    for (const auto& batch : batches) {
+        if (batch->members.empty()) continue;
+        ++stats.batches;
+        stats.triangles += batch->triangleCount;
+    }
+    stats.batchesRebuilt = lastRebuildCount;
+    return stats;
+}
+
+} // namespace Editor
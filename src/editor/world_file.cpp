@@ -0,0 +1,215 @@
+#include "../../include/editor/world_file.h"
+#include "../../include/editor/editor.h"
+#include "../../include/editor/scene_file.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Editor {
+
+namespace {
+    const char MAGIC[4] = { 'F', 'P', 'S', 'K' };
+
+    static_assert(sizeof(WorldFileHeader) == 24, "world header layout");
+    static_assert(sizeof(WorldChunkEntry) == 32, "world chunk layout");
+
+    uint64_t align8(uint64_t offset) {
+        return (offset + 7) & ~uint64_t(7);
+    }
+}
+
+const uint32_t WorldFile::FORMAT_VERSION;
+
+WorldFile::WorldFile()
+    : fd(-1)
+    , opened(false)
+    , chunkSize(0.0f) {}
+
+WorldFile::~WorldFile() {
+    close();
+}
+
+bool WorldFile::open(const std::string& worldPath) {
+    close();
+    std::ifstream file(worldPath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Failed to open world: " << worldPath << std::endl;
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    WorldFileHeader header;
+    bool valid = fileSize >= sizeof(header) && file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        && std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == FORMAT_VERSION
+        && header.chunkSize > 0.0f && header.tableOffset >= sizeof(header) && header.tableOffset <= fileSize
+        && header.chunkCount == (fileSize - header.tableOffset) / sizeof(WorldChunkEntry);
+    if (valid) {
+        chunks.resize(header.chunkCount);
+        file.seekg(static_cast<std::streamoff>(header.tableOffset));
+        valid = chunks.empty()
+            || file.read(reinterpret_cast<char*>(chunks.data()), chunks.size() * sizeof(WorldChunkEntry));
+    }
+    // Scenes lie between the header and the table
+    for (size_t i = 0; valid && i < chunks.size(); ++i) {
+        const WorldChunkEntry& entry = chunks[i];
+        valid = entry.offset % 8 == 0 && entry.offset >= sizeof(header) && entry.offset <= header.tableOffset
+            && entry.size <= header.tableOffset - entry.offset;
+    }
+    if (!valid) {
+        std::cerr << "Invalid world file: " << worldPath << std::endl;
+        chunks.clear();
+        return false;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    fd = ::open(worldPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open world: " << worldPath << std::endl;
+        chunks.clear();
+        return false;
+    }
+#endif
+    path = worldPath;
+    chunkSize = header.chunkSize;
+    opened = true;
+    return true;
+}
+
+void WorldFile::close() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (fd >= 0) ::close(fd);
+#endif
+    fd = -1;
+    opened = false;
+    chunkSize = 0.0f;
+    chunks.clear();
+    path.clear();
+}
+
+bool WorldFile::readChunk(size_t index, std::vector<uint8_t>& out) const {
+    if (!opened || index >= chunks.size()) return false;
+    const WorldChunkEntry& entry = chunks[index];
+    out.resize(static_cast<size_t>(entry.size));
+    bool ok = true;
+#if defined(__unix__) || defined(__APPLE__)
+    // Positioned reads share the descriptor without sharing a file offset
+    size_t done = 0;
+    while (ok && done < out.size()) {
+        ssize_t got = pread(fd, out.data() + done, out.size() - done, static_cast<off_t>(entry.offset + done));
+        ok = got > 0;
+        if (ok) done += static_cast<size_t>(got);
+    }
+#else
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(entry.offset));
+    ok = file && file.read(reinterpret_cast<char*>(out.data()), out.size());
+#endif
+    if (!ok) {
+        std::cerr << "Failed to read world chunk " << entry.x << ", " << entry.z << ": " << path << std::endl;
+    }
+    return ok;
+}
+
+WorldFileWriter::WorldFileWriter()
+    : file(nullptr)
+    , chunkSize(0.0f)
+    , offset(0)
+    , failed(false) {}
+
+WorldFileWriter::~WorldFileWriter() {
+    if (file) std::fclose(file);
+}
+
+bool WorldFileWriter::open(const std::string& worldPath, float size) {
+    if (file) std::fclose(file);
+    path = worldPath;
+    chunkSize = size;
+    chunks.clear();
+    failed = false;
+    file = std::fopen(worldPath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to write world: " << worldPath << std::endl;
+        return false;
+    }
+    // The header is written last, once the table's place is known
+    WorldFileHeader header = {};
+    failed = std::fwrite(&header, 1, sizeof(header), file) != sizeof(header);
+    offset = sizeof(header);
+    return !failed;
+}
+
+void WorldFileWriter::addChunk(int32_t x, int32_t z, uint32_t objectCount, const std::vector<uint8_t>& scene) {
+    if (!file || failed) return;
+    WorldChunkEntry entry;
+    entry.x = x;
+    entry.z = z;
+    entry.objectCount = objectCount;
+    entry.reserved = 0;
+    entry.offset = offset;
+    entry.size = scene.size();
+    chunks.push_back(entry);
+
+    static const uint8_t PADDING[8] = {};
+    size_t padding = static_cast<size_t>(align8(offset + scene.size()) - (offset + scene.size()));
+    failed = std::fwrite(scene.data(), 1, scene.size(), file) != scene.size()
+        || std::fwrite(PADDING, 1, padding, file) != padding;
+    offset += scene.size() + padding;
+}
+
+bool WorldFileWriter::finish() {
+    if (!file) return false;
+    WorldFileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = WorldFile::FORMAT_VERSION;
+    header.chunkSize = chunkSize;
+    header.chunkCount = static_cast<uint32_t>(chunks.size());
+    header.tableOffset = offset;
+    bool ok = !failed
+        && std::fwrite(chunks.data(), sizeof(WorldChunkEntry), chunks.size(), file) == chunks.size()
+        && std::fseek(file, 0, SEEK_SET) == 0
+        && std::fwrite(&header, 1, sizeof(header), file) == sizeof(header);
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    if (!ok) {
+        std::cerr << "Failed to write world: " << path << std::endl;
+    }
+    return ok;
+}
+
+bool generateTestWorld(const std::string& path, const TestWorldOptions& options) {
+    WorldFileWriter writer;
+    if (!writer.open(path, options.chunkSize)) return false;
+
+    static const ObjectType TYPES[] = {
+        ObjectType::WALL, ObjectType::RECTANGLE, ObjectType::HOUSE, ObjectType::TOWER, ObjectType::BRIDGE
+    };
+    std::mt19937 random(options.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_int_distribution<size_t> pickType(0, sizeof(TYPES) / sizeof(TYPES[0]) - 1);
+
+    // One editor serializes every chunk; loading an empty scene clears it
+    WorldEditor editor;
+    int first = -options.chunksPerSide / 2;
+    for (int z = first; z < first + options.chunksPerSide; ++z) {
+        for (int x = first; x < first + options.chunksPerSide; ++x) {
+            editor.loadScene(SceneFile());
+            for (size_t i = 0; i < options.objectsPerChunk; ++i) {
+                glm::vec3 size(1.0f + 4.0f * unit(random), 1.0f + 6.0f * unit(random), 1.0f + 4.0f * unit(random));
+                glm::vec3 position((x + unit(random)) * options.chunkSize, size.y * 0.5f,
+                                   (z + unit(random)) * options.chunkSize);
+                editor.addObject(TYPES[pickType(random)], position, size);
+                editor.setSelectedObjectColor(glm::vec3(unit(random), unit(random), unit(random)));
+            }
+            writer.addChunk(x, z, static_cast<uint32_t>(editor.getEntities().size()), SceneFile::serialize(editor));
+        }
+    }
+    return writer.finish();
+}
+
+} // namespace Editor
@@ -0,0 +1,298 @@
+#include "../../include/editor/world_streamer.h"
+#include "../../include/editor/scene_file.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Editor {
+
+namespace {
+    double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+WorldStreamer::WorldStreamer()
+    : editor(nullptr)
+    , committedBytes(0)
+    , lastPosition(0.0f)
+    , totalLoadMs(0.0)
+    , reading(false)
+    , stopping(false) {}
+
+WorldStreamer::~WorldStreamer() {
+    close();
+}
+
+bool WorldStreamer::open(const std::string& path, WorldEditor& target) {
+    return open(path, target, Options());
+}
+
+bool WorldStreamer::open(const std::string& path, WorldEditor& target, const Options& streamOptions) {
+    close();
+    if (!file.open(path)) return false;
+
+    options = streamOptions;
+    options.unloadRadius = std::max(options.unloadRadius, options.loadRadius);
+    const std::vector<WorldChunkEntry>& entries = file.getChunks();
+    chunks.assign(entries.size(), Chunk());
+    chunkAt.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        chunks[i].cost = entries[i].objectCount * options.bytesPerObject;
+        chunkAt.emplace(packCoordinates(entries[i].x, entries[i].z), static_cast<uint32_t>(i));
+    }
+    stats = Stats();
+    totalLoadMs = 0.0;
+    committedBytes = 0;
+    reading = false;
+    stopping = false;
+    editor = &target;
+    ioThread = std::thread(&WorldStreamer::ioLoop, this);
+    return true;
+}
+
+void WorldStreamer::close() {
+    if (!editor) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    ioThread.join();
+
+    while (!residentChunks.empty()) {
+        unloadChunk(residentChunks.back());
+    }
+    queue.clear();
+    finished.clear();
+    arrived.clear();
+    chunks.clear();
+    chunkAt.clear();
+    committedBytes = 0;
+    stats.pendingChunks = 0;
+    file.close();
+    editor = nullptr;
+}
+
+int64_t WorldStreamer::packCoordinates(int32_t x, int32_t z) {
+    return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(z);
+}
+
+bool WorldStreamer::isResident(int32_t x, int32_t z) const {
+    auto it = chunkAt.find(packCoordinates(x, z));
+    return it != chunkAt.end() && chunks[it->second].state == ChunkState::RESIDENT;
+}
+
+float WorldStreamer::distanceTo(const WorldChunkEntry& entry, const glm::vec3& position) const {
+    float size = file.getChunkSize();
+    float minX = entry.x * size;
+    float minZ = entry.z * size;
+    float dx = std::max(std::max(minX - position.x, position.x - (minX + size)), 0.0f);
+    float dz = std::max(std::max(minZ - position.z, position.z - (minZ + size)), 0.0f);
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+// The distance, stretched for chunks away from where the view points
+float WorldStreamer::rankOf(const WorldChunkEntry& entry, const glm::vec3& position, const glm::vec2& view) const {
+    float size = file.getChunkSize();
+    float distance = distanceTo(entry, position);
+    glm::vec2 toChunk((entry.x + 0.5f) * size - position.x, (entry.z + 0.5f) * size - position.z);
+    float length = glm::length(toChunk);
+    if (length < 1e-4f) return distance;
+    float facing = glm::dot(toChunk / length, view);
+    return distance * (1.0f + options.viewWeight * (1.0f - facing));
+}
+
+void WorldStreamer::update(const glm::vec3& position, const glm::vec3& viewDirection) {
+    if (!editor) return;
+    lastPosition = position;
+    glm::vec2 view(viewDirection.x, viewDirection.z);
+    float viewLength = glm::length(view);
+    view = viewLength > 1e-6f ? view / viewLength : glm::vec2(0.0f);
+    const std::vector<WorldChunkEntry>& entries = file.getChunks();
+
+    // Requests the background thread has not started on are reconsidered;
+    // those asked for again keep their request time
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        untaken.swap(queue);
+    }
+    for (uint32_t index : untaken) {
+        Chunk& chunk = chunks[index];
+        chunk.state = ChunkState::UNLOADED;
+        chunk.requeued = true;
+        committedBytes -= chunk.cost;
+        --stats.pendingChunks;
+    }
+    collectArrived();
+
+    for (size_t i = 0; i < residentChunks.size();) {
+        uint32_t index = residentChunks[i];
+        if (distanceTo(entries[index], position) > options.unloadRadius) {
+            unloadChunk(index);
+            continue;
+        }
+        chunks[index].rank = rankOf(entries[index], position, view);
+        ++i;
+    }
+    integrateArrived(options.chunksPerUpdate);
+
+    candidates.clear();
+    float size = file.getChunkSize();
+    int32_t minX = static_cast<int32_t>(std::floor((position.x - options.loadRadius) / size));
+    int32_t maxX = static_cast<int32_t>(std::floor((position.x + options.loadRadius) / size));
+    int32_t minZ = static_cast<int32_t>(std::floor((position.z - options.loadRadius) / size));
+    int32_t maxZ = static_cast<int32_t>(std::floor((position.z + options.loadRadius) / size));
+    for (int32_t z = minZ; z <= maxZ; ++z) {
+        for (int32_t x = minX; x <= maxX; ++x) {
+            auto it = chunkAt.find(packCoordinates(x, z));
+            if (it == chunkAt.end()) continue;
+            Chunk& chunk = chunks[it->second];
+            if (chunk.state != ChunkState::UNLOADED || distanceTo(entries[it->second], position) > options.loadRadius) {
+                continue;
+            }
+            chunk.rank = rankOf(entries[it->second], position, view);
+            candidates.push_back(it->second);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [this](uint32_t a, uint32_t b) { return chunks[a].rank < chunks[b].rank; });
+
+    // Best first; one that cannot be made room for holds back the rest
+    requests.clear();
+    auto now = std::chrono::steady_clock::now();
+    for (uint32_t index : candidates) {
+        Chunk& chunk = chunks[index];
+        while (committedBytes + chunk.cost > options.memoryBudget) {
+            uint32_t worst = 0;
+            float worstRank = chunk.rank;
+            bool found = false;
+            for (uint32_t resident : residentChunks) {
+                if (chunks[resident].rank > worstRank) {
+                    worst = resident;
+                    worstRank = chunks[resident].rank;
+                    found = true;
+                }
+            }
+            if (!found) break;
+            unloadChunk(worst);
+            ++stats.chunksEvicted;
+        }
+        if (committedBytes + chunk.cost > options.memoryBudget) {
+            ++stats.budgetStalls;
+            break;
+        }
+        chunk.state = ChunkState::LOADING;
+        if (!chunk.requeued) chunk.requested = now;
+        committedBytes += chunk.cost;
+        ++stats.pendingChunks;
+        requests.push_back(index);
+    }
+    for (uint32_t index : untaken) {
+        chunks[index].requeued = false;
+    }
+    untaken.clear();
+
+    std::reverse(requests.begin(), requests.end());
+    bool requested = !requests.empty();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.swap(requests);
+    }
+    if (requested) wake.notify_one();
+}
+
+void WorldStreamer::finishPending() {
+    if (!editor) return;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return queue.empty() && !reading; });
+    }
+    collectArrived();
+    integrateArrived(arrived.size());
+}
+
+void WorldStreamer::collectArrived() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (ReadChunk& read : finished) {
+        arrived.push_back(std::move(read));
+    }
+    finished.clear();
+}
+
+void WorldStreamer::integrateArrived(size_t limit) {
+    const std::vector<WorldChunkEntry>& entries = file.getChunks();
+    size_t used = 0;
+    size_t integrated = 0;
+    for (; used < arrived.size() && integrated < limit; ++used) {
+        ReadChunk& read = arrived[used];
+        Chunk& chunk = chunks[read.chunk];
+        --stats.pendingChunks;
+
+        SceneFile scene;
+        bool wanted = distanceTo(entries[read.chunk], lastPosition) <= options.unloadRadius;
+        if (!read.ok || !wanted || !scene.view(read.scene.data(), read.scene.size())) {
+            if (!read.ok) ++stats.readFailures;
+            chunk.state = ChunkState::UNLOADED;
+            committedBytes -= chunk.cost;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        editor->appendScene(scene, chunk.handles);
+        stats.lastInsertMs = millisecondsSince(start);
+        chunk.state = ChunkState::RESIDENT;
+        residentChunks.push_back(read.chunk);
+
+        stats.lastReadMs = read.readMs;
+        stats.lastLoadMs = millisecondsSince(chunk.requested);
+        stats.maxLoadMs = std::max(stats.maxLoadMs, stats.lastLoadMs);
+        totalLoadMs += stats.lastLoadMs;
+        ++stats.chunksLoaded;
+        stats.averageLoadMs = totalLoadMs / stats.chunksLoaded;
+        ++stats.residentChunks;
+        stats.residentObjects += chunk.handles.size();
+        stats.residentBytes += chunk.cost;
+        stats.peakResidentBytes = std::max(stats.peakResidentBytes, stats.residentBytes);
+        ++integrated;
+    }
+    arrived.erase(arrived.begin(), arrived.begin() + used);
+}
+
+void WorldStreamer::unloadChunk(uint32_t index) {
+    Chunk& chunk = chunks[index];
+    editor->removeObjects(chunk.handles);
+    stats.residentObjects -= chunk.handles.size();
+    chunk.handles.clear();
+    chunk.state = ChunkState::UNLOADED;
+    committedBytes -= chunk.cost;
+    --stats.residentChunks;
+    stats.residentBytes -= chunk.cost;
+    ++stats.chunksUnloaded;
+    residentChunks.erase(std::find(residentChunks.begin(), residentChunks.end(), index));
+}
+
+// Reads the best request first; the editor thread may replace the queue at any time
+void WorldStreamer::ioLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (stopping) break;
+        ReadChunk read;
+        read.chunk = queue.back();
+        queue.pop_back();
+        reading = true;
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        SceneFile scene;
+        read.ok = file.readChunk(read.chunk, read.scene) && scene.view(read.scene.data(), read.scene.size());
+        read.readMs = millisecondsSince(start);
+
+        lock.lock();
+        finished.push_back(std::move(read));
+        reading = false;
+        idle.notify_all();
+    }
+}
+
+} // namespace Editor
@@ -0,0 +1,119 @@
+#include "../../include/graphics/camera.h"
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+Camera::Camera(float fovYDegrees, float aspect, float nearPlane, float farPlane)
+    : position(0.0f)
+    , direction(0.0f, 0.0f, -1.0f)
+    , fovYDegrees(fovYDegrees)
+    , aspect(aspect)
+    , nearPlane(nearPlane)
+    , farPlane(farPlane)
+    , viewDirty(true)
+    , projectionDirty(true)
+    , combinedDirty(true)
+    , view(1.0f)
+    , projection(1.0f)
+    , viewProjection(1.0f)
+    , inverseView(1.0f)
+    , inverseProjection(1.0f)
+    , inverseViewProjection(1.0f)
+    , updateCount(0) {}
+
+void Camera::setPosition(const glm::vec3& newPosition) {
+    if (newPosition != position) {
+        position = newPosition;
+        viewDirty = true;
+    }
+}
+
+void Camera::setDirection(const glm::vec3& newDirection) {
+    if (newDirection != direction) {
+        direction = newDirection;
+        viewDirty = true;
+    }
+}
+
+void Camera::setPerspective(float newFovYDegrees, float newAspect, float newNearPlane, float newFarPlane) {
+    if (newFovYDegrees != fovYDegrees || newAspect != aspect || newNearPlane != nearPlane || newFarPlane != farPlane) {
+        fovYDegrees = newFovYDegrees;
+        aspect = newAspect;
+        nearPlane = newNearPlane;
+        farPlane = newFarPlane;
+        projectionDirty = true;
+    }
+}
+
+void Camera::update() const {
+    if (viewDirty) {
+        view = glm::lookAt(position, position + direction, glm::vec3(0.0f, 1.0f, 0.0f));
+        // Rigid transform: the inverse is the transposed rotation and the eye
+        inverseView = glm::mat4(1.0f);
+        for (int column = 0; column < 3; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                inverseView[column][row] = view[row][column];
+            }
+        }
+        inverseView[3] = glm::vec4(position, 1.0f);
+        viewDirty = false;
+        combinedDirty = true;
+    }
+    if (projectionDirty) {
+        projection = glm::perspective(glm::radians(fovYDegrees), aspect, nearPlane, farPlane);
+        // Closed form for the perspective matrix's few non-zero terms
+        inverseProjection = glm::mat4(0.0f);
+        inverseProjection[0][0] = 1.0f / projection[0][0];
+        inverseProjection[1][1] = 1.0f / projection[1][1];
+        inverseProjection[2][3] = 1.0f / projection[3][2];
+        inverseProjection[3][2] = -1.0f;
+        inverseProjection[3][3] = projection[2][2] / projection[3][2];
+        projectionDirty = false;
+        combinedDirty = true;
+    }
+    if (combinedDirty) {
+        viewProjection = projection * view;
+        inverseViewProjection = inverseView * inverseProjection;
+        frustum = Frustum::fromMatrix(viewProjection);
+        combinedDirty = false;
+        ++updateCount;
+    }
+}
+
+const glm::mat4& Camera::getView() const {
+    update();
+    return view;
+}
+
+const glm::mat4& Camera::getProjection() const {
+    update();
+    return projection;
+}
+
+const glm::mat4& Camera::getViewProjection() const {
+    update();
+    return viewProjection;
+}
+
+const glm::mat4& Camera::getInverseView() const {
+    update();
+    return inverseView;
+}
+
+const glm::mat4& Camera::getInverseProjection() const {
+    update();
+    return inverseProjection;
+}
+
+const glm::mat4& Camera::getInverseViewProjection() const {
+    update();
+    return inverseViewProjection;
+}
+
+const Frustum& Camera::getFrustum() const {
+    update();
+    return frustum;
+}
+
+Ray Camera::screenRay(double x, double y, float width, float height) const {
+    return Ray::fromScreen(x, y, getInverseViewProjection(), width, height);
+}
@@ -0,0 +1,47 @@
+#include "../../include/graphics/frustum.h"
+
+Frustum Frustum::fromMatrix(const glm::mat4& m) {
+    // Gribb-Hartmann: rows of the (column-major) matrix combined with the w row
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0;
+    frustum.planes[1] = row3 - row0;
+    frustum.planes[2] = row3 + row1;
+    frustum.planes[3] = row3 - row1;
+    frustum.planes[4] = row3 + row2;
+    frustum.planes[5] = row3 - row2;
+
+    for (glm::vec4& plane : frustum.planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane = plane * (1.0f / length);
+        }
+    }
+    return frustum;
+}
+
+bool Frustum::intersects(const AABB& box) const {
+    for (const glm::vec4& plane : planes) {
+        // Corner furthest along the plane normal
+        glm::vec3 positive(plane.x >= 0.0f ? box.max.x : box.min.x,
+                           plane.y >= 0.0f ? box.max.y : box.min.y,
+                           plane.z >= 0.0f ? box.max.z : box.min.z);
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::contains(const glm::vec3& point) const {
+    for (const glm::vec4& plane : planes) {
+        if (glm::dot(glm::vec3(plane), point) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,221 @@
+#include <GL/glew.h>
+#include "../../include/graphics/indirect_renderer.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+    const char* VERTEX_SHADER = R"(
+        #version 430 core
+        layout(location = 0) in vec3 aPosition;
+        layout(location = 1) in vec3 aColor;
+        layout(location = 2) in float aTint;
+        layout(location = 3) in vec4 aInstanceColor;
+        layout(location = 4) in mat4 aModel;
+
+        uniform mat4 uViewProjection;
+        out vec3 vColor;
+
+        void main() {
+            vColor = mix(aColor, aInstanceColor.rgb, aTint);
+            gl_Position = uViewProjection * aModel * vec4(aPosition, 1.0);
+        }
+    )";
+
+    const char* FRAGMENT_SHADER = R"(
+        #version 430 core
+        in vec3 vColor;
+        out vec4 fragColor;
+
+        void main() {
+            fragColor = vec4(vColor, 1.0);
+        }
+    )";
+
+    GLuint compileShader(GLenum type, const char* source) {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+
+        GLint success = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            char infoLog[512];
+            glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+            std::cerr << "Indirect renderer shader compilation failed: " << infoLog << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+}
+
+void IndirectDrawList::clear() {
+    commands.clear();
+    instances.clear();
+    materials.clear();
+    visibleItems = 0;
+    culledItems = 0;
+}
+
+namespace IndirectDraw {
+
+void buildDrawList(const std::vector<IndirectDrawItem>& items, const Frustum& frustum, IndirectDrawList& out) {
+    out.clear();
+
+    // Sort key: material, then mesh; arena ranges are unique per mesh
+    std::vector<std::pair<uint64_t, uint32_t>> visible;
+    visible.reserve(items.size());
+    for (uint32_t i = 0; i < items.size(); ++i) {
+        const IndirectDrawItem& item = items[i];
+        if (item.mesh.indexCount == 0 || !frustum.intersects(item.mesh.bounds.transformed(item.model))) {
+            ++out.culledItems;
+            continue;
+        }
+        uint64_t key = (static_cast<uint64_t>(item.material) << 32) | item.mesh.firstIndex;
+        visible.emplace_back(key, i);
+    }
+    std::sort(visible.begin(), visible.end());
+    out.visibleItems = visible.size();
+    out.instances.reserve(visible.size());
+
+    for (size_t i = 0; i < visible.size(); ++i) {
+        const IndirectDrawItem& item = items[visible[i].second];
+        uint32_t instance = static_cast<uint32_t>(out.instances.size());
+        out.instances.push_back(DrawInstanceData{ item.model, item.color });
+
+        bool sameMesh = i > 0 && visible[i - 1].first == visible[i].first;
+        if (sameMesh) {
+            ++out.commands.back().instanceCount;
+            continue;
+        }
+
+        if (out.materials.empty() || out.materials.back().material != item.material) {
+            out.materials.push_back(MaterialDrawRange{ item.material, static_cast<uint32_t>(out.commands.size()), 0 });
+        }
+        out.commands.push_back(DrawElementsIndirectCommand{
+            item.mesh.indexCount, 1, item.mesh.firstIndex, item.mesh.baseVertex, instance });
+        ++out.materials.back().commandCount;
+    }
+}
+
+} // namespace IndirectDraw
+
+IndirectRenderer::IndirectRenderer()
+    : program(0)
+    , vertexArray(0)
+    , instanceBuffer(0)
+    , commandBuffer(0)
+    , boundVertexBuffer(0)
+    , viewProjectionLocation(-1)
+    , lastMultiDrawCount(0) {}
+
+IndirectRenderer::~IndirectRenderer() {
+    if (program) glDeleteProgram(program);
+    if (vertexArray) glDeleteVertexArrays(1, &vertexArray);
+    if (instanceBuffer) glDeleteBuffers(1, &instanceBuffer);
+    if (commandBuffer) glDeleteBuffers(1, &commandBuffer);
+}
+
+bool IndirectRenderer::initialize() {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if (!vertexShader || !fragmentShader) {
+        if (vertexShader) glDeleteShader(vertexShader);
+        if (fragmentShader) glDeleteShader(fragmentShader);
+        return false;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, sizeof(infoLog), nullptr, infoLog);
+        std::cerr << "Indirect renderer program linking failed: " << infoLog << std::endl;
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+    viewProjectionLocation = glGetUniformLocation(program, "uViewProjection");
+
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(1, &instanceBuffer);
+    glGenBuffers(1, &commandBuffer);
+
+    // Per-draw attributes advance once per instance; baseInstance selects the record
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(DrawInstanceData),
+                          reinterpret_cast<const void*>(offsetof(DrawInstanceData, color)));
+    glVertexAttribDivisor(3, 1);
+    for (int column = 0; column < 4; ++column) {
+        GLuint location = 4 + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(DrawInstanceData),
+                              reinterpret_cast<const void*>(offsetof(DrawInstanceData, model) + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void IndirectRenderer::bindArena(const MeshArena& arena) {
+    glBindBuffer(GL_ARRAY_BUFFER, arena.getVertexBuffer());
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ArenaVertex),
+                          reinterpret_cast<const void*>(offsetof(ArenaVertex, position)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ArenaVertex),
+                          reinterpret_cast<const void*>(offsetof(ArenaVertex, color)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(ArenaVertex),
+                          reinterpret_cast<const void*>(offsetof(ArenaVertex, tint)));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arena.getIndexBuffer());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    boundVertexBuffer = arena.getVertexBuffer();
+}
+
+void IndirectRenderer::submit(MeshArena& arena, const IndirectDrawList& list, const glm::mat4& viewProjection,
+                              const std::function<void(uint32_t)>& bindMaterial) {
+    lastMultiDrawCount = 0;
+    if (!program || list.commands.empty()) return;
+
+    arena.upload();
+
+    glBindVertexArray(vertexArray);
+    if (boundVertexBuffer != arena.getVertexBuffer()) {
+        bindArena(arena);
+    }
+
+    // Orphan and refill the per-frame buffers
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, list.instances.size() * sizeof(DrawInstanceData), list.instances.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, list.commands.size() * sizeof(DrawElementsIndirectCommand), list.commands.data(), GL_STREAM_DRAW);
+
+    glUseProgram(program);
+    glUniformMatrix4fv(viewProjectionLocation, 1, GL_FALSE, glm::value_ptr(viewProjection));
+
+    for (const MaterialDrawRange& range : list.materials) {
+        if (bindMaterial) bindMaterial(range.material);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                                    reinterpret_cast<const void*>(range.firstCommand * sizeof(DrawElementsIndirectCommand)),
+                                    static_cast<GLsizei>(range.commandCount), 0);
+        ++lastMultiDrawCount;
+    }
+
+    glUseProgram(0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+}
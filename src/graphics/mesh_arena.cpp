@@ -0,0 +1,69 @@
+#include <GL/glew.h>
+#include "../../include/graphics/mesh_arena.h"
+#include <algorithm>
+
+MeshArena::MeshArena()
+    : vertexBuffer(0)
+    , indexBuffer(0)
+    , vertexCapacity(0)
+    , indexCapacity(0)
+    , uploadedVertices(0)
+    , uploadedIndices(0) {}
+
+MeshArena::~MeshArena() {
+    if (vertexBuffer) glDeleteBuffers(1, &vertexBuffer);
+    if (indexBuffer) glDeleteBuffers(1, &indexBuffer);
+}
+
+MeshRange MeshArena::add(const std::vector<ArenaVertex>& meshVertices, const std::vector<uint32_t>& meshIndices) {
+    MeshRange range;
+    range.firstIndex = static_cast<uint32_t>(indices.size());
+    range.indexCount = static_cast<uint32_t>(meshIndices.size());
+    range.baseVertex = static_cast<int32_t>(vertices.size());
+    for (const ArenaVertex& vertex : meshVertices) {
+        range.bounds.expand(vertex.position);
+    }
+
+    // Indices stay mesh-local; baseVertex offsets them at draw time
+    vertices.insert(vertices.end(), meshVertices.begin(), meshVertices.end());
+    indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+    return range;
+}
+
+void MeshArena::clear() {
+    vertices.clear();
+    indices.clear();
+    uploadedVertices = 0;
+    uploadedIndices = 0;
+}
+
+void MeshArena::upload() {
+    if (!needsUpload()) return;
+
+    if (!vertexBuffer) glGenBuffers(1, &vertexBuffer);
+    if (!indexBuffer) glGenBuffers(1, &indexBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    if (vertices.size() > vertexCapacity) {
+        vertexCapacity = std::max(vertices.size(), vertexCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, vertexCapacity * sizeof(ArenaVertex), nullptr, GL_STATIC_DRAW);
+        uploadedVertices = 0;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, uploadedVertices * sizeof(ArenaVertex),
+                    (vertices.size() - uploadedVertices) * sizeof(ArenaVertex), vertices.data() + uploadedVertices);
+    uploadedVertices = vertices.size();
+
+    // GL_ELEMENT_ARRAY_BUFFER binding is VAO state, so use a neutral target
+    glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+    if (indices.size() > indexCapacity) {
+        indexCapacity = std::max(indices.size(), indexCapacity * 2);
+        glBufferData(GL_COPY_WRITE_BUFFER, indexCapacity * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+        uploadedIndices = 0;
+    }
+    glBufferSubData(GL_COPY_WRITE_BUFFER, uploadedIndices * sizeof(uint32_t),
+                    (indices.size() - uploadedIndices) * sizeof(uint32_t), indices.data() + uploadedIndices);
+    uploadedIndices = indices.size();
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
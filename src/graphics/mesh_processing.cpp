@@ -0,0 +1,268 @@
+#include "../../include/graphics/mesh_processing.h"
+#include "../../include/core/thread_pool.h"
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+
+namespace MeshProcessing {
+
+namespace {
+    const size_t TRIANGLE_GRAIN = 16384;
+    const size_t VERTEX_GRAIN = 32768;
+    const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+    // Generated corner normals closer than this (cosine) share a vertex
+    const float NORMAL_MERGE_DOT = 0.9999f;
+
+    void forRange(ThreadPool* pool, size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body) {
+        if (pool) {
+            pool->parallelFor(count, grainSize, body);
+        } else {
+            body(0, count);
+        }
+    }
+
+    // Interior angle at corner a of triangle (a, b, c)
+    float cornerAngle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+        glm::vec3 e1 = b - a;
+        glm::vec3 e2 = c - a;
+        float lengths = glm::length(e1) * glm::length(e2);
+        if (lengths <= 0.0f) return 0.0f;
+        return std::acos(glm::clamp(glm::dot(e1, e2) / lengths, -1.0f, 1.0f));
+    }
+
+    // Corners (3 * triangle + k) bucketed by a per-corner key, in CSR form.
+    // Lets each output gather from its neighbours instead of scattering with atomics.
+    struct CornerGroups {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> corners;
+    };
+
+    CornerGroups groupCorners(const std::vector<uint32_t>& cornerKeys, size_t keyCount) {
+        CornerGroups groups;
+        groups.offsets.assign(keyCount + 1, 0);
+        for (uint32_t key : cornerKeys) {
+            ++groups.offsets[key + 1];
+        }
+        for (size_t i = 0; i < keyCount; ++i) {
+            groups.offsets[i + 1] += groups.offsets[i];
+        }
+
+        std::vector<uint32_t> cursor(groups.offsets.begin(), groups.offsets.end() - 1);
+        groups.corners.resize(cornerKeys.size());
+        for (size_t corner = 0; corner < cornerKeys.size(); ++corner) {
+            groups.corners[cursor[cornerKeys[corner]]++] = static_cast<uint32_t>(corner);
+        }
+        return groups;
+    }
+
+    struct PositionKey {
+        uint32_t bits[3];
+        bool operator==(const PositionKey& other) const {
+            return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+        }
+    };
+
+    struct PositionKeyHash {
+        size_t operator()(const PositionKey& key) const {
+            return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+        }
+    };
+
+    // Maps every vertex to an id shared by all vertices at the same position
+    size_t weldPositions(const std::vector<Vertex>& vertices, std::vector<uint32_t>& positionIds) {
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> ids;
+        ids.reserve(vertices.size());
+        positionIds.resize(vertices.size());
+
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            glm::vec3 p = vertices[i].position;
+            // Fold -0.0 into 0.0 so both hash the same
+            p += glm::vec3(0.0f);
+            PositionKey key;
+            std::memcpy(key.bits, &p.x, sizeof(key.bits));
+            auto inserted = ids.emplace(key, static_cast<uint32_t>(ids.size()));
+            positionIds[i] = inserted.first->second;
+        }
+        return ids.size();
+    }
+}
+
+void generateNormals(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                     float creaseAngleDegrees, ThreadPool* pool) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Pass 1: unit face normals and interior angles, one triangle per iteration
+    std::vector<glm::vec3> faceNormals(triangleCount);
+    std::vector<float> cornerAngles(triangleCount * 3);
+    forRange(pool, triangleCount, TRIANGLE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            const glm::vec3& p0 = vertices[indices[3 * t + 0]].position;
+            const glm::vec3& p1 = vertices[indices[3 * t + 1]].position;
+            const glm::vec3& p2 = vertices[indices[3 * t + 2]].position;
+
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float len = glm::length(n);
+            faceNormals[t] = len > 0.0f ? n / len : glm::vec3(0.0f);
+
+            cornerAngles[3 * t + 0] = cornerAngle(p0, p1, p2);
+            cornerAngles[3 * t + 1] = cornerAngle(p1, p2, p0);
+            cornerAngles[3 * t + 2] = cornerAngle(p2, p0, p1);
+        }
+    });
+
+    // Pass 2: group corners by welded position so smoothing crosses UV seams
+    std::vector<uint32_t> positionIds;
+    size_t positionCount = weldPositions(vertices, positionIds);
+    std::vector<uint32_t> cornerPositions(indices.size());
+    for (size_t corner = 0; corner < indices.size(); ++corner) {
+        cornerPositions[corner] = positionIds[indices[corner]];
+    }
+    CornerGroups groups = groupCorners(cornerPositions, positionCount);
+
+    // Pass 3: each corner gathers the angle-weighted normals of the faces around its
+    // position that lie within the crease angle of its own face
+    float cosCrease = std::cos(glm::radians(creaseAngleDegrees));
+    std::vector<glm::vec3> cornerNormals(indices.size());
+    forRange(pool, triangleCount, TRIANGLE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            const glm::vec3& faceNormal = faceNormals[t];
+            bool degenerate = glm::dot(faceNormal, faceNormal) == 0.0f;
+
+            for (size_t k = 0; k < 3; ++k) {
+                size_t corner = 3 * t + k;
+                uint32_t group = cornerPositions[corner];
+                glm::vec3 sum(0.0f);
+
+                for (uint32_t j = groups.offsets[group]; j < groups.offsets[group + 1]; ++j) {
+                    uint32_t other = groups.corners[j];
+                    const glm::vec3& otherNormal = faceNormals[other / 3];
+                    if (degenerate || glm::dot(faceNormal, otherNormal) >= cosCrease) {
+                        sum += otherNormal * cornerAngles[other];
+                    }
+                }
+
+                float len = glm::length(sum);
+                if (len > 1e-12f) {
+                    cornerNormals[corner] = sum / len;
+                } else {
+                    cornerNormals[corner] = degenerate ? glm::vec3(0.0f, 1.0f, 0.0f) : faceNormal;
+                }
+            }
+        }
+    });
+
+    // Pass 4: emit one vertex per distinct (source vertex, normal) pair
+    std::vector<Vertex> result;
+    result.reserve(vertices.size());
+    std::vector<uint32_t> firstCopy(vertices.size(), INVALID_INDEX);
+    std::vector<uint32_t> nextCopy;
+    nextCopy.reserve(vertices.size());
+
+    for (size_t corner = 0; corner < indices.size(); ++corner) {
+        uint32_t source = indices[corner];
+        const glm::vec3& normal = cornerNormals[corner];
+
+        uint32_t match = INVALID_INDEX;
+        for (uint32_t copy = firstCopy[source]; copy != INVALID_INDEX; copy = nextCopy[copy]) {
+            if (glm::dot(result[copy].normal, normal) > NORMAL_MERGE_DOT) {
+                match = copy;
+                break;
+            }
+        }
+
+        if (match == INVALID_INDEX) {
+            match = static_cast<uint32_t>(result.size());
+            Vertex vertex = vertices[source];
+            vertex.normal = normal;
+            result.push_back(vertex);
+            nextCopy.push_back(firstCopy[source]);
+            firstCopy[source] = match;
+        }
+
+        indices[corner] = match;
+    }
+
+    vertices.swap(result);
+}
+
+void generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, ThreadPool* pool) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Pass 1: per-corner tangents from the UV gradient, projected onto the corner's
+    // normal plane and weighted by the corner angle, plus a weighted handedness vote
+    std::vector<glm::vec3> cornerTangents(indices.size());
+    std::vector<float> cornerSigns(indices.size());
+    forRange(pool, triangleCount, TRIANGLE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            const Vertex& v0 = vertices[indices[3 * t + 0]];
+            const Vertex& v1 = vertices[indices[3 * t + 1]];
+            const Vertex& v2 = vertices[indices[3 * t + 2]];
+
+            glm::vec3 e1 = v1.position - v0.position;
+            glm::vec3 e2 = v2.position - v0.position;
+            glm::vec2 d1 = v1.texCoord - v0.texCoord;
+            glm::vec2 d2 = v2.texCoord - v0.texCoord;
+
+            float det = d1.x * d2.y - d2.x * d1.y;
+            bool valid = std::fabs(det) > 1e-20f;
+            glm::vec3 faceTangent(0.0f);
+            glm::vec3 faceBitangent(0.0f);
+            if (valid) {
+                faceTangent = (e1 * d2.y - e2 * d1.y) / det;
+                faceBitangent = (e2 * d1.x - e1 * d2.x) / det;
+            }
+
+            const Vertex* corners[3] = { &v0, &v1, &v2 };
+            for (size_t k = 0; k < 3; ++k) {
+                size_t corner = 3 * t + k;
+                if (!valid) {
+                    cornerTangents[corner] = glm::vec3(0.0f);
+                    cornerSigns[corner] = 0.0f;
+                    continue;
+                }
+
+                const glm::vec3& n = corners[k]->normal;
+                float angle = cornerAngle(corners[k]->position, corners[(k + 1) % 3]->position,
+                                          corners[(k + 2) % 3]->position);
+
+                glm::vec3 projected = faceTangent - n * glm::dot(n, faceTangent);
+                float len = glm::length(projected);
+                cornerTangents[corner] = len > 0.0f ? projected * (angle / len) : glm::vec3(0.0f);
+
+                float handedness = glm::dot(glm::cross(n, faceTangent), faceBitangent) < 0.0f ? -1.0f : 1.0f;
+                cornerSigns[corner] = handedness * angle;
+            }
+        }
+    });
+
+    // Pass 2: each vertex gathers its corners and orthonormalizes against its normal
+    CornerGroups groups = groupCorners(indices, vertices.size());
+    forRange(pool, vertices.size(), VERTEX_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            glm::vec3 sum(0.0f);
+            float vote = 0.0f;
+            for (uint32_t j = groups.offsets[v]; j < groups.offsets[v + 1]; ++j) {
+                sum += cornerTangents[groups.corners[j]];
+                vote += cornerSigns[groups.corners[j]];
+            }
+
+            const glm::vec3& n = vertices[v].normal;
+            glm::vec3 tangent = sum - n * glm::dot(n, sum);
+            float len = glm::length(tangent);
+            if (len > 1e-12f) {
+                tangent /= len;
+            } else {
+                // No usable UVs: any unit vector perpendicular to the normal
+                glm::vec3 axis = std::fabs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+                tangent = glm::normalize(axis - n * glm::dot(n, axis));
+            }
+
+            vertices[v].tangent = glm::vec4(tangent, vote < 0.0f ? -1.0f : 1.0f);
+        }
+    });
+}
+
+} // namespace MeshProcessing
@@ -0,0 +1,377 @@
+#include "../../include/graphics/mesh_simplifier.h"
+#include "../../include/core/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace MeshSimplifier {
+
+namespace {
+    const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+    // Extra weight of the planes that hold mesh borders in place
+    const float BORDER_WEIGHT = 10.0f;
+    // Each pass collapses at most 1/PASS_FRACTION of its candidate edges, cheapest first,
+    // before costs are re-evaluated on the updated mesh
+    const size_t PASS_FRACTION = 3;
+
+    // Symmetric 4x4 error quadric plus the total weight of the planes it holds
+    struct Quadric {
+        double a2 = 0, b2 = 0, c2 = 0, d2 = 0;
+        double ab = 0, ac = 0, ad = 0, bc = 0, bd = 0, cd = 0;
+        double weight = 0;
+
+        void addPlane(const glm::vec3& n, float d, float w) {
+            a2 += w * n.x * n.x; b2 += w * n.y * n.y; c2 += w * n.z * n.z; d2 += w * d * d;
+            ab += w * n.x * n.y; ac += w * n.x * n.z; ad += w * n.x * d;
+            bc += w * n.y * n.z; bd += w * n.y * d; cd += w * n.z * d;
+            weight += w;
+        }
+
+        void add(const Quadric& o) {
+            a2 += o.a2; b2 += o.b2; c2 += o.c2; d2 += o.d2;
+            ab += o.ab; ac += o.ac; ad += o.ad; bc += o.bc; bd += o.bd; cd += o.cd;
+            weight += o.weight;
+        }
+
+        // Weighted mean squared distance from p to the planes
+        double error(const glm::vec3& p) const {
+            if (weight <= 0.0) return 0.0;
+            double x = p.x, y = p.y, z = p.z;
+            double sum = a2 * x * x + b2 * y * y + c2 * z * z + d2
+                + 2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+            return std::max(sum / weight, 0.0);
+        }
+    };
+
+    enum class VertexKind : uint8_t {
+        MANIFOLD,   // Free to collapse onto any neighbour
+        BORDER,     // Only collapses along a border edge
+        LOCKED      // Seam, non-manifold or border corner: never moves
+    };
+
+    uint64_t edgeKey(uint32_t from, uint32_t to) {
+        return (static_cast<uint64_t>(from) << 32) | to;
+    }
+
+    struct PositionKey {
+        uint32_t bits[3];
+        bool operator==(const PositionKey& other) const {
+            return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+        }
+    };
+
+    struct PositionKeyHash {
+        size_t operator()(const PositionKey& key) const {
+            return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+        }
+    };
+
+    struct Collapse {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+        bool operator<(const Collapse& other) const { return cost < other.cost; }
+    };
+
+    uint32_t resolve(std::vector<uint32_t>& remap, uint32_t vertex) {
+        uint32_t root = vertex;
+        while (remap[root] != root) root = remap[root];
+        // Path compression keeps later lookups O(1)
+        while (remap[vertex] != root) {
+            uint32_t next = remap[vertex];
+            remap[vertex] = root;
+            vertex = next;
+        }
+        return root;
+    }
+}
+
+SimplifiedMesh simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                        size_t targetIndexCount) {
+    SimplifiedMesh result;
+    result.indices = indices;
+    size_t targetTriangles = targetIndexCount / 3;
+    if (indices.size() / 3 <= targetTriangles) return result;
+
+    // Weld vertices by position; attribute copies of one position are "wedges"
+    std::vector<uint32_t> positionOf(vertices.size());
+    std::vector<glm::vec3> positions;
+    {
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> ids;
+        ids.reserve(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            glm::vec3 p = vertices[i].position + glm::vec3(0.0f);
+            PositionKey key;
+            std::memcpy(key.bits, &p.x, sizeof(key.bits));
+            auto inserted = ids.emplace(key, static_cast<uint32_t>(positions.size()));
+            if (inserted.second) positions.push_back(p);
+            positionOf[i] = inserted.first->second;
+        }
+    }
+    size_t positionCount = positions.size();
+
+    // Classify positions: seams (several referenced wedges), non-manifold edges and
+    // border corners are locked; other border vertices may slide along their border
+    std::vector<VertexKind> kinds(positionCount, VertexKind::MANIFOLD);
+    {
+        std::vector<uint32_t> firstWedge(positionCount, INVALID_INDEX);
+        for (uint32_t index : indices) {
+            uint32_t p = positionOf[index];
+            if (firstWedge[p] == INVALID_INDEX) {
+                firstWedge[p] = index;
+            } else if (firstWedge[p] != index) {
+                kinds[p] = VertexKind::LOCKED;
+            }
+        }
+
+        std::unordered_map<uint64_t, uint32_t> directedEdges;
+        directedEdges.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            for (size_t k = 0; k < 3; ++k) {
+                ++directedEdges[edgeKey(positionOf[indices[i + k]], positionOf[indices[i + (k + 1) % 3]])];
+            }
+        }
+
+        std::vector<uint32_t> borderEdges(positionCount, 0);
+        for (const auto& edge : directedEdges) {
+            uint32_t from = static_cast<uint32_t>(edge.first >> 32);
+            uint32_t to = static_cast<uint32_t>(edge.first & 0xFFFFFFFFu);
+            if (edge.second > 1) {
+                kinds[from] = VertexKind::LOCKED;
+                kinds[to] = VertexKind::LOCKED;
+            } else if (directedEdges.find(edgeKey(to, from)) == directedEdges.end()) {
+                ++borderEdges[from];
+                ++borderEdges[to];
+            }
+        }
+
+        for (size_t p = 0; p < positionCount; ++p) {
+            if (borderEdges[p] > 0 && kinds[p] == VertexKind::MANIFOLD) {
+                kinds[p] = borderEdges[p] == 2 ? VertexKind::BORDER : VertexKind::LOCKED;
+            }
+        }
+    }
+
+    // Area-weighted face quadrics, plus perpendicular planes along borders
+    std::vector<Quadric> quadrics(positionCount);
+    {
+        std::unordered_set<uint64_t> directedEdges;
+        directedEdges.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            for (size_t k = 0; k < 3; ++k) {
+                directedEdges.insert(edgeKey(positionOf[indices[i + k]], positionOf[indices[i + (k + 1) % 3]]));
+            }
+        }
+
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            uint32_t p[3] = { positionOf[indices[i]], positionOf[indices[i + 1]], positionOf[indices[i + 2]] };
+            glm::vec3 cross = glm::cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+            float area = glm::length(cross) * 0.5f;
+            if (area <= 0.0f) continue;
+            glm::vec3 normal = cross / (area * 2.0f);
+
+            Quadric face;
+            face.addPlane(normal, -glm::dot(normal, positions[p[0]]), area);
+            for (size_t k = 0; k < 3; ++k) {
+                quadrics[p[k]].add(face);
+            }
+
+            for (size_t k = 0; k < 3; ++k) {
+                uint32_t from = p[k];
+                uint32_t to = p[(k + 1) % 3];
+                if (directedEdges.count(edgeKey(to, from))) continue;
+
+                glm::vec3 edge = positions[to] - positions[from];
+                float edgeLength = glm::length(edge);
+                if (edgeLength <= 0.0f) continue;
+                glm::vec3 borderNormal = glm::normalize(glm::cross(edge, normal));
+
+                Quadric border;
+                border.addPlane(borderNormal, -glm::dot(borderNormal, positions[from]),
+                                BORDER_WEIGHT * edgeLength * edgeLength);
+                quadrics[from].add(border);
+                quadrics[to].add(border);
+            }
+        }
+    }
+
+    std::vector<uint32_t> remap(vertices.size());
+    for (size_t i = 0; i < remap.size(); ++i) remap[i] = static_cast<uint32_t>(i);
+
+    std::vector<uint32_t>& current = result.indices;
+    double maxError = 0.0;
+
+    std::vector<uint32_t> adjacencyOffsets;
+    std::vector<uint32_t> adjacency;
+    std::vector<char> touched;
+    std::vector<Collapse> candidates;
+    std::unordered_set<uint64_t> directedEdges;
+
+    while (current.size() / 3 > targetTriangles) {
+        size_t triangleCount = current.size() / 3;
+
+        // Position -> triangle adjacency for the current mesh
+        adjacencyOffsets.assign(positionCount + 1, 0);
+        for (uint32_t index : current) ++adjacencyOffsets[positionOf[index] + 1];
+        for (size_t p = 0; p < positionCount; ++p) adjacencyOffsets[p + 1] += adjacencyOffsets[p];
+        adjacency.resize(current.size());
+        {
+            std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < current.size(); ++i) {
+                adjacency[cursor[positionOf[current[i]]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        directedEdges.clear();
+        for (size_t i = 0; i < current.size(); i += 3) {
+            for (size_t k = 0; k < 3; ++k) {
+                directedEdges.insert(edgeKey(positionOf[current[i + k]], positionOf[current[i + (k + 1) % 3]]));
+            }
+        }
+
+        // Cheapest legal direction for every edge
+        candidates.clear();
+        for (uint64_t key : directedEdges) {
+            uint32_t a = static_cast<uint32_t>(key >> 32);
+            uint32_t b = static_cast<uint32_t>(key & 0xFFFFFFFFu);
+            bool border = directedEdges.count(edgeKey(b, a)) == 0;
+            // Visit interior edges once
+            if (!border && a > b) continue;
+
+            Collapse best = { INVALID_INDEX, INVALID_INDEX, 0.0 };
+            for (int direction = 0; direction < 2; ++direction) {
+                uint32_t from = direction == 0 ? a : b;
+                uint32_t to = direction == 0 ? b : a;
+                if (kinds[from] == VertexKind::LOCKED) continue;
+                if (kinds[from] == VertexKind::BORDER && !border) continue;
+
+                Quadric combined = quadrics[from];
+                combined.add(quadrics[to]);
+                double cost = combined.error(positions[to]);
+                if (best.from == INVALID_INDEX || cost < best.cost) {
+                    best = { from, to, cost };
+                }
+            }
+            if (best.from != INVALID_INDEX) candidates.push_back(best);
+        }
+        if (candidates.empty()) break;
+        std::sort(candidates.begin(), candidates.end());
+
+        touched.assign(positionCount, 0);
+        size_t removed = 0;
+        size_t collapses = 0;
+        size_t collapseLimit = std::max<size_t>(1, candidates.size() / PASS_FRACTION);
+
+        for (const Collapse& collapse : candidates) {
+            if (collapses >= collapseLimit || triangleCount - removed <= targetTriangles) break;
+            uint32_t u = collapse.from;
+            uint32_t v = collapse.to;
+            if (touched[u] || touched[v]) continue;
+
+            // Reject collapses that flip a surviving triangle, and find the wedges involved
+            bool valid = true;
+            uint32_t fromWedge = INVALID_INDEX;
+            uint32_t toWedge = INVALID_INDEX;
+            size_t sharedTriangles = 0;
+            for (uint32_t j = adjacencyOffsets[u]; j < adjacencyOffsets[u + 1] && valid; ++j) {
+                const uint32_t* tri = &current[adjacency[j] * 3];
+                uint32_t p[3] = { positionOf[tri[0]], positionOf[tri[1]], positionOf[tri[2]] };
+
+                int uCorner = p[0] == u ? 0 : (p[1] == u ? 1 : 2);
+                fromWedge = tri[uCorner];
+
+                int vCorner = p[0] == v ? 0 : (p[1] == v ? 1 : (p[2] == v ? 2 : -1));
+                if (vCorner >= 0) {
+                    if (toWedge != INVALID_INDEX && toWedge != tri[vCorner]) valid = false;
+                    toWedge = tri[vCorner];
+                    ++sharedTriangles;
+                    continue;
+                }
+
+                glm::vec3 a = positions[p[0]];
+                glm::vec3 b = positions[p[1]];
+                glm::vec3 c = positions[p[2]];
+                glm::vec3 before = glm::cross(b - a, c - a);
+                (uCorner == 0 ? a : (uCorner == 1 ? b : c)) = positions[v];
+                glm::vec3 after = glm::cross(b - a, c - a);
+                if (glm::dot(before, after) <= 0.0f) valid = false;
+            }
+            if (!valid || toWedge == INVALID_INDEX) continue;
+
+            remap[fromWedge] = toWedge;
+            quadrics[v].add(quadrics[u]);
+            maxError = std::max(maxError, collapse.cost);
+            removed += sharedTriangles;
+            ++collapses;
+
+            // Freeze the whole one-ring so later flip checks this pass stay accurate
+            for (uint32_t j = adjacencyOffsets[u]; j < adjacencyOffsets[u + 1]; ++j) {
+                const uint32_t* tri = &current[adjacency[j] * 3];
+                for (int k = 0; k < 3; ++k) touched[positionOf[tri[k]]] = 1;
+            }
+        }
+
+        if (collapses == 0) break;
+
+        // Apply the remap and drop triangles that became degenerate
+        size_t write = 0;
+        for (size_t i = 0; i < current.size(); i += 3) {
+            uint32_t a = resolve(remap, current[i]);
+            uint32_t b = resolve(remap, current[i + 1]);
+            uint32_t c = resolve(remap, current[i + 2]);
+            uint32_t pa = positionOf[a], pb = positionOf[b], pc = positionOf[c];
+            if (pa == pb || pb == pc || pa == pc) continue;
+            current[write++] = a;
+            current[write++] = b;
+            current[write++] = c;
+        }
+        current.resize(write);
+    }
+
+    result.error = static_cast<float>(std::sqrt(maxError));
+    return result;
+}
+
+std::vector<SimplifiedMesh> buildLodChain(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                          const std::vector<float>& ratios, ThreadPool* pool) {
+    std::vector<float> sortedRatios = ratios;
+    std::sort(sortedRatios.begin(), sortedRatios.end(), [](float a, float b) { return a > b; });
+
+    std::vector<SimplifiedMesh> levels(sortedRatios.size());
+    size_t triangleCount = indices.size() / 3;
+    auto buildLevels = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float ratio = glm::clamp(sortedRatios[i], 0.0f, 1.0f);
+            size_t targetTriangles = static_cast<size_t>(std::lround(ratio * triangleCount));
+            levels[i] = simplify(vertices, indices, targetTriangles * 3);
+        }
+    };
+
+    // Levels are independent, so each one is a separate task
+    if (pool) {
+        pool->parallelFor(levels.size(), 1, buildLevels);
+    } else {
+        buildLevels(0, levels.size());
+    }
+
+    for (size_t i = 1; i < levels.size(); ++i) {
+        levels[i].error = std::max(levels[i].error, levels[i - 1].error);
+    }
+    return levels;
+}
+
+size_t selectLod(const std::vector<MeshLod>& lods, float distance, float projectionScale, float pixelThreshold) {
+    distance = std::max(distance, 1e-4f);
+
+    size_t selected = 0;
+    for (size_t i = 1; i < lods.size(); ++i) {
+        float pixelError = lods[i].error * projectionScale / distance;
+        if (pixelError > pixelThreshold) break;
+        selected = i;
+    }
+    return selected;
+}
+
+} // namespace MeshSimplifier
@@ -0,0 +1,128 @@
+#include "../../include/graphics/model_streamer.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+const size_t ModelStreamer::DEFAULT_UPLOAD_BUDGET;
+
+ModelStreamer::ModelStreamer(ThreadPool& pool, size_t uploadBudgetBytes, std::unique_ptr<ModelUploader> uploader)
+    : pool(pool)
+    , uploader(std::move(uploader))
+    , uploadBudget(uploadBudgetBytes > 0 ? uploadBudgetBytes : 1)
+    , pendingRequests(0)
+    , parsesInFlight(0) {
+    if (!this->uploader) {
+        this->uploader.reset(new GLModelUploader());
+    }
+}
+
+ModelStreamer::~ModelStreamer() {
+    // Workers still hold raw pointers into this object; let them finish
+    while (parsesInFlight.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+
+    Request* request = nullptr;
+    while (parsedRequests.tryPop(request)) {
+        delete request;
+    }
+}
+
+std::shared_future<ModelStreamer::ModelPtr> ModelStreamer::requestLoad(const std::string& objFilename,
+                                                                       const std::string& mtlBasePath,
+                                                                       ReadyCallback onReady) {
+    Request* request = new Request();
+    request->objFilename = objFilename;
+    request->mtlBasePath = mtlBasePath;
+    request->model = std::make_shared<Model>();
+    request->model->setProcessingPool(&pool);
+    request->onReady = std::move(onReady);
+    std::shared_future<ModelPtr> future = request->promise.get_future().share();
+
+    pendingRequests.fetch_add(1, std::memory_order_relaxed);
+    parsesInFlight.fetch_add(1, std::memory_order_relaxed);
+
+    pool.enqueue([this, request] {
+        request->parsed = request->model->loadMeshData(request->objFilename, request->mtlBasePath);
+        parsedRequests.push(request);
+        parsesInFlight.fetch_sub(1, std::memory_order_release);
+    });
+
+    return future;
+}
+
+size_t ModelStreamer::update() {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Request* parsed = nullptr;
+    while (parsedRequests.tryPop(parsed)) {
+        std::unique_ptr<Request> request(parsed);
+        if (!request->parsed) {
+            complete(*request, false);
+            continue;
+        }
+        uploadQueue.push_back(std::move(request));
+    }
+
+    size_t budgetLeft = uploadBudget;
+    while (!uploadQueue.empty() && budgetLeft > 0) {
+        Request& request = *uploadQueue.front();
+        Model& model = *request.model;
+
+        if (!request.uploadStarted) {
+            if (!uploader->begin(model)) {
+                complete(request, false);
+                uploadQueue.pop_front();
+                continue;
+            }
+            request.uploadStarted = true;
+        }
+
+        // Vertices first, then indices, each clipped to what is left of this frame's budget
+        size_t vertexBytes = std::min(model.getVertexDataSize() - request.vertexBytesUploaded, budgetLeft);
+        if (vertexBytes > 0) {
+            uploader->uploadVertices(model, request.vertexBytesUploaded, vertexBytes);
+            request.vertexBytesUploaded += vertexBytes;
+            budgetLeft -= vertexBytes;
+        }
+
+        size_t indexBytes = std::min(model.getIndexDataSize() - request.indexBytesUploaded, budgetLeft);
+        if (indexBytes > 0) {
+            uploader->uploadIndices(model, request.indexBytesUploaded, indexBytes);
+            request.indexBytesUploaded += indexBytes;
+            budgetLeft -= indexBytes;
+        }
+
+        if (request.vertexBytesUploaded == model.getVertexDataSize() &&
+            request.indexBytesUploaded == model.getIndexDataSize()) {
+            uploader->finish(model);
+            complete(request, true);
+            uploadQueue.pop_front();
+        }
+    }
+
+    size_t uploaded = uploadBudget - budgetLeft;
+    stats.totalBytesUploaded += uploaded;
+    stats.lastFrameBytes = uploaded;
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    stats.lastFrameMs = elapsed.count();
+    stats.maxFrameMs = std::max(stats.maxFrameMs, stats.lastFrameMs);
+
+    return uploaded;
+}
+
+void ModelStreamer::complete(Request& request, bool success) {
+    ModelPtr result = success ? request.model : nullptr;
+    if (success) {
+        ++stats.requestsCompleted;
+    } else {
+        ++stats.requestsFailed;
+    }
+
+    pendingRequests.fetch_sub(1, std::memory_order_relaxed);
+    request.promise.set_value(result);
+    if (request.onReady) {
+        request.onReady(result);
+    }
+}
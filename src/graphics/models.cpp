@@ -1,11 +1,16 @@
 #include "../../include/graphics/models.h"
+#include "../../include/graphics/mesh_processing.h"
+#include "../../include/graphics/mesh_simplifier.h"
+#include <algorithm>
 #include <iostream>
 #include <unordered_map>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-Model::Model() : VAO(0), VBO(0), EBO(0), isInitialized(false), modelMatrix(glm::mat4(1.0f)) {}
+Model::Model()
+    : VAO(0), VBO(0), EBO(0), isInitialized(false), modelMatrix(glm::mat4(1.0f))
+    , normalCreaseAngle(MeshProcessing::DEFAULT_CREASE_ANGLE), processingPool(nullptr) {}
 
 Model::~Model() {
     cleanup();
@@ -15,6 +20,22 @@ bool Model::loadFromFile(const std::string& objFilename, const std::string& mtlB
     // Clean up any existing resources first
     cleanup();
 
+    if (!loadMeshData(objFilename, mtlBasePath)) {
+        return false;
+    }
+
+    // Setup OpenGL buffers
+    if (!setupBuffers()) {
+        std::cerr << "Failed to setup OpenGL buffers" << std::endl;
+        cleanup();
+        return false;
+    }
+
+    isInitialized = true;
+    return true;
+}
+
+bool Model::loadMeshData(const std::string& objFilename, const std::string& mtlBasePath) {
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
@@ -39,18 +60,19 @@ bool Model::loadFromFile(const std::string& objFilename, const std::string& mtlB
         return false;
     }
 
-    // Setup OpenGL buffers
-    if (!setupBuffers()) {
-        std::cerr << "Failed to setup OpenGL buffers" << std::endl;
-        cleanup();
+    if (!lodRatios.empty() && !generateLods(lodRatios)) {
+        std::cerr << "Failed to generate LODs for: " << objFilename << std::endl;
         return false;
     }
 
-    isInitialized = true;
     return true;
 }
 
 void Model::draw(GLuint shaderProgram) const {
+    drawLod(shaderProgram, 0);
+}
+
+void Model::drawLod(GLuint shaderProgram, size_t level) const {
     if (!isInitialized) {
         std::cerr << "Attempting to draw uninitialized model" << std::endl;
         return;
@@ -65,8 +87,10 @@ void Model::draw(GLuint shaderProgram) const {
 
     glBindVertexArray(VAO);
 
-    if (!indices.empty()) {
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+    if (!lods.empty()) {
+        const MeshLod& lod = lods[std::min(level, lods.size() - 1)];
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(lod.indexCount), GL_UNSIGNED_INT,
+                       reinterpret_cast<const void*>(lod.indexOffset * sizeof(uint32_t)));
     }
     else {
         glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
@@ -75,13 +99,43 @@ void Model::draw(GLuint shaderProgram) const {
     glBindVertexArray(0);
 }
 
+bool Model::generateLods(const std::vector<float>& ratios) {
+    if (lods.empty()) {
+        std::cerr << "Cannot build LODs before the model data is processed" << std::endl;
+        return false;
+    }
+
+    // Rebuild from the full-detail mesh, dropping any previous chain
+    indices.resize(lods[0].indexCount);
+    lods.resize(1);
+
+    std::vector<MeshSimplifier::SimplifiedMesh> levels =
+        MeshSimplifier::buildLodChain(vertices, indices, ratios, processingPool);
+
+    size_t baseTriangles = lods[0].indexCount / 3;
+    for (const auto& level : levels) {
+        MeshLod lod;
+        lod.indexOffset = indices.size();
+        lod.indexCount = level.indices.size();
+        lod.ratio = baseTriangles > 0 ? static_cast<float>(level.indices.size() / 3) / baseTriangles : 0.0f;
+        lod.error = level.error;
+        indices.insert(indices.end(), level.indices.begin(), level.indices.end());
+        lods.push_back(lod);
+    }
+    return true;
+}
 
+size_t Model::selectLod(float distance, float projectionScale, float pixelThreshold) const {
+    return MeshSimplifier::selectLod(lods, distance, projectionScale, pixelThreshold);
+}
 
 bool Model::processModelData(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::shape_t>& shapes) {
     try {
         vertices.clear();
         indices.clear();
+        lods.clear();
         std::unordered_map<std::string, uint32_t> uniqueVertices;
+        bool missingNormals = false;
 
         for (const auto& shape : shapes) {
             for (const auto& index : shape.mesh.indices) {
@@ -109,7 +163,8 @@ bool Model::processModelData(const tinyobj::attrib_t& attrib, const std::vector<
                     };
                 }
                 else {
-                    vertex.normal = { 0.0f, 1.0f, 0.0f };  // Default normal
+                    vertex.normal = { 0.0f, 1.0f, 0.0f };  // Placeholder, regenerated below
+                    missingNormals = true;
                 }
 
                 // Get texture coordinates if available
@@ -142,7 +197,18 @@ bool Model::processModelData(const tinyobj::attrib_t& attrib, const std::vector<
             }
         }
 
-        return !vertices.empty();
+        if (vertices.empty()) return false;
+
+        if (missingNormals) {
+            MeshProcessing::generateNormals(vertices, indices, normalCreaseAngle, processingPool);
+        }
+        MeshProcessing::generateTangents(vertices, indices, processingPool);
+
+        // Level 0 is the full mesh; generateLods appends the simplified levels
+        lods.clear();
+        lods.push_back({ 0, indices.size(), 1.0f, 0.0f });
+
+        return true;
     }
     catch (const std::exception& e) {
         std::cerr << "Exception in processModelData: " << e.what() << std::endl;
@@ -151,6 +217,17 @@ bool Model::processModelData(const tinyobj::attrib_t& attrib, const std::vector<
 }
 
 bool Model::setupBuffers() {
+    if (!beginUpload()) {
+        return false;
+    }
+
+    uploadVertexRange(0, getVertexDataSize());
+    uploadIndexRange(0, getIndexDataSize());
+    finishUpload();
+    return true;
+}
+
+bool Model::beginUpload() {
     if (vertices.empty()) {
         std::cerr << "No vertices to setup buffers" << std::endl;
         return false;
@@ -164,10 +241,10 @@ bool Model::setupBuffers() {
         glGenVertexArrays(1, &VAO);
         glBindVertexArray(VAO);
 
-        // Generate and setup VBO
+        // Allocate the VBO; contents arrive through uploadVertexRange
         glGenBuffers(1, &VBO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, getVertexDataSize(), nullptr, GL_STATIC_DRAW);
 
         // Setup vertex attributes
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
@@ -179,10 +256,13 @@ bool Model::setupBuffers() {
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
         glEnableVertexAttribArray(2);
 
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
+        glEnableVertexAttribArray(3);
+
         if (!indices.empty()) {
             glGenBuffers(1, &EBO);
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, getIndexDataSize(), nullptr, GL_STATIC_DRAW);
         }
 
         glBindVertexArray(0);
@@ -195,6 +275,29 @@ bool Model::setupBuffers() {
     }
 }
 
+void Model::uploadVertexRange(size_t byteOffset, size_t byteCount) {
+    if (VBO == 0 || byteCount == 0) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, byteOffset, byteCount,
+        reinterpret_cast<const char*>(vertices.data()) + byteOffset);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Model::uploadIndexRange(size_t byteOffset, size_t byteCount) {
+    if (EBO == 0 || byteCount == 0) return;
+
+    // The element buffer binding is VAO state, so bind through the VAO
+    glBindVertexArray(VAO);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, byteOffset, byteCount,
+        reinterpret_cast<const char*>(indices.data()) + byteOffset);
+    glBindVertexArray(0);
+}
+
+void Model::finishUpload() {
+    isInitialized = (VAO != 0);
+}
+
 void Model::cleanup() {
     if (VAO != 0) {
         glDeleteVertexArrays(1, &VAO);
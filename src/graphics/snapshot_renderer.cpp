@@ -0,0 +1,114 @@
+#include <GL/glew.h>
+#include "../../include/graphics/snapshot_renderer.h"
+#include <iostream>
+
+SnapshotRenderer::SnapshotRenderer()
+    : indirectUnavailable(false)
+    , frame(0) {}
+
+const MeshRange& SnapshotRenderer::rangeFor(const std::shared_ptr<const Editor::ProceduralMesh>& mesh) {
+    auto it = meshes.find(mesh.get());
+    if (it != meshes.end()) {
+        it->second.lastFrame = frame;
+        return it->second.range;
+    }
+
+    CachedMesh& entry = meshes[mesh.get()];
+    entry.mesh = mesh;
+    entry.range = mesh->appendTo(arena);
+    entry.lastFrame = frame;
+    return entry.range;
+}
+
+// The arena is append-only, so meshes the latest snapshot no longer uses leave
+// dead ranges behind. Once those outweigh the live ones the arena starts over
+// with the live meshes; their cache entries, and the ranges the snapshot
+// resolved to, are updated in place.
+void SnapshotRenderer::releaseUnusedMeshes() {
+    size_t liveIndices = 0;
+    for (const auto& entry : meshes) {
+        if (entry.second.lastFrame == frame) liveIndices += entry.second.range.indexCount;
+    }
+    if (liveIndices * 2 >= arena.getIndices().size()) return;
+
+    arena.clear();
+    for (auto it = meshes.begin(); it != meshes.end();) {
+        if (it->second.lastFrame != frame) {
+            it = meshes.erase(it);
+        } else {
+            it->second.range = it->second.mesh->appendTo(arena);
+            ++it;
+        }
+    }
+}
+
+const IndirectDrawList& SnapshotRenderer::buildDrawList(const FrameSnapshot& snapshot, const Frustum& frustum) {
+    // Resolve arena ranges once per distinct mesh, not per object
+    ++frame;
+    snapshotRanges.clear();
+    for (const auto& mesh : snapshot.meshes) {
+        snapshotRanges.push_back(&rangeFor(mesh));
+    }
+    releaseUnusedMeshes();
+
+    items.clear();
+    items.reserve(snapshot.objects.size());
+    for (const SnapshotObject& object : snapshot.objects) {
+        items.push_back(IndirectDrawItem{ *snapshotRanges[object.meshIndex], object.material, object.model, object.color });
+    }
+    IndirectDraw::buildDrawList(items, frustum, drawList);
+    return drawList;
+}
+
+// Batches are world space, so the object size stays folded into the model
+size_t SnapshotRenderer::updateStaticBatches(const FrameSnapshot& snapshot) {
+    ++frame;
+    for (const SnapshotObject& object : snapshot.objects) {
+        if (object.key >= batched.size()) {
+            batched.resize(object.key + 1);
+        }
+        BatchedObject& entry = batched[object.key];
+        entry.lastFrame = frame;
+        const std::shared_ptr<const Editor::ProceduralMesh>& mesh = snapshot.meshes[object.meshIndex];
+        bool reshaped = entry.mesh != mesh.get() || entry.color != object.color;
+        bool moved = entry.model != object.model;
+        if (!reshaped && !moved) continue;
+
+        Editor::BatchObject batchObject{ mesh, glm::vec3(1.0f), glm::vec3(object.color) };
+        if (!batcher.contains(object.key)) {
+            batcher.addObject(object.key, batchObject, object.model);
+        } else {
+            if (reshaped) batcher.updateObject(object.key, batchObject);
+            if (moved) batcher.updateObject(object.key, object.model);
+        }
+        entry.mesh = mesh.get();
+        entry.model = object.model;
+        entry.color = object.color;
+    }
+
+    // Objects missing from the snapshot were removed
+    for (size_t key = 0; key < batched.size(); ++key) {
+        BatchedObject& entry = batched[key];
+        if (entry.mesh && entry.lastFrame != frame) {
+            batcher.removeObject(static_cast<uint32_t>(key));
+            entry.mesh = nullptr;
+        }
+    }
+    return batcher.rebuildDirty();
+}
+
+void SnapshotRenderer::render(const FrameSnapshot& snapshot, const Camera& camera) {
+    if (!indirectUnavailable && !indirectRenderer.isInitialized() && !indirectRenderer.initialize()) {
+        std::cerr << "Indirect rendering unavailable, falling back to static batches" << std::endl;
+        indirectUnavailable = true;
+    }
+
+    if (!indirectUnavailable) {
+        buildDrawList(snapshot, camera.getFrustum());
+        indirectRenderer.submit(arena, drawList, camera.getViewProjection());
+        return;
+    }
+
+    updateStaticBatches(snapshot);
+    batcher.render();
+}
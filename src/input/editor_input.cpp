@@ -1,8 +1,10 @@
 #include "../../include/input/editor_input.h"
 #include "../../include/core/globals.h"
 #include "../../include/ui/cursor.h"
+#include "../../include/core/frame_snapshot.h"
+#include "../../include/graphics/camera.h"
+#include "../../include/editor/edit_log.h"
 #include <glm/gtc/matrix_transform.hpp>
-#include <GL/glu.h>
 #include <iostream>
 
 namespace EditorInput {
@@ -13,9 +15,46 @@ namespace EditorInput {
     glm::vec3 placementEnd;
     Editor::WorldEditor worldEditor;
     GLFWwindow* window = nullptr;
+    std::string scenePath;
+    Editor::EditLog* editLog = nullptr;
     
     // Editor state
     Editor::ObjectType currentObjectType = Editor::ObjectType::WALL;
+
+    // Input state as last reported by the window callbacks, so the editor never
+    // has to query GLFW or GL from the simulation thread
+    bool keyDown[GLFW_KEY_LAST + 1] = {};
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+    glm::vec3 cursorWorldPosition(0.0f);
+    const glm::vec3 PREVIEW_SIZE(1.0f, 2.0f, 0.1f);
+
+    // Same lens as the render camera main.cpp sets up, posed from the
+    // simulation's state; its matrices are only redone when that moves
+    Camera pickCamera(90.0f, static_cast<float>(WIDTH) / HEIGHT, 0.1f, 100.0f);
+
+    // From the near to the far plane through the cursor
+    Ray cursorRay(double xpos, double ypos) {
+        pickCamera.setPosition(glm::vec3(characterPosX, characterPosY + 1.5f, characterPosZ));
+        pickCamera.setDirection(cameraFront);
+        return pickCamera.screenRay(xpos, ypos, static_cast<float>(WIDTH), static_cast<float>(HEIGHT));
+    }
+
+    // What the cursor points at: the nearest object's surface, else the ground,
+    // else the point on the near plane. objectIndex gets the object hit, if any.
+    glm::vec3 screenToWorld(double xpos, double ypos, size_t* objectIndex = nullptr) {
+        Ray ray = cursorRay(xpos, ypos);
+        Editor::PickHit hit;
+        if (worldEditor.pick(ray, 1.0f, hit)) {
+            if (objectIndex) *objectIndex = hit.objectIndex;
+            return hit.point;
+        }
+        if (ray.direction.y < 0.0f) {
+            float groundT = -ray.origin.y / ray.direction.y;
+            if (groundT >= 0.0f && groundT <= 1.0f) return ray.at(groundT);
+        }
+        return ray.origin;
+    }
     
     void initialize(GLFWwindow* win) {
         window = win;
@@ -23,16 +62,14 @@ namespace EditorInput {
     }
     
     void handleKeyPress(GLFWwindow* window, int key, int scancode, int action, int mods) {
+        // A released key or button ends the gesture: the next change is its own undo step
+        if (action == GLFW_RELEASE) worldEditor.sealUndoStep();
         if (action != GLFW_PRESS) return;
         
         switch (key) {
             case GLFW_KEY_TAB:
+                // The render loop switches the cursor mode to match
                 isEditorMode = !isEditorMode;
-                if (isEditorMode) {
-                    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-                } else {
-                    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-                }
                 break;
                 
             case GLFW_KEY_1:
@@ -57,7 +94,7 @@ namespace EditorInput {
                 
             case GLFW_KEY_P:
                 if (isEditorMode && worldEditor.isPlacingObject()) {
-                    worldEditor.placeSelectedItem(placementEnd, glm::vec3(1.0f, 2.0f, 0.1f));
+                    worldEditor.placeSelectedItem(placementEnd, PREVIEW_SIZE);
                     isPlacingObject = false;
                 }
                 break;
@@ -69,6 +106,30 @@ namespace EditorInput {
                 }
                 break;
                 
+            // Ctrl+Z undoes, Ctrl+Shift+Z or Ctrl+Y redoes
+            case GLFW_KEY_Z:
+                if (isEditorMode && (mods & GLFW_MOD_CONTROL)) {
+                    if (mods & GLFW_MOD_SHIFT) worldEditor.redo();
+                    else worldEditor.undo();
+                }
+                break;
+
+            case GLFW_KEY_Y:
+                if (isEditorMode && (mods & GLFW_MOD_CONTROL)) worldEditor.redo();
+                break;
+
+            case GLFW_KEY_S:
+                if (isEditorMode && (mods & GLFW_MOD_CONTROL) && !scenePath.empty()) {
+                    // Saving behind the log's back would leave its checkpoint
+                    // stale, and a crash would then lose the edits after the save
+                    if (editLog && editLog->isOpen()) {
+                        editLog->save();
+                    } else if (worldEditor.saveScene(scenePath)) {
+                        std::cout << "Saved " << worldEditor.getObjects().size() << " objects to " << scenePath << std::endl;
+                    }
+                }
+                break;
+
             case GLFW_KEY_DELETE:
                 if (isEditorMode) {
                     size_t selectedIndex = worldEditor.getSelectedObjectIndex();
@@ -80,76 +141,61 @@ namespace EditorInput {
     
     void handleMouseClick(GLFWwindow* window, int button, int action, int mods) {
         if (!isEditorMode) return;
+        if (action == GLFW_RELEASE) worldEditor.sealUndoStep();
         
         if (button == GLFW_MOUSE_BUTTON_LEFT) {
             if (action == GLFW_PRESS) {
                 isPlacingObject = true;
-                double xpos, ypos;
-                glfwGetCursorPos(window, &xpos, &ypos);
-                
-                // Convert screen coordinates to world coordinates
-                GLint viewport[4];
-                glGetIntegerv(GL_VIEWPORT, viewport);
-                GLdouble modelview[16];
-                GLdouble projection[16];
-                glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
-                glGetDoublev(GL_PROJECTION_MATRIX, projection);
-                
-                GLdouble worldX, worldY, worldZ;
-                gluUnProject(xpos, viewport[3] - ypos, 0.0,
-                           modelview, projection, viewport,
-                           &worldX, &worldY, &worldZ);
-                
-                placementStart = glm::vec3(worldX, worldY, worldZ);
+                // Clicking an object selects it; placement starts on its surface
+                size_t hitIndex = worldEditor.getObjects().size();
+                placementStart = screenToWorld(cursorX, cursorY, &hitIndex);
+                worldEditor.selectObject(hitIndex);
             }
         }
     }
     
     void handleMouseMove(GLFWwindow* window, double xpos, double ypos) {
+        cursorX = xpos;
+        cursorY = ypos;
         if (!isEditorMode) return;
         
         // Update preview of object being placed
-        GLint viewport[4];
-        glGetIntegerv(GL_VIEWPORT, viewport);
-        GLdouble modelview[16];
-        GLdouble projection[16];
-        glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
-        glGetDoublev(GL_PROJECTION_MATRIX, projection);
-        
-        GLdouble worldX, worldY, worldZ;
-        gluUnProject(xpos, viewport[3] - ypos, 0.0,
-                    modelview, projection, viewport,
-                    &worldX, &worldY, &worldZ);
-        
+        cursorWorldPosition = screenToWorld(xpos, ypos);
         if (isPlacingObject) {
-            placementEnd = glm::vec3(worldX, worldY, worldZ);
+            placementEnd = cursorWorldPosition;
         }
-        
-        // Show preview at current mouse position
-        glm::vec3 previewSize(1.0f, 2.0f, 0.1f); // Default size for preview
-        glm::vec3 previewPos(worldX, worldY, worldZ);
-        worldEditor.renderPreview(previewPos, previewSize);
+    }
+
+    void recordKey(int key, int action) {
+        if (key < 0 || key > GLFW_KEY_LAST) return;
+        if (action == GLFW_PRESS) keyDown[key] = true;
+        else if (action == GLFW_RELEASE) keyDown[key] = false;
+    }
+
+    void captureSnapshot(FrameSnapshot& out) {
+        worldEditor.captureSnapshot(out);
+        out.editorMode = isEditorMode;
+        out.placingObject = isPlacingObject;
+        out.placementStart = placementStart;
+        out.placementEnd = placementEnd;
+        // Preview at the current mouse position
+        out.previewPosition = cursorWorldPosition;
+        out.previewSize = PREVIEW_SIZE;
     }
     
+    // Reads only recorded key state, so it also runs without a window (headless replay)
     void update(float deltaTime) {
-        if (!window) return;
-
         // Toggle editor mode with M key
         static bool wasMPressed = false;
-        bool isMPressed = glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS;
+        bool isMPressed = keyDown[GLFW_KEY_M];
         if (isMPressed && !wasMPressed) {
             isEditorMode = !isEditorMode;
-            if (isEditorMode) {
-                glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-            } else {
-                glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-            }
         }
         wasMPressed = isMPressed;
 
         // Toggle god mode with G key
         static bool wasGPressed = false;
-        bool isGPressed = glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS;
+        bool isGPressed = keyDown[GLFW_KEY_G];
         if (isGPressed && !wasGPressed) {
             isGodMode = !isGodMode;
         }
@@ -0,0 +1,66 @@
+#include "../../include/input/input_queue.h"
+#include "../../include/core/frame_limiter.h"
+
+const size_t InputQueue::CAPACITY;
+const size_t InputQueue::CURSOR_HEADROOM;
+
+InputQueue::InputQueue()
+    : events(CAPACITY)
+    , pushed(0)
+    , dropped(0)
+    , applied(0)
+    , coalesced(0) {}
+
+bool InputQueue::push(InputEvent event) {
+    if (event.timeNs == 0) {
+        event.timeNs = FrameLimiter::nowNanoseconds();
+    }
+    bool accepted = events.tryPush(event, event.type == InputEventType::CURSOR ? CURSOR_HEADROOM : 0);
+
+    // Only this thread writes these two
+    std::atomic<uint64_t>& counter = accepted ? pushed : dropped;
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return accepted;
+}
+
+size_t InputQueue::drain(const ApplyFunction& apply) {
+    InputEvent event;
+    InputEvent pendingCursor;
+    bool hasPendingCursor = false;
+    size_t count = 0;
+    uint64_t merged = 0;
+
+    while (events.tryPop(event)) {
+        if (event.type == InputEventType::CURSOR) {
+            merged += hasPendingCursor ? 1 : 0;
+            pendingCursor = event;
+            hasPendingCursor = true;
+            continue;
+        }
+        // Clicks and keys see the cursor where it was when they happened
+        if (hasPendingCursor) {
+            apply(pendingCursor);
+            hasPendingCursor = false;
+            ++count;
+        }
+        apply(event);
+        ++count;
+    }
+    if (hasPendingCursor) {
+        apply(pendingCursor);
+        ++count;
+    }
+
+    applied.store(applied.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    coalesced.store(coalesced.load(std::memory_order_relaxed) + merged, std::memory_order_relaxed);
+    return count;
+}
+
+InputQueue::Stats InputQueue::getStats() const {
+    Stats stats;
+    stats.pushed = pushed.load(std::memory_order_relaxed);
+    stats.applied = applied.load(std::memory_order_relaxed);
+    stats.coalesced = coalesced.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,289 @@
+#include "../../include/input/input_recording.h"
+#include "../../include/input/movement.h"
+#include "../../include/input/editor_input.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const char MAGIC[4] = { 'F', 'P', 'S', 'I' };
+    const size_t HEADER_SIZE = 4 + 4 + 4 + 8 + 8;
+
+    void putFixed(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void putSigned(std::vector<uint8_t>& out, int32_t value) {
+        // Zigzag, so small negatives (GLFW_KEY_UNKNOWN is -1) stay one byte
+        putVarint(out, (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+    }
+
+    void putDouble(std::vector<uint8_t>& out, double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putFixed(out, bits, 8);
+    }
+
+    // Bounds-checked reader; any overrun sets failed and returns zeros
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+        size_t offset;
+        bool failed;
+
+        uint64_t fixed(int bytes) {
+            if (size - offset < static_cast<size_t>(bytes)) {
+                failed = true;
+                return 0;
+            }
+            uint64_t value = 0;
+            for (int i = 0; i < bytes; ++i) {
+                value |= static_cast<uint64_t>(data[offset++]) << (8 * i);
+            }
+            return value;
+        }
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (offset >= size) break;
+                uint8_t byte = data[offset++];
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            failed = true;
+            return 0;
+        }
+
+        int32_t signedVarint() {
+            uint32_t value = static_cast<uint32_t>(varint());
+            return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+        }
+
+        double floating() {
+            uint64_t bits = fixed(8);
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+}
+
+const uint32_t InputRecording::FORMAT_VERSION;
+
+InputEvent InputEvent::key(int key, int scancode, int action, int mods) {
+    InputEvent event;
+    event.type = InputEventType::KEY;
+    event.code = key;
+    event.scancode = scancode;
+    event.action = action;
+    event.mods = mods;
+    return event;
+}
+
+InputEvent InputEvent::cursor(double x, double y) {
+    InputEvent event;
+    event.type = InputEventType::CURSOR;
+    event.x = x;
+    event.y = y;
+    return event;
+}
+
+InputEvent InputEvent::mouseButton(int button, int action, int mods) {
+    InputEvent event;
+    event.type = InputEventType::MOUSE_BUTTON;
+    event.code = button;
+    event.action = action;
+    event.mods = mods;
+    return event;
+}
+
+InputEvent InputEvent::inventorySelect(size_t index) {
+    InputEvent event;
+    event.type = InputEventType::INVENTORY_SELECT;
+    event.code = static_cast<int32_t>(index);
+    return event;
+}
+
+bool InputEvent::operator==(const InputEvent& other) const {
+    return tick == other.tick && type == other.type && code == other.code && scancode == other.scancode
+        && action == other.action && mods == other.mods
+        && std::memcmp(&x, &other.x, sizeof(x)) == 0 && std::memcmp(&y, &other.y, sizeof(y)) == 0;
+}
+
+void applyInputEvent(GLFWwindow* window, const InputEvent& event) {
+    switch (event.type) {
+        case InputEventType::KEY:
+            key_callback(window, event.code, event.scancode, event.action, event.mods);
+            break;
+        case InputEventType::CURSOR:
+            mouse_callback(window, event.x, event.y);
+            break;
+        case InputEventType::MOUSE_BUTTON:
+            mouse_button_callback(window, event.code, event.action, event.mods);
+            break;
+        case InputEventType::INVENTORY_SELECT:
+            EditorInput::worldEditor.selectInventoryItem(static_cast<size_t>(event.code));
+            break;
+    }
+}
+
+InputRecording::InputRecording(float tickRate)
+    : tickRate(tickRate)
+    , tickCount(0) {}
+
+void InputRecording::append(const InputEvent& event) {
+    events.push_back(event);
+    tickCount = std::max(tickCount, event.tick + 1);
+}
+
+void InputRecording::clear() {
+    events.clear();
+    tickCount = 0;
+}
+
+std::vector<uint8_t> InputRecording::serialize() const {
+    std::vector<uint8_t> out(MAGIC, MAGIC + sizeof(MAGIC));
+    out.reserve(HEADER_SIZE + events.size() * 8);
+    uint32_t rateBits;
+    std::memcpy(&rateBits, &tickRate, sizeof(rateBits));
+    putFixed(out, FORMAT_VERSION, 4);
+    putFixed(out, rateBits, 4);
+    putFixed(out, tickCount, 8);
+    putFixed(out, events.size(), 8);
+
+    uint64_t previousTick = 0;
+    for (const InputEvent& event : events) {
+        putVarint(out, event.tick - previousTick);
+        previousTick = event.tick;
+        out.push_back(static_cast<uint8_t>(event.type));
+        switch (event.type) {
+            case InputEventType::KEY:
+                putSigned(out, event.code);
+                putSigned(out, event.scancode);
+                out.push_back(static_cast<uint8_t>(event.action));
+                out.push_back(static_cast<uint8_t>(event.mods));
+                break;
+            case InputEventType::CURSOR:
+                putDouble(out, event.x);
+                putDouble(out, event.y);
+                break;
+            case InputEventType::MOUSE_BUTTON:
+                out.push_back(static_cast<uint8_t>(event.code));
+                out.push_back(static_cast<uint8_t>(event.action));
+                out.push_back(static_cast<uint8_t>(event.mods));
+                break;
+            case InputEventType::INVENTORY_SELECT:
+                putVarint(out, static_cast<uint32_t>(event.code));
+                break;
+        }
+    }
+    return out;
+}
+
+bool InputRecording::deserialize(const uint8_t* data, size_t size) {
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    Reader reader{ data, size, sizeof(MAGIC), false };
+    if (reader.fixed(4) != FORMAT_VERSION) {
+        return false;
+    }
+    uint32_t rateBits = static_cast<uint32_t>(reader.fixed(4));
+    float rate;
+    std::memcpy(&rate, &rateBits, sizeof(rate));
+    uint64_t ticks = reader.fixed(8);
+    uint64_t count = reader.fixed(8);
+    // Every event takes at least three bytes; rejects absurd counts before reserving
+    if (count > (size - HEADER_SIZE) / 3) {
+        return false;
+    }
+
+    std::vector<InputEvent> parsed;
+    parsed.reserve(static_cast<size_t>(count));
+    uint64_t tick = 0;
+    for (uint64_t i = 0; i < count && !reader.failed; ++i) {
+        InputEvent event;
+        tick += reader.varint();
+        event.tick = tick;
+        event.type = static_cast<InputEventType>(reader.fixed(1));
+        switch (event.type) {
+            case InputEventType::KEY:
+                event.code = reader.signedVarint();
+                event.scancode = reader.signedVarint();
+                event.action = static_cast<int32_t>(reader.fixed(1));
+                event.mods = static_cast<int32_t>(reader.fixed(1));
+                break;
+            case InputEventType::CURSOR:
+                event.x = reader.floating();
+                event.y = reader.floating();
+                break;
+            case InputEventType::MOUSE_BUTTON:
+                event.code = static_cast<int32_t>(reader.fixed(1));
+                event.action = static_cast<int32_t>(reader.fixed(1));
+                event.mods = static_cast<int32_t>(reader.fixed(1));
+                break;
+            case InputEventType::INVENTORY_SELECT:
+                event.code = static_cast<int32_t>(reader.varint());
+                break;
+            default:
+                return false;
+        }
+        parsed.push_back(event);
+    }
+    if (reader.failed || reader.offset != size || (!parsed.empty() && parsed.back().tick >= ticks)) {
+        return false;
+    }
+
+    tickRate = rate;
+    tickCount = ticks;
+    events.swap(parsed);
+    return true;
+}
+
+bool InputRecording::save(const std::string& path) const {
+    std::vector<uint8_t> data = serialize();
+    std::ofstream file(path, std::ios::binary);
+    if (!file || !file.write(reinterpret_cast<const char*>(data.data()), data.size())) {
+        std::cerr << "Failed to write input recording: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputRecording::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open input recording: " << path << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!deserialize(data.data(), data.size())) {
+        std::cerr << "Invalid input recording: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+InputReplayer::InputReplayer(const InputRecording& recording)
+    : recording(recording)
+    , nextEvent(0) {}
+
+void InputReplayer::replayTick(uint64_t tick, const ApplyFunction& apply) {
+    const std::vector<InputEvent>& events = recording.getEvents();
+    while (nextEvent < events.size() && events[nextEvent].tick <= tick) {
+        apply(events[nextEvent++]);
+    }
+}
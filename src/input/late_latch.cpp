@@ -0,0 +1,48 @@
+#include "../../include/input/late_latch.h"
+#include "../../include/ui/cursor.h"
+
+LateLatch::LateLatch()
+    : enabled(false)
+    , cursor(0.0)
+    , cursorTimeNs(0) {}
+
+void LateLatch::onCursor(const InputEvent& event) {
+    cursor = glm::dvec2(event.x, event.y);
+    cursorTimeNs = event.timeNs;
+}
+
+LateLatch::View LateLatch::aim(const FrameSnapshot& snapshot) const {
+    View view{ snapshot.cameraFront, snapshot.lookCursorTimeNs, false };
+    // Nothing to add until the simulation has a cursor to measure from, and
+    // the editor uses the cursor for picking, not looking
+    if (!enabled || snapshot.editorMode || snapshot.lookCursorTimeNs == 0
+        || cursorTimeNs <= snapshot.lookCursorTimeNs) {
+        return view;
+    }
+
+    // Same steps handleCameraMouseMovement takes, from where the tick left off
+    float yaw = snapshot.yaw;
+    float pitch = snapshot.pitch;
+    applyMouseLook(yaw, pitch, cursor.x - snapshot.lookCursor.x, snapshot.lookCursor.y - cursor.y);
+    view.front = cameraDirection(yaw, pitch);
+    view.inputTimeNs = cursorTimeNs;
+    view.latched = true;
+    return view;
+}
+
+InputLatencyTracker::InputLatencyTracker(size_t windowFrames)
+    : stats(windowFrames)
+    , lastInputNs(0) {}
+
+void InputLatencyTracker::onSubmit(int64_t inputTimeNs, int64_t submitNs) {
+    if (inputTimeNs <= lastInputNs) {
+        return;
+    }
+    lastInputNs = inputTimeNs;
+    stats.addFrame(static_cast<double>(submitNs - inputTimeNs) / 1e6);
+}
+
+void InputLatencyTracker::reset() {
+    stats.reset();
+    lastInputNs = 0;
+}
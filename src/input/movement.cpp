@@ -29,6 +29,7 @@ float cubePos[3] = {0.0f, 0.0f, 0.0f};  // Posición del cubo en la escena
 
 // Callback function definitions (outside namespace)
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    EditorInput::recordKey(key, action);
     if (EditorInput::isEditorMode) {
         EditorInput::handleKeyPress(window, key, scancode, action, mods);
         return;
@@ -58,7 +59,10 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
                 }
                 break;
             case GLFW_KEY_ESCAPE:
-                glfwSetWindowShouldClose(window, GLFW_TRUE);
+                // No window during a headless replay
+                if (window) {
+                    glfwSetWindowShouldClose(window, GLFW_TRUE);
+                }
                 break;
         }
     } else if (action == GLFW_RELEASE) {
@@ -93,8 +97,8 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 }
 
 void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
+    EditorInput::handleMouseMove(window, xpos, ypos);
     if (EditorInput::isEditorMode) {
-        EditorInput::handleMouseMove(window, xpos, ypos);
         return;
     }
     
@@ -0,0 +1,2 @@
+#define TINYOBJLOADER_IMPLEMENTATION
+#include "../../include/third_party/tiny_obj_loader.h"
\ No newline at end of file
@@ -8,13 +8,32 @@ float lastX = WIDTH / 2.0f;
 float lastY = HEIGHT / 2.0f;
 bool firstMouse = true;
 
-// Function to update the camera direction
-void updateCameraDirection() {
+void applyMouseLook(float& yaw, float& pitch, double xoffset, double yoffset) {
+    const float sensitivity = 0.15f; // Increased sensitivity for quicker response
+
+    // Apply sensitivity
+    xoffset *= sensitivity;
+    yoffset *= sensitivity;
+
+    // Update yaw and pitch
+    yaw += xoffset; 
+    pitch += yoffset;
+
+    // Clamp pitch to prevent inverted view
+    pitch = glm::clamp(pitch, -89.0f, 89.0f);
+}
+
+glm::vec3 cameraDirection(float yaw, float pitch) {
     glm::vec3 front;
     front.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
     front.y = sin(glm::radians(pitch));
     front.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-    cameraFront = glm::normalize(front);
+    return glm::normalize(front);
+}
+
+// Function to update the camera direction
+void updateCameraDirection() {
+    cameraFront = cameraDirection(yaw, pitch);
 }
 
 // Function to handle mouse movement for camera control
@@ -30,18 +49,7 @@ void handleCameraMouseMovement(double xpos, double ypos) {
     lastX = xpos;
     lastY = ypos;
 
-    const float sensitivity = 0.15f; // Increased sensitivity for quicker response
-
-    // Apply sensitivity
-    xoffset *= sensitivity;
-    yoffset *= sensitivity;
-
-    // Update yaw and pitch
-    yaw += xoffset; 
-    pitch += yoffset;
-
-    // Clamp pitch to prevent inverted view
-    pitch = glm::clamp(pitch, -89.0f, 89.0f);
+    applyMouseLook(yaw, pitch, xoffset, yoffset);
 
     // Update camera direction based on new yaw and pitch
     updateCameraDirection();
@@ -1,43 +1,35 @@
 #include "../../include/ui/fps_counter.h"
 #include <GL/freeglut.h>
 #include <sstream>
-#include <algorithm>
+#include <chrono>
 
-FPSCounter::FPSCounter() 
-    : currentFPS(0.0f)
-    , averageFPS(0.0f)
-    , minFPS(0.0f)
-    , maxFPS(0.0f)
-    , lastFrameTime(std::chrono::high_resolution_clock::now()) {
+namespace {
+    int64_t steadyNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 }
 
-void FPSCounter::update() {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>
-        (currentTime - lastFrameTime).count();
-    
-    currentFPS = 1.0f / deltaTime;
-    fpsHistory.push_back(currentFPS);
-    
-    if (fpsHistory.size() > SAMPLE_SIZE) {
-        fpsHistory.pop_front();
-    }
-    
-    updateStats();
-    lastFrameTime = currentTime;
+const size_t FPSCounter::SAMPLE_SIZE;
+const size_t FPSCounter::PERCENTILE_WINDOW_SIZE;
+
+FPSCounter::FPSCounter(ClockFunction clock, size_t windowFrames, size_t percentileWindowFrames)
+    : clock(clock ? std::move(clock) : ClockFunction(steadyNanoseconds))
+    , lastFrameTime(0)
+    , started(false)
+    , recent(windowFrames)
+    , longTerm(percentileWindowFrames) {
 }
 
-void FPSCounter::updateStats() {
-    if (fpsHistory.empty()) return;
-    
-    averageFPS = 0.0f;
-    for (float fps : fpsHistory) {
-        averageFPS += fps;
+void FPSCounter::update() {
+    int64_t currentTime = clock();
+    if (started) {
+        double frameMs = (currentTime - lastFrameTime) / 1.0e6;
+        recent.addFrame(frameMs);
+        longTerm.addFrame(frameMs);
     }
-    averageFPS /= fpsHistory.size();
-    
-    minFPS = *std::min_element(fpsHistory.begin(), fpsHistory.end());
-    maxFPS = *std::max_element(fpsHistory.begin(), fpsHistory.end());
+    started = true;
+    lastFrameTime = currentTime;
 }
 
 void FPSCounter::render() {
@@ -57,10 +49,11 @@ void FPSCounter::render() {
     
     // Render FPS information
     std::ostringstream ss;
-    ss << "FPS: " << static_cast<int>(currentFPS) << "\n"
-       << "Avg: " << static_cast<int>(averageFPS) << "\n"
-       << "Min: " << static_cast<int>(minFPS) << "\n"
-       << "Max: " << static_cast<int>(maxFPS);
+    ss << "FPS: " << static_cast<int>(getCurrentFPS()) << "\n"
+       << "Avg: " << static_cast<int>(getAverageFPS()) << "\n"
+       << "Min: " << static_cast<int>(getMinFPS()) << "\n"
+       << "Max: " << static_cast<int>(getMaxFPS()) << "\n"
+       << "1% low: " << static_cast<int>(longTerm.getOnePercentLowFps());
     
     renderText(ss.str(), -0.95f, 0.95f);
     
@@ -94,7 +87,8 @@ void FPSCounter::renderText(const std::string& text, float x, float y) {
     }
 }
 
-float FPSCounter::getCurrentFPS() const { return currentFPS; }
-float FPSCounter::getAverageFPS() const { return averageFPS; }
-float FPSCounter::getMinFPS() const { return minFPS; }
-float FPSCounter::getMaxFPS() const { return maxFPS; } 
\ No newline at end of file
+float FPSCounter::getCurrentFPS() const { return toFPS(recent.getLastMs()); }
+float FPSCounter::getAverageFPS() const { return toFPS(recent.getAverageMs()); }
+// The slowest frame sets the lowest rate
+float FPSCounter::getMinFPS() const { return toFPS(recent.getMaxMs()); }
+float FPSCounter::getMaxFPS() const { return toFPS(recent.getMinMs()); }
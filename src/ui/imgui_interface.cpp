@@ -73,12 +73,15 @@ namespace UI {
             glm::vec3 pos = obj->getPosition();
             glm::vec3 size = obj->getSize();
             
+            // A drag is one undo step, ended when the widget lets go
             if (ImGui::DragFloat3("Position", &pos.x, 0.1f)) {
-                obj->setPosition(pos);
+                editor.setObjectPosition(editor.getSelectedObjectIndex(), pos);
             }
+            if (ImGui::IsItemDeactivatedAfterEdit()) editor.sealUndoStep();
             if (ImGui::DragFloat3("Size", &size.x, 0.1f)) {
-                obj->setSize(size);
+                editor.resizeSelectedObject(size);
             }
+            if (ImGui::IsItemDeactivatedAfterEdit()) editor.sealUndoStep();
         }
 
         ImGui::End();
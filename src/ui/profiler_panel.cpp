@@ -0,0 +1,92 @@
+#include "../../include/ui/profiler_panel.h"
+#include "../../include/core/profiler.h"
+#include "../../include/third_party/imgui/imgui.h"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace UI {
+    namespace {
+        const char* TRACE_PATH = "profile_trace.json";
+        const float ROW_HEIGHT = 18.0f;
+
+        ImU32 colorForName(const char* name) {
+            // Stable colour per marker name
+            size_t hash = std::hash<std::string>()(name);
+            return IM_COL32(80 + hash % 120, 80 + (hash >> 8) % 120, 80 + (hash >> 16) % 120, 255);
+        }
+    }
+
+    void renderProfilerWindow() {
+        Profiler& profiler = Profiler::instance();
+        static std::vector<Profiler::ThreadTimeline> timelines;
+        static uint64_t frameBegin = 0, frameEnd = 0;
+        static std::string exportStatus;
+
+        ImGui::Begin("Profiler");
+
+        // Paused keeps showing the frame that was on screen
+        bool recording = profiler.isEnabled();
+        if (ImGui::Checkbox("Record", &recording)) {
+            profiler.setEnabled(recording);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Export trace")) {
+            exportStatus = profiler.writeChromeTrace(TRACE_PATH)
+                ? std::string("Wrote ") + TRACE_PATH
+                : std::string("Export failed");
+        }
+        if (!exportStatus.empty()) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(exportStatus.c_str());
+        }
+
+        if (recording && profiler.getLastFrame(frameBegin, frameEnd)) {
+            profiler.collect(frameBegin, frameEnd, timelines);
+        }
+        if (frameEnd <= frameBegin) {
+            ImGui::Text("Waiting for frames...");
+            ImGui::End();
+            return;
+        }
+
+        double frameMs = profiler.ticksToMicroseconds(frameEnd - frameBegin) / 1000.0;
+        ImGui::Text("Frame: %.2f ms", frameMs);
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f);
+        double ticksPerPixel = static_cast<double>(frameEnd - frameBegin) / width;
+        ImVec2 mouse = ImGui::GetIO().MousePos;
+
+        for (const Profiler::ThreadTimeline& timeline : timelines) {
+            if (timeline.events.empty()) continue;
+            ImGui::TextUnformatted(timeline.name.c_str());
+
+            uint32_t maxDepth = 0;
+            for (const ProfileEvent& event : timeline.events) maxDepth = std::max(maxDepth, event.depth);
+            ImVec2 origin = ImGui::GetCursorScreenPos();
+
+            for (const ProfileEvent& event : timeline.events) {
+                // Events straddling the frame bounds are clipped to them
+                uint64_t start = std::max(event.start, frameBegin);
+                uint64_t end = std::min(event.end, frameEnd);
+                ImVec2 min(origin.x + static_cast<float>((start - frameBegin) / ticksPerPixel),
+                           origin.y + event.depth * ROW_HEIGHT);
+                ImVec2 max(std::max(origin.x + static_cast<float>((end - frameBegin) / ticksPerPixel), min.x + 1.0f),
+                           min.y + ROW_HEIGHT - 1.0f);
+                drawList->AddRectFilled(min, max, colorForName(event.name));
+                if (max.x - min.x > ImGui::CalcTextSize(event.name).x + 4.0f) {
+                    drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32_WHITE, event.name);
+                }
+                if (ImGui::IsWindowHovered() && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+                    ImGui::SetTooltip("%s: %.3f ms", event.name,
+                                      profiler.ticksToMicroseconds(event.end - event.start) / 1000.0);
+                }
+            }
+            ImGui::Dummy(ImVec2(width, (maxDepth + 1) * ROW_HEIGHT));
+        }
+
+        ImGui::End();
+    }
+}
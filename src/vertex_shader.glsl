@@ -2,6 +2,7 @@
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoord;
+layout(location = 3) in vec4 aTangent;  // xyz = tangent, w = bitangent sign
 
 uniform mat4 u_ModelMatrix;
 uniform mat4 u_ViewMatrix;
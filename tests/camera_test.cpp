@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <graphics/camera.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    void expectMatrixNear(const glm::mat4& actual, const glm::mat4& expected, float tolerance) {
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                EXPECT_NEAR(actual[column][row], expected[column][row], tolerance)
+                    << "column " << column << ", row " << row;
+            }
+        }
+    }
+
+    Camera posedCamera() {
+        Camera camera(75.0f, 4.0f / 3.0f, 0.5f, 250.0f);
+        camera.setPosition(glm::vec3(3.0f, 1.5f, -7.0f));
+        camera.setDirection(glm::vec3(0.4f, -0.2f, -1.0f));
+        return camera;
+    }
+}
+
+TEST(CameraTest, MatchesReferenceMatrices) {
+    Camera camera = posedCamera();
+    glm::vec3 eye(3.0f, 1.5f, -7.0f);
+    glm::mat4 view = glm::lookAt(eye, eye + glm::vec3(0.4f, -0.2f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(75.0f), 4.0f / 3.0f, 0.5f, 250.0f);
+
+    expectMatrixNear(camera.getView(), view, 1e-6f);
+    expectMatrixNear(camera.getProjection(), projection, 1e-6f);
+    expectMatrixNear(camera.getViewProjection(), projection * view, 1e-5f);
+}
+
+TEST(CameraTest, ClosedFormInversesMatchGlmInverse) {
+    Camera camera = posedCamera();
+    expectMatrixNear(camera.getInverseView(), glm::inverse(camera.getView()), 1e-5f);
+    expectMatrixNear(camera.getInverseProjection(), glm::inverse(camera.getProjection()), 1e-5f);
+    expectMatrixNear(camera.getInverseViewProjection(), glm::inverse(camera.getViewProjection()), 1e-3f);
+    expectMatrixNear(camera.getViewProjection() * camera.getInverseViewProjection(), glm::mat4(1.0f), 1e-5f);
+}
+
+TEST(CameraTest, FrustumMatchesExtractedPlanes) {
+    Camera camera = posedCamera();
+    Frustum expected = Frustum::fromMatrix(camera.getViewProjection());
+    for (int plane = 0; plane < 6; ++plane) {
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_FLOAT_EQ(camera.getFrustum().planes[plane][i], expected.planes[plane][i]);
+        }
+    }
+    EXPECT_TRUE(camera.getFrustum().contains(glm::vec3(3.4f, 1.3f, -8.0f)));
+    EXPECT_FALSE(camera.getFrustum().contains(glm::vec3(3.0f, 1.5f, 0.0f)));
+}
+
+TEST(CameraTest, RecomputesOnlyAfterChanges) {
+    Camera camera = posedCamera();
+    camera.getView();
+    camera.getFrustum();
+    camera.getInverseViewProjection();
+    EXPECT_EQ(camera.getUpdateCount(), 1u);
+
+    // Same values again change nothing
+    camera.setPosition(glm::vec3(3.0f, 1.5f, -7.0f));
+    camera.setPerspective(75.0f, 4.0f / 3.0f, 0.5f, 250.0f);
+    camera.getViewProjection();
+    EXPECT_EQ(camera.getUpdateCount(), 1u);
+
+    camera.setPosition(glm::vec3(0.0f, 1.5f, 0.0f));
+    camera.setPerspective(60.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    EXPECT_EQ(camera.getUpdateCount(), 1u);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.5f, 0.0f), glm::vec3(0.4f, 1.3f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    expectMatrixNear(camera.getViewProjection(), projection * view, 1e-5f);
+    EXPECT_EQ(camera.getUpdateCount(), 2u);
+}
+
+TEST(CameraTest, ScreenRayThroughCenterFollowsDirection) {
+    Camera camera(90.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    camera.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    camera.setDirection(glm::vec3(1.0f, 0.0f, 0.0f));
+    Ray ray = camera.screenRay(960.0, 540.0, 1920.0f, 1080.0f);
+
+    EXPECT_NEAR(ray.origin.x, 1.1f, 1e-4f);
+    EXPECT_NEAR(ray.origin.y, 2.0f, 1e-4f);
+    EXPECT_NEAR(ray.origin.z, 3.0f, 1e-4f);
+    EXPECT_NEAR(ray.at(1.0f).x, 101.0f, 0.05f);
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <editor/edit_journal.h>
+#include <editor/editor.h>
+#include <glm/glm.hpp>
+
+using Editor::Edit;
+using Editor::EditJournal;
+using Editor::EditKind;
+using Editor::ObjectType;
+using Editor::WorldEditor;
+
+namespace {
+    Edit moveEdit(uint32_t index, float from, float to) {
+        Edit edit;
+        edit.kind = EditKind::MOVE;
+        edit.objectIndex = index;
+        edit.before = glm::vec3(from, 0.0f, 0.0f);
+        edit.after = glm::vec3(to, 0.0f, 0.0f);
+        return edit;
+    }
+}
+
+TEST(EditJournalTest, UndoAndRedoWalkTheSteps) {
+    EditJournal journal;
+    journal.record(moveEdit(0, 0.0f, 1.0f));
+    journal.seal();
+    journal.record(moveEdit(0, 1.0f, 2.0f));
+    EXPECT_EQ(journal.getUndoCount(), 2u);
+    EXPECT_EQ(journal.getMemoryUsed(), 80u);
+
+    Edit edit;
+    ASSERT_TRUE(journal.undo(edit));
+    EXPECT_EQ(edit.before.x, 1.0f);
+    ASSERT_TRUE(journal.undo(edit));
+    EXPECT_EQ(edit.before.x, 0.0f);
+    EXPECT_FALSE(journal.undo(edit));
+
+    ASSERT_TRUE(journal.redo(edit));
+    EXPECT_EQ(edit.after.x, 1.0f);
+    EXPECT_EQ(journal.getRedoCount(), 1u);
+
+    // A new edit drops what could have been redone
+    journal.record(moveEdit(3, 5.0f, 6.0f));
+    EXPECT_EQ(journal.getRedoCount(), 0u);
+    EXPECT_FALSE(journal.redo(edit));
+}
+
+TEST(EditJournalTest, DragsMergeUntilSealed) {
+    EditJournal journal;
+    for (int i = 0; i < 100; ++i) {
+        journal.record(moveEdit(7, static_cast<float>(i), static_cast<float>(i + 1)));
+    }
+    EXPECT_EQ(journal.getUndoCount(), 1u);
+
+    // Another object, kind or property starts a new step
+    journal.record(moveEdit(8, 0.0f, 1.0f));
+    Edit resize = moveEdit(8, 1.0f, 2.0f);
+    resize.kind = EditKind::RESIZE;
+    journal.record(resize);
+    EXPECT_EQ(journal.getUndoCount(), 3u);
+
+    journal.seal();
+    journal.record(resize);
+    EXPECT_EQ(journal.getUndoCount(), 4u);
+
+    Edit edit;
+    journal.undo(edit);
+    journal.undo(edit);
+    journal.undo(edit);
+    ASSERT_TRUE(journal.undo(edit));
+    EXPECT_EQ(edit.objectIndex, 7u);
+    EXPECT_EQ(edit.before.x, 0.0f);
+    EXPECT_EQ(edit.after.x, 100.0f);
+}
+
+TEST(EditJournalTest, MemoryLimitDropsOldestSteps) {
+    EditJournal journal(1000);
+    for (int i = 0; i < 1000; ++i) {
+        journal.record(moveEdit(i, static_cast<float>(i), static_cast<float>(i + 1)));
+        EXPECT_LE(journal.getMemoryUsed(), 1000u);
+    }
+    // 40 bytes a step
+    EXPECT_EQ(journal.getUndoCount(), 25u);
+
+    // The newest survive, intact across the ring's wrap
+    Edit edit;
+    for (int i = 999; i >= 975; --i) {
+        ASSERT_TRUE(journal.undo(edit));
+        EXPECT_EQ(edit.objectIndex, static_cast<uint32_t>(i));
+        EXPECT_EQ(edit.after.x, static_cast<float>(i + 1));
+    }
+    EXPECT_FALSE(journal.undo(edit));
+
+    for (int i = 0; i < 10; ++i) journal.redo(edit);
+    journal.setMemoryLimit(200);
+    EXPECT_EQ(journal.getUndoCount(), 5u);
+    EXPECT_EQ(journal.getRedoCount(), 0u);
+    ASSERT_TRUE(journal.undo(edit));
+    EXPECT_EQ(edit.objectIndex, 984u);
+}
+
+TEST(EditJournalTest, ObjectsRoundTrip) {
+    EditJournal journal(64);
+    Edit remove;
+    remove.kind = EditKind::REMOVE;
+    remove.objectIndex = 4;
+    remove.object.type = ObjectType::TOWER;
+    remove.object.position = glm::vec3(1.0f, 2.0f, 3.0f);
+    remove.object.size = glm::vec3(4.0f);
+    remove.object.color = glm::vec3(0.5f);
+    remove.object.windowCount = 6;
+    remove.object.parentIndex = 2;
+    remove.object.children = { 5, 9 };
+
+    // Too big for the ring: not kept, and neither is anything before it
+    journal.record(moveEdit(0, 0.0f, 1.0f));
+    journal.record(remove);
+    EXPECT_EQ(journal.getUndoCount(), 0u);
+
+    journal.setMemoryLimit(4096);
+    journal.record(remove);
+    EXPECT_EQ(journal.getMemoryUsed(), 88u);
+    Edit edit;
+    ASSERT_TRUE(journal.undo(edit));
+    EXPECT_EQ(edit.kind, EditKind::REMOVE);
+    EXPECT_EQ(edit.objectIndex, 4u);
+    EXPECT_EQ(edit.object.type, ObjectType::TOWER);
+    EXPECT_EQ(edit.object.position, remove.object.position);
+    EXPECT_EQ(edit.object.windowCount, 6);
+    EXPECT_EQ(edit.object.parentIndex, 2u);
+    EXPECT_EQ(edit.object.children, remove.object.children);
+}
+
+TEST(EditJournalTest, WorldEditorUndoesEveryOperation) {
+    WorldEditor editor;
+    editor.addObject(ObjectType::WALL, glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+    editor.addObject(ObjectType::HOUSE, glm::vec3(5.0f, 0.0f, 0.0f), glm::vec3(2.0f));
+    editor.sealUndoStep();
+    editor.setSelectedObjectRoofHeight(3.0f);
+    editor.setSelectedObjectColor(glm::vec3(1.0f, 0.0f, 0.0f));
+    editor.resizeSelectedObject(glm::vec3(4.0f));
+    editor.moveSelectedObject(glm::vec3(0.0f, 0.0f, 1.0f));
+    editor.moveSelectedObject(glm::vec3(0.0f, 0.0f, 1.0f));
+    editor.removeObject(0);
+    ASSERT_EQ(editor.getObjects().size(), 1u);
+    EXPECT_EQ(editor.getJournal().getUndoCount(), 7u);
+
+    ASSERT_TRUE(editor.undo());
+    ASSERT_EQ(editor.getObjects().size(), 2u);
+    EXPECT_EQ(editor.getObjects()[0]->getPosition(), glm::vec3(1.0f, 0.0f, 0.0f));
+
+    // The drag comes back as one step
+    ASSERT_TRUE(editor.undo());
+    Editor::ObjectRef house = editor.getObjects()[1];
+    ASSERT_TRUE(house->isPredefined());
+    EXPECT_EQ(house->getPosition(), glm::vec3(5.0f, 0.0f, 0.0f));
+    EXPECT_EQ(editor.getSelectedObjectIndex(), 1u);
+
+    while (editor.undo()) {}
+    EXPECT_TRUE(editor.getObjects().empty());
+
+    while (editor.redo()) {}
+    ASSERT_EQ(editor.getObjects().size(), 1u);
+    house = editor.getObjects()[0];
+    ASSERT_TRUE(house->isPredefined());
+    EXPECT_EQ(house->getPosition(), glm::vec3(5.0f, 0.0f, 2.0f));
+    EXPECT_EQ(house->getSize(), glm::vec3(4.0f));
+    EXPECT_EQ(house->getColor(), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(house->getRoofHeight(), 3.0f);
+}
+
+TEST(EditJournalTest, UndoneRemovalRestoresTheHierarchy) {
+    WorldEditor editor;
+    editor.addObject(ObjectType::WALL, glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+    editor.addObject(ObjectType::WALL, glm::vec3(12.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+    editor.addObject(ObjectType::WALL, glm::vec3(13.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+    editor.setObjectParent(1, 0);
+    editor.setObjectParent(2, 1);
+
+    editor.removeObject(1);
+    EXPECT_EQ(editor.getObjectWorldPosition(1), glm::vec3(13.0f, 0.0f, 0.0f));
+
+    ASSERT_TRUE(editor.undo());
+    ASSERT_EQ(editor.getObjects().size(), 3u);
+    const TransformHierarchy& transforms = editor.getTransforms();
+    TransformId nodes[3];
+    for (size_t i = 0; i < 3; ++i) nodes[i] = editor.getObjects()[i]->getTransformId();
+    EXPECT_EQ(transforms.getParent(nodes[1]), nodes[0]);
+    EXPECT_EQ(transforms.getParent(nodes[2]), nodes[1]);
+    EXPECT_EQ(editor.getObjects()[2]->getPosition(), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(editor.getObjectWorldPosition(2), glm::vec3(13.0f, 0.0f, 0.0f));
+
+    // Moving the restored parent carries the child again
+    editor.selectObject(1);
+    editor.moveSelectedObject(glm::vec3(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(editor.getObjectWorldPosition(2), glm::vec3(13.0f, 1.0f, 0.0f));
+}
@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include <editor/edit_log.h>
+#include <editor/editor.h>
+#include <glm/glm.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using Editor::EditLog;
+using Editor::ObjectType;
+using Editor::WorldEditor;
+
+namespace {
+    std::string scenePath(const std::string& name) {
+        return ::testing::TempDir() + "edit_log_test_" + name + ".scene";
+    }
+
+    void removeFiles(const std::string& path) {
+        std::remove(path.c_str());
+        std::remove((path + ".wal").c_str());
+        std::remove((path + ".checkpoint").c_str());
+    }
+
+    std::vector<char> readBytes(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream file(path, std::ios::binary);
+        file.write(bytes.data(), bytes.size());
+    }
+
+    // What a crash would leave on disk: the files as they are right now
+    void snapshotFiles(const std::string& from, const std::string& to) {
+        removeFiles(to);
+        writeBytes(to + ".wal", readBytes(from + ".wal"));
+        writeBytes(to + ".checkpoint", readBytes(from + ".checkpoint"));
+    }
+
+    // Six logged edits: two adds, a move, a parent link, a color change and its undo
+    void makeEdits(WorldEditor& editor) {
+        editor.addObject(ObjectType::TOWER, glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(3.0f));
+        editor.addObject(ObjectType::WALL, glm::vec3(12.0f, 0.0f, 1.0f), glm::vec3(1.0f));
+        editor.setObjectPosition(0, glm::vec3(20.0f, 0.0f, 0.0f));
+        editor.setObjectParent(1, 0);
+        editor.selectObject(1);
+        editor.setSelectedObjectColor(glm::vec3(0.5f, 0.0f, 0.0f));
+        editor.undo();
+    }
+
+    void expectSameScene(WorldEditor& a, WorldEditor& b) {
+        ASSERT_EQ(a.getObjects().size(), b.getObjects().size());
+        for (size_t i = 0; i < a.getObjects().size(); ++i) {
+            EXPECT_EQ(b.getObjects()[i]->getType(), a.getObjects()[i]->getType()) << "object " << i;
+            EXPECT_EQ(b.getObjects()[i]->getColor(), a.getObjects()[i]->getColor()) << "object " << i;
+            EXPECT_EQ(b.getObjectWorldPosition(i), a.getObjectWorldPosition(i)) << "object " << i;
+        }
+    }
+}
+
+TEST(EditLogTest, RecoversEditsAfterCrash) {
+    std::string path = scenePath("crash");
+    std::string crashed = scenePath("crash_copy");
+    removeFiles(path);
+    WorldEditor editor;
+    EditLog log;
+    ASSERT_TRUE(log.open(path, editor));
+    makeEdits(editor);
+    log.flush();
+    snapshotFiles(path, crashed);
+    EXPECT_EQ(log.getStats().editsLogged, 6u);
+
+    WorldEditor recovered;
+    EditLog recoveredLog;
+    ASSERT_TRUE(recoveredLog.open(crashed, recovered));
+    EXPECT_EQ(recoveredLog.getStats().recoveredEdits, 6u);
+    expectSameScene(editor, recovered);
+    // The recovered parent link still carries the child
+    recovered.setObjectPosition(0, glm::vec3(0.0f));
+    EXPECT_EQ(recovered.getObjectWorldPosition(1), glm::vec3(-8.0f, 0.0f, 1.0f));
+
+    recoveredLog.close();
+    log.close();
+    removeFiles(path);
+    removeFiles(crashed);
+}
+
+TEST(EditLogTest, TornTailIsIgnored) {
+    std::string path = scenePath("torn");
+    std::string crashed = scenePath("torn_copy");
+    removeFiles(path);
+    WorldEditor editor;
+    EditLog log;
+    ASSERT_TRUE(log.open(path, editor));
+    editor.addObject(ObjectType::WALL, glm::vec3(1.0f), glm::vec3(1.0f));
+    log.flush();
+    editor.setObjectPosition(0, glm::vec3(5.0f));
+    log.flush();
+    snapshotFiles(path, crashed);
+
+    // Half of the move made it to disk
+    std::vector<char> bytes = readBytes(crashed + ".wal");
+    writeBytes(crashed + ".wal", std::vector<char>(bytes.begin(), bytes.end() - 10));
+    WorldEditor recovered;
+    EditLog recoveredLog;
+    ASSERT_TRUE(recoveredLog.open(crashed, recovered));
+    EXPECT_EQ(recoveredLog.getStats().recoveredEdits, 1u);
+    ASSERT_EQ(recovered.getObjects().size(), 1u);
+    EXPECT_EQ(recovered.getObjectWorldPosition(0), glm::vec3(1.0f));
+    recoveredLog.close();
+
+    // A damaged record ends the log the same way
+    snapshotFiles(path, crashed);
+    bytes = readBytes(crashed + ".wal");
+    bytes.back() ^= 0x40;
+    writeBytes(crashed + ".wal", bytes);
+    WorldEditor damaged;
+    ASSERT_TRUE(recoveredLog.open(crashed, damaged));
+    EXPECT_EQ(recoveredLog.getStats().recoveredEdits, 1u);
+    recoveredLog.close();
+
+    log.close();
+    removeFiles(path);
+    removeFiles(crashed);
+}
+
+TEST(EditLogTest, CheckpointsStartTheLogOver) {
+    std::string path = scenePath("checkpoint");
+    removeFiles(path);
+    WorldEditor editor;
+    EditLog::Options options;
+    options.checkpointBytes = 256;
+    EditLog log;
+    ASSERT_TRUE(log.open(path, editor, options));
+    for (int i = 0; i < 50; ++i) {
+        editor.addObject(ObjectType::RECTANGLE, glm::vec3(float(i), 0.0f, 0.0f), glm::vec3(1.0f));
+        if (i % 10 == 9) log.flush();
+    }
+    log.flush();
+    EXPECT_GT(log.getStats().checkpoints, 0u);
+    EXPECT_LT(readBytes(path + ".wal").size(), 512u);
+    log.close();
+
+    // Everything is in the final checkpoint
+    WorldEditor reopened;
+    ASSERT_TRUE(log.open(path, reopened));
+    EXPECT_EQ(log.getStats().recoveredEdits, 0u);
+    expectSameScene(editor, reopened);
+    log.close();
+    removeFiles(path);
+}
+
+TEST(EditLogTest, StartsFromTheSceneFile) {
+    std::string path = scenePath("base");
+    removeFiles(path);
+    WorldEditor saved;
+    saved.addObject(ObjectType::HOUSE, glm::vec3(-4.0f, 0.0f, 2.0f), glm::vec3(5.0f));
+    ASSERT_TRUE(saved.saveScene(path));
+
+    WorldEditor editor;
+    EditLog log;
+    ASSERT_TRUE(log.open(path, editor));
+    expectSameScene(saved, editor);
+    editor.removeObject(0);
+    log.close();
+
+    // The checkpoint wins over the scene file, which is left alone
+    WorldEditor reopened;
+    ASSERT_TRUE(log.open(path, reopened));
+    EXPECT_TRUE(reopened.getObjects().empty());
+    log.close();
+    WorldEditor original;
+    ASSERT_TRUE(original.loadScene(path));
+    EXPECT_EQ(original.getObjects().size(), 1u);
+    removeFiles(path);
+}
+
+TEST(EditLogTest, ReplacedSceneFileWinsOverAStaleCheckpoint) {
+    std::string path = scenePath("stale");
+    std::string crashed = scenePath("stale_crashed");
+    removeFiles(path);
+    WorldEditor editor;
+    EditLog log;
+    ASSERT_TRUE(log.open(path, editor));
+    makeEdits(editor);
+    log.flush();
+
+    // The crash leaves a log, and the scene file is then replaced from elsewhere
+    snapshotFiles(path, crashed);
+    log.close();
+    WorldEditor saved;
+    saved.addObject(ObjectType::HOUSE, glm::vec3(-4.0f, 0.0f, 2.0f), glm::vec3(5.0f));
+    ASSERT_TRUE(saved.saveScene(crashed));
+
+    WorldEditor recovered;
+    ASSERT_TRUE(log.open(crashed, recovered));
+    EXPECT_EQ(log.getStats().recoveredEdits, 0u);
+    expectSameScene(saved, recovered);
+    log.close();
+
+    // The checkpoint written then matches the scene file again
+    WorldEditor reopened;
+    ASSERT_TRUE(log.open(crashed, reopened));
+    expectSameScene(saved, reopened);
+    reopened.removeObject(0);
+    log.close();
+    WorldEditor edited;
+    ASSERT_TRUE(log.open(crashed, edited));
+    EXPECT_TRUE(edited.getObjects().empty());
+    log.close();
+    removeFiles(path);
+    removeFiles(crashed);
+}
+
+TEST(EditLogTest, SaveKeepsLaterEditsRecoverable) {
+    std::string path = scenePath("save");
+    std::string crashed = scenePath("save_crashed");
+    removeFiles(path);
+    WorldEditor editor;
+    EditLog log;
+    ASSERT_TRUE(log.open(path, editor));
+    editor.addObject(ObjectType::TOWER, glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(3.0f));
+    log.save();
+    log.flush();
+    EXPECT_EQ(log.getStats().saves, 1u);
+    WorldEditor saved;
+    ASSERT_TRUE(saved.loadScene(path));
+    expectSameScene(editor, saved);
+
+    editor.setObjectPosition(0, glm::vec3(20.0f, 0.0f, 0.0f));
+    editor.addObject(ObjectType::WALL, glm::vec3(12.0f, 0.0f, 1.0f), glm::vec3(1.0f));
+    log.flush();
+
+    // Crash: the log and checkpoint as they are now, next to the saved scene
+    // file, which keeps its stamp
+    snapshotFiles(path, crashed);
+    log.close();
+    writeBytes(path + ".wal", readBytes(crashed + ".wal"));
+    writeBytes(path + ".checkpoint", readBytes(crashed + ".checkpoint"));
+
+    WorldEditor recovered;
+    ASSERT_TRUE(log.open(path, recovered));
+    EXPECT_EQ(log.getStats().recoveredEdits, 2u);
+    expectSameScene(editor, recovered);
+    log.close();
+    removeFiles(path);
+    removeFiles(crashed);
+}
@@ -21,7 +21,7 @@ TEST_F(EditorTest, AddWall) {
     
     EXPECT_EQ(worldEditor.getObjects().size(), 1);
     const auto& objects = worldEditor.getObjects();
-    EXPECT_NE(objects[0], nullptr);
+    ASSERT_EQ(objects.size(), 1u);
     EXPECT_EQ(objects[0]->getType(), Editor::ObjectType::WALL);
     EXPECT_EQ(objects[0]->getPosition(), position);
     EXPECT_EQ(objects[0]->getSize(), size);
@@ -35,7 +35,7 @@ TEST_F(EditorTest, AddRectangle) {
     
     EXPECT_EQ(worldEditor.getObjects().size(), 1);
     const auto& objects = worldEditor.getObjects();
-    EXPECT_NE(objects[0], nullptr);
+    ASSERT_EQ(objects.size(), 1u);
     EXPECT_EQ(objects[0]->getType(), Editor::ObjectType::RECTANGLE);
     EXPECT_EQ(objects[0]->getPosition(), position);
     EXPECT_EQ(objects[0]->getSize(), size);
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <editor/editor.h>
+#include <editor/entity_store.h>
+#include <graphics/frustum.h>
+#include <graphics/indirect_renderer.h>
+#include <graphics/snapshot_renderer.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+
+using Editor::EntityStore;
+using Editor::ObjectType;
+using Editor::PredefinedParams;
+
+namespace {
+    PredefinedParams windows(int count) {
+        PredefinedParams params;
+        params.windowCount = count;
+        return params;
+    }
+}
+
+TEST(EntityStoreTest, ParametersFollowTheirEntity) {
+    EntityStore store;
+    store.insert(0, ObjectType::HOUSE, glm::vec3(0.0f), glm::vec3(1.0f), 10);
+    store.insert(1, ObjectType::WALL, glm::vec3(1.0f), glm::vec3(1.0f), 11);
+    store.insert(2, ObjectType::TOWER, glm::vec3(2.0f), glm::vec3(1.0f), 12);
+    store.setParams(0, windows(3));
+    store.setParams(2, windows(5));
+    EXPECT_FALSE(store.hasParams(1));
+    EXPECT_EQ(store.getColor(0), glm::vec3(0.8f));
+    EXPECT_EQ(store.getColor(1), glm::vec3(1.0f));
+
+    // A bridge in front sends the house to the back
+    store.insert(0, ObjectType::BRIDGE, glm::vec3(-1.0f), glm::vec3(1.0f), 13);
+    EXPECT_EQ(store.getNode(3), 10u);
+    EXPECT_EQ(store.getParams(3).windowCount, 3);
+    EXPECT_EQ(store.getParams(2).windowCount, 5);
+    EXPECT_EQ(store.getParams(0).windowCount, PredefinedParams().windowCount);
+
+    // Removing the wall moves the house into its place, parameters and all
+    store.erase(1);
+    ASSERT_EQ(store.size(), 3u);
+    EXPECT_EQ(store.getType(1), ObjectType::HOUSE);
+    EXPECT_EQ(store.getNode(1), 10u);
+    EXPECT_EQ(store.getParams(1).windowCount, 3);
+
+    // Removing the bridge moves the last parameter slot into its place
+    store.erase(0);
+    ASSERT_EQ(store.size(), 2u);
+    EXPECT_EQ(store.getType(0), ObjectType::TOWER);
+    EXPECT_EQ(store.getParams(0).windowCount, 5);
+    store.setParams(0, windows(6));
+    EXPECT_EQ(store.getParams(0).windowCount, 6);
+    EXPECT_EQ(store.getParams(1).windowCount, 3);
+}
+
+TEST(EntityStoreTest, IdenticalEntitiesShareAMeshId) {
+    EntityStore store;
+    for (uint32_t i = 0; i < 100; ++i) {
+        store.insert(i, i % 2 ? ObjectType::WALL : ObjectType::HOUSE, glm::vec3(float(i)), glm::vec3(1.0f), i);
+    }
+    EXPECT_EQ(store.getMeshId(0), store.getMeshId(98));
+    EXPECT_EQ(store.getMeshId(1), store.getMeshId(99));
+    EXPECT_NE(store.getMeshId(0), store.getMeshId(1));
+    EXPECT_EQ(store.getMeshCount(), 2u);
+    EXPECT_FALSE(store.getMeshEntry(store.getMeshId(0)).bounds.isEmpty());
+
+    // New parameters mean a new mesh for that entity alone
+    store.setParams(0, windows(4));
+    EXPECT_NE(store.getMeshId(0), store.getMeshId(2));
+    EXPECT_EQ(store.getMeshCount(), 3u);
+    EXPECT_EQ(store.getMesh(0)->getIndices().size(), store.getMeshEntry(store.getMeshId(0)).mesh->getIndices().size());
+}
+
+TEST(EntityStoreTest, UnusedMeshesAreReleased) {
+    EntityStore store;
+    store.insert(0, ObjectType::HOUSE, glm::vec3(0.0f), glm::vec3(1.0f), 0);
+    store.insert(1, ObjectType::TOWER, glm::vec3(1.0f), glm::vec3(1.0f), 1);
+    store.getMeshId(0);
+    store.getMeshId(1);
+
+    // Each new value frees the mesh it replaces, and the new one takes its id
+    for (int count = 3; count < 50; ++count) {
+        store.setParams(0, windows(count));
+        store.getMeshId(0);
+    }
+    EXPECT_EQ(store.getMeshCount(), 2u);
+    EXPECT_EQ(store.getMeshesInUse(), 2u);
+
+    store.erase(1);
+    EXPECT_EQ(store.getMeshesInUse(), 1u);
+    store.clear();
+    EXPECT_EQ(store.getMeshesInUse(), 0u);
+    EXPECT_FALSE(store.getMeshEntry(0).mesh);
+}
+
+TEST(EntityStoreTest, MeshArenaDropsReleasedMeshes) {
+    Editor::WorldEditor editor;
+    editor.addObject(ObjectType::HOUSE, glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(2.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+    Frustum frustum = Frustum::fromMatrix(projection);
+    SnapshotRenderer renderer;
+    FrameSnapshot snapshot;
+    editor.captureSnapshot(snapshot);
+    renderer.buildDrawList(snapshot, frustum);
+    size_t oneMesh = renderer.getMeshArena().getIndices().size();
+    ASSERT_GT(oneMesh, 0u);
+
+    size_t largestMesh = oneMesh;
+    for (int count = 0; count < 40; ++count) {
+        editor.setSelectedObjectWindowCount(count % 7 + 3);
+        editor.captureSnapshot(snapshot);
+        renderer.buildDrawList(snapshot, frustum);
+        largestMesh = std::max(largestMesh, editor.getObjects()[0]->getMesh()->getIndices().size());
+    }
+    EXPECT_EQ(editor.getEntities().getMeshesInUse(), 1u);
+    // Dead ranges never outweigh the live mesh for long, and the renderer lets
+    // go of the meshes it no longer draws
+    EXPECT_LE(renderer.getMeshArena().getIndices().size(), 3 * largestMesh);
+    EXPECT_LE(renderer.getCachedMeshCount(), 2u);
+}
+
+TEST(EntityStoreTest, EditorListsObjectsThroughTheStore) {
+    Editor::WorldEditor editor;
+    editor.addObject(ObjectType::WALL, glm::vec3(1.0f), glm::vec3(2.0f));
+    editor.addObject(ObjectType::CUBE, glm::vec3(0.0f), glm::vec3(1.0f));
+    editor.addObject(ObjectType::HOUSE, glm::vec3(3.0f), glm::vec3(4.0f));
+    // Cubes cannot be placed
+    ASSERT_EQ(editor.getObjects().size(), 2u);
+
+    size_t visited = 0;
+    for (const auto& obj : editor.getObjects()) {
+        EXPECT_EQ(obj->getTransformId(), editor.getEntities().getNode(visited));
+        ++visited;
+    }
+    EXPECT_EQ(visited, 2u);
+    EXPECT_FALSE(editor.getObjects()[0]->isPredefined());
+    EXPECT_EQ(editor.getObjects()[1]->getRoofHeight(), 1.0f);
+    EXPECT_EQ(editor.getObjects()[1]->getSize(), glm::vec3(4.0f));
+}
+
+TEST(EntityStoreTest, HandlesFollowSwappedEntities) {
+    EntityStore store;
+    for (uint32_t i = 0; i < 4; ++i) {
+        store.insert(i, i == 1 ? ObjectType::HOUSE : ObjectType::WALL, glm::vec3(float(i)), glm::vec3(1.0f), i);
+    }
+    Editor::ObjectHandle first = store.getHandle(0);
+    Editor::ObjectHandle house = store.getHandle(1);
+    Editor::ObjectHandle last = store.getHandle(3);
+    store.setParams(1, windows(7));
+
+    // The last entity fills the hole and its handle follows it
+    store.erase(0);
+    EXPECT_FALSE(store.isValid(first));
+    EXPECT_EQ(store.indexOf(first), EntityStore::NO_INDEX);
+    EXPECT_EQ(store.indexOf(last), 0u);
+    EXPECT_EQ(store.getNode(0), 3u);
+    EXPECT_EQ(store.indexOf(house), 1u);
+
+    // A reused slot does not bring the old handle back
+    store.insert(3, ObjectType::WALL, glm::vec3(9.0f), glm::vec3(1.0f), 9);
+    EXPECT_EQ(store.getHandle(3).slot, first.slot);
+    EXPECT_NE(store.getHandle(3), first);
+    EXPECT_FALSE(store.isValid(first));
+
+    // Inserting at an index undoes the swap
+    store.erase(3);
+    store.insert(0, ObjectType::WALL, glm::vec3(0.0f), glm::vec3(1.0f), 0);
+    EXPECT_EQ(store.getNode(0), 0u);
+    EXPECT_EQ(store.indexOf(last), 3u);
+    EXPECT_EQ(store.getParams(store.indexOf(house)).windowCount, 7);
+
+    store.clear();
+    EXPECT_FALSE(store.isValid(house));
+}
+
+TEST(EntityStoreTest, SelectionSurvivesRemovals) {
+    Editor::WorldEditor editor;
+    for (int i = 0; i < 5; ++i) {
+        editor.addObject(ObjectType::WALL, glm::vec3(float(i), 0.0f, 0.0f), glm::vec3(1.0f));
+    }
+    editor.selectObject(1);
+    Editor::ObjectHandle selected = editor.getSelectedObject();
+    Editor::ObjectHandle fourth = editor.getObjects()[3]->getHandle();
+
+    editor.removeObject(0);
+    editor.removeObject(fourth);
+    ASSERT_EQ(editor.getObjects().size(), 3u);
+    EXPECT_EQ(editor.getSelectedObject(), selected);
+    EXPECT_EQ(editor.getObjects()[editor.getSelectedObjectIndex()]->getPosition(), glm::vec3(1.0f, 0.0f, 0.0f));
+
+    // A stale handle removes nothing
+    editor.removeObject(fourth);
+    EXPECT_EQ(editor.getObjects().size(), 3u);
+
+    editor.removeObject(selected);
+    EXPECT_EQ(editor.getSelectedObjectIndex(), editor.getObjects().size());
+    editor.moveSelectedObject(glm::vec3(1.0f));
+
+    // Undo puts every object back at its old index
+    EXPECT_EQ(editor.getJournal().getUndoCount(), 8u);
+    for (int i = 0; i < 3; ++i) ASSERT_TRUE(editor.undo());
+    ASSERT_EQ(editor.getObjects().size(), 5u);
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(editor.getObjects()[i]->getPosition(), glm::vec3(float(i), 0.0f, 0.0f)) << "object " << i;
+    }
+}
@@ -1,11 +1,17 @@
 #include <gtest/gtest.h>
 #include <ui/fps_counter.h>
-#include <chrono>
-#include <thread>
+#include <cstdint>
 
 class FPSCounterTest : public ::testing::Test {
 protected:
-    FPSCounter fpsCounter;
+    // Fake clock the test moves by hand instead of sleeping
+    int64_t nowNs = 0;
+    FPSCounter fpsCounter{ [this] { return nowNs; } };
+
+    void frame(double ms) {
+        nowNs += static_cast<int64_t>(ms * 1.0e6);
+        fpsCounter.update();
+    }
 };
 
 TEST_F(FPSCounterTest, InitialValues) {
@@ -16,36 +22,33 @@ TEST_F(FPSCounterTest, InitialValues) {
 }
 
 TEST_F(FPSCounterTest, UpdateFPS) {
-    // Simulate 60 FPS (16.67ms per frame)
+    // 60 FPS, with a little jitter either side of 16.67 ms
+    fpsCounter.update();
     for (int i = 0; i < 60; ++i) {
-        fpsCounter.update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(17)); // Slightly longer to account for processing time
+        frame(i % 2 ? 16.0 : 17.0 + 1.0 / 3.0);
     }
 
-    // Check if FPS is close to 60
     float currentFPS = fpsCounter.getCurrentFPS();
-    EXPECT_NEAR(currentFPS, 60.0f, 5.0f); // Allow 5 FPS margin of error
+    EXPECT_NEAR(currentFPS, 62.5f, 0.01f);
 
-    // Check if average FPS is being calculated
     float avgFPS = fpsCounter.getAverageFPS();
     EXPECT_GT(avgFPS, 0.0f);
-    EXPECT_NEAR(avgFPS, 60.0f, 5.0f);
+    EXPECT_NEAR(avgFPS, 60.0f, 0.01f);
 
-    // Check if min/max FPS are being tracked
     float minFPS = fpsCounter.getMinFPS();
     float maxFPS = fpsCounter.getMaxFPS();
     EXPECT_GT(maxFPS, minFPS);
+    EXPECT_NEAR(maxFPS, 62.5f, 0.01f);
+    EXPECT_NEAR(minFPS, 1000.0f / (17.0f + 1.0f / 3.0f), 0.01f);
 }
 
 TEST_F(FPSCounterTest, FPSHistory) {
-    // Simulate varying FPS
+    fpsCounter.update();
     for (int i = 0; i < 30; ++i) {
-        fpsCounter.update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(17)); // ~60 FPS
+        frame(1000.0 / 60.0);
     }
     for (int i = 0; i < 30; ++i) {
-        fpsCounter.update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(33)); // ~30 FPS
+        frame(1000.0 / 30.0);
     }
 
     float minFPS = fpsCounter.getMinFPS();
@@ -53,7 +56,21 @@ TEST_F(FPSCounterTest, FPSHistory) {
     float avgFPS = fpsCounter.getAverageFPS();
 
     // Check if min/max FPS reflect the variation
-    EXPECT_NEAR(minFPS, 30.0f, 5.0f);
-    EXPECT_NEAR(maxFPS, 60.0f, 5.0f);
-    EXPECT_NEAR(avgFPS, 45.0f, 5.0f);
-} 
\ No newline at end of file
+    EXPECT_NEAR(minFPS, 30.0f, 0.01f);
+    EXPECT_NEAR(maxFPS, 60.0f, 0.01f);
+    // Frames over time, not the mean of per-frame rates: 60 frames in 1.5 s
+    EXPECT_NEAR(avgFPS, 40.0f, 0.01f);
+}
+
+TEST_F(FPSCounterTest, OldFramesLeaveTheWindow) {
+    fpsCounter.update();
+    frame(100.0);
+    for (size_t i = 0; i < FPSCounter::SAMPLE_SIZE; ++i) {
+        frame(10.0);
+    }
+
+    EXPECT_NEAR(fpsCounter.getMinFPS(), 100.0f, 0.01f);
+    // The long window still remembers the hitch
+    EXPECT_NEAR(fpsCounter.getPercentileStats().getMaxMs(), 100.0, 1e-9);
+    EXPECT_NEAR(fpsCounter.getPercentileStats().getOnePercentLowFps(), 10.0, 0.2);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <core/frame_stats.h>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <vector>
+
+TEST(FrameTimeHistogramTest, BucketsStayWithinPrecision) {
+    for (uint32_t us = 0; us < 128; ++us) {
+        EXPECT_EQ(FrameTimeHistogram::bucketValue(FrameTimeHistogram::bucketFor(us)), us);
+    }
+    uint32_t previous = 0;
+    for (uint32_t us = 128; us < (1u << 26); us += 1 + us / 97) {
+        uint32_t bucket = FrameTimeHistogram::bucketFor(us);
+        ASSERT_GE(bucket, previous);
+        ASSERT_LT(bucket, FrameTimeHistogram::BUCKET_COUNT);
+        ASSERT_NEAR(FrameTimeHistogram::bucketValue(bucket), us, us / 64.0);
+        previous = bucket;
+    }
+    EXPECT_EQ(FrameTimeHistogram::bucketFor(UINT32_MAX), FrameTimeHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(FrameTimeHistogramTest, PercentilesMatchSortedSamples) {
+    std::mt19937 rng(7);
+    std::lognormal_distribution<double> frameUs(std::log(8000.0), 0.4);
+    FrameTimeHistogram histogram;
+    std::vector<uint32_t> samples;
+    for (int i = 0; i < 10000; ++i) {
+        uint32_t us = static_cast<uint32_t>(frameUs(rng));
+        samples.push_back(us);
+        histogram.add(us);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    for (double percentile : { 50.0, 95.0, 99.0, 99.9 }) {
+        double exact = samples[static_cast<size_t>(std::ceil(percentile / 100.0 * samples.size())) - 1];
+        EXPECT_NEAR(histogram.percentileMicroseconds(percentile), exact, exact / 64.0) << "p" << percentile;
+    }
+
+    double slowest = 0.0;
+    for (size_t i = samples.size() - 100; i < samples.size(); ++i) slowest += samples[i];
+    slowest /= 100.0;
+    EXPECT_NEAR(histogram.slowestMeanMicroseconds(0.01), slowest, slowest / 64.0);
+
+    for (uint32_t us : samples) histogram.remove(us);
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.percentileMicroseconds(50.0), 0.0);
+}
+
+TEST(FrameTimeStatsTest, RollingMinMaxMatchBruteForce) {
+    const size_t window = 50;
+    FrameTimeStats stats(window);
+    std::deque<double> reference;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> frameMs(5.0, 40.0);
+
+    for (int i = 0; i < 2000; ++i) {
+        double ms = frameMs(rng);
+        stats.addFrame(ms);
+        reference.push_back(ms);
+        if (reference.size() > window) reference.pop_front();
+
+        ASSERT_EQ(stats.getMinMs(), *std::min_element(reference.begin(), reference.end()));
+        ASSERT_EQ(stats.getMaxMs(), *std::max_element(reference.begin(), reference.end()));
+        double sum = 0.0;
+        for (double value : reference) sum += value;
+        ASSERT_NEAR(stats.getAverageMs(), sum / reference.size(), 1e-9);
+    }
+    EXPECT_EQ(stats.getSampleCount(), window);
+}
+
+TEST(FrameTimeStatsTest, DetectsStuttersAgainstTheMedian) {
+    FrameTimeStats stats(100);
+    for (int i = 0; i < 60; ++i) {
+        stats.addFrame(i % 2 ? 8.0 : 9.0);
+        EXPECT_FALSE(stats.wasLastFrameStutter());
+    }
+
+    stats.addFrame(30.0);
+    EXPECT_TRUE(stats.wasLastFrameStutter());
+    stats.addFrame(12.0);
+    EXPECT_FALSE(stats.wasLastFrameStutter());
+    EXPECT_EQ(stats.getStuttersInWindow(), 1u);
+
+    // The hitch ages out of the window; the lifetime count keeps it
+    for (int i = 0; i < 100; ++i) stats.addFrame(8.5);
+    EXPECT_EQ(stats.getStuttersInWindow(), 0u);
+    EXPECT_EQ(stats.getTotalStutters(), 1u);
+    EXPECT_NEAR(stats.getPercentileMs(99.0), 8.5, 8.5 / 64.0);
+}
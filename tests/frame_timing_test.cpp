@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <core/fixed_timestep.h>
+#include <core/frame_limiter.h>
+#include <core/frame_pipeline.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+TEST(FixedTimestepTest, AccumulatesPartialFrames) {
+    FixedTimestep timestep(60.0f);
+
+    EXPECT_EQ(timestep.advance(0.010), 0);
+    EXPECT_NEAR(timestep.getAlpha(), 0.6f, 1e-4f);
+    EXPECT_EQ(timestep.advance(0.010), 1);
+    EXPECT_NEAR(timestep.getAlpha(), 0.2f, 1e-4f);
+    EXPECT_EQ(timestep.advance(1.0 / 30.0), 2);
+    EXPECT_NEAR(timestep.getSimulatedSeconds(), 3.0 / 60.0, 1e-9);
+}
+
+TEST(FixedTimestepTest, DropsTimeAfterLongStalls) {
+    FixedTimestep timestep(60.0f, 4);
+
+    EXPECT_EQ(timestep.advance(2.0), 4);
+    EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+    EXPECT_EQ(timestep.advance(1.0 / 60.0), 1);
+}
+
+TEST(FixedTimestepTest, SimulationDoesNotDependOnFrameRate) {
+    // The same second of real time, split into very different frames
+    auto simulate = [](const std::vector<double>& frames) {
+        FixedTimestep timestep(120.0f);
+        float position = 0.0f, velocity = 10.0f;
+        for (double frame : frames) {
+            for (int tick = timestep.advance(frame); tick > 0; --tick) {
+                velocity -= 9.81f * timestep.getTickSeconds();
+                position += velocity * timestep.getTickSeconds();
+            }
+        }
+        return position;
+    };
+
+    std::vector<double> steady(100, 0.01);
+    std::vector<double> jittery;
+    for (int i = 0; i < 50; ++i) {
+        jittery.push_back(0.0035);
+        jittery.push_back(0.0165);
+    }
+    EXPECT_FLOAT_EQ(simulate(steady), simulate(jittery));
+}
+
+TEST(FramePipelineTimingTest, InterpolationAlphaFollowsAccumulator) {
+    FramePipeline pipeline([](float, FrameSnapshot&) {}, 50.0f);
+
+    pipeline.advance(0.03);
+    const FrameSnapshot* snapshot = pipeline.acquireLatest();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->frameIndex, 1u);
+    EXPECT_FLOAT_EQ(snapshot->deltaTime, 0.02f);
+    EXPECT_NEAR(pipeline.getInterpolationAlpha(*snapshot), 0.5f, 1e-4f);
+}
+
+// Fake clock and sleep the tests move by hand. A sleep wakes lateNs past its
+// deadline, minus the spin window the limiter spins out itself, and records
+// the deadline it was given.
+class FrameLimiterTest : public ::testing::Test {
+protected:
+    const int64_t periodNs = 10000000;      // 100 FPS
+    int64_t nowNs = 1000000000;
+    int64_t lateNs = 0;
+    std::vector<int64_t> deadlines;
+    FrameLimiter limiter{ 100.0, [this] { return nowNs; },
+                          [this](int64_t deadlineNs, int64_t spinWindowNs) {
+                              deadlines.push_back(deadlineNs);
+                              int64_t sleepTargetNs = deadlineNs - spinWindowNs;
+                              if (sleepTargetNs <= nowNs) {
+                                  nowNs = std::max(nowNs, deadlineNs);
+                                  return static_cast<int64_t>(0);
+                              }
+                              int64_t wakeNs = sleepTargetNs + lateNs;
+                              nowNs = std::max(wakeNs, deadlineNs);
+                              return lateNs;
+                          } };
+};
+
+TEST_F(FrameLimiterTest, DeadlinesAdvanceByExactlyOnePeriod) {
+    int64_t start = nowNs;
+    limiter.wait();
+    // Frame work of varying length never moves the boundaries
+    for (int frame = 0; frame < 5; ++frame) {
+        nowNs += frame * 1500000;
+        double frameSeconds = limiter.wait();
+        EXPECT_DOUBLE_EQ(frameSeconds, 0.01);
+    }
+    ASSERT_EQ(deadlines.size(), 6u);
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        EXPECT_EQ(deadlines[i], start + static_cast<int64_t>(i + 1) * periodNs) << "wait " << i;
+    }
+}
+
+TEST_F(FrameLimiterTest, FallingAFrameBehindStartsTheScheduleOver) {
+    int64_t start = nowNs;
+    limiter.wait();
+    nowNs += 25000000;
+    EXPECT_DOUBLE_EQ(limiter.wait(), 0.025);
+    limiter.wait();
+    // No catch-up frames: the next boundary is a period after the late one
+    EXPECT_EQ(deadlines.back(), start + periodNs + 25000000 + periodNs);
+}
+
+// A lead wakes the loop early without moving the boundaries after it
+TEST_F(FrameLimiterTest, LeadWakesEarlyOnTheSameSchedule) {
+    const int64_t leadNs = 4000000;
+    limiter.wait();
+    int64_t start = nowNs;
+
+    limiter.wait(leadNs);
+    EXPECT_EQ(nowNs - start, periodNs - leadNs);
+    limiter.wait();
+    EXPECT_EQ(nowNs - start, 2 * periodNs);
+
+    // A lead longer than the period waits not at all
+    int64_t before = nowNs;
+    limiter.wait(2 * periodNs);
+    EXPECT_EQ(nowNs, before);
+}
+
+TEST_F(FrameLimiterTest, SpinWindowFollowsWakeLatency) {
+    // Twice the smoothed latency, clamped to [50 us, 2 ms]
+    lateNs = 400000;
+    for (int frame = 0; frame < 100; ++frame) limiter.wait();
+    EXPECT_NEAR(static_cast<double>(limiter.getSpinWindowNanoseconds()), 800000.0, 1000.0);
+
+    lateNs = 5000000;
+    for (int frame = 0; frame < 100; ++frame) limiter.wait();
+    EXPECT_EQ(limiter.getSpinWindowNanoseconds(), 2000000);
+
+    lateNs = 1000;
+    for (int frame = 0; frame < 200; ++frame) limiter.wait();
+    EXPECT_EQ(limiter.getSpinWindowNanoseconds(), 50000);
+}
+
+TEST_F(FrameLimiterTest, ResetStartsOverFromNow) {
+    limiter.wait();
+    limiter.wait();
+    nowNs += 500000000;
+    limiter.reset();
+    int64_t resetAt = nowNs;
+    EXPECT_DOUBLE_EQ(limiter.wait(), 0.01);
+    EXPECT_EQ(deadlines.back(), resetAt + periodNs);
+
+    limiter.setTargetFps(0.0);
+    size_t sleeps = deadlines.size();
+    nowNs += 3000000;
+    limiter.wait();
+    nowNs += 3000000;
+    EXPECT_DOUBLE_EQ(limiter.wait(), 0.003);
+    EXPECT_EQ(deadlines.size(), sleeps);
+}
+
+// The limiter's frame times feed the pipeline one 60 Hz tick per 1/60 s
+TEST_F(FrameLimiterTest, PacedPipelineSimulatesRealTime) {
+    FramePipeline pipeline([](float, FrameSnapshot& snapshot) { snapshot.cameraPosition.x += 1.0f; }, 60.0f);
+    limiter.wait();
+    for (int frame = 0; frame < 240; ++frame) {
+        nowNs += (frame % 7) * 1000000;
+        pipeline.advance(limiter.wait());
+        pipeline.acquireLatest();
+    }
+    EXPECT_EQ(pipeline.getStats().simulatedFrames, 144u);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <GL/glew.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <graphics/indirect_renderer.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Runs the indirect renderer against a real driver. Meant for Mesa's software
+// rasterizer (LIBGL_ALWAYS_SOFTWARE=1), which needs no display or GPU.
+class GLValidationTest : public ::testing::Test {
+protected:
+    static EGLDisplay display;
+    static EGLContext context;
+
+    static void SetUpTestCase() {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (!getPlatformDisplay) return;
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+            display = EGL_NO_DISPLAY;
+            return;
+        }
+
+        eglBindAPI(EGL_OPENGL_API);
+        const EGLint contextAttributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 4,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+            EGL_NONE
+        };
+        context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+        if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+            context = EGL_NO_CONTEXT;
+            return;
+        }
+
+        glewExperimental = GL_TRUE;
+        glewInit();
+        glGetError();   // glewInit can leave GL_INVALID_ENUM behind
+    }
+
+    static void TearDownTestCase() {
+        if (context != EGL_NO_CONTEXT) {
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(display, context);
+        }
+        if (display != EGL_NO_DISPLAY) eglTerminate(display);
+        context = EGL_NO_CONTEXT;
+        display = EGL_NO_DISPLAY;
+    }
+
+    void SetUp() override {
+        if (context == EGL_NO_CONTEXT) GTEST_SKIP() << "No OpenGL 4.3 context available";
+    }
+};
+
+EGLDisplay GLValidationTest::display = EGL_NO_DISPLAY;
+EGLContext GLValidationTest::context = EGL_NO_CONTEXT;
+
+namespace {
+    const int TARGET_SIZE = 64;
+
+    MeshRange quadRange(MeshArena& arena, const glm::vec3& color, float tint) {
+        std::vector<ArenaVertex> vertices = {
+            { glm::vec3(-0.5f, -0.5f, 0.0f), color, tint },
+            { glm::vec3( 0.5f, -0.5f, 0.0f), color, tint },
+            { glm::vec3( 0.5f,  0.5f, 0.0f), color, tint },
+            { glm::vec3(-0.5f,  0.5f, 0.0f), color, tint },
+        };
+        return arena.add(vertices, { 0, 1, 2, 0, 2, 3 });
+    }
+
+    IndirectDrawItem quadItem(const MeshRange& mesh, uint32_t material, const glm::vec3& position,
+                              const glm::vec3& scale, const glm::vec4& color) {
+        glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.0f), position), scale);
+        return IndirectDrawItem{ mesh, material, model, color };
+    }
+
+    glm::vec4 readPixel(int x, int y) {
+        unsigned char pixel[4] = {};
+        glReadPixels(x, y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        return glm::vec4(pixel[0], pixel[1], pixel[2], pixel[3]);
+    }
+}
+
+TEST_F(GLValidationTest, MultiDrawIndirectRendersCulledList) {
+    GLuint framebuffer = 0, colorTarget = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(1, &colorTarget);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorTarget);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, TARGET_SIZE, TARGET_SIZE);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorTarget);
+    ASSERT_EQ(glCheckFramebufferStatus(GL_FRAMEBUFFER), static_cast<GLenum>(GL_FRAMEBUFFER_COMPLETE));
+    glViewport(0, 0, TARGET_SIZE, TARGET_SIZE);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    MeshArena arena;
+    MeshRange tinted = quadRange(arena, glm::vec3(1.0f), 1.0f);
+    MeshRange blue = quadRange(arena, glm::vec3(0.0f, 0.0f, 1.0f), 0.0f);
+
+    // Left and right halves share a mesh and differ only in per-draw color;
+    // the blue marker is a second material drawn on top
+    std::vector<IndirectDrawItem> items = {
+        quadItem(tinted, 0, glm::vec3(-0.5f, 0.0f, 0.0f), glm::vec3(1.0f, 2.0f, 1.0f), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)),
+        quadItem(tinted, 0, glm::vec3( 0.5f, 0.0f, 0.0f), glm::vec3(1.0f, 2.0f, 1.0f), glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)),
+        quadItem(blue, 1, glm::vec3(0.0f, 0.75f, 0.0f), glm::vec3(0.25f), glm::vec4(1.0f)),
+        quadItem(blue, 1, glm::vec3(5.0f, 0.0f, 0.0f), glm::vec3(1.0f), glm::vec4(1.0f)),
+    };
+
+    glm::mat4 viewProjection(1.0f);
+    IndirectDrawList list;
+    IndirectDraw::buildDrawList(items, Frustum::fromMatrix(viewProjection), list);
+    ASSERT_EQ(list.culledItems, 1u);
+    ASSERT_EQ(list.commands.size(), 2u);
+    EXPECT_EQ(list.commands[0].instanceCount, 2u);
+
+    IndirectRenderer renderer;
+    ASSERT_TRUE(renderer.initialize());
+    std::vector<uint32_t> boundMaterials;
+    renderer.submit(arena, list, viewProjection, [&](uint32_t material) { boundMaterials.push_back(material); });
+    glFinish();
+
+    EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+    EXPECT_EQ(renderer.getLastMultiDrawCount(), 2u);
+    EXPECT_EQ(boundMaterials, (std::vector<uint32_t>{ 0, 1 }));
+
+    EXPECT_EQ(readPixel(8, 32), glm::vec4(255, 0, 0, 255));
+    EXPECT_EQ(readPixel(56, 32), glm::vec4(0, 255, 0, 255));
+    EXPECT_EQ(readPixel(32, 56), glm::vec4(0, 0, 255, 255));
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteRenderbuffers(1, &colorTarget);
+    glDeleteFramebuffers(1, &framebuffer);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <graphics/indirect_renderer.h>
+#include <graphics/snapshot_renderer.h>
+#include <editor/editor.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    // Camera at the origin looking down -Z
+    Frustum testFrustum() {
+        glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return Frustum::fromMatrix(projection * view);
+    }
+
+    MeshRange cubeRange(MeshArena& arena) {
+        std::vector<ArenaVertex> vertices;
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec3 position((corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 0.5f : -0.5f, (corner & 4) ? 0.5f : -0.5f);
+            vertices.push_back(ArenaVertex{ position, glm::vec3(1.0f), 0.0f });
+        }
+        return arena.add(vertices, { 0, 1, 2, 1, 3, 2 });
+    }
+
+    IndirectDrawItem itemAt(const MeshRange& mesh, uint32_t material, const glm::vec3& position) {
+        return IndirectDrawItem{ mesh, material, glm::translate(glm::mat4(1.0f), position), glm::vec4(1.0f) };
+    }
+}
+
+TEST(IndirectDrawTest, FrustumCullsBoxes) {
+    Frustum frustum = testFrustum();
+    EXPECT_TRUE(frustum.intersects(AABB(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f))));
+    // Behind, beyond the far plane, and well off to the side
+    EXPECT_FALSE(frustum.intersects(AABB(glm::vec3(-1.0f, -1.0f, 5.0f), glm::vec3(1.0f, 1.0f, 6.0f))));
+    EXPECT_FALSE(frustum.intersects(AABB(glm::vec3(-1.0f, -1.0f, -200.0f), glm::vec3(1.0f, 1.0f, -150.0f))));
+    EXPECT_FALSE(frustum.intersects(AABB(glm::vec3(30.0f, -1.0f, -11.0f), glm::vec3(32.0f, 1.0f, -9.0f))));
+    // Straddling the left plane
+    EXPECT_TRUE(frustum.intersects(AABB(glm::vec3(-12.0f, -1.0f, -11.0f), glm::vec3(-9.0f, 1.0f, -9.0f))));
+}
+
+TEST(IndirectDrawTest, ArenaRangesAreConsecutive) {
+    MeshArena arena;
+    MeshRange first = cubeRange(arena);
+    MeshRange second = cubeRange(arena);
+
+    EXPECT_EQ(first.firstIndex, 0u);
+    EXPECT_EQ(first.baseVertex, 0);
+    EXPECT_EQ(second.firstIndex, 6u);
+    EXPECT_EQ(second.baseVertex, 8);
+    EXPECT_EQ(arena.getIndices().size(), 12u);
+    // Indices stay local to their mesh
+    EXPECT_EQ(arena.getIndices()[6], 0u);
+    EXPECT_EQ(second.bounds.max, glm::vec3(0.5f));
+}
+
+TEST(IndirectDrawTest, CommandsGroupByMaterialAndMesh) {
+    MeshArena arena;
+    MeshRange cube = cubeRange(arena);
+    MeshRange other = cubeRange(arena);
+
+    std::vector<IndirectDrawItem> items = {
+        itemAt(cube, 1, glm::vec3(0.0f, 0.0f, -10.0f)),
+        itemAt(other, 0, glm::vec3(2.0f, 0.0f, -10.0f)),
+        itemAt(cube, 1, glm::vec3(-2.0f, 0.0f, -10.0f)),
+        itemAt(cube, 1, glm::vec3(0.0f, 0.0f, 10.0f)),      // Behind the camera
+        itemAt(cube, 0, glm::vec3(0.0f, 2.0f, -10.0f)),
+    };
+
+    IndirectDrawList list;
+    IndirectDraw::buildDrawList(items, testFrustum(), list);
+
+    EXPECT_EQ(list.visibleItems, 4u);
+    EXPECT_EQ(list.culledItems, 1u);
+    ASSERT_EQ(list.materials.size(), 2u);
+    EXPECT_EQ(list.materials[0].material, 0u);
+    EXPECT_EQ(list.materials[0].commandCount, 2u);
+    EXPECT_EQ(list.materials[1].material, 1u);
+    EXPECT_EQ(list.materials[1].firstCommand, 2u);
+    EXPECT_EQ(list.materials[1].commandCount, 1u);
+
+    // Both visible material-1 cubes share one instanced command
+    ASSERT_EQ(list.commands.size(), 3u);
+    const DrawElementsIndirectCommand& instanced = list.commands[2];
+    EXPECT_EQ(instanced.instanceCount, 2u);
+    EXPECT_EQ(instanced.count, cube.indexCount);
+    EXPECT_EQ(instanced.firstIndex, cube.firstIndex);
+    EXPECT_EQ(instanced.baseInstance, 2u);
+    ASSERT_EQ(list.instances.size(), 4u);
+
+    // Every command points at its own run of per-draw records
+    uint32_t expectedInstance = 0;
+    for (const auto& command : list.commands) {
+        EXPECT_EQ(command.baseInstance, expectedInstance);
+        expectedInstance += command.instanceCount;
+    }
+}
+
+TEST(IndirectDrawTest, EditorSceneBecomesOneCommandPerMesh) {
+    Editor::WorldEditor editor;
+    for (int i = 0; i < 1000; ++i) {
+        float x = float(i % 10) * 2.0f - 9.0f;
+        float z = -20.0f - float(i / 10) * 0.5f;
+        editor.addObject(Editor::ObjectType::HOUSE, glm::vec3(x, 0.0f, z), glm::vec3(1.0f));
+    }
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(1.0f));
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(0.0f, 0.0f, 50.0f), glm::vec3(1.0f));    // Behind the camera
+
+    FrameSnapshot snapshot;
+    editor.captureSnapshot(snapshot);
+    SnapshotRenderer renderer;
+    const IndirectDrawList& list = renderer.buildDrawList(snapshot, testFrustum());
+
+    EXPECT_EQ(list.visibleItems, 1001u);
+    EXPECT_EQ(list.culledItems, 1u);
+    ASSERT_EQ(list.materials.size(), 2u);
+    ASSERT_EQ(list.commands.size(), 2u);
+    EXPECT_EQ(list.materials[0].material, static_cast<uint32_t>(Editor::ObjectType::WALL));
+    EXPECT_EQ(list.commands[0].instanceCount, 1u);
+    EXPECT_EQ(list.commands[1].instanceCount, 1000u);
+
+    // Two distinct meshes in the arena, however many objects use them
+    size_t houseIndices = editor.getObjects()[0]->getMesh()->getIndices().size();
+    size_t wallIndices = editor.getObjects()[1000]->getMesh()->getIndices().size();
+    EXPECT_EQ(renderer.getMeshArena().getIndices().size(), houseIndices + wallIndices);
+}
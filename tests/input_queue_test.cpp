@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <core/spsc_queue.h>
+#include <input/input_queue.h>
+#include <thread>
+#include <vector>
+
+TEST(SPSCQueueTest, FifoUntilFull) {
+    SPSCQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+
+    int value = 0;
+    EXPECT_FALSE(queue.tryPop(value));
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 8; ++i) EXPECT_TRUE(queue.tryPush(round * 10 + i));
+        EXPECT_FALSE(queue.tryPush(99));
+        EXPECT_EQ(queue.sizeForProducer(), 8u);
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_TRUE(queue.tryPop(value));
+            EXPECT_EQ(value, round * 10 + i);
+        }
+        EXPECT_FALSE(queue.tryPop(value));
+    }
+}
+
+TEST(SPSCQueueTest, ConcurrentTransferKeepsOrder) {
+    SPSCQueue<uint64_t> queue(1024);
+    const uint64_t count = 1000000;
+
+    std::thread producer([&] {
+        for (uint64_t i = 1; i <= count; ++i) {
+            while (!queue.tryPush(i)) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 1;
+    bool ordered = true;
+    while (expected <= count) {
+        uint64_t value;
+        if (!queue.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && value == expected;
+        ++expected;
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+}
+
+TEST(InputQueueTest, BurstOfCursorMovesAppliesOncePerRun) {
+    InputQueue queue;
+    std::vector<InputEvent> applied;
+
+    // Per frame: 4000 mouse reports with a click and a key press in the middle
+    for (int frame = 0; frame < 3; ++frame) {
+        for (int i = 0; i < 4000; ++i) {
+            if (i == 2000) {
+                queue.push(InputEvent::mouseButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, 0));
+                queue.push(InputEvent::key(GLFW_KEY_W, 17, GLFW_PRESS, 0));
+            }
+            ASSERT_TRUE(queue.push(InputEvent::cursor(frame * 4000 + i, -i)));
+        }
+
+        applied.clear();
+        size_t count = queue.drain([&](const InputEvent& event) { applied.push_back(event); });
+        ASSERT_EQ(count, 4u);
+        ASSERT_EQ(applied.size(), 4u);
+
+        // The click sees the cursor where it was just before it
+        EXPECT_EQ(applied[0].type, InputEventType::CURSOR);
+        EXPECT_EQ(applied[0].x, frame * 4000 + 1999);
+        EXPECT_EQ(applied[1].type, InputEventType::MOUSE_BUTTON);
+        EXPECT_EQ(applied[2].type, InputEventType::KEY);
+        EXPECT_EQ(applied[3].type, InputEventType::CURSOR);
+        EXPECT_EQ(applied[3].x, frame * 4000 + 3999);
+        EXPECT_EQ(applied[3].y, -3999.0);
+        EXPECT_LE(applied[0].timeNs, applied[3].timeNs);
+        EXPECT_GT(applied[3].timeNs, 0);
+    }
+
+    InputQueue::Stats stats = queue.getStats();
+    EXPECT_EQ(stats.pushed, 3u * 4002u);
+    EXPECT_EQ(stats.applied, 12u);
+    EXPECT_EQ(stats.coalesced, 3u * 3998u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST(InputQueueTest, FloodOfCursorMovesNeverCrowdsOutKeys) {
+    InputQueue queue;
+    size_t acceptedCursors = 0;
+    for (size_t i = 0; i < InputQueue::CAPACITY * 2; ++i) {
+        acceptedCursors += queue.push(InputEvent::cursor(static_cast<double>(i), 0.0)) ? 1 : 0;
+    }
+    EXPECT_EQ(acceptedCursors, InputQueue::CAPACITY - InputQueue::CURSOR_HEADROOM);
+
+    // The key still fits, and its release too
+    EXPECT_TRUE(queue.push(InputEvent::key(GLFW_KEY_W, 17, GLFW_PRESS, 0)));
+    EXPECT_TRUE(queue.push(InputEvent::key(GLFW_KEY_W, 17, GLFW_RELEASE, 0)));
+
+    std::vector<InputEvent> applied;
+    queue.drain([&](const InputEvent& event) { applied.push_back(event); });
+    ASSERT_EQ(applied.size(), 3u);
+    EXPECT_EQ(applied[0].x, static_cast<double>(acceptedCursors - 1));
+    EXPECT_EQ(applied[2].action, GLFW_RELEASE);
+    EXPECT_EQ(queue.getStats().dropped, InputQueue::CAPACITY * 2 - acceptedCursors);
+}
+
+TEST(InputQueueTest, ProducerAndConsumerOnDifferentThreads) {
+    InputQueue queue;
+    const int frames = 200;
+    const int reportsPerFrame = 1000;
+    std::atomic<bool> done(false);
+
+    std::thread producer([&] {
+        for (int frame = 0; frame < frames; ++frame) {
+            for (int i = 0; i < reportsPerFrame; ++i) {
+                while (!queue.push(InputEvent::cursor(frame * reportsPerFrame + i, 0.0))) std::this_thread::yield();
+            }
+            while (!queue.push(InputEvent::key(GLFW_KEY_SPACE, 57, frame % 2 ? GLFW_RELEASE : GLFW_PRESS, 0))) {
+                std::this_thread::yield();
+            }
+        }
+        done = true;
+    });
+
+    int keys = 0;
+    double lastX = -1.0;
+    bool ordered = true;
+    auto apply = [&](const InputEvent& event) {
+        if (event.type == InputEventType::KEY) {
+            ordered = ordered && event.action == (keys % 2 ? GLFW_RELEASE : GLFW_PRESS);
+            ++keys;
+        } else {
+            ordered = ordered && event.x > lastX;
+            lastX = event.x;
+        }
+    };
+    while (!done) {
+        queue.drain(apply);
+        std::this_thread::yield();
+    }
+    producer.join();
+    queue.drain(apply);
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(keys, frames);
+    EXPECT_EQ(lastX, frames * reportsPerFrame - 1.0);
+}
@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+#include <input/input_recording.h>
+#include <input/movement.h>
+#include <input/editor_input.h>
+#include <core/globals.h>
+#include <cstdio>
+#include <cmath>
+
+extern MovementState moveState;
+extern bool firstMouse;
+
+namespace {
+    InputRecording sampleRecording() {
+        InputRecording recording(60.0f);
+        InputEvent event = InputEvent::key(GLFW_KEY_W, 17, GLFW_PRESS, 0);
+        event.tick = 0;
+        recording.append(event);
+        event = InputEvent::cursor(960.25, -3.0e-7);
+        event.tick = 0;
+        recording.append(event);
+        event = InputEvent::key(GLFW_KEY_UNKNOWN, -1, GLFW_RELEASE, GLFW_MOD_SHIFT);
+        event.tick = 200;
+        recording.append(event);
+        event = InputEvent::mouseButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, 0);
+        event.tick = 200000;
+        recording.append(event);
+        event = InputEvent::inventorySelect(3);
+        event.tick = 200001;
+        recording.append(event);
+        recording.setTickCount(300000);
+        return recording;
+    }
+
+    // Scripted session: walk, look around with the mouse, jump, stop
+    std::vector<InputEvent> script() {
+        std::vector<InputEvent> events;
+        auto at = [&events](uint64_t tick, InputEvent event) {
+            event.tick = tick;
+            events.push_back(event);
+        };
+        at(0, InputEvent::cursor(960.0, 540.0));
+        at(3, InputEvent::key(GLFW_KEY_W, 17, GLFW_PRESS, 0));
+        for (uint64_t tick = 10; tick < 70; ++tick) {
+            at(tick, InputEvent::cursor(960.0 + tick * 3.7, 540.0 - std::sin(tick * 0.1) * 20.0));
+        }
+        at(40, InputEvent::key(GLFW_KEY_SPACE, 57, GLFW_PRESS, 0));
+        at(41, InputEvent::key(GLFW_KEY_SPACE, 57, GLFW_RELEASE, 0));
+        at(50, InputEvent::key(GLFW_KEY_LEFT_SHIFT, 42, GLFW_PRESS, 0));
+        at(50, InputEvent::key(GLFW_KEY_D, 32, GLFW_PRESS, 0));
+        at(100, InputEvent::key(GLFW_KEY_W, 17, GLFW_RELEASE, 0));
+        at(100, InputEvent::key(GLFW_KEY_D, 32, GLFW_RELEASE, 0));
+        std::stable_sort(events.begin(), events.end(),
+                         [](const InputEvent& a, const InputEvent& b) { return a.tick < b.tick; });
+        return events;
+    }
+
+    struct PlayerState {
+        float x, y, z;
+        glm::vec3 front;
+    };
+
+    void resetPlayer() {
+        characterPosX = characterPosY = characterPosZ = 0.0f;
+        cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
+        yaw = -90.0f;
+        pitch = 0.0f;
+        firstMouse = true;
+        moveState = MovementState();
+        EditorInput::isEditorMode = false;
+    }
+
+    // The same per-tick order main.cpp uses: input for the tick, then movement
+    template <typename ApplyTickInput>
+    PlayerState simulate(uint64_t ticks, ApplyTickInput applyTickInput) {
+        resetPlayer();
+        for (uint64_t tick = 0; tick < ticks; ++tick) {
+            applyTickInput(tick);
+            Movement::updateMovement(1.0f / 60.0f);
+        }
+        return PlayerState{ characterPosX, characterPosY, characterPosZ, cameraFront };
+    }
+}
+
+TEST(InputRecordingTest, SerializeRoundTripsExactly) {
+    InputRecording recording = sampleRecording();
+    std::vector<uint8_t> data = recording.serialize();
+
+    InputRecording loaded;
+    ASSERT_TRUE(loaded.deserialize(data.data(), data.size()));
+    EXPECT_EQ(loaded.getTickRate(), 60.0f);
+    EXPECT_EQ(loaded.getTickCount(), 300000u);
+    ASSERT_EQ(loaded.getEvents().size(), recording.getEvents().size());
+    for (size_t i = 0; i < recording.getEvents().size(); ++i) {
+        EXPECT_TRUE(loaded.getEvents()[i] == recording.getEvents()[i]) << "event " << i;
+    }
+}
+
+TEST(InputRecordingTest, EncodingIsCompact) {
+    InputRecording recording(60.0f);
+    for (uint64_t tick = 0; tick < 1000; ++tick) {
+        InputEvent event = InputEvent::key(GLFW_KEY_W, 17, tick % 2 ? GLFW_RELEASE : GLFW_PRESS, 0);
+        event.tick = tick;
+        recording.append(event);
+    }
+    size_t header = recording.serialize().size() - 1000 * 7;
+    // Tick delta, type, 2-byte key code, scancode, action, mods
+    EXPECT_EQ(header, 28u);
+}
+
+TEST(InputRecordingTest, RejectsDamagedData) {
+    std::vector<uint8_t> data = sampleRecording().serialize();
+    InputRecording loaded;
+
+    std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+    EXPECT_FALSE(loaded.deserialize(truncated.data(), truncated.size()));
+
+    std::vector<uint8_t> badMagic = data;
+    badMagic[0] = 'X';
+    EXPECT_FALSE(loaded.deserialize(badMagic.data(), badMagic.size()));
+
+    std::vector<uint8_t> hugeCount = data;
+    hugeCount[20 + 7] = 0x7f;
+    EXPECT_FALSE(loaded.deserialize(hugeCount.data(), hugeCount.size()));
+    EXPECT_TRUE(loaded.getEvents().empty());
+}
+
+TEST(InputRecordingTest, SaveAndLoadFile) {
+    std::string path = ::testing::TempDir() + "input_recording_test.bin";
+    InputRecording recording = sampleRecording();
+    ASSERT_TRUE(recording.save(path));
+
+    InputRecording loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.getEvents().size(), recording.getEvents().size());
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(loaded.load(path));
+}
+
+TEST(InputRecordingTest, ReplayReproducesTheRecordedRunBitForBit) {
+    std::vector<InputEvent> events = script();
+    const uint64_t ticks = 150;
+
+    // Live run: events arrive as they happen and are recorded on the way in
+    InputRecording recording(60.0f);
+    size_t next = 0;
+    PlayerState live = simulate(ticks, [&](uint64_t tick) {
+        while (next < events.size() && events[next].tick == tick) {
+            recording.append(events[next]);
+            applyInputEvent(nullptr, events[next++]);
+        }
+    });
+    recording.setTickCount(ticks);
+
+    std::vector<uint8_t> data = recording.serialize();
+    InputRecording loaded;
+    ASSERT_TRUE(loaded.deserialize(data.data(), data.size()));
+
+    for (int run = 0; run < 2; ++run) {
+        InputReplayer replayer(loaded);
+        uint64_t replayedTicks = 0;
+        PlayerState replayed = simulate(ticks, [&](uint64_t tick) {
+            replayer.replayTick(tick, [](const InputEvent& event) { applyInputEvent(nullptr, event); });
+            replayedTicks = tick + 1;
+        });
+
+        EXPECT_TRUE(replayer.isFinished(replayedTicks));
+        EXPECT_EQ(replayed.x, live.x);
+        EXPECT_EQ(replayed.y, live.y);
+        EXPECT_EQ(replayed.z, live.z);
+        EXPECT_EQ(replayed.front, live.front);
+    }
+    // The script actually moved and turned the player
+    EXPECT_GT(std::abs(live.x) + std::abs(live.z), 1.0f);
+    EXPECT_NE(live.front, glm::vec3(0.0f, 0.0f, -1.0f));
+    resetPlayer();
+}
+
+// A headless replay has no window; the editor toggle and placement must still
+// run, or the replay ends somewhere else than the session it recorded
+TEST(InputRecordingTest, HeadlessReplayReproducesEditorActions) {
+    std::vector<InputEvent> events;
+    auto at = [&events](uint64_t tick, InputEvent event) {
+        event.tick = tick;
+        events.push_back(event);
+    };
+    at(0, InputEvent::key(GLFW_KEY_M, 50, GLFW_PRESS, 0));
+    at(1, InputEvent::key(GLFW_KEY_M, 50, GLFW_RELEASE, 0));
+    at(2, InputEvent::key(GLFW_KEY_1, 2, GLFW_PRESS, 0));
+    at(3, InputEvent::cursor(400.0, 900.0));
+    at(4, InputEvent::mouseButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, 0));
+    at(5, InputEvent::cursor(700.0, 1000.0));
+    at(6, InputEvent::mouseButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE, 0));
+    at(7, InputEvent::key(GLFW_KEY_P, 25, GLFW_PRESS, 0));
+    InputRecording recording(60.0f);
+    for (const InputEvent& event : events) {
+        recording.append(event);
+    }
+    recording.setTickCount(10);
+
+    // main.cpp's tick without a window: input, movement outside the editor, editor update
+    struct EditorState {
+        bool editorMode;
+        size_t objects;
+        glm::vec3 position;
+    };
+    auto replay = [&recording]() {
+        resetPlayer();
+        EditorInput::worldEditor = Editor::WorldEditor();
+        EditorInput::isPlacingObject = false;
+        InputReplayer replayer(recording);
+        for (uint64_t tick = 0; tick < recording.getTickCount(); ++tick) {
+            replayer.replayTick(tick, [](const InputEvent& event) { applyInputEvent(nullptr, event); });
+            if (!EditorInput::isEditorMode) Movement::updateMovement(1.0f / 60.0f);
+            EditorInput::update(1.0f / 60.0f);
+        }
+        const Editor::WorldEditor& editor = EditorInput::worldEditor;
+        EditorState state{ EditorInput::isEditorMode, editor.getObjects().size(), glm::vec3(0.0f) };
+        if (state.objects > 0) state.position = editor.getObjectWorldPosition(0);
+        return state;
+    };
+
+    ASSERT_EQ(EditorInput::window, nullptr);
+    EditorState first = replay();
+    EXPECT_TRUE(first.editorMode);
+    ASSERT_EQ(first.objects, 1u);
+    EXPECT_EQ(first.position, EditorInput::placementEnd);
+
+    EditorState second = replay();
+    EXPECT_EQ(second.editorMode, first.editorMode);
+    EXPECT_EQ(second.objects, first.objects);
+    EXPECT_EQ(second.position, first.position);
+
+    resetPlayer();
+    EditorInput::worldEditor = Editor::WorldEditor();
+}
+
+// Changes to one object merge into one undo step until a key or button is released
+TEST(InputRecordingTest, ReleasingInputSealsTheUndoStep) {
+    EditorInput::worldEditor = Editor::WorldEditor();
+    Editor::WorldEditor& editor = EditorInput::worldEditor;
+    EditorInput::isEditorMode = true;
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(0.0f), glm::vec3(1.0f));
+    editor.sealUndoStep();
+
+    editor.setObjectPosition(0, glm::vec3(1.0f, 0.0f, 0.0f));
+    editor.setObjectPosition(0, glm::vec3(2.0f, 0.0f, 0.0f));
+    EXPECT_EQ(editor.getJournal().getUndoCount(), 2u);
+    applyInputEvent(nullptr, InputEvent::mouseButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE, 0));
+    editor.setObjectPosition(0, glm::vec3(3.0f, 0.0f, 0.0f));
+    EXPECT_EQ(editor.getJournal().getUndoCount(), 3u);
+    applyInputEvent(nullptr, InputEvent::key(GLFW_KEY_G, 34, GLFW_RELEASE, 0));
+    editor.setObjectPosition(0, glm::vec3(4.0f, 0.0f, 0.0f));
+    EXPECT_EQ(editor.getJournal().getUndoCount(), 4u);
+
+    EXPECT_TRUE(editor.undo());
+    EXPECT_EQ(editor.getObjectWorldPosition(0), glm::vec3(3.0f, 0.0f, 0.0f));
+    EditorInput::isEditorMode = false;
+    EditorInput::worldEditor = Editor::WorldEditor();
+}
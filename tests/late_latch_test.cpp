@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <core/globals.h>
+#include <input/late_latch.h>
+#include <ui/cursor.h>
+
+namespace {
+    // Snapshot as a tick leaves it after applying a cursor move to (x, y)
+    FrameSnapshot tickWithCursor(double x, double y, int64_t timeNs) {
+        handleCameraMouseMovement(x, y);
+        FrameSnapshot snapshot;
+        snapshot.cameraFront = cameraFront;
+        snapshot.yaw = yaw;
+        snapshot.pitch = pitch;
+        snapshot.lookCursor = glm::dvec2(x, y);
+        snapshot.lookCursorTimeNs = timeNs;
+        return snapshot;
+    }
+
+    InputEvent cursorAt(double x, double y, int64_t timeNs) {
+        InputEvent event = InputEvent::cursor(x, y);
+        event.timeNs = timeNs;
+        return event;
+    }
+}
+
+TEST(LateLatchTest, KeepsSnapshotViewWithoutNewerInput) {
+    FrameSnapshot snapshot = tickWithCursor(100.0, 100.0, 1000);
+    LateLatch latch;
+    latch.setEnabled(true);
+
+    LateLatch::View view = latch.aim(snapshot);
+    EXPECT_FALSE(view.latched);
+    EXPECT_EQ(view.front, snapshot.cameraFront);
+    EXPECT_EQ(view.inputTimeNs, 1000);
+
+    // Already applied by the tick
+    latch.onCursor(cursorAt(100.0, 100.0, 1000));
+    EXPECT_FALSE(latch.aim(snapshot).latched);
+}
+
+TEST(LateLatchTest, MatchesWhatTheNextTickApplies) {
+    FrameSnapshot snapshot = tickWithCursor(100.0, 100.0, 1000);
+    LateLatch latch;
+    latch.setEnabled(true);
+    latch.onCursor(cursorAt(160.0, 70.0, 2000));
+
+    LateLatch::View view = latch.aim(snapshot);
+    EXPECT_TRUE(view.latched);
+    EXPECT_EQ(view.inputTimeNs, 2000);
+
+    handleCameraMouseMovement(160.0, 70.0);
+    EXPECT_FLOAT_EQ(view.front.x, cameraFront.x);
+    EXPECT_FLOAT_EQ(view.front.y, cameraFront.y);
+    EXPECT_FLOAT_EQ(view.front.z, cameraFront.z);
+}
+
+TEST(LateLatchTest, OffInEditorModeOrWhenDisabled) {
+    FrameSnapshot snapshot = tickWithCursor(100.0, 100.0, 1000);
+    LateLatch latch;
+    latch.onCursor(cursorAt(400.0, 100.0, 2000));
+    EXPECT_FALSE(latch.aim(snapshot).latched);
+
+    latch.setEnabled(true);
+    snapshot.editorMode = true;
+    EXPECT_FALSE(latch.aim(snapshot).latched);
+
+    // Before the simulation has applied any live cursor move
+    snapshot.editorMode = false;
+    snapshot.lookCursorTimeNs = 0;
+    EXPECT_FALSE(latch.aim(snapshot).latched);
+}
+
+TEST(InputLatencyTrackerTest, CountsEachInputOnce) {
+    InputLatencyTracker tracker(16);
+    tracker.onSubmit(0, 5000000);
+    EXPECT_EQ(tracker.getStats().getSampleCount(), 0u);
+
+    tracker.onSubmit(1000000, 3000000);
+    tracker.onSubmit(1000000, 11000000);    // Same input on the next frame
+    tracker.onSubmit(12000000, 16000000);
+    EXPECT_EQ(tracker.getStats().getSampleCount(), 2u);
+    EXPECT_DOUBLE_EQ(tracker.getStats().getMinMs(), 2.0);
+    EXPECT_DOUBLE_EQ(tracker.getStats().getMaxMs(), 4.0);
+}
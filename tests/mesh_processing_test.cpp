@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <graphics/mesh_processing.h>
+#include <core/thread_pool.h>
+#include <glm/glm.hpp>
+
+namespace {
+    Vertex makeVertex(const glm::vec3& position, const glm::vec2& uv = glm::vec2(0.0f)) {
+        Vertex vertex{};
+        vertex.position = position;
+        vertex.texCoord = uv;
+        return vertex;
+    }
+
+    // Unit cube with 8 shared corners and outward-facing triangles
+    void buildCube(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        vertices.clear();
+        for (int i = 0; i < 8; ++i) {
+            vertices.push_back(makeVertex(glm::vec3(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f)));
+        }
+        indices = {
+            0, 2, 1,  1, 2, 3,   // -z
+            4, 5, 6,  5, 7, 6,   // +z
+            0, 1, 4,  1, 5, 4,   // -y
+            2, 6, 3,  3, 6, 7,   // +y
+            0, 4, 2,  2, 4, 6,   // -x
+            1, 3, 5,  3, 7, 5    // +x
+        };
+    }
+
+    // Single quad in the XZ plane facing +Y
+    void buildQuad(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, bool mirrorU) {
+        float u0 = mirrorU ? 1.0f : 0.0f;
+        float u1 = mirrorU ? 0.0f : 1.0f;
+        vertices = {
+            makeVertex(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec2(u0, 1.0f)),
+            makeVertex(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec2(u1, 1.0f)),
+            makeVertex(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(u0, 0.0f)),
+            makeVertex(glm::vec3(1.0f, 0.0f, 1.0f), glm::vec2(u1, 0.0f))
+        };
+        indices = { 0, 2, 1, 1, 2, 3 };
+    }
+}
+
+TEST(MeshProcessingTest, HardEdgesBelowCreaseAngle) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildCube(vertices, indices);
+
+    MeshProcessing::generateNormals(vertices, indices, 30.0f);
+
+    // Every cube corner splits into one vertex per adjacent face
+    EXPECT_EQ(vertices.size(), 24u);
+    ASSERT_EQ(indices.size(), 36u);
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+        const glm::vec3& p0 = vertices[indices[3 * t]].position;
+        const glm::vec3& p1 = vertices[indices[3 * t + 1]].position;
+        const glm::vec3& p2 = vertices[indices[3 * t + 2]].position;
+        glm::vec3 faceNormal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+        for (int k = 0; k < 3; ++k) {
+            EXPECT_NEAR(glm::dot(vertices[indices[3 * t + k]].normal, faceNormal), 1.0f, 1e-5f);
+        }
+    }
+}
+
+TEST(MeshProcessingTest, SmoothAboveCreaseAngle) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildCube(vertices, indices);
+
+    MeshProcessing::generateNormals(vertices, indices, 180.0f);
+
+    // Fully smoothed: corners stay shared and point diagonally outwards
+    EXPECT_EQ(vertices.size(), 8u);
+    for (const auto& vertex : vertices) {
+        glm::vec3 expected = glm::normalize(vertex.position);
+        EXPECT_NEAR(glm::dot(vertex.normal, expected), 1.0f, 1e-5f);
+    }
+}
+
+TEST(MeshProcessingTest, TangentFollowsUDirection) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildQuad(vertices, indices, false);
+    MeshProcessing::generateNormals(vertices, indices);
+    MeshProcessing::generateTangents(vertices, indices);
+
+    for (const auto& vertex : vertices) {
+        EXPECT_NEAR(vertex.normal.y, 1.0f, 1e-5f);
+        EXPECT_NEAR(vertex.tangent.x, 1.0f, 1e-5f);
+        EXPECT_NEAR(glm::dot(glm::vec3(vertex.tangent), vertex.normal), 0.0f, 1e-5f);
+        // bitangent = w * cross(n, t) must follow +V, which runs towards -Z here
+        glm::vec3 bitangent = vertex.tangent.w * glm::cross(vertex.normal, glm::vec3(vertex.tangent));
+        EXPECT_NEAR(bitangent.z, -1.0f, 1e-5f);
+    }
+}
+
+TEST(MeshProcessingTest, MirroredUVsFlipHandedness) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildQuad(vertices, indices, false);
+    MeshProcessing::generateNormals(vertices, indices);
+    MeshProcessing::generateTangents(vertices, indices);
+    float sign = vertices[0].tangent.w;
+
+    buildQuad(vertices, indices, true);
+    MeshProcessing::generateNormals(vertices, indices);
+    MeshProcessing::generateTangents(vertices, indices);
+
+    for (const auto& vertex : vertices) {
+        EXPECT_NEAR(vertex.tangent.x, -1.0f, 1e-5f);
+        EXPECT_EQ(vertex.tangent.w, -sign);
+    }
+}
+
+TEST(MeshProcessingTest, ParallelMatchesSerial) {
+    // Bumpy grid large enough to span several work chunks
+    const int size = 200;
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    for (int z = 0; z <= size; ++z) {
+        for (int x = 0; x <= size; ++x) {
+            float height = ((x * 7 + z * 13) % 5) * 0.1f;
+            vertices.push_back(makeVertex(glm::vec3(x, height, z), glm::vec2(float(x) / size, float(z) / size)));
+        }
+    }
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            uint32_t a = z * (size + 1) + x;
+            indices.insert(indices.end(), { a, a + size + 1, a + 1, a + 1, a + size + 1, a + size + 2 });
+        }
+    }
+
+    std::vector<Vertex> serialVertices = vertices;
+    std::vector<uint32_t> serialIndices = indices;
+    MeshProcessing::generateNormals(serialVertices, serialIndices);
+    MeshProcessing::generateTangents(serialVertices, serialIndices);
+
+    ThreadPool pool(3);
+    MeshProcessing::generateNormals(vertices, indices, MeshProcessing::DEFAULT_CREASE_ANGLE, &pool);
+    MeshProcessing::generateTangents(vertices, indices, &pool);
+
+    ASSERT_EQ(vertices.size(), serialVertices.size());
+    EXPECT_EQ(indices, serialIndices);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        EXPECT_EQ(vertices[i].normal, serialVertices[i].normal);
+        EXPECT_EQ(vertices[i].tangent, serialVertices[i].tangent);
+    }
+}
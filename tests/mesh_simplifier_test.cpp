@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <graphics/mesh_simplifier.h>
+#include <algorithm>
+#include <set>
+
+namespace {
+    // Flat (size x size) grid in the XZ plane. With seamColumn >= 0 the vertices of that
+    // column are duplicated with a different UV, like a texture seam.
+    void buildGrid(int size, int seamColumn, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        vertices.clear();
+        indices.clear();
+        auto vertexIndex = [&](int x, int z) { return static_cast<uint32_t>(z * (size + 1) + x); };
+
+        for (int z = 0; z <= size; ++z) {
+            for (int x = 0; x <= size; ++x) {
+                Vertex vertex{};
+                vertex.position = glm::vec3(x, 0.0f, z);
+                vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+                vertex.texCoord = glm::vec2(float(x) / size, float(z) / size);
+                vertices.push_back(vertex);
+            }
+        }
+
+        std::vector<uint32_t> seamCopy(size + 1);
+        if (seamColumn >= 0) {
+            for (int z = 0; z <= size; ++z) {
+                Vertex vertex = vertices[vertexIndex(seamColumn, z)];
+                vertex.texCoord.x += 0.5f;
+                seamCopy[z] = static_cast<uint32_t>(vertices.size());
+                vertices.push_back(vertex);
+            }
+        }
+
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                uint32_t a = vertexIndex(x, z), b = vertexIndex(x + 1, z);
+                uint32_t c = vertexIndex(x, z + 1), d = vertexIndex(x + 1, z + 1);
+                // Quads right of the seam use the duplicated vertices
+                if (x == seamColumn) {
+                    a = seamCopy[z];
+                    c = seamCopy[z + 1];
+                }
+                indices.insert(indices.end(), { a, c, b, b, c, d });
+            }
+        }
+    }
+
+    std::set<uint32_t> usedVertices(const std::vector<uint32_t>& indices) {
+        return std::set<uint32_t>(indices.begin(), indices.end());
+    }
+}
+
+TEST(MeshSimplifierTest, FlatGridCollapsesWithoutError) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildGrid(20, -1, vertices, indices);
+
+    auto result = MeshSimplifier::simplify(vertices, indices, indices.size() / 10);
+
+    EXPECT_LE(result.indices.size(), indices.size() / 10 + 6);
+    EXPECT_GT(result.indices.size(), 0u);
+    EXPECT_NEAR(result.error, 0.0f, 1e-4f);
+
+    // Border corners never move, so the footprint is preserved
+    std::set<uint32_t> used = usedVertices(result.indices);
+    EXPECT_TRUE(used.count(0));
+    EXPECT_TRUE(used.count(20));
+    EXPECT_TRUE(used.count(21 * 20));
+    EXPECT_TRUE(used.count(21 * 21 - 1));
+}
+
+TEST(MeshSimplifierTest, SeamVerticesAreKept) {
+    const int size = 20;
+    const int seamColumn = 10;
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildGrid(size, seamColumn, vertices, indices);
+
+    auto result = MeshSimplifier::simplify(vertices, indices, indices.size() / 10);
+    EXPECT_LT(result.indices.size(), indices.size() / 2);
+
+    // Both wedges of every seam vertex survive, so the UV discontinuity stays intact
+    std::set<uint32_t> used = usedVertices(result.indices);
+    for (int z = 0; z <= size; ++z) {
+        EXPECT_TRUE(used.count(z * (size + 1) + seamColumn)) << "seam row " << z;
+        EXPECT_TRUE(used.count((size + 1) * (size + 1) + z)) << "seam copy row " << z;
+    }
+}
+
+TEST(MeshSimplifierTest, LodChainIsOrderedAndErrorsGrow) {
+    // Bumpy surface so coarser levels have measurable error
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    buildGrid(32, -1, vertices, indices);
+    for (auto& vertex : vertices) {
+        vertex.position.y = std::sin(vertex.position.x * 0.7f) * std::cos(vertex.position.z * 0.5f);
+    }
+
+    auto levels = MeshSimplifier::buildLodChain(vertices, indices, { 0.1f, 0.5f, 0.25f });
+    ASSERT_EQ(levels.size(), 3u);
+    EXPECT_GT(levels[0].indices.size(), levels[1].indices.size());
+    EXPECT_GT(levels[1].indices.size(), levels[2].indices.size());
+    EXPECT_LE(levels[0].error, levels[1].error);
+    EXPECT_LE(levels[1].error, levels[2].error);
+    EXPECT_GT(levels[2].error, 0.0f);
+}
+
+TEST(MeshSimplifierTest, SelectLodByScreenSpaceError) {
+    std::vector<MeshLod> lods = {
+        { 0, 300, 1.0f, 0.0f },
+        { 300, 150, 0.5f, 0.01f },
+        { 450, 30, 0.1f, 0.1f }
+    };
+    const float projectionScale = 1000.0f;  // ~90 degree FOV at 2000 px
+
+    // Close up only the full mesh stays under one pixel
+    EXPECT_EQ(MeshSimplifier::selectLod(lods, 1.0f, projectionScale, 1.0f), 0u);
+    // 0.01 * 1000 / 20 = 0.5 px, 0.1 * 1000 / 20 = 5 px
+    EXPECT_EQ(MeshSimplifier::selectLod(lods, 20.0f, projectionScale, 1.0f), 1u);
+    EXPECT_EQ(MeshSimplifier::selectLod(lods, 500.0f, projectionScale, 1.0f), 2u);
+}
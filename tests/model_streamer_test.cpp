@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <graphics/model_streamer.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+// Records uploads instead of calling GL so streaming can run without a context
+class RecordingUploader : public ModelUploader {
+public:
+    size_t frameBytes = 0;
+    size_t begins = 0;
+    size_t finishes = 0;
+    size_t vertexBytes = 0;         // Uploaded so far; ranges must follow on from these
+    size_t indexBytes = 0;
+    bool rangesContiguous = true;
+
+    bool begin(Model& model) override { ++begins; vertexBytes = indexBytes = 0; return true; }
+    void uploadVertices(Model& model, size_t byteOffset, size_t byteCount) override {
+        rangesContiguous = rangesContiguous && byteOffset == vertexBytes;
+        vertexBytes += byteCount;
+        frameBytes += byteCount;
+    }
+    void uploadIndices(Model& model, size_t byteOffset, size_t byteCount) override {
+        rangesContiguous = rangesContiguous && byteOffset == indexBytes;
+        indexBytes += byteCount;
+        frameBytes += byteCount;
+    }
+    void finish(Model& model) override { ++finishes; }
+};
+
+class ModelStreamerTest : public ::testing::Test {
+protected:
+    static const int GRID_SIZE = 150;  // 150x150 quads -> 45k triangles
+    std::string objPath;
+    ThreadPool pool{2};
+    RecordingUploader* uploader = nullptr;
+
+    void SetUp() override {
+        objPath = ::testing::TempDir() + "streamer_grid.obj";
+        std::ofstream out(objPath);
+        for (int z = 0; z <= GRID_SIZE; ++z) {
+            for (int x = 0; x <= GRID_SIZE; ++x) {
+                out << "v " << x << " 0 " << z << "\n";
+                out << "vt " << float(x) / GRID_SIZE << " " << float(z) / GRID_SIZE << "\n";
+            }
+        }
+        out << "vn 0 1 0\n";
+        for (int z = 0; z < GRID_SIZE; ++z) {
+            for (int x = 0; x < GRID_SIZE; ++x) {
+                int a = z * (GRID_SIZE + 1) + x + 1;
+                int b = a + 1;
+                int c = a + GRID_SIZE + 1;
+                int d = c + 1;
+                out << "f " << a << "/" << a << "/1 " << c << "/" << c << "/1 " << b << "/" << b << "/1\n";
+                out << "f " << b << "/" << b << "/1 " << c << "/" << c << "/1 " << d << "/" << d << "/1\n";
+            }
+        }
+    }
+
+    void TearDown() override {
+        std::remove(objPath.c_str());
+    }
+
+    std::unique_ptr<ModelUploader> makeUploader() {
+        uploader = new RecordingUploader();
+        return std::unique_ptr<ModelUploader>(uploader);
+    }
+};
+
+TEST_F(ModelStreamerTest, UploadsRespectFrameBudget) {
+    const size_t budget = 64 * 1024;
+    ModelStreamer streamer(pool, budget, makeUploader());
+
+    int callbackCount = 0;
+    std::thread::id callbackThread;
+    auto future = streamer.requestLoad(objPath, "", [&](const ModelStreamer::ModelPtr& model) {
+        ++callbackCount;
+        callbackThread = std::this_thread::get_id();
+    });
+
+    // Bytes the uploader saw per update(), once the parse is done and uploads start
+    std::vector<size_t> uploadFrames;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+        uploader->frameBytes = 0;
+        size_t uploaded = streamer.update();
+        EXPECT_EQ(uploaded, uploader->frameBytes);
+        if (uploader->begins > 0) {
+            uploadFrames.push_back(uploaded);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    auto model = future.get();
+    ASSERT_NE(model, nullptr);
+    EXPECT_EQ(model->getIndices().size(), static_cast<size_t>(GRID_SIZE * GRID_SIZE * 6));
+    EXPECT_EQ(callbackCount, 1);
+    EXPECT_EQ(callbackThread, std::this_thread::get_id());
+    EXPECT_EQ(uploader->begins, 1u);
+    EXPECT_EQ(uploader->finishes, 1u);
+    EXPECT_EQ(streamer.getPendingCount(), 0u);
+
+    // The mesh is larger than one frame's budget: every update() from the first
+    // upload fills the budget exactly, in order, until the remainder
+    size_t totalBytes = model->getVertexDataSize() + model->getIndexDataSize();
+    ASSERT_GT(totalBytes, budget);
+    EXPECT_EQ(streamer.getStats().totalBytesUploaded, totalBytes);
+    EXPECT_EQ(uploader->vertexBytes, model->getVertexDataSize());
+    EXPECT_EQ(uploader->indexBytes, model->getIndexDataSize());
+    EXPECT_TRUE(uploader->rangesContiguous);
+    ASSERT_EQ(uploadFrames.size(), (totalBytes + budget - 1) / budget);
+    for (size_t i = 0; i + 1 < uploadFrames.size(); ++i) {
+        EXPECT_EQ(uploadFrames[i], budget) << "update " << i;
+    }
+    EXPECT_EQ(uploadFrames.back(), totalBytes - (uploadFrames.size() - 1) * budget);
+}
+
+TEST_F(ModelStreamerTest, MissingFileResolvesToNull) {
+    ModelStreamer streamer(pool, ModelStreamer::DEFAULT_UPLOAD_BUDGET, makeUploader());
+
+    bool callbackRan = false;
+    auto future = streamer.requestLoad(objPath + ".missing", "", [&](const ModelStreamer::ModelPtr& model) {
+        callbackRan = true;
+        EXPECT_EQ(model, nullptr);
+    });
+
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        streamer.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(future.get(), nullptr);
+    EXPECT_TRUE(callbackRan);
+    EXPECT_EQ(streamer.getStats().requestsFailed, 1u);
+    EXPECT_EQ(uploader->begins, 0u);
+}
+
+TEST_F(ModelStreamerTest, ConcurrentRequestsAllComplete) {
+    ModelStreamer streamer(pool, 256 * 1024, makeUploader());
+
+    std::vector<std::shared_future<ModelStreamer::ModelPtr>> futures;
+    for (int i = 0; i < 4; ++i) {
+        futures.push_back(streamer.requestLoad(objPath, ""));
+    }
+
+    // Several meshes in the queue still share one frame's budget
+    while (streamer.getPendingCount() > 0) {
+        EXPECT_LE(streamer.update(), streamer.getUploadBudget());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (auto& future : futures) {
+        EXPECT_NE(future.get(), nullptr);
+    }
+    EXPECT_EQ(streamer.getStats().requestsCompleted, 4u);
+    EXPECT_EQ(uploader->finishes, 4u);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <core/bvh.h>
+#include <core/ray.h>
+#include <editor/editor.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+TEST(RayTest, BoxAndTriangleTests) {
+    AABB box(glm::vec3(-1.0f), glm::vec3(1.0f));
+    float t;
+    EXPECT_TRUE(intersectRayAABB(Ray(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f)), box, 100.0f, t));
+    EXPECT_FLOAT_EQ(t, 4.0f);
+    EXPECT_FALSE(intersectRayAABB(Ray(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f)), box, 3.0f, t));
+    EXPECT_FALSE(intersectRayAABB(Ray(glm::vec3(0.0f, 3.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f)), box, 100.0f, t));
+    // Starting inside counts from the origin
+    EXPECT_TRUE(intersectRayAABB(Ray(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f)), box, 100.0f, t));
+    EXPECT_FLOAT_EQ(t, 0.0f);
+
+    glm::vec3 a(-1.0f, -1.0f, 0.0f), b(1.0f, -1.0f, 0.0f), c(0.0f, 1.0f, 0.0f);
+    EXPECT_TRUE(intersectRayTriangle(Ray(glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(0.0f, 0.0f, -2.0f)), a, b, c, t));
+    EXPECT_FLOAT_EQ(t, 1.0f);
+    EXPECT_FALSE(intersectRayTriangle(Ray(glm::vec3(0.9f, 0.9f, 2.0f), glm::vec3(0.0f, 0.0f, -1.0f)), a, b, c, t));
+    EXPECT_FALSE(intersectRayTriangle(Ray(glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(0.0f, 0.0f, 1.0f)), a, b, c, t));
+}
+
+TEST(RayTest, ScreenCenterLooksDownTheView) {
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(1.0f, 2.0f, 2.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Ray ray = Ray::fromScreen(960.0, 540.0, glm::inverse(projection * view), 1920.0f, 1080.0f);
+
+    EXPECT_NEAR(ray.origin.x, 1.0f, 1e-4f);
+    EXPECT_NEAR(ray.origin.y, 2.0f, 1e-4f);
+    EXPECT_NEAR(ray.origin.z, 2.9f, 1e-3f);
+    EXPECT_NEAR(ray.at(1.0f).z, 3.0f - 100.0f, 0.05f);
+    EXPECT_NEAR(ray.direction.x, 0.0f, 1e-3f);
+    EXPECT_NEAR(ray.direction.y, 0.0f, 1e-3f);
+}
+
+// The tree must find exactly what testing every box finds
+TEST(BVHTest, MatchesBruteForce) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 2.0f);
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 2000; ++i) {
+        glm::vec3 center(coordinate(rng), coordinate(rng), coordinate(rng));
+        glm::vec3 half(extent(rng), extent(rng), extent(rng));
+        boxes.push_back(AABB(center - half, center + half));
+    }
+    BVH tree;
+    tree.build(boxes);
+    EXPECT_EQ(tree.getItemCount(), boxes.size());
+
+    int hits = 0;
+    for (int i = 0; i < 500; ++i) {
+        Ray ray(glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)),
+                glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)));
+        uint32_t expected = BVH::NO_ITEM;
+        float expectedT = 10.0f;
+        for (uint32_t item = 0; item < boxes.size(); ++item) {
+            float t;
+            if (intersectRayAABB(ray, boxes[item], expectedT, t) && t < expectedT) {
+                expectedT = t;
+                expected = item;
+            }
+        }
+
+        float t;
+        uint32_t found = tree.raycast(ray, 10.0f, [](uint32_t, float&) { return true; }, t);
+        EXPECT_EQ(found, expected);
+        if (expected != BVH::NO_ITEM) {
+            EXPECT_FLOAT_EQ(t, expectedT);
+            ++hits;
+        }
+    }
+    EXPECT_GT(hits, 100);
+}
+
+TEST(BVHTest, RefitFollowsMovedBoxes) {
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 100; ++i) {
+        glm::vec3 center(static_cast<float>(i) * 3.0f, 0.0f, 0.0f);
+        boxes.push_back(AABB(center - glm::vec3(1.0f), center + glm::vec3(1.0f)));
+    }
+    BVH tree;
+    tree.build(boxes);
+    auto acceptBox = [](uint32_t, float&) { return true; };
+    Ray down(glm::vec3(150.0f, 10.0f, 0.0f), glm::vec3(0.0f, -20.0f, 0.0f));
+    float t;
+    EXPECT_EQ(tree.raycast(down, 1.0f, acceptBox, t), 50u);
+
+    // Box 7 moves from x = 21 to right above box 50
+    boxes[7] = AABB(glm::vec3(149.0f, 4.0f, -1.0f), glm::vec3(151.0f, 6.0f, 1.0f));
+    tree.refit(boxes);
+    EXPECT_EQ(tree.raycast(down, 1.0f, acceptBox, t), 7u);
+    EXPECT_FLOAT_EQ(t, 0.2f);
+    EXPECT_EQ(tree.raycast(Ray(glm::vec3(21.0f, 10.0f, 0.0f), glm::vec3(0.0f, -20.0f, 0.0f)), 1.0f, acceptBox, t),
+              BVH::NO_ITEM);
+}
+
+TEST(BVHTest, EmptyTreeMisses) {
+    BVH tree;
+    tree.build(std::vector<AABB>{ AABB() });
+    float t;
+    EXPECT_EQ(tree.raycast(Ray(glm::vec3(0.0f), glm::vec3(1.0f)), 1.0f, [](uint32_t, float&) { return true; }, t),
+              BVH::NO_ITEM);
+}
+
+class PickingTest : public ::testing::Test {
+protected:
+    Editor::WorldEditor editor;
+    // From the origin down -z, far enough to reach everything below
+    Ray forward = Ray(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, -100.0f));
+};
+
+TEST_F(PickingTest, NearestObjectAndSurfacePoint) {
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(0.0f, 1.0f, -20.0f), glm::vec3(2.0f, 2.0f, 0.2f));
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(0.0f, 1.0f, -10.0f), glm::vec3(2.0f, 2.0f, 0.2f));
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(5.0f, 1.0f, -5.0f), glm::vec3(2.0f, 2.0f, 0.2f));
+
+    Editor::PickHit hit;
+    ASSERT_TRUE(editor.pick(forward, 1.0f, hit));
+    EXPECT_EQ(hit.objectIndex, 1u);
+    EXPECT_NEAR(hit.point.z, -9.9f, 1e-4f);
+    EXPECT_NEAR(hit.distance, 0.099f, 1e-6f);
+
+    // Too short to reach it
+    EXPECT_FALSE(editor.pick(forward, 0.05f, hit));
+}
+
+TEST_F(PickingTest, TrianglesDecideInsideBounds) {
+    // Only the top and bottom of a rectangle are geometry; the ray passes between them
+    editor.addObject(Editor::ObjectType::RECTANGLE, glm::vec3(0.0f, 1.0f, -5.0f), glm::vec3(2.0f, 2.0f, 2.0f));
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(0.0f, 1.0f, -10.0f), glm::vec3(2.0f, 2.0f, 0.2f));
+
+    Editor::PickHit hit;
+    ASSERT_TRUE(editor.pick(forward, 1.0f, hit, false));
+    EXPECT_EQ(hit.objectIndex, 0u);
+    EXPECT_NEAR(hit.point.z, -4.0f, 1e-4f);
+
+    ASSERT_TRUE(editor.pick(forward, 1.0f, hit));
+    EXPECT_EQ(hit.objectIndex, 1u);
+}
+
+TEST_F(PickingTest, FollowsEdits) {
+    Editor::PickHit hit;
+    EXPECT_FALSE(editor.pick(forward, 1.0f, hit));
+
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(0.0f, 1.0f, -10.0f), glm::vec3(2.0f, 2.0f, 0.2f));
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(0.0f, 1.0f, -30.0f), glm::vec3(2.0f, 2.0f, 0.2f));
+    ASSERT_TRUE(editor.pick(forward, 1.0f, hit));
+    EXPECT_EQ(hit.objectIndex, 0u);
+
+    // Moved out of the way
+    editor.setObjectPosition(0, glm::vec3(10.0f, 1.0f, -10.0f));
+    ASSERT_TRUE(editor.pick(forward, 1.0f, hit));
+    EXPECT_EQ(hit.objectIndex, 1u);
+
+    // Grown into the ray again
+    editor.selectObject(0);
+    editor.resizeSelectedObject(glm::vec3(30.0f, 2.0f, 0.2f));
+    ASSERT_TRUE(editor.pick(forward, 1.0f, hit));
+    EXPECT_EQ(hit.objectIndex, 0u);
+
+    editor.removeObject(0);
+    ASSERT_TRUE(editor.pick(forward, 1.0f, hit));
+    EXPECT_EQ(hit.objectIndex, 0u);
+    EXPECT_NEAR(hit.point.z, -29.9f, 1e-3f);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <editor/editor.h>
+#include <algorithm>
+#include <cmath>
+
+class ProceduralMeshTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        cache().clear();
+        cache().resetStats();
+    }
+
+    static Editor::ProceduralMeshCache& cache() { return Editor::ProceduralMeshCache::instance(); }
+};
+
+TEST_F(ProceduralMeshTest, IdenticalHousesShareOneMesh) {
+    Editor::WorldEditor editor;
+    const size_t houseCount = 10000;
+    for (size_t i = 0; i < houseCount; ++i) {
+        editor.addObject(Editor::ObjectType::HOUSE, glm::vec3(float(i % 100) * 3.0f, 0.0f, float(i / 100) * 3.0f), glm::vec3(2.0f));
+    }
+
+    const Editor::ProceduralMesh* shared = nullptr;
+    for (const auto& house : editor.getObjects()) {
+        ASSERT_TRUE(house->isPredefined());
+        auto mesh = house->getMesh();
+        if (!shared) shared = mesh.get();
+        EXPECT_EQ(mesh.get(), shared);
+    }
+
+    Editor::ProceduralMeshCache::Stats stats = cache().getStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, houseCount - 1);
+    EXPECT_GE(stats.hitRate(), 0.9999);
+    EXPECT_EQ(cache().size(), 1u);
+
+    // Asking again is served by the store without touching the cache
+    for (const auto& obj : editor.getObjects()) {
+        obj->getMesh();
+    }
+    EXPECT_EQ(cache().getStats().hits, houseCount - 1);
+}
+
+TEST_F(ProceduralMeshTest, SettersInvalidateTheBakedMesh) {
+    Editor::PredefinedObject house(Editor::ObjectType::HOUSE, glm::vec3(0.0f), glm::vec3(1.0f));
+    Editor::PredefinedObject twin(Editor::ObjectType::HOUSE, glm::vec3(5.0f), glm::vec3(1.0f));
+    auto original = house.getMesh();
+    EXPECT_EQ(twin.getMesh(), original);
+
+    // Same value keeps the mesh
+    house.setRoofHeight(house.getRoofHeight());
+    EXPECT_EQ(house.getMesh(), original);
+
+    house.setWindowCount(4);
+    auto fourWindows = house.getMesh();
+    EXPECT_NE(fourWindows, original);
+    EXPECT_GT(fourWindows->getIndices().size(), original->getIndices().size());
+    EXPECT_EQ(twin.getMesh(), original);
+
+    // Wall thickness is not part of the geometry
+    house.setWallThickness(0.5f);
+    EXPECT_EQ(house.getMesh(), fourWindows);
+    house.setDoorWidth(0.4f);
+    house.setRoofHeight(2.0f);
+    // Nothing is baked until the mesh is asked for
+    EXPECT_EQ(cache().getStats().misses, 2u);
+
+    // Back to the twin's parameters finds the twin's mesh again
+    house.setWindowCount(twin.getWindowCount());
+    house.setWallThickness(twin.getWallThickness());
+    house.setDoorWidth(twin.getDoorWidth());
+    house.setRoofHeight(twin.getRoofHeight());
+    EXPECT_EQ(house.getMesh(), original);
+}
+
+TEST_F(ProceduralMeshTest, GeometryMatchesParameters) {
+    Editor::PredefinedObject house(Editor::ObjectType::HOUSE, glm::vec3(0.0f), glm::vec3(1.0f));
+    house.setRoofHeight(1.5f);
+    house.setWindowCount(3);
+    auto mesh = house.getMesh();
+
+    // Two body quads, then two roof triangles, three windows and the door
+    EXPECT_EQ(mesh->getBodyIndexCount(), 12u);
+    EXPECT_EQ(mesh->getIndices().size(), 12u + 6u + 3u * 6u + 6u);
+
+    float apex = -1.0f;
+    for (const auto& vertex : mesh->getVertices()) {
+        apex = std::max(apex, vertex.position.y);
+    }
+    EXPECT_FLOAT_EQ(apex, 2.0f);
+
+    // A single tower window no longer divides by zero
+    Editor::PredefinedObject tower(Editor::ObjectType::TOWER, glm::vec3(0.0f), glm::vec3(1.0f));
+    tower.setWindowCount(1);
+    for (const auto& vertex : tower.getMesh()->getVertices()) {
+        EXPECT_TRUE(std::isfinite(vertex.position.y));
+    }
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <core/profiler.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Profiler is a process-wide singleton; each test starts from an empty buffer
+    class ProfilerTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            Profiler::instance().setEnabled(true);
+            Profiler::instance().clear();
+        }
+
+        std::vector<Profiler::ThreadTimeline> collectAll() {
+            std::vector<Profiler::ThreadTimeline> timelines;
+            Profiler::instance().collect(0, UINT64_MAX, timelines);
+            return timelines;
+        }
+
+        const Profiler::ThreadTimeline* findThread(const std::vector<Profiler::ThreadTimeline>& timelines,
+                                                   const std::string& name) {
+            for (const Profiler::ThreadTimeline& timeline : timelines) {
+                if (timeline.name == name) return &timeline;
+            }
+            return nullptr;
+        }
+    };
+}
+
+TEST_F(ProfilerTest, NestedScopesRecordDepthAndContainment) {
+    Profiler::instance().setThreadName("Test main");
+    {
+        ProfileScope outer("Outer");
+        {
+            ProfileScope inner("Inner");
+        }
+        {
+            ProfileScope inner("Inner 2");
+        }
+    }
+
+    auto timelines = collectAll();
+    const Profiler::ThreadTimeline* main = findThread(timelines, "Test main");
+    ASSERT_NE(main, nullptr);
+    ASSERT_EQ(main->events.size(), 3u);
+
+    // Recorded on close, so children come first
+    const ProfileEvent& inner = main->events[0];
+    const ProfileEvent& inner2 = main->events[1];
+    const ProfileEvent& outer = main->events[2];
+    EXPECT_STREQ(outer.name, "Outer");
+    EXPECT_EQ(outer.depth, 0u);
+    EXPECT_EQ(inner.depth, 1u);
+    EXPECT_EQ(inner2.depth, 1u);
+    EXPECT_LE(outer.start, inner.start);
+    EXPECT_LE(inner.end, inner2.start);
+    EXPECT_LE(inner2.end, outer.end);
+    EXPECT_EQ(Profiler::threadDepth(), 0u);
+}
+
+TEST_F(ProfilerTest, DisabledScopesRecordNothing) {
+    Profiler::instance().setEnabled(false);
+    {
+        ProfileScope scope("Ignored");
+    }
+    Profiler::instance().setEnabled(true);
+
+    for (const Profiler::ThreadTimeline& timeline : collectAll()) {
+        EXPECT_TRUE(timeline.events.empty());
+    }
+}
+
+TEST_F(ProfilerTest, EachThreadGetsItsOwnTimeline) {
+    const int threadCount = 4;
+    const int scopesPerThread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([t] {
+            Profiler::instance().setThreadName("Worker " + std::to_string(t));
+            for (int i = 0; i < scopesPerThread; ++i) {
+                ProfileScope scope("Work");
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    auto timelines = collectAll();
+    for (int t = 0; t < threadCount; ++t) {
+        const Profiler::ThreadTimeline* worker = findThread(timelines, "Worker " + std::to_string(t));
+        ASSERT_NE(worker, nullptr);
+        EXPECT_EQ(worker->events.size(), static_cast<size_t>(scopesPerThread));
+    }
+}
+
+TEST_F(ProfilerTest, RingKeepsTheNewestEvents) {
+    Profiler::instance().setThreadName("Test main");
+    const uint32_t extra = 100;
+    for (uint32_t i = 0; i < Profiler::EVENTS_PER_THREAD + extra; ++i) {
+        Profiler::instance().record("Tick", i, i + 1, 0);
+    }
+
+    auto timelines = collectAll();
+    const Profiler::ThreadTimeline* main = findThread(timelines, "Test main");
+    ASSERT_NE(main, nullptr);
+    ASSERT_EQ(main->events.size(), static_cast<size_t>(Profiler::EVENTS_PER_THREAD));
+    EXPECT_EQ(main->events.front().start, extra);
+    EXPECT_EQ(main->events.back().start, Profiler::EVENTS_PER_THREAD + extra - 1);
+}
+
+TEST_F(ProfilerTest, CollectKeepsEventsOverlappingTheRange) {
+    Profiler::instance().setThreadName("Test main");
+    Profiler::instance().record("Before", 10, 20, 0);
+    Profiler::instance().record("Straddles", 25, 35, 0);
+    Profiler::instance().record("Inside", 32, 38, 1);
+    Profiler::instance().record("After", 40, 50, 0);
+
+    std::vector<Profiler::ThreadTimeline> timelines;
+    Profiler::instance().collect(30, 40, timelines);
+    const Profiler::ThreadTimeline* main = findThread(timelines, "Test main");
+    ASSERT_NE(main, nullptr);
+    ASSERT_EQ(main->events.size(), 2u);
+    EXPECT_STREQ(main->events[0].name, "Straddles");
+    EXPECT_STREQ(main->events[1].name, "Inside");
+}
+
+TEST_F(ProfilerTest, TicksConvertToWallClockTime) {
+    uint64_t start = Profiler::now();
+    auto wallStart = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t end = Profiler::now();
+    double wallUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - wallStart).count();
+
+    EXPECT_NEAR(Profiler::instance().ticksToMicroseconds(end - start), wallUs, wallUs * 0.05);
+}
+
+TEST_F(ProfilerTest, ChromeTraceHasCompleteEventsAndThreadNames) {
+    Profiler::instance().setThreadName("Render \"main\"");
+    {
+        ProfileScope scope("Scene draw");
+    }
+
+    std::string trace = Profiler::instance().toChromeTrace();
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+    EXPECT_NE(trace.find("\"name\":\"Scene draw\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"M\""), std::string::npos);
+    EXPECT_NE(trace.find("Render \\\"main\\\""), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <editor/editor.h>
+#include <editor/scene_file.h>
+#include <glm/glm.hpp>
+#include <cstdio>
+#include <cstring>
+
+using Editor::ObjectType;
+using Editor::SceneFile;
+using Editor::WorldEditor;
+
+namespace {
+    WorldEditor sampleScene() {
+        WorldEditor editor;
+        editor.addObject(ObjectType::TOWER, glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(3.0f));
+        editor.addObject(ObjectType::WALL, glm::vec3(12.0f, 0.0f, 1.0f), glm::vec3(1.0f, 2.0f, 0.1f));
+        editor.addObject(ObjectType::HOUSE, glm::vec3(-4.0f, 0.0f, 2.0f), glm::vec3(5.0f));
+        editor.addObject(ObjectType::RECTANGLE, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(2.0f));
+        editor.selectObject(2);
+        editor.setSelectedObjectColor(glm::vec3(0.1f, 0.2f, 0.3f));
+        editor.setSelectedObjectWindowCount(7);
+        editor.setSelectedObjectDoorWidth(1.5f);
+        // The wall hangs off the tower, which sits in a later section
+        editor.setObjectParent(1, 0);
+        return editor;
+    }
+
+    // Same objects in the same order
+    void expectSameScene(WorldEditor& a, WorldEditor& b) {
+        ASSERT_EQ(a.getObjects().size(), b.getObjects().size());
+        for (size_t i = 0; i < a.getObjects().size(); ++i) {
+            const auto& expected = *a.getObjects()[i];
+            const auto& actual = *b.getObjects()[i];
+            EXPECT_EQ(actual.getType(), expected.getType()) << "object " << i;
+            EXPECT_EQ(actual.getPosition(), expected.getPosition()) << "object " << i;
+            EXPECT_EQ(actual.getSize(), expected.getSize()) << "object " << i;
+            EXPECT_EQ(actual.getColor(), expected.getColor()) << "object " << i;
+            EXPECT_EQ(actual.getMeshKey(), expected.getMeshKey()) << "object " << i;
+            EXPECT_EQ(b.getObjectWorldPosition(i), a.getObjectWorldPosition(i)) << "object " << i;
+        }
+    }
+}
+
+TEST(SceneFileTest, RoundTripsThroughMemory) {
+    WorldEditor editor = sampleScene();
+    std::vector<uint8_t> bytes = SceneFile::serialize(editor);
+
+    SceneFile file;
+    ASSERT_TRUE(file.view(bytes.data(), bytes.size()));
+    EXPECT_EQ(file.getObjectCount(), 4u);
+    ASSERT_EQ(file.getSections().size(), 4u);
+    // Sections in type order, predefined ones with their parameters
+    EXPECT_STREQ(file.getSections()[0].name, "Wall");
+    EXPECT_EQ(file.getSections()[0].params, nullptr);
+    const SceneFile::Section& house = file.getSections()[2];
+    EXPECT_STREQ(house.name, "House");
+    ASSERT_NE(house.params, nullptr);
+    EXPECT_EQ(house.params[0].windowCount, 7);
+    EXPECT_EQ(file.getSections()[0].objects[0].index, 1u);
+    EXPECT_EQ(file.getSections()[0].objects[0].parent, 0u);
+
+    WorldEditor loaded;
+    loaded.addObject(ObjectType::WALL, glm::vec3(100.0f), glm::vec3(1.0f));
+    loaded.loadScene(file);
+    expectSameScene(editor, loaded);
+    EXPECT_EQ(loaded.getJournal().getUndoCount(), 0u);
+}
+
+TEST(SceneFileTest, SaveAndLoadFile) {
+    std::string path = ::testing::TempDir() + "scene_file_test.scene";
+    WorldEditor editor = sampleScene();
+    ASSERT_TRUE(editor.saveScene(path));
+
+    WorldEditor loaded;
+    ASSERT_TRUE(loaded.loadScene(path));
+    expectSameScene(editor, loaded);
+
+    // Loaded parents still carry their children
+    loaded.setObjectPosition(0, glm::vec3(20.0f, 0.0f, 0.0f));
+    EXPECT_EQ(loaded.getObjectWorldPosition(1), glm::vec3(22.0f, 0.0f, 1.0f));
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(loaded.loadScene(path));
+}
+
+// Saving goes to a new file renamed over the old one: a reader of the old
+// scene is undisturbed, and nothing is left behind
+TEST(SceneFileTest, SaveReplacesTheSceneWhole) {
+    std::string path = ::testing::TempDir() + "scene_file_test_replace.scene";
+    WorldEditor editor = sampleScene();
+    ASSERT_TRUE(editor.saveScene(path));
+    SceneFile previous;
+    ASSERT_TRUE(previous.open(path));
+
+    WorldEditor emptied;
+    ASSERT_TRUE(emptied.saveScene(path));
+    EXPECT_EQ(previous.getObjectCount(), 4u);
+    EXPECT_EQ(previous.getSections()[0].objects[0].parent, 0u);
+    WorldEditor loaded;
+    ASSERT_TRUE(loaded.loadScene(path));
+    EXPECT_EQ(loaded.getObjects().size(), 0u);
+    EXPECT_EQ(std::fopen((path + ".tmp").c_str(), "rb"), nullptr);
+
+    // A save that cannot be written leaves the scene as it was
+    EXPECT_FALSE(editor.saveScene(::testing::TempDir() + "missing_directory/scene"));
+    std::remove(path.c_str());
+}
+
+TEST(SceneFileTest, EmptySceneRoundTrips) {
+    WorldEditor editor;
+    std::vector<uint8_t> bytes = SceneFile::serialize(editor);
+    SceneFile file;
+    ASSERT_TRUE(file.view(bytes.data(), bytes.size()));
+    EXPECT_EQ(file.getObjectCount(), 0u);
+    EXPECT_TRUE(file.getSections().empty());
+}
+
+TEST(SceneFileTest, RejectsDamagedData) {
+    WorldEditor editor = sampleScene();
+    std::vector<uint8_t> bytes = SceneFile::serialize(editor);
+    SceneFile file;
+
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 8);
+    EXPECT_FALSE(file.view(truncated.data(), truncated.size()));
+    EXPECT_FALSE(file.isOpen());
+
+    std::vector<uint8_t> badMagic = bytes;
+    badMagic[0] = 'X';
+    EXPECT_FALSE(file.view(badMagic.data(), badMagic.size()));
+
+    std::vector<uint8_t> badVersion = bytes;
+    badVersion[4] = 99;
+    EXPECT_FALSE(file.view(badVersion.data(), badVersion.size()));
+
+    // A section claiming more records than the file holds
+    std::vector<uint8_t> hugeCount = bytes;
+    uint32_t count = 0x10000000u;
+    std::memcpy(hugeCount.data() + sizeof(Editor::SceneFileHeader) + 8, &count, sizeof(count));
+    EXPECT_FALSE(file.view(hugeCount.data(), hugeCount.size()));
+
+    EXPECT_TRUE(file.view(bytes.data(), bytes.size()));
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <core/frame_snapshot.h>
+#include <editor/editor.h>
+#include <graphics/snapshot_renderer.h>
+
+namespace {
+    // size x size grid of walls spaced 4 units apart, 8 per 32-unit batching cell
+    void buildWallGrid(Editor::WorldEditor& editor, int size) {
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                editor.addObject(Editor::ObjectType::WALL, glm::vec3(x * 4.0f + 1.0f, 0.0f, z * 4.0f + 1.0f), glm::vec3(1.0f, 2.0f, 0.1f));
+            }
+        }
+    }
+
+    // What the render thread does with each new frame on the fallback path
+    size_t updateBatches(const Editor::WorldEditor& editor, SnapshotRenderer& renderer) {
+        FrameSnapshot snapshot;
+        editor.captureSnapshot(snapshot);
+        return renderer.updateStaticBatches(snapshot);
+    }
+}
+
+TEST(StaticBatcherTest, BatchesRespectTriangleCap) {
+    Editor::StaticBatcher batcher(1000.0f, 100);
+    std::vector<std::unique_ptr<Editor::Wall>> walls;
+    for (int i = 0; i < 100; ++i) {
+        walls.emplace_back(new Editor::Wall(glm::vec3(float(i), 0.0f, 0.0f), glm::vec3(1.0f)));
+        glm::mat4 world(1.0f);
+        world[3] = glm::vec4(walls.back()->getPosition(), 1.0f);
+        Editor::BatchObject object{ walls.back()->getMesh(), walls.back()->getSize(), walls.back()->getColor() };
+        batcher.addObject(static_cast<uint32_t>(i), object, world);
+    }
+
+    // 100 walls of 4 triangles in one cell, at most 100 triangles per batch
+    EXPECT_EQ(batcher.rebuildDirty(), 4u);
+    Editor::StaticBatcher::Stats stats = batcher.getStats();
+    EXPECT_EQ(stats.objects, 100u);
+    EXPECT_EQ(stats.batches, 4u);
+    EXPECT_EQ(stats.triangles, 400u);
+    EXPECT_EQ(batcher.getDrawCallCount(), 4u);
+
+    // Removed keys leave the table and can be used again
+    batcher.removeObject(7);
+    batcher.removeObject(7);
+    batcher.removeObject(1000);
+    EXPECT_FALSE(batcher.contains(7));
+    EXPECT_FALSE(batcher.contains(1000));
+    EXPECT_EQ(batcher.getStats().objects, 99u);
+    glm::mat4 world(1.0f);
+    batcher.addObject(7, Editor::BatchObject{ walls[0]->getMesh(), glm::vec3(1.0f), glm::vec3(1.0f) }, world);
+    batcher.addObject(7, Editor::BatchObject{ walls[0]->getMesh(), glm::vec3(1.0f), glm::vec3(1.0f) }, world);
+    EXPECT_TRUE(batcher.contains(7));
+    EXPECT_EQ(batcher.getStats().objects, 100u);
+}
+
+// Counts come from what each member was batched with, and a member whose new
+// mesh overflows its batch moves out instead of stretching it past the cap
+TEST(StaticBatcherTest, UpdatesStayWithinTriangleCap) {
+    Editor::StaticBatcher batcher(1000.0f, 100);
+    Editor::Wall wall(glm::vec3(0.0f), glm::vec3(1.0f));
+    Editor::PredefinedObject tower(Editor::ObjectType::TOWER, glm::vec3(0.0f), glm::vec3(1.0f));
+    Editor::BatchObject wallObject{ wall.getMesh(), wall.getSize(), wall.getColor() };
+    Editor::BatchObject towerObject{ tower.getMesh(), tower.getSize(), tower.getColor() };
+    size_t wallTriangles = wall.getMesh()->getTriangleCount();
+    size_t towerTriangles = tower.getMesh()->getTriangleCount();
+    ASSERT_EQ(wallTriangles, 4u);
+    ASSERT_LE(towerTriangles, 100u);
+    for (uint32_t key = 0; key < 25; ++key) {
+        batcher.addObject(key, wallObject, glm::mat4(1.0f));
+    }
+    batcher.rebuildDirty();
+    ASSERT_EQ(batcher.getStats().batches, 1u);
+
+    batcher.updateObject(3, towerObject);
+    EXPECT_EQ(batcher.getStats().batches, 2u);
+    EXPECT_EQ(batcher.getStats().triangles, 24 * wallTriangles + towerTriangles);
+    EXPECT_EQ(batcher.rebuildDirty(), 2u);
+    EXPECT_EQ(batcher.getStats().triangles, 24 * wallTriangles + towerTriangles);
+
+    // Back to a wall fits where it now is; removing takes off what it added
+    batcher.updateObject(3, wallObject);
+    EXPECT_EQ(batcher.getStats().triangles, 25 * wallTriangles);
+    batcher.removeObject(3);
+    batcher.removeObject(4);
+    EXPECT_EQ(batcher.getStats().triangles, 23 * wallTriangles);
+    batcher.rebuildDirty();
+    EXPECT_EQ(batcher.getStats().triangles, 23 * wallTriangles);
+    EXPECT_EQ(batcher.getStats().objects, 23u);
+}
+
+TEST(StaticBatcherTest, EditsOnlyRebuildTouchedBatches) {
+    Editor::WorldEditor editor;
+    SnapshotRenderer renderer;
+    buildWallGrid(editor, 40);
+
+    size_t initial = updateBatches(editor, renderer);
+    EXPECT_EQ(initial, renderer.getStaticBatcher().getDrawCallCount());
+    // 1600 walls in 5x5 cells
+    EXPECT_EQ(renderer.getStaticBatcher().getDrawCallCount(), 25u);
+    EXPECT_EQ(updateBatches(editor, renderer), 0u);
+
+    // Moving inside the cell touches one batch, across a cell border two
+    editor.selectObject(0);
+    editor.moveSelectedObject(glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(updateBatches(editor, renderer), 1u);
+    editor.moveSelectedObject(glm::vec3(40.0f, 0.0f, 0.0f));
+    EXPECT_EQ(updateBatches(editor, renderer), 2u);
+
+    editor.selectObject(100);
+    editor.setSelectedObjectColor(glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(updateBatches(editor, renderer), 1u);
+
+    // The last object fills the removed one's index but keeps its key
+    editor.removeObject(500);
+    EXPECT_EQ(updateBatches(editor, renderer), 1u);
+    EXPECT_EQ(renderer.getStaticBatcher().getStats().objects, 1599u);
+
+    editor.addObject(Editor::ObjectType::HOUSE, glm::vec3(5.0f, 0.0f, 5.0f), glm::vec3(2.0f));
+    EXPECT_EQ(updateBatches(editor, renderer), 1u);
+    EXPECT_EQ(renderer.getStaticBatcher().getStats().objects, 1600u);
+
+    // Resizing and reshaping rebuild the object's batch too
+    editor.resizeSelectedObject(glm::vec3(3.0f));
+    EXPECT_EQ(updateBatches(editor, renderer), 1u);
+    editor.setSelectedObjectWindowCount(5);
+    EXPECT_EQ(updateBatches(editor, renderer), 1u);
+}
+
+TEST(StaticBatcherTest, ChildrenFollowParentIntoBatches) {
+    Editor::WorldEditor editor;
+    SnapshotRenderer renderer;
+    editor.addObject(Editor::ObjectType::HOUSE, glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(1.0f));
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(100.0f, 0.0f, 100.0f), glm::vec3(1.0f));
+    ASSERT_TRUE(editor.setObjectParent(1, 0));
+    updateBatches(editor, renderer);
+    EXPECT_EQ(renderer.getStaticBatcher().getDrawCallCount(), 2u);
+
+    // Moving the house drags the wall along; both batches are rebuilt
+    editor.selectObject(0);
+    editor.moveSelectedObject(glm::vec3(2.0f, 0.0f, 0.0f));
+    EXPECT_EQ(updateBatches(editor, renderer), 2u);
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <core/transform_batch.h>
+#include <core/transform_hierarchy.h>
+#include <core/thread_pool.h>
+#include <random>
+
+namespace {
+    // Every object gets its own bounds; every eleventh has none
+    TransformSoA randomTransforms(size_t count) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.1f, 5.0f);
+
+        TransformSoA transforms;
+        for (size_t i = 0; i < count; ++i) {
+            glm::vec3 axis = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 0.01f, 0.0f));
+            transforms.push(glm::vec3(position(rng), position(rng), position(rng)),
+                            glm::angleAxis(unit(rng) * 3.14159f, axis),
+                            glm::vec3(scale(rng), scale(rng), scale(rng)));
+            glm::vec3 center(unit(rng), unit(rng), unit(rng));
+            glm::vec3 half(scale(rng), scale(rng), scale(rng));
+            transforms.setBounds(i, i % 11 == 0 ? AABB() : AABB(center - half, center + half));
+        }
+        return transforms;
+    }
+
+    void expectMatrixNear(const glm::mat4& a, const glm::mat4& b, float tolerance = 1e-4f) {
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                EXPECT_NEAR(a[c][r], b[c][r], tolerance) << "column " << c << " row " << r;
+            }
+        }
+    }
+
+    void expectBoundsNear(const AABB& a, const AABB& b, float tolerance) {
+        ASSERT_EQ(a.isEmpty(), b.isEmpty());
+        if (a.isEmpty()) return;
+        for (int axis = 0; axis < 3; ++axis) {
+            EXPECT_NEAR(a.min[axis], b.min[axis], tolerance);
+            EXPECT_NEAR(a.max[axis], b.max[axis], tolerance);
+        }
+    }
+}
+
+TEST(TransformBatchTest, MatchesScalarReference) {
+    // Odd count so both the SIMD blocks and the scalar tail run. The second
+    // half hangs off the first, with a third of the objects left unchanged.
+    const size_t count = 1003;
+    const size_t roots = count / 2;
+    TransformSoA transforms = randomTransforms(count);
+    std::vector<uint32_t> parents(count, TransformBatch::NO_PARENT);
+    std::vector<uint8_t> changed(count, 1);
+    for (size_t i = roots; i < count; ++i) {
+        if (i % 5 != 0) parents[i] = static_cast<uint32_t>((i * 7) % roots);
+        if (i % 3 == 0) changed[i] = 0;
+    }
+
+    std::vector<glm::mat4> simdMatrices(count, glm::mat4(2.0f)), scalarMatrices(count, glm::mat4(2.0f));
+    std::vector<AABB> simdBounds(count), scalarBounds(count);
+    TransformBatchData simd{ &transforms, parents.data(), changed.data(), simdMatrices.data(), simdBounds.data() };
+    TransformBatchData scalar{ &transforms, parents.data(), changed.data(), scalarMatrices.data(), scalarBounds.data() };
+    TransformBatch::computeRange(simd, 0, roots);
+    TransformBatch::computeRange(simd, roots, count);
+    TransformBatch::computeRangeScalar(scalar, 0, roots);
+    TransformBatch::computeRangeScalar(scalar, roots, count);
+
+    for (size_t i = 0; i < count; ++i) {
+        expectMatrixNear(simdMatrices[i], scalarMatrices[i], 1e-2f);
+        expectBoundsNear(simdBounds[i], scalarBounds[i], 1e-2f);
+        if (!changed[i]) expectMatrixNear(simdMatrices[i], glm::mat4(2.0f));
+    }
+}
+
+TEST(TransformBatchTest, BoundsContainTransformedCorners) {
+    const size_t count = 64;
+    TransformSoA transforms = randomTransforms(count);
+
+    std::vector<glm::mat4> matrices(count);
+    std::vector<AABB> bounds(count);
+    TransformBatchData data{ &transforms, nullptr, nullptr, matrices.data(), bounds.data() };
+    TransformBatch::computeRange(data, 0, count);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 11 == 0) {
+            EXPECT_TRUE(bounds[i].isEmpty()) << "object " << i;
+            continue;
+        }
+        glm::vec3 center(transforms.boundsCenterX[i], transforms.boundsCenterY[i], transforms.boundsCenterZ[i]);
+        glm::vec3 half(transforms.boundsHalfX[i], transforms.boundsHalfY[i], transforms.boundsHalfZ[i]);
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec3 sign((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f);
+            glm::vec3 world(matrices[i] * glm::vec4(center + sign * half, 1.0f));
+            AABB padded(bounds[i].min - glm::vec3(1e-3f), bounds[i].max + glm::vec3(1e-3f));
+            EXPECT_TRUE(padded.contains(world)) << "object " << i << " corner " << corner;
+        }
+    }
+}
+
+TEST(TransformBatchTest, ParallelHierarchyMatchesSerial) {
+    // Wide levels, so the pool gets several ranges per level
+    const size_t rootCount = 3 * TransformHierarchy::PARALLEL_GRAIN + 5;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    ThreadPool pool(3);
+
+    TransformHierarchy serial, parallel;
+    parallel.setThreadPool(&pool);
+    std::vector<TransformId> nodes;
+    for (size_t i = 0; i < 2 * rootCount; ++i) {
+        TransformId parent = i < rootCount ? INVALID_TRANSFORM : nodes[i % rootCount];
+        glm::vec3 position(unit(rng) * 50.0f, unit(rng) * 50.0f, unit(rng) * 50.0f);
+        glm::quat rotation = glm::angleAxis(unit(rng) * 3.14159f, glm::vec3(0.0f, 1.0f, 0.0f));
+        AABB bounds(glm::vec3(-0.5f), glm::vec3(0.5f, unit(rng) + 2.0f, 0.5f));
+        for (TransformHierarchy* h : { &serial, &parallel }) {
+            TransformId node = h->createNode(parent);
+            h->setLocalPosition(node, position);
+            h->setLocalRotation(node, rotation);
+            h->setLocalBounds(node, bounds);
+            if (h == &serial) nodes.push_back(node);
+        }
+    }
+
+    EXPECT_EQ(serial.updateWorldMatrices(), 2 * rootCount);
+    EXPECT_EQ(parallel.updateWorldMatrices(), 2 * rootCount);
+
+    // Moving a few roots recomputes just them and their children
+    for (size_t i = 0; i < rootCount; i += 1000) {
+        serial.setLocalPosition(nodes[i], glm::vec3(1.0f, 2.0f, 3.0f));
+        parallel.setLocalPosition(nodes[i], glm::vec3(1.0f, 2.0f, 3.0f));
+    }
+    std::vector<TransformId> serialChanged, parallelChanged;
+    serial.updateWorldMatrices(&serialChanged);
+    parallel.updateWorldMatrices(&parallelChanged);
+    EXPECT_EQ(serialChanged, parallelChanged);
+    EXPECT_EQ(serialChanged.size(), 2 * ((rootCount + 999) / 1000));
+
+    for (TransformId node : nodes) {
+        expectMatrixNear(parallel.getWorldMatrix(node), serial.getWorldMatrix(node));
+        expectBoundsNear(parallel.getWorldBounds(node), serial.getWorldBounds(node), 1e-4f);
+    }
+}
+
+TEST(TransformBatchTest, HierarchyBoundsFollowEachNode) {
+    TransformHierarchy hierarchy;
+    TransformId parent = hierarchy.createNode();
+    TransformId child = hierarchy.createNode(parent);
+    TransformId bare = hierarchy.createNode();
+    hierarchy.setLocalPosition(parent, glm::vec3(10.0f, 0.0f, 0.0f));
+    hierarchy.setLocalPosition(child, glm::vec3(0.0f, 5.0f, 0.0f));
+    hierarchy.setLocalBounds(parent, AABB(glm::vec3(-1.0f), glm::vec3(1.0f)));
+    hierarchy.setLocalBounds(child, AABB(glm::vec3(0.0f), glm::vec3(2.0f, 4.0f, 2.0f)));
+    hierarchy.updateWorldMatrices();
+
+    expectBoundsNear(hierarchy.getWorldBounds(parent), AABB(glm::vec3(9.0f, -1.0f, -1.0f), glm::vec3(11.0f, 1.0f, 1.0f)), 1e-5f);
+    expectBoundsNear(hierarchy.getWorldBounds(child), AABB(glm::vec3(10.0f, 5.0f, 0.0f), glm::vec3(12.0f, 9.0f, 2.0f)), 1e-5f);
+    EXPECT_TRUE(hierarchy.getWorldBounds(bare).isEmpty());
+
+    // The parent moving carries the child's bounds along
+    hierarchy.setLocalPosition(parent, glm::vec3(0.0f));
+    hierarchy.updateWorldMatrices();
+    expectBoundsNear(hierarchy.getWorldBounds(child), AABB(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(2.0f, 9.0f, 2.0f)), 1e-5f);
+}
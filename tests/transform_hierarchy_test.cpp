@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <core/transform_hierarchy.h>
+#include <editor/editor.h>
+
+namespace {
+    void expectVecNear(const glm::vec3& actual, const glm::vec3& expected) {
+        EXPECT_NEAR(actual.x, expected.x, 1e-5f);
+        EXPECT_NEAR(actual.y, expected.y, 1e-5f);
+        EXPECT_NEAR(actual.z, expected.z, 1e-5f);
+    }
+}
+
+TEST(TransformHierarchyTest, ChildFollowsParent) {
+    TransformHierarchy hierarchy;
+    TransformId parent = hierarchy.createNode();
+    TransformId child = hierarchy.createNode(parent);
+
+    hierarchy.setLocalPosition(parent, glm::vec3(10.0f, 0.0f, 0.0f));
+    hierarchy.setLocalRotation(parent, glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    hierarchy.setLocalScale(parent, glm::vec3(2.0f));
+    hierarchy.setLocalPosition(child, glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(hierarchy.updateWorldMatrices(), 2u);
+
+    // Scaled by 2 and turned 90 degrees about Y: +X becomes -Z
+    expectVecNear(hierarchy.getWorldPosition(child), glm::vec3(10.0f, 0.0f, -2.0f));
+    EXPECT_EQ(hierarchy.getParent(child), parent);
+    EXPECT_EQ(hierarchy.getDepth(child), 1u);
+}
+
+TEST(TransformHierarchyTest, OnlyDirtySubtreesAreRecomputed) {
+    TransformHierarchy hierarchy;
+    TransformId rootA = hierarchy.createNode();
+    TransformId rootB = hierarchy.createNode();
+    for (int i = 0; i < 10; ++i) {
+        hierarchy.createNode(rootA);
+        hierarchy.createNode(rootB);
+    }
+    EXPECT_EQ(hierarchy.updateWorldMatrices(), 22u);
+    EXPECT_EQ(hierarchy.updateWorldMatrices(), 0u);
+
+    hierarchy.setLocalPosition(rootB, glm::vec3(1.0f));
+    EXPECT_EQ(hierarchy.updateWorldMatrices(), 11u);
+}
+
+TEST(TransformHierarchyTest, ReparentingResortsAndRejectsCycles) {
+    TransformHierarchy hierarchy;
+    TransformId a = hierarchy.createNode();
+    TransformId b = hierarchy.createNode(a);
+    TransformId c = hierarchy.createNode();
+    hierarchy.setLocalPosition(a, glm::vec3(1.0f, 0.0f, 0.0f));
+    hierarchy.setLocalPosition(b, glm::vec3(0.0f, 1.0f, 0.0f));
+    hierarchy.setLocalPosition(c, glm::vec3(0.0f, 0.0f, 1.0f));
+
+    EXPECT_FALSE(hierarchy.setParent(a, b));
+    EXPECT_FALSE(hierarchy.setParent(a, a));
+
+    // c was created after a, so a now sits behind its new parent until the sort
+    EXPECT_TRUE(hierarchy.setParent(a, c));
+    hierarchy.updateWorldMatrices();
+    EXPECT_EQ(hierarchy.getDepth(b), 2u);
+    expectVecNear(hierarchy.getWorldPosition(b), glm::vec3(1.0f, 1.0f, 1.0f));
+}
+
+TEST(TransformHierarchyTest, DestroyMovesChildrenUp) {
+    TransformHierarchy hierarchy;
+    TransformId root = hierarchy.createNode();
+    TransformId middle = hierarchy.createNode(root);
+    TransformId leaf = hierarchy.createNode(middle);
+    hierarchy.setLocalPosition(root, glm::vec3(1.0f, 0.0f, 0.0f));
+    hierarchy.setLocalPosition(middle, glm::vec3(5.0f, 0.0f, 0.0f));
+    hierarchy.setLocalPosition(leaf, glm::vec3(0.0f, 1.0f, 0.0f));
+    hierarchy.updateWorldMatrices();
+
+    hierarchy.destroyNode(middle);
+    EXPECT_FALSE(hierarchy.isValid(middle));
+    EXPECT_EQ(hierarchy.getParent(leaf), root);
+    EXPECT_EQ(hierarchy.size(), 2u);
+
+    hierarchy.updateWorldMatrices();
+    expectVecNear(hierarchy.getWorldPosition(leaf), glm::vec3(1.0f, 1.0f, 0.0f));
+
+    // Ids are recycled
+    EXPECT_EQ(hierarchy.createNode(), middle);
+}
+
+TEST(TransformHierarchyTest, EditorObjectsFollowParent) {
+    Editor::WorldEditor editor;
+    editor.addObject(Editor::ObjectType::HOUSE, glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+    editor.addObject(Editor::ObjectType::WALL, glm::vec3(12.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+
+    ASSERT_TRUE(editor.setObjectParent(1, 0));
+    EXPECT_FALSE(editor.setObjectParent(0, 1));
+    expectVecNear(editor.getObjects()[1]->getPosition(), glm::vec3(2.0f, 0.0f, 0.0f));
+
+    editor.selectObject(0);
+    editor.moveSelectedObject(glm::vec3(0.0f, 0.0f, 5.0f));
+    expectVecNear(editor.getObjectWorldPosition(1), glm::vec3(12.0f, 0.0f, 5.0f));
+
+    // Removing the parent leaves the child where it was
+    editor.removeObject(0);
+    ASSERT_EQ(editor.getObjects().size(), 1u);
+    expectVecNear(editor.getObjectWorldPosition(0), glm::vec3(12.0f, 0.0f, 5.0f));
+    expectVecNear(editor.getObjects()[0]->getPosition(), glm::vec3(12.0f, 0.0f, 5.0f));
+}
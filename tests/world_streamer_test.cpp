@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <editor/editor.h>
+#include <editor/scene_file.h>
+#include <editor/world_file.h>
+#include <editor/world_streamer.h>
+#include <glm/glm.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using Editor::ObjectHandle;
+using Editor::ObjectType;
+using Editor::SceneFile;
+using Editor::TestWorldOptions;
+using Editor::WorldEditor;
+using Editor::WorldFile;
+using Editor::WorldStreamer;
+
+namespace {
+    const size_t OBJECTS_PER_CHUNK = 20;
+
+    // 4x4 chunks of 64 units, from -128 to 128 on X and Z
+    std::string makeWorld(const std::string& name) {
+        std::string path = ::testing::TempDir() + "world_streamer_test_" + name + ".world";
+        TestWorldOptions options;
+        options.chunksPerSide = 4;
+        options.chunkSize = 64.0f;
+        options.objectsPerChunk = OBJECTS_PER_CHUNK;
+        EXPECT_TRUE(Editor::generateTestWorld(path, options));
+        return path;
+    }
+
+    WorldStreamer::Options streamOptions() {
+        WorldStreamer::Options options;
+        options.loadRadius = 40.0f;
+        options.unloadRadius = 100.0f;
+        return options;
+    }
+
+    void streamTo(WorldStreamer& streamer, const glm::vec3& position, const glm::vec3& view) {
+        streamer.update(position, view);
+        streamer.finishPending();
+    }
+}
+
+TEST(WorldStreamerTest, GeneratedChunksHoldTheirObjects) {
+    std::string path = makeWorld("generated");
+    WorldFile world;
+    ASSERT_TRUE(world.open(path));
+    EXPECT_EQ(world.getChunkSize(), 64.0f);
+    ASSERT_EQ(world.getChunks().size(), 16u);
+
+    for (size_t i = 0; i < world.getChunks().size(); ++i) {
+        const Editor::WorldChunkEntry& entry = world.getChunks()[i];
+        EXPECT_EQ(entry.objectCount, OBJECTS_PER_CHUNK);
+        std::vector<uint8_t> bytes;
+        ASSERT_TRUE(world.readChunk(i, bytes));
+        SceneFile scene;
+        ASSERT_TRUE(scene.view(bytes.data(), bytes.size()));
+
+        WorldEditor editor;
+        editor.loadScene(scene);
+        ASSERT_EQ(editor.getObjects().size(), OBJECTS_PER_CHUNK);
+        for (size_t j = 0; j < OBJECTS_PER_CHUNK; ++j) {
+            glm::vec3 position = editor.getObjectWorldPosition(j);
+            EXPECT_GE(position.x, entry.x * 64.0f);
+            EXPECT_LE(position.x, (entry.x + 1) * 64.0f);
+            EXPECT_GE(position.z, entry.z * 64.0f);
+            EXPECT_LE(position.z, (entry.z + 1) * 64.0f);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(WorldStreamerTest, RejectsDamagedWorld) {
+    std::string path = ::testing::TempDir() + "world_streamer_test_damaged.world";
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("FPSK not a world", file);
+    std::fclose(file);
+
+    WorldEditor editor;
+    WorldStreamer streamer;
+    EXPECT_FALSE(streamer.open(path, editor));
+    EXPECT_FALSE(streamer.isOpen());
+    std::remove(path.c_str());
+}
+
+TEST(WorldStreamerTest, LoadsAroundThePositionAndUnloadsWithHysteresis) {
+    std::string path = makeWorld("hysteresis");
+    WorldEditor editor;
+    WorldStreamer streamer;
+    ASSERT_TRUE(streamer.open(path, editor, streamOptions()));
+
+    // Inside chunk (0, 0), 32 units from the chunks on either side
+    streamTo(streamer, glm::vec3(32.0f, 0.0f, 32.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(streamer.isResident(0, 0));
+    EXPECT_TRUE(streamer.isResident(-1, 0));
+    EXPECT_TRUE(streamer.isResident(1, 0));
+    EXPECT_TRUE(streamer.isResident(0, -1));
+    EXPECT_TRUE(streamer.isResident(0, 1));
+    EXPECT_FALSE(streamer.isResident(1, 1));
+    EXPECT_EQ(streamer.getStats().residentChunks, 5u);
+    EXPECT_EQ(editor.getObjects().size(), 5 * OBJECTS_PER_CHUNK);
+    EXPECT_EQ(streamer.getStats().pendingChunks, 0u);
+    EXPECT_GT(streamer.getStats().averageLoadMs, 0.0);
+
+    // Past the load radius of (-1, 0) but inside its unload radius
+    streamTo(streamer, glm::vec3(90.0f, 0.0f, 32.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(streamer.isResident(-1, 0));
+    EXPECT_EQ(streamer.getStats().chunksUnloaded, 0u);
+
+    streamTo(streamer, glm::vec3(110.0f, 0.0f, 32.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_FALSE(streamer.isResident(-1, 0));
+    EXPECT_TRUE(streamer.isResident(1, 0));
+    EXPECT_EQ(editor.getObjects().size(), streamer.getStats().residentObjects);
+
+    streamer.close();
+    EXPECT_EQ(editor.getObjects().size(), 0u);
+    std::remove(path.c_str());
+}
+
+TEST(WorldStreamerTest, BudgetKeepsTheChunksAheadOfTheView) {
+    std::string path = makeWorld("budget");
+    WorldStreamer::Options options = streamOptions();
+    options.bytesPerObject = 1000;
+    options.memoryBudget = 2 * OBJECTS_PER_CHUNK * options.bytesPerObject;
+    WorldEditor editor;
+    WorldStreamer streamer;
+    ASSERT_TRUE(streamer.open(path, editor, options));
+
+    streamTo(streamer, glm::vec3(32.0f, 0.0f, 32.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(streamer.isResident(0, 0));
+    EXPECT_TRUE(streamer.isResident(1, 0));
+    EXPECT_FALSE(streamer.isResident(-1, 0));
+    EXPECT_EQ(streamer.getStats().residentBytes, options.memoryBudget);
+    EXPECT_GT(streamer.getStats().budgetStalls, 0u);
+
+    // Turning around trades the chunk now behind for the one ahead
+    streamTo(streamer, glm::vec3(32.0f, 0.0f, 32.0f), glm::vec3(-1.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(streamer.isResident(0, 0));
+    EXPECT_TRUE(streamer.isResident(-1, 0));
+    EXPECT_FALSE(streamer.isResident(1, 0));
+    EXPECT_EQ(streamer.getStats().chunksEvicted, 1u);
+    EXPECT_LE(streamer.getStats().peakResidentBytes, options.memoryBudget);
+    std::remove(path.c_str());
+}
+
+TEST(WorldStreamerTest, EditorObjectsSurviveStreaming) {
+    std::string path = makeWorld("editor_objects");
+    WorldEditor editor;
+    editor.addObject(ObjectType::TOWER, glm::vec3(500.0f, 0.0f, 500.0f), glm::vec3(2.0f));
+    ObjectHandle tower = editor.getSelectedObject();
+    WorldStreamer streamer;
+    ASSERT_TRUE(streamer.open(path, editor, streamOptions()));
+
+    streamTo(streamer, glm::vec3(32.0f, 0.0f, 32.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(editor.getSelectedObject(), tower);
+    EXPECT_FALSE(editor.undo());
+
+    // A streamed object the user removed is already gone when its chunk unloads
+    size_t streamedIndex = editor.getObjectIndex(tower) == 0 ? 1 : 0;
+    editor.removeObject(streamedIndex);
+    streamTo(streamer, glm::vec3(-1000.0f, 0.0f, -1000.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(streamer.getStats().residentChunks, 0u);
+    ASSERT_EQ(editor.getObjects().size(), 1u);
+    EXPECT_EQ(editor.getSelectedObject(), tower);
+    EXPECT_EQ(editor.getObjectWorldPosition(0), glm::vec3(500.0f, 0.0f, 500.0f));
+    std::remove(path.c_str());
+}